@@ -0,0 +1,73 @@
+#include "number_stats.h"
+#include "common/EventArena.h"
+#include <benchmark/benchmark.h>
+#include <string>
+#include <vector>
+
+// 01_demo_qt5_cmake_vcpkg：计算器的解析与统计
+
+namespace {
+
+// 与界面输入相同的格式："1, 2, 3, ..."，数值在 1..100 之间循环
+std::string makeInput(int count)
+{
+    std::string input;
+    for (int i = 0; i < count; ++i) {
+        if (i > 0) {
+            input += ", ";
+        }
+        input += std::to_string(i % 100 + 1);
+    }
+    return input;
+}
+
+void BM_ParseNumbers(benchmark::State& state)
+{
+    const std::string input = makeInput(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        auto numbers = parseNumbers(input);
+        benchmark::DoNotOptimize(numbers.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(input.size()));
+}
+BENCHMARK(BM_ParseNumbers)->Arg(5)->Arg(1000);
+
+void BM_ComputeStats(benchmark::State& state)
+{
+    const auto numbers = parseNumbers(makeInput(static_cast<int>(state.range(0))));
+    for (auto _ : state) {
+        auto stats = computeStats(numbers);
+        benchmark::DoNotOptimize(stats);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ComputeStats)->Arg(5)->Arg(1000);
+
+// 点击 Calculate 时的完整计算路径（不含界面更新）
+void BM_CalculateSum(benchmark::State& state)
+{
+    const std::string input = makeInput(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        auto numbers = parseNumbers(input);
+        auto stats = computeStats(numbers);
+        benchmark::DoNotOptimize(stats);
+    }
+}
+BENCHMARK(BM_CalculateSum)->Arg(5);
+
+// 同一路径，临时数据放在事件内存池中（界面实际使用的方式）
+void BM_CalculateSumArena(benchmark::State& state)
+{
+    const std::string input = makeInput(static_cast<int>(state.range(0)));
+    common::EventArena arena;
+    for (auto _ : state) {
+        common::EventArena::Scope scope(arena);
+        auto numbers = parseNumbers(input, scope.resource());
+        auto stats = computeStats(numbers);
+        benchmark::DoNotOptimize(stats);
+    }
+}
+BENCHMARK(BM_CalculateSumArena)->Arg(5)->Arg(1000);
+
+} // namespace
@@ -0,0 +1,168 @@
+#!/usr/bin/env python3
+"""
+基准测试回归检查
+运行 benchmarks 程序，把每项的中位数 CPU 时间与签入的基线比较，
+任何一项比基线慢超过阈值时以非零状态退出（供 ctest 使用）
+
+    compare_baseline.py --benchmark build/benchmarks/bin/benchmarks \\
+                        --baseline benchmarks/baselines/benchmarks.json \\
+                        --output benchmark_results.json
+
+--update 用本次结果重写基线文件（在参考机器上以 Release 构建运行后签入）；
+没有基线的基准默认只醒目地警告，--strict 时视为失败
+"""
+
+import argparse
+import json
+import platform
+import subprocess
+import sys
+from pathlib import Path
+
+# ctest 的 SKIP_RETURN_CODE：非优化构建不比较
+SKIP_RETURN_CODE = 77
+
+TIME_UNIT_NS = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+
+
+def run_benchmarks(executable, output, repetitions, benchmark_filter):
+    """运行基准程序，结果写入 output（Google Benchmark JSON 格式）"""
+    command = [
+        str(executable),
+        f"--benchmark_out={output}",
+        "--benchmark_out_format=json",
+        f"--benchmark_repetitions={repetitions}",
+        "--benchmark_report_aggregates_only=true",
+    ]
+    if benchmark_filter:
+        command.append(f"--benchmark_filter={benchmark_filter}")
+    print(f"执行命令: {' '.join(command)}")
+    subprocess.run(command, check=True)
+    with open(output, encoding="utf-8") as file:
+        return json.load(file)
+
+
+def median_times(results):
+    """每项基准的中位数 CPU 时间（纳秒），键为 run_name"""
+    times = {}
+    for entry in results.get("benchmarks", []):
+        if entry.get("run_type") == "aggregate" and entry.get("aggregate_name") != "median":
+            continue
+        name = entry.get("run_name", entry["name"])
+        scale = TIME_UNIT_NS[entry.get("time_unit", "ns")]
+        # 未重复运行时只有单次结果；有中位数时以中位数为准
+        if entry.get("run_type") == "aggregate" or name not in times:
+            times[name] = entry["cpu_time"] * scale
+    return times
+
+
+def write_baseline(path, results, times):
+    """写入基线；已有基线中本次没有运行的项（--filter）保留原值"""
+    merged = {}
+    if path.exists():
+        with open(path, encoding="utf-8") as file:
+            for entry in json.load(file).get("benchmarks", []):
+                merged[entry["name"]] = entry["cpu_time_ns"]
+    merged.update(times)
+    context = results.get("context", {})
+    baseline = {
+        "context": {
+            "host_name": context.get("host_name", platform.node()),
+            "num_cpus": context.get("num_cpus"),
+            "mhz_per_cpu": context.get("mhz_per_cpu"),
+            "date": context.get("date"),
+        },
+        "benchmarks": [
+            {"name": name, "cpu_time_ns": round(merged[name], 3)} for name in sorted(merged)
+        ],
+    }
+    path.parent.mkdir(parents=True, exist_ok=True)
+    with open(path, "w", encoding="utf-8") as file:
+        json.dump(baseline, file, indent=2, ensure_ascii=False)
+        file.write("\n")
+    print(f"基线已更新: {path}（本次 {len(times)} 项，共 {len(merged)} 项）")
+
+
+def compare(baseline, times, threshold, allow_missing, strict):
+    """返回失败的项数：回归、基线中有而本次缺失（只运行部分基准时除外）、--strict 时还包括没有基线的项"""
+    failures = 0
+    known = set()
+    print(f"{'benchmark':<40} {'baseline':>12} {'current':>12} {'change':>9}")
+    for entry in baseline.get("benchmarks", []):
+        name = entry["name"]
+        known.add(name)
+        expected = entry["cpu_time_ns"]
+        if name not in times:
+            if not allow_missing:
+                print(f"{name:<40} {expected:>10.1f}ns {'missing':>12}")
+                failures += 1
+            continue
+        actual = times[name]
+        change = actual / expected - 1.0
+        status = ""
+        if change > threshold:
+            status = "  REGRESSION"
+            failures += 1
+        print(f"{name:<40} {expected:>10.1f}ns {actual:>10.1f}ns {change:>+8.1%}{status}")
+    unrecorded = sorted(set(times) - known)
+    for name in unrecorded:
+        status = "  NO BASELINE" if strict else "  WARNING: no baseline"
+        print(f"{name:<40} {'-':>12} {times[name]:>10.1f}ns {'':>9}{status}")
+    if unrecorded:
+        print()
+        print("!" * 72)
+        print(f"!! {len(unrecorded)} 项基准没有基线，不受回归检查保护：")
+        for name in unrecorded:
+            print(f"!!     {name}")
+        print("!! 在参考机器上以 Release 构建运行 --update 记录后签入")
+        print("!" * 72)
+        if strict:
+            failures += len(unrecorded)
+    return failures
+
+
+def main():
+    parser = argparse.ArgumentParser(description="比较基准测试结果与签入的基线")
+    parser.add_argument("--benchmark", required=True, help="benchmarks 可执行文件")
+    parser.add_argument("--baseline", required=True, type=Path, help="基线 JSON 文件")
+    parser.add_argument("--output", default="benchmark_results.json", help="本次结果的 JSON 文件")
+    parser.add_argument("--threshold", type=float, default=0.25,
+                        help="允许的最大变慢比例（0.25 表示慢 25%%）")
+    parser.add_argument("--repetitions", type=int, default=5)
+    parser.add_argument("--filter", default="", help="只运行匹配的基准（正则）")
+    parser.add_argument("--build-type", default=None,
+                        help="构建类型，非优化构建或为空（单配置生成器未设置 CMAKE_BUILD_TYPE）时跳过比较")
+    parser.add_argument("--strict", action="store_true", help="没有基线的基准视为失败")
+    parser.add_argument("--update", action="store_true", help="用本次结果重写基线")
+    args = parser.parse_args()
+
+    if args.build_type == "":
+        print("未指定构建类型（CMAKE_BUILD_TYPE 为空），计时没有参考意义，跳过基线比较")
+        return SKIP_RETURN_CODE
+    if args.build_type is not None and args.build_type not in ("Release", "RelWithDebInfo"):
+        print(f"{args.build_type} 构建的计时没有参考意义，跳过基线比较")
+        return SKIP_RETURN_CODE
+
+    results = run_benchmarks(args.benchmark, args.output, args.repetitions, args.filter)
+    times = median_times(results)
+
+    if args.update:
+        write_baseline(args.baseline, results, times)
+        return 0
+
+    if not args.baseline.exists():
+        print(f"基线文件不存在: {args.baseline}（使用 --update 生成）")
+        return 1
+    with open(args.baseline, encoding="utf-8") as file:
+        baseline = json.load(file)
+
+    failures = compare(baseline, times, args.threshold, bool(args.filter), args.strict)
+    if failures:
+        print(f"{failures} 项比基线慢超过 {args.threshold:.0%}、缺失或没有基线")
+        return 1
+    print(f"全部在基线的 {args.threshold:.0%} 以内")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,77 @@
+#include "demo_steps.h"
+#include "common/TaskGraph.h"
+#include <benchmark/benchmark.h>
+
+// 02_demo_my_large_project：onButtonClicked 中的各个演示步骤（不含 imshow 和日志输出）
+
+namespace {
+
+void BM_MatrixDeterminant(benchmark::State& state) {
+    for (auto _ : state) {
+        Eigen::Matrix3d matrix = demoMatrix();
+        benchmark::DoNotOptimize(matrix.data());
+        double determinant = matrix.determinant();
+        benchmark::DoNotOptimize(determinant);
+    }
+}
+BENCHMARK(BM_MatrixDeterminant);
+
+void BM_DeterminantMessage(benchmark::State& state) {
+    const Eigen::Matrix3d matrix = demoMatrix();
+    for (auto _ : state) {
+        auto message = determinantMessage(matrix);
+        benchmark::DoNotOptimize(message.data());
+    }
+}
+BENCHMARK(BM_DeterminantMessage);
+
+void BM_RenderDemoImage(benchmark::State& state) {
+    for (auto _ : state) {
+        cv::Mat image = renderDemoImage();
+        benchmark::DoNotOptimize(image.data);
+    }
+    state.SetBytesProcessed(state.iterations() * 300 * 300 * 3);
+}
+BENCHMARK(BM_RenderDemoImage);
+
+void BM_DemoConfigDump(benchmark::State& state) {
+    for (auto _ : state) {
+        std::string text = demoConfig().dump(2);
+        benchmark::DoNotOptimize(text.data());
+    }
+}
+BENCHMARK(BM_DemoConfigDump);
+
+// 整个点击处理：依次执行与按依赖图执行，后者应接近最慢的单个步骤
+void BM_DemoStepsSequential(benchmark::State& state) {
+    for (auto _ : state) {
+        auto message = determinantMessage(demoMatrix());
+        cv::Mat image = renderDemoImage();
+        std::string config = demoConfig().dump(2);
+        benchmark::DoNotOptimize(message.data());
+        benchmark::DoNotOptimize(image.data);
+        benchmark::DoNotOptimize(config.data());
+    }
+}
+BENCHMARK(BM_DemoStepsSequential)->UseRealTime();
+
+void BM_DemoStepsGraph(benchmark::State& state) {
+    Eigen::Matrix3d matrix;
+    std::pmr::string message;
+    cv::Mat image;
+    std::string config;
+    common::TaskGraph graph;
+    auto matrixNode = graph.add("matrix", [&] { matrix = demoMatrix(); });
+    graph.add("determinant", [&] { message = determinantMessage(matrix); }, {matrixNode});
+    graph.add("image", [&] { image = renderDemoImage(); });
+    graph.add("config", [&] { config = demoConfig().dump(2); });
+    for (auto _ : state) {
+        graph.run();
+        benchmark::DoNotOptimize(message.data());
+        benchmark::DoNotOptimize(image.data);
+        benchmark::DoNotOptimize(config.data());
+    }
+}
+BENCHMARK(BM_DemoStepsGraph)->UseRealTime();
+
+} // namespace
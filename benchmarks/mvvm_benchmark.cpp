@@ -0,0 +1,69 @@
+#include "model/UserModel.h"
+#include "viewmodel/UserViewModel.h"
+#include <benchmark/benchmark.h>
+#include <QString>
+#include <memory>
+
+// 03_demo_mvvm：UserModel → UserViewModel 的更新级联（校验、属性通知、命令状态）
+
+namespace mvvm {
+namespace {
+
+struct Fixture {
+    std::shared_ptr<UserModel> model = std::make_shared<UserModel>();
+    UserViewModel viewModel{model};
+
+    // 输入值预先构造好，模拟控件已经持有的字符串
+    const QString names[2] = {QStringLiteral("张三"), QStringLiteral("李四")};
+    const QString emails[2] = {QStringLiteral("zhang@example.com"), QStringLiteral("li@bad")};
+    const QString ages[2] = {QStringLiteral("25"), QStringLiteral("80")};
+};
+
+// 视图输入一个字段：视图模型 → 模型 → 校验 → 视图模型属性通知
+void BM_ViewModelUpdateName(benchmark::State& state) {
+    Fixture fixture;
+    int i = 0;
+    for (auto _ : state) {
+        fixture.viewModel.updateName(fixture.names[i ^= 1]);
+    }
+}
+BENCHMARK(BM_ViewModelUpdateName);
+
+// 邮箱在合法与非法之间切换，每次都改变校验状态和保存命令的可用性
+void BM_ViewModelUpdateEmail(benchmark::State& state) {
+    Fixture fixture;
+    fixture.viewModel.updateName(fixture.names[0]);
+    int i = 0;
+    for (auto _ : state) {
+        fixture.viewModel.updateEmail(fixture.emails[i ^= 1]);
+    }
+}
+BENCHMARK(BM_ViewModelUpdateEmail);
+
+// 模型端修改（例如来自其他进程或导入）传播到视图模型
+void BM_ModelSetAgeCascade(benchmark::State& state) {
+    Fixture fixture;
+    int age = 0;
+    for (auto _ : state) {
+        fixture.model->setAge(20 + (age++ & 31));
+    }
+}
+BENCHMARK(BM_ModelSetAgeCascade);
+
+// 一轮典型的编辑：逐字段修改并执行重置命令
+void BM_ViewModelEditCycle(benchmark::State& state) {
+    Fixture fixture;
+    for (auto _ : state) {
+        for (int i = 0; i < 2; ++i) {
+            fixture.viewModel.updateName(fixture.names[i]);
+            fixture.viewModel.updateEmail(fixture.emails[i]);
+            fixture.viewModel.updateAge(fixture.ages[i]);
+            benchmark::DoNotOptimize(fixture.viewModel.saveCommand()->canExecute());
+        }
+        fixture.viewModel.resetCommand()->execute();
+    }
+}
+BENCHMARK(BM_ViewModelEditCycle);
+
+} // namespace
+} // namespace mvvm
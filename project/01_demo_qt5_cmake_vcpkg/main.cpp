@@ -7,7 +7,6 @@
 #include <QPushButton>
 #include <QLineEdit>
 #include <QLabel>
-#include <QTextEdit>
 #include <QListWidget>
 #include <QProgressBar>
 #include <QSlider>
@@ -18,10 +17,18 @@
 #include <QMessageBox>
 #include <QTimer>
 #include <QString>
-#include <QStringList>
 #include <fmt/core.h>
 #include <range/v3/all.hpp>
 #include <cxxopts.hpp>
+#include "common/EventArena.h"
+#include "common/LogView.h"
+#include "common/Metrics.h"
+#include "common/MetricsExporter.h"
+#include "common/QtStallWatchdog.h"
+#include "common/QtTaskBridge.h"
+#include "number_stats.h"
+#include <chrono>
+#include <optional>
 #include <vector>
 #include <string>
 #include <random>
@@ -31,7 +38,16 @@ class CalculatorWidget : public QWidget
     Q_OBJECT
 
 public:
-    CalculatorWidget(QWidget *parent = nullptr) : QWidget(parent)
+    CalculatorWidget(QWidget *parent = nullptr)
+        : QWidget(parent)
+        , m_runCounter(common::MetricsRegistry::global().counter(
+              "calculator_runs_total", "Calculate 的执行次数"))
+        , m_errorCounter(common::MetricsRegistry::global().counter(
+              "calculator_errors_total", "输入无法解析的次数"))
+        , m_inputSize(common::MetricsRegistry::global().gauge(
+              "calculator_input_numbers", "最近一次计算的数字个数"))
+        , m_runDuration(common::MetricsRegistry::global().latencyHistogram(
+              "calculator_run_duration_seconds", "解析、统计并显示结果的耗时"))
     {
         setupUI();
         connectSignals();
@@ -40,56 +56,50 @@ public:
 private slots:
     void calculateSum()
     {
-        try {
-            auto text = m_numberInput->text();
-            auto numbers = parseNumbers(text.toStdString());
-            
-            // 使用 range-v3 计算统计信息
-            if (!numbers.empty()) {
-                int sum = ranges::accumulate(numbers, 0);
-                int product = ranges::accumulate(numbers, 1, std::multiplies<int>());
-                double average = static_cast<double>(sum) / numbers.size();
-                auto [min_it, max_it] = ranges::minmax_element(numbers);
-                
-                QString result = QString(
-                    "Numbers: %1\n"
-                    "Count: %2\n"
-                    "Sum: %3\n"
-                    "Product: %4\n"
-                    "Average: %5\n"
-                    "Min: %6\n"
-                    "Max: %7"
-                ).arg(text)
-                 .arg(numbers.size())
-                 .arg(sum)
-                 .arg(product)
-                 .arg(average, 0, 'f', 2)
-                 .arg(*min_it)
-                 .arg(*max_it);
-                
-                m_resultText->setText(result);
-                
-                // 使用 fmt 在控制台输出
-                fmt::print("Calculated: sum={}, count={}, avg={:.2f}\n", 
-                          sum, numbers.size(), average);
-            }
-        } catch (const std::exception& e) {
-            m_resultText->setText(QString("Error: %1").arg(e.what()));
-        }
+        m_runCounter.add();
+        
+        // 最新一次计算胜出：上一次还没显示的结果直接丢弃
+        m_calculation.cancel();
+        m_calculation = common::CancellationToken();
+        
+        const auto started = std::chrono::steady_clock::now();
+        const QString text = m_numberInput->text();
+        
+        // 解析和统计在调度器中执行，结果回到 GUI 线程显示
+        // 解析的临时数据放在工作线程各自的事件内存池中，计算结束即整体释放
+        common::qt::run(this,
+            [input = text.toUtf8()]()
+            {
+                thread_local common::EventArena arena;
+                common::EventArena::Scope scope(arena);
+                Calculation calculation;
+                try {
+                    auto numbers = parseNumbers(std::string_view(input.constData(), input.size()), scope.resource());
+                    calculation.count = numbers.size();
+                    if (!numbers.empty()) {
+                        calculation.stats = computeStats(numbers);
+                    }
+                } catch (const std::exception& e) {
+                    calculation.error = e.what();
+                }
+                return calculation;
+            },
+            [this, text, started](Calculation calculation)
+            {
+                showCalculation(text, calculation);
+                m_runDuration.record(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - started).count());
+            },
+            common::TaskPriority::High, m_calculation);
     }
     
     void addRandomNumbers()
     {
-        std::random_device rd;
-        std::mt19937 gen(rd());
-        std::uniform_int_distribution<> dis(1, 100);
+        // 拼接的文本只在本次事件中使用，只有交给输入框的 QString 来自全局堆
+        common::EventArena::Scope scope(m_eventArena);
+        std::pmr::string numbers = randomNumbersText(m_random, 5, scope.resource());
         
-        QStringList numbers;
-        for (int i = 0; i < 5; ++i) {
-            numbers << QString::number(dis(gen));
-        }
-        
-        m_numberInput->setText(numbers.join(", "));
+        m_numberInput->setText(QString::fromUtf8(numbers.data(), static_cast<int>(numbers.size())));
         calculateSum();
     }
     
@@ -101,6 +111,51 @@ private slots:
     }
 
 private:
+    // 在调度器中算出的结果，解析失败时 error 非空
+    struct Calculation
+    {
+        std::size_t count = 0;
+        std::optional<NumberStats> stats;
+        std::string error;
+    };
+    
+    void showCalculation(const QString &text, const Calculation &calculation)
+    {
+        if (!calculation.error.empty()) {
+            m_errorCounter.add();
+            m_resultText->setPlainText(QString("Error: %1").arg(QString::fromStdString(calculation.error)));
+            return;
+        }
+        
+        m_inputSize.set(static_cast<std::int64_t>(calculation.count));
+        
+        if (calculation.stats) {
+            const NumberStats &stats = *calculation.stats;
+            
+            QString result = QString(
+                "Numbers: %1\n"
+                "Count: %2\n"
+                "Sum: %3\n"
+                "Product: %4\n"
+                "Average: %5\n"
+                "Min: %6\n"
+                "Max: %7"
+            ).arg(text)
+             .arg(stats.count)
+             .arg(stats.sum)
+             .arg(stats.product)
+             .arg(stats.average, 0, 'f', 2)
+             .arg(stats.min)
+             .arg(stats.max);
+            
+            m_resultText->setPlainText(result);
+            
+            // 使用 fmt 在控制台输出
+            fmt::print("Calculated: sum={}, count={}, avg={:.2f}\n", 
+                      stats.sum, stats.count, stats.average);
+        }
+    }
+    
     void setupUI()
     {
         auto *layout = new QVBoxLayout(this);
@@ -123,9 +178,9 @@ private:
         auto *resultGroup = new QGroupBox("Results", this);
         auto *resultLayout = new QVBoxLayout(resultGroup);
         
-        m_resultText = new QTextEdit(this);
+        // 只读结果面板：只绘制可见行，不为每次更新重排整个文档
+        m_resultText = new common::LogView(this);
         m_resultText->setMaximumHeight(150);
-        m_resultText->setReadOnly(true);
         
         resultLayout->addWidget(m_resultText);
         
@@ -155,34 +210,18 @@ private:
         connect(m_numberInput, &QLineEdit::returnPressed, this, &CalculatorWidget::calculateSum);
     }
     
-    std::vector<int> parseNumbers(const std::string& input)
-    {
-        std::vector<int> numbers;
-        std::string current;
-        
-        for (char c : input) {
-            if (c == ',' || c == ' ') {
-                if (!current.empty()) {
-                    numbers.push_back(std::stoi(current));
-                    current.clear();
-                }
-            } else if (std::isdigit(c) || c == '-') {
-                current += c;
-            }
-        }
-        
-        if (!current.empty()) {
-            numbers.push_back(std::stoi(current));
-        }
-        
-        return numbers;
-    }
-    
     QLineEdit *m_numberInput;
     QPushButton *m_calculateBtn;
     QPushButton *m_randomBtn;
-    QTextEdit *m_resultText;
+    common::LogView *m_resultText;
     QListWidget *m_historyList;
+    common::Counter &m_runCounter;
+    common::Counter &m_errorCounter;
+    common::Gauge &m_inputSize;
+    common::Histogram &m_runDuration;
+    common::CancellationToken m_calculation;
+    common::EventArena m_eventArena{4 * 1024};
+    std::mt19937 m_random{std::random_device{}()};
 };
 
 class ProgressWidget : public QWidget
@@ -370,6 +409,14 @@ int main(int argc, char *argv[])
     
     QApplication app(argc, argv);
     
+    // METRICS_SOCKET / METRICS_FILE 设置时导出运行指标
+    common::MetricsExporter metricsExporter;
+    metricsExporter.startFromEnvironment();
+    
+    // GUI 线程卡顿超过 GUI_STALL_THRESHOLD_MS（默认 500，0 关闭）时输出调用栈到 stderr
+    common::StallWatchdog stallWatchdog(common::StallWatchdog::Options::fromEnvironment());
+    common::qt::startStallWatchdog(stallWatchdog, &app);
+    
     MainWindow window;
     
     if (result.count("fullscreen")) {
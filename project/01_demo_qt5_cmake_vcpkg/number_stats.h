@@ -0,0 +1,100 @@
+#pragma once
+
+#include <range/v3/algorithm/minmax_element.hpp>
+#include <range/v3/numeric/accumulate.hpp>
+#include <fmt/format.h>
+#include <cctype>
+#include <charconv>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory_resource>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// 计算器的解析与统计逻辑，不依赖 Qt，界面和基准测试共用
+
+// 解析一个数字记号，与 std::stoi 相同：取开头的整数部分，没有数字时抛出 std::invalid_argument，
+// 超出 int 范围时抛出 std::out_of_range
+inline int parseNumberToken(std::string_view token)
+{
+    int value = 0;
+    const std::from_chars_result result = std::from_chars(token.data(), token.data() + token.size(), value);
+    if (result.ec == std::errc::invalid_argument) {
+        throw std::invalid_argument("stoi");
+    }
+    if (result.ec == std::errc::result_out_of_range) {
+        throw std::out_of_range("stoi");
+    }
+    return value;
+}
+
+// 解析以逗号或空格分隔的整数，忽略其他字符；数字超出 int 范围时抛出 std::out_of_range
+// 结果和解析用的临时文本都从 memory 分配，传入事件内存池时不访问全局堆
+inline std::pmr::vector<int> parseNumbers(std::string_view input,
+                                          std::pmr::memory_resource* memory = std::pmr::get_default_resource())
+{
+    std::pmr::vector<int> numbers(memory);
+    std::pmr::string current(memory);
+
+    for (char c : input) {
+        if (c == ',' || c == ' ') {
+            if (!current.empty()) {
+                numbers.push_back(parseNumberToken(current));
+                current.clear();
+            }
+        } else if (std::isdigit(static_cast<unsigned char>(c)) || c == '-') {
+            current += c;
+        }
+    }
+
+    if (!current.empty()) {
+        numbers.push_back(parseNumberToken(current));
+    }
+
+    return numbers;
+}
+
+struct NumberStats
+{
+    std::size_t count = 0;
+    int sum = 0;
+    int product = 1;
+    double average = 0.0;
+    int min = 0;
+    int max = 0;
+};
+
+// 使用 range-v3 计算统计信息，numbers 不能为空（std::vector 或 std::pmr::vector）
+template<typename Numbers>
+NumberStats computeStats(const Numbers& numbers)
+{
+    NumberStats stats;
+    stats.count = numbers.size();
+    stats.sum = ranges::accumulate(numbers, 0);
+    stats.product = ranges::accumulate(numbers, 1, std::multiplies<int>());
+    stats.average = static_cast<double>(stats.sum) / numbers.size();
+    auto [min_it, max_it] = ranges::minmax_element(numbers);
+    stats.min = *min_it;
+    stats.max = *max_it;
+    return stats;
+}
+
+// 生成 count 个 1..100 的随机数，格式与输入框相同（"12, 7, 95"），文本从 memory 分配
+inline std::pmr::string randomNumbersText(std::mt19937& generator, int count,
+                                          std::pmr::memory_resource* memory = std::pmr::get_default_resource())
+{
+    std::uniform_int_distribution<> distribution(1, 100);
+    std::pmr::string text(memory);
+    text.reserve(static_cast<std::size_t>(count) * 5);
+    for (int i = 0; i < count; ++i) {
+        if (i > 0) {
+            text += ", ";
+        }
+        fmt::format_to(std::back_inserter(text), "{}", distribution(generator));
+    }
+    return text;
+}
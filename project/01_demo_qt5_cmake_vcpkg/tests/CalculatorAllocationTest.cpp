@@ -0,0 +1,172 @@
+#include "number_stats.h"
+#include "common/EventArena.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <stdexcept>
+
+/**
+ * 堆分配计数
+ *
+ * 替换全局 operator new；glibc 下同时拦截 malloc 系列。
+ * 只在 AllocationScope 存活期间计数，gtest 自身的分配不受影响。
+ */
+namespace {
+
+std::atomic<bool> counting{false};
+std::atomic<long> allocations{0};
+
+void countAllocation() {
+    if (counting.load(std::memory_order_relaxed)) {
+        allocations.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+class AllocationScope {
+public:
+    AllocationScope() {
+        allocations = 0;
+        counting = true;
+    }
+    ~AllocationScope() { counting = false; }
+
+    long count() const { return allocations.load(); }
+};
+
+} // namespace
+
+#if defined(__GLIBC__)
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* pointer, size_t size);
+
+void* malloc(size_t size) {
+    countAllocation();
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size) {
+    countAllocation();
+    return __libc_calloc(count, size);
+}
+
+void* realloc(void* pointer, size_t size) {
+    countAllocation();
+    return __libc_realloc(pointer, size);
+}
+}
+#endif
+
+void* operator new(std::size_t size) {
+#if !defined(__GLIBC__)
+    countAllocation();
+#endif
+    if (void* pointer = std::malloc(size ? size : 1)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+#if !defined(__GLIBC__)
+    countAllocation();
+#endif
+    return std::malloc(size ? size : 1);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept {
+    return operator new(size, tag);
+}
+
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+void operator delete[](void* pointer) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::size_t) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, std::size_t) noexcept { std::free(pointer); }
+
+namespace {
+
+// 一次 Calculate 事件中不涉及界面的部分：生成输入文本、解析、统计
+NumberStats handleEvent(common::EventArena& arena, std::mt19937& random)
+{
+    common::EventArena::Scope scope(arena);
+    std::pmr::string text = randomNumbersText(random, 5, scope.resource());
+    auto numbers = parseNumbers(text, scope.resource());
+    return computeStats(numbers);
+}
+
+TEST(CalculatorAllocationTest, SteadyStateEventsDoNotAllocate)
+{
+    common::EventArena arena(4 * 1024);
+    std::mt19937 random(42);
+    handleEvent(arena, random);
+
+    long count = 0;
+    std::size_t total = 0;
+    {
+        AllocationScope scope;
+        for (int i = 0; i < 1000; ++i) {
+            total += handleEvent(arena, random).count;
+        }
+        count = scope.count();
+    }
+
+    EXPECT_EQ(total, 5000u);
+    EXPECT_EQ(count, 0) << "处理事件期间发生了 " << count << " 次堆分配";
+    EXPECT_EQ(arena.overflowCount(), 0u);
+}
+
+TEST(CalculatorAllocationTest, ArenaGrowsAfterOverflowThenStopsAllocating)
+{
+    // 初始缓冲区远小于一次事件的用量：第一次事件溢出到全局堆，reset 后扩容
+    common::EventArena arena(64);
+    std::string input;
+    for (int i = 0; i < 500; ++i) {
+        input += std::to_string(i) + ", ";
+    }
+    {
+        common::EventArena::Scope scope(arena);
+        EXPECT_EQ(parseNumbers(input, scope.resource()).size(), 500u);
+    }
+    EXPECT_GT(arena.overflowCount(), 0u);
+    EXPECT_GT(arena.capacity(), 64u);
+
+    const std::size_t overflows = arena.overflowCount();
+    long count = 0;
+    {
+        AllocationScope scope;
+        for (int i = 0; i < 10; ++i) {
+            common::EventArena::Scope event(arena);
+            auto numbers = parseNumbers(input, event.resource());
+            EXPECT_EQ(computeStats(numbers).max, 499);
+        }
+        count = scope.count();
+    }
+    EXPECT_EQ(count, 0);
+    EXPECT_EQ(arena.overflowCount(), overflows);
+}
+
+TEST(CalculatorParseTest, MatchesPreviousStoiBehaviour)
+{
+    const auto numbers = parseNumbers("1, 2,3  -4 x5 1a2");
+    ASSERT_EQ(numbers.size(), 6u);
+    EXPECT_EQ(numbers[3], -4);
+    EXPECT_EQ(numbers[4], 5);
+    EXPECT_EQ(numbers[5], 12);
+
+    // 只有符号没有数字、超出 int 范围：与 std::stoi 抛出相同的异常
+    EXPECT_THROW(parseNumbers("1, -"), std::invalid_argument);
+    EXPECT_THROW(parseNumbers("99999999999"), std::out_of_range);
+
+    const NumberStats stats = computeStats(parseNumbers("1, 2, 3, 4"));
+    EXPECT_EQ(stats.sum, 10);
+    EXPECT_EQ(stats.product, 24);
+    EXPECT_DOUBLE_EQ(stats.average, 2.5);
+}
+
+} // namespace
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <opencv2/core.hpp>
+#include <opencv2/imgproc.hpp>
+#include <eigen3/Eigen/Dense>
+#include <fmt/format.h>
+#include <nlohmann/json.hpp>
+#include <iterator>
+#include <memory_resource>
+#include <string>
+
+// onButtonClicked 中各演示步骤的计算部分，不依赖 Qt 和窗口，界面和基准测试共用
+
+// Eigen 矩阵运算
+inline Eigen::Matrix3d demoMatrix() {
+    Eigen::Matrix3d matrix;
+    matrix << 1, 2, 3,
+              4, 5, 6,
+              7, 8, 9;
+    return matrix;
+}
+
+// fmt 格式化，文本从 memory 分配（点击处理中传入事件内存池）
+inline std::pmr::string determinantMessage(const Eigen::Matrix3d& matrix,
+                                           std::pmr::memory_resource* memory = std::pmr::get_default_resource()) {
+    std::pmr::string message(memory);
+    fmt::format_to(std::back_inserter(message), "矩阵行列式: {:.2f}", matrix.determinant());
+    return message;
+}
+
+// OpenCV 创建一个简单图像
+inline cv::Mat renderDemoImage() {
+    cv::Mat image = cv::Mat::zeros(300, 300, CV_8UC3);
+    cv::circle(image, cv::Point(150, 150), 50, cv::Scalar(0, 255, 0), -1);
+    return image;
+}
+
+// JSON 处理
+inline nlohmann::json demoConfig() {
+    nlohmann::json config;
+    config["name"] = "MyLargeProject";
+    config["version"] = "1.0.0";
+    config["libraries"] = {"Qt", "OpenCV", "Boost", "Eigen", "fmt", "spdlog"};
+    return config;
+}
+
+// 配置是常量：第一次调用时构造 JSON 并序列化，之后每次点击直接复用文本
+inline const std::string& demoConfigText() {
+    static const std::string text = demoConfig().dump(2);
+    return text;
+}
@@ -10,6 +10,15 @@
 #include <fmt/format.h>
 #include <spdlog/spdlog.h>
 #include <nlohmann/json.hpp>
+#include "demo_steps.h"
+#include "common/EventArena.h"
+#include "common/Metrics.h"
+#include "common/MetricsExporter.h"
+#include "common/QtStallWatchdog.h"
+#include "common/QtTaskBridge.h"
+#include "common/TaskGraph.h"
+#include <chrono>
+#include <future>
 
 #ifdef ENABLE_TESTS
 #include <gtest/gtest.h>
@@ -25,36 +34,95 @@ public:
 
 private slots:
     void onButtonClicked() {
-        // 演示各种库的使用
+        // 运行指标：首次调用时注册，之后只做原子累加
+        static common::Counter& runs = common::MetricsRegistry::global().counter(
+            "demo_runs_total", "运行演示的次数");
+        static common::Histogram& runDuration = common::MetricsRegistry::global().latencyHistogram(
+            "demo_run_duration_seconds", "从点击到显示结果的耗时");
+        static common::Counter& frames = common::MetricsRegistry::global().counter(
+            "image_frames_total", "生成并显示的图像帧数");
+        static common::Histogram& frameDuration = common::MetricsRegistry::global().latencyHistogram(
+            "image_frame_duration_seconds", "生成并显示一帧图像的耗时");
+        // 每次点击租用自己的事件内存池（只存放行列式文本）；连续点击时实例数等于同时在执行的点击数
+        static common::EventArenaPool arenas(4 * 1024);
         
-        // Boost filesystem
-        boost::filesystem::path currentPath = boost::filesystem::current_path();
-        spdlog::info("当前路径: {}", currentPath.string());
+        runs.add();
+        const auto started = std::chrono::steady_clock::now();
         
-        // Eigen 矩阵运算
-        Eigen::Matrix3d matrix;
-        matrix << 1, 2, 3,
-                  4, 5, 6,
-                  7, 8, 9;
+        // 演示各种库的使用：各步骤组成依赖图，在调度器中执行，互不依赖的步骤并行
+        //   determinant <- matrix
+        //   show        <- determinant, image           （投递到 GUI 线程显示）
+        //   log         <- filesystem, determinant, config
+        // show 只等待它需要的行列式和图像，点击到显示的延迟约为最长的单个步骤
+        struct DemoState {
+            std::string currentPath;
+            Eigen::Matrix3d matrix;
+            std::pmr::string message;
+            cv::Mat image;
+            const std::string* config = nullptr;
+            
+            explicit DemoState(std::pmr::memory_resource* memory) : message(memory) {}
+        };
+        QPointer<MainWindow> window(this);
         
-        // fmt 格式化
-        std::string message = fmt::format("矩阵行列式: {:.2f}", matrix.determinant());
-        spdlog::info(message);
-        
-        // OpenCV 创建一个简单图像
-        cv::Mat image = cv::Mat::zeros(300, 300, CV_8UC3);
-        cv::circle(image, cv::Point(150, 150), 50, cv::Scalar(0, 255, 0), -1);
-        cv::imshow("OpenCV Demo", image);
-        
-        // JSON 处理
-        nlohmann::json config;
-        config["name"] = "MyLargeProject";
-        config["version"] = "1.0.0";
-        config["libraries"] = {"Qt", "OpenCV", "Boost", "Eigen", "fmt", "spdlog"};
-        
-        std::cout << "项目配置: " << config.dump(2) << std::endl;
-        
-        label->setText(QString::fromStdString(message));
+        common::TaskScheduler::shared().submit([window, started]() {
+            // 本次点击的行列式文本放在租来的事件内存池中，图执行完（所有节点结束）后归还。
+            // 不能用 thread_local：graph.run() 等待时本线程可能帮忙执行下一次点击的任务。
+            // 只有 determinant 节点从中分配，读取 message 的节点都依赖它，同一时刻只有一个线程使用。
+            // 点击的其余部分仍使用全局堆：图节点和任务闭包、currentPath、交给 GUI 线程的
+            // cv::Mat 与 QString、spdlog 的格式化；这条路径不是零分配的
+            auto lease = arenas.acquire();
+            DemoState state(lease.resource());
+            common::TaskGraph graph;
+            
+            // Boost filesystem
+            auto filesystem = graph.add("filesystem", [&state] {
+                state.currentPath = boost::filesystem::current_path().string();
+            });
+            
+            // Eigen 矩阵运算，fmt 格式化
+            auto matrix = graph.add("matrix", [&state] { state.matrix = demoMatrix(); });
+            auto determinant = graph.add("determinant", [&state] {
+                state.message = determinantMessage(state.matrix, state.message.get_allocator().resource());
+            }, {matrix});
+            
+            // OpenCV 创建一个简单图像
+            auto image = graph.add("image", [&state] { state.image = renderDemoImage(); });
+            
+            // JSON 处理：配置是常量，只在第一次点击时构造和序列化
+            auto config = graph.add("config", [&state] { state.config = &demoConfigText(); });
+            
+            // 显示窗口、更新标签必须在 GUI 线程；结果按值交给 GUI 线程，图执行完后 state 即销毁。
+            // 窗口是否还在只能在 GUI 线程判断：post 的 QPointer 重载投递到程序对象，执行前检查 window
+            graph.add("show", [&state, window, started] {
+                const QString message = QString::fromUtf8(state.message.data(), static_cast<int>(state.message.size()));
+                common::qt::post(window, [window, started, image = state.image, message]() {
+                    cv::imshow("OpenCV Demo", image);
+                    frames.add();
+                    frameDuration.record(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now() - started).count());
+                    
+                    window->label->setText(message);
+                    
+                    runDuration.record(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now() - started).count());
+                });
+            }, {determinant, image}, common::TaskPriority::High);
+            
+            // 日志不在显示的关键路径上
+            graph.add("log", [&state] {
+                spdlog::info("当前路径: {}", state.currentPath);
+                spdlog::info(std::string_view(state.message));
+                std::cout << "项目配置: " << *state.config << std::endl;
+            }, {filesystem, determinant, config});
+            
+            try {
+                graph.run();
+            } catch (const std::exception& e) {
+                spdlog::error("演示失败: {}", e.what());
+            }
+            spdlog::info("演示步骤耗时，{}", graph.report().toString());
+        }, common::TaskPriority::High);
     }
 
 private:
@@ -81,6 +149,55 @@ private:
 TEST(BasicTest, SampleTest) {
     EXPECT_EQ(2 + 2, 4);
 }
+
+namespace {
+
+// 每层点击写入的文本；比测试中内存池的初始容量长，每次点击都会走超出缓冲区的分配路径
+std::string clickText(int depth) {
+    return "第 " + std::to_string(depth) + " 层点击：" + std::string(300, static_cast<char>('a' + depth));
+}
+
+// 与 onButtonClicked 相同的内存用法：租用事件内存池，一个节点写入，后继节点读取；
+// 中间的节点在图执行期间嵌套执行下一层点击
+std::string runNestedClick(common::TaskScheduler& scheduler, common::EventArenaPool& arenas, int depth) {
+    auto lease = arenas.acquire();
+    std::pmr::string message(lease.resource());
+    std::string inner;
+    common::TaskGraph graph;
+    auto write = graph.add("write", [&message, depth] { message = clickText(depth); });
+    auto nested = graph.add("nested", [&] {
+        if (depth > 0) {
+            inner = runNestedClick(scheduler, arenas, depth - 1);
+        }
+    }, {write});
+    graph.add("check", [&message, depth] { EXPECT_EQ(std::string_view(message), clickText(depth)); }, {nested});
+    graph.run(scheduler);
+    if (depth > 0) {
+        EXPECT_EQ(inner, clickText(depth - 1));
+    }
+    return std::string(message);
+}
+
+} // namespace
+
+TEST(DemoGraphTest, NestedRunsUseSeparateArenas) {
+    // 单个工作线程，测试线程只阻塞等待结果、不帮忙执行：三层点击的图都在同一线程上嵌套执行。
+    // 共用一个 thread_local 的内存池时，内层点击结束的 reset() 会释放外层仍在使用的文本
+    common::TaskScheduler scheduler(1);
+    common::EventArenaPool arenas(256);
+    const auto click = [&scheduler, &arenas]() {
+        std::promise<std::string> result;
+        scheduler.submit([&] { result.set_value(runNestedClick(scheduler, arenas, 2)); });
+        return result.get_future().get();
+    };
+    
+    EXPECT_EQ(click(), clickText(2));
+    EXPECT_EQ(arenas.arenaCount(), 3u);
+    
+    // 全部归还后再次点击复用已有的实例
+    EXPECT_EQ(click(), clickText(2));
+    EXPECT_EQ(arenas.arenaCount(), 3u);
+}
 #endif
 
 int main(int argc, char *argv[]) {
@@ -93,10 +210,21 @@ int main(int argc, char *argv[]) {
     
     QApplication app(argc, argv);
     
+    // METRICS_SOCKET / METRICS_FILE 设置时导出运行指标
+    common::MetricsExporter metricsExporter;
+    metricsExporter.startFromEnvironment();
+    
     // 设置日志
     spdlog::set_level(spdlog::level::info);
     spdlog::info("应用程序启动");
     
+    // GUI 线程卡顿超过 GUI_STALL_THRESHOLD_MS（默认 500，0 关闭）时记录时长和调用栈
+    common::StallWatchdog stallWatchdog(common::StallWatchdog::Options::fromEnvironment());
+    stallWatchdog.setReporter([](const common::StallWatchdog::StallEvent& event) {
+        spdlog::warn(event.toString());
+    });
+    common::qt::startStallWatchdog(stallWatchdog, &app);
+    
     MainWindow window;
     window.show();
     
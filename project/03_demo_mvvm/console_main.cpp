@@ -0,0 +1,44 @@
+#include "view/ConsoleView.h"
+#include "sync/SharedUserChannel.h"
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+/**
+ * MVVM 控制台演示程序
+ *
+ * 与 Qt 界面使用相同的校验规则和状态文本，但视图模型来自不依赖 Qt 的 lite 核心：
+ * 不需要 QApplication、事件循环或 moc，观察者通知是同步的直接调用。
+ *
+ * 设置 MVVM_SYNC_NAME 时与同名的其他前端进程（Qt 界面或控制台）通过共享内存同步当前用户。
+ */
+
+using namespace mvvm;
+
+int main() {
+#ifdef _WIN32
+    // 源码与输出均为 UTF-8
+    SetConsoleOutputCP(CP_UTF8);
+    SetConsoleCP(CP_UTF8);
+#endif
+
+    auto viewModel = std::make_shared<lite::UserViewModel>();
+    ConsoleView view(viewModel);
+
+    if (const char* syncName = std::getenv("MVVM_SYNC_NAME"); syncName && *syncName) {
+        auto channel = std::make_shared<sync::SharedUserChannel>();
+        std::string error;
+        if (channel->open(syncName, &error)) {
+            view.setSharedChannel(channel);
+        } else {
+            std::cerr << "共享内存同步不可用: " << error << std::endl;
+        }
+    }
+
+    view.run();
+    return 0;
+}
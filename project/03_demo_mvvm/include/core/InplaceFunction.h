@@ -0,0 +1,155 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace mvvm {
+
+/**
+ * 默认容量：捕获 this 加上两三个指针的 lambda，且至少能放下一个 std::function
+ * （MSVC x64 上 std::function 为 64 字节，libstdc++ 上为 32 字节）
+ */
+template<typename Signature>
+constexpr std::size_t defaultInplaceCapacity =
+    sizeof(std::function<Signature>) > 4 * sizeof(void*) ? sizeof(std::function<Signature>) : 4 * sizeof(void*);
+
+template<typename Signature, std::size_t Capacity = defaultInplaceCapacity<Signature>>
+class InplaceFunction;
+
+/**
+ * 小缓冲区可调用对象 - std::function 的替代
+ *
+ * 可调用对象总是存放在对象内部的 Capacity 字节缓冲区中，从不分配堆内存；
+ * 放不下时在编译期报错，而不是像 std::function 那样悄悄退化为堆分配。
+ * 命令、限流器等在每次执行时都会调用回调，热路径上不能有分配。
+ *
+ * 默认容量见 defaultInplaceCapacity，传入的 std::function 总能放下（其内部是否分配由它自己决定）。
+ */
+template<typename Result, typename... Args, std::size_t Capacity>
+class InplaceFunction<Result(Args...), Capacity> {
+private:
+    using Storage = std::aligned_storage_t<Capacity, alignof(std::max_align_t)>;
+
+    // 手写的虚表：调用、复制构造、移动构造、析构
+    struct Ops {
+        Result (*invoke)(void* object, Args&&... args);
+        void (*copy)(void* destination, const void* source);
+        void (*move)(void* destination, void* source);
+        void (*destroy)(void* object);
+    };
+
+    template<typename Callable>
+    static const Ops* opsFor() {
+        static const Ops ops = {
+            [](void* object, Args&&... args) -> Result {
+                return (*static_cast<Callable*>(object))(std::forward<Args>(args)...);
+            },
+            [](void* destination, const void* source) {
+                new (destination) Callable(*static_cast<const Callable*>(source));
+            },
+            [](void* destination, void* source) {
+                new (destination) Callable(std::move(*static_cast<Callable*>(source)));
+            },
+            [](void* object) {
+                static_cast<Callable*>(object)->~Callable();
+            }
+        };
+        return &ops;
+    }
+
+    Storage storage_;
+    const Ops* ops_;
+
+public:
+    InplaceFunction() noexcept : ops_(nullptr) {}
+    InplaceFunction(std::nullptr_t) noexcept : ops_(nullptr) {}
+
+    template<typename Callable,
+             typename Decayed = std::decay_t<Callable>,
+             typename = std::enable_if_t<!std::is_same<Decayed, InplaceFunction>::value &&
+                                         !std::is_same<Decayed, std::nullptr_t>::value>>
+    InplaceFunction(Callable&& callable) : ops_(nullptr) {
+        static_assert(sizeof(Decayed) <= Capacity, "可调用对象超出 InplaceFunction 容量，请减少捕获或增大 Capacity");
+        static_assert(alignof(Decayed) <= alignof(std::max_align_t), "可调用对象对齐要求过高");
+        static_assert(std::is_copy_constructible<Decayed>::value, "可调用对象必须可复制");
+        if (isEmpty(callable)) {
+            return;
+        }
+        new (&storage_) Decayed(std::forward<Callable>(callable));
+        ops_ = opsFor<Decayed>();
+    }
+
+    InplaceFunction(const InplaceFunction& other) : ops_(other.ops_) {
+        if (ops_) {
+            ops_->copy(&storage_, &other.storage_);
+        }
+    }
+
+    InplaceFunction(InplaceFunction&& other) noexcept : ops_(other.ops_) {
+        if (ops_) {
+            ops_->move(&storage_, &other.storage_);
+            other.reset();
+        }
+    }
+
+    ~InplaceFunction() { reset(); }
+
+    InplaceFunction& operator=(const InplaceFunction& other) {
+        if (this != &other) {
+            InplaceFunction copy(other);
+            *this = std::move(copy);
+        }
+        return *this;
+    }
+
+    InplaceFunction& operator=(InplaceFunction&& other) noexcept {
+        if (this != &other) {
+            reset();
+            if (other.ops_) {
+                other.ops_->move(&storage_, &other.storage_);
+                ops_ = other.ops_;
+                other.reset();
+            }
+        }
+        return *this;
+    }
+
+    InplaceFunction& operator=(std::nullptr_t) noexcept {
+        reset();
+        return *this;
+    }
+
+    Result operator()(Args... args) const {
+        if (!ops_) {
+            throw std::bad_function_call();
+        }
+        return ops_->invoke(const_cast<Storage*>(&storage_), std::forward<Args>(args)...);
+    }
+
+    explicit operator bool() const noexcept { return ops_ != nullptr; }
+
+private:
+    void reset() noexcept {
+        if (ops_) {
+            ops_->destroy(&storage_);
+            ops_ = nullptr;
+        }
+    }
+
+    // 空函数指针、空 std::function 视为未设置
+    template<typename Callable>
+    static bool isEmpty(const Callable& callable) {
+        if constexpr (std::is_pointer<Callable>::value || std::is_member_pointer<Callable>::value) {
+            return callable == nullptr;
+        } else {
+            return false;
+        }
+    }
+
+    template<typename Signature>
+    static bool isEmpty(const std::function<Signature>& function) { return !function; }
+};
+
+} // namespace mvvm
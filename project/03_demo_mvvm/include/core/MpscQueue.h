@@ -0,0 +1,80 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+namespace mvvm {
+
+/**
+ * 无锁多生产者单消费者队列（Vyukov 链表算法）
+ *
+ * - push() 可在任意线程调用，等待无关：一次原子交换加一次 release 写
+ * - tryPop() 只能由唯一的消费者线程调用，不需要任何原子读改写
+ * - 生产者交换完尾指针、尚未链接 next 的瞬间，消费者看到的队列会暂时"断开"，
+ *   tryPop() 返回 false，下一次调用即可取到；批量消费时这不影响正确性
+ *
+ * 每个元素一个节点（一次分配），T 需可默认构造（哨兵节点使用）。
+ */
+template<typename T>
+class MpscQueue {
+private:
+    struct Node {
+        std::atomic<Node*> next{nullptr};
+        T value;
+
+        Node() = default;
+        explicit Node(T&& item) : value(std::move(item)) {}
+    };
+
+    // 生产者与消费者访问的指针分开在不同缓存行，避免伪共享
+    alignas(64) std::atomic<Node*> head_;
+    alignas(64) Node* tail_;
+    alignas(64) std::atomic<std::size_t> size_;
+
+public:
+    MpscQueue() : size_(0) {
+        Node* stub = new Node();
+        head_.store(stub, std::memory_order_relaxed);
+        tail_ = stub;
+    }
+
+    ~MpscQueue() {
+        Node* node = tail_;
+        while (node) {
+            Node* next = node->next.load(std::memory_order_relaxed);
+            delete node;
+            node = next;
+        }
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    void push(T item) {
+        Node* node = new Node(std::move(item));
+        size_.fetch_add(1, std::memory_order_relaxed);
+        Node* previous = head_.exchange(node, std::memory_order_acq_rel);
+        previous->next.store(node, std::memory_order_release);
+    }
+
+    bool tryPop(T& out) {
+        Node* tail = tail_;
+        Node* next = tail->next.load(std::memory_order_acquire);
+        if (!next) {
+            return false;
+        }
+        out = std::move(next->value);
+        tail_ = next;   // next 成为新的哨兵
+        delete tail;
+        size_.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /**
+     * 当前元素个数（近似值，任意线程可读）
+     */
+    std::size_t size() const { return size_.load(std::memory_order_relaxed); }
+    bool empty() const { return size() == 0; }
+};
+
+} // namespace mvvm
@@ -0,0 +1,165 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace mvvm {
+
+/**
+ * 不可变快照发布器（RCU 风格，基于纪元的回收）
+ *
+ * - 写者（唯一，通常是 GUI 线程）publish() 一个新版本：原子替换当前指针，旧版本进入待回收列表
+ * - 读者（任意线程、任意数量）read() 得到 ReadGuard，在其存活期间快照不会被修改或释放；
+ *   读取不加锁、不复制，只有一次槽位 CAS 和两次原子读
+ * - 读者进入时在槽位中登记当前纪元；写者每次发布推进纪元，
+ *   待回收版本只有在所有登记中的读者都晚于其退役纪元后才回收
+ * - 回收的节点放入空闲列表供下次发布复用（按赋值更新），稳定状态下发布不分配堆内存
+ *
+ * 同时存在的读者最多 kMaxReaders 个，超出时 read() 让出 CPU 等待空闲槽位。
+ */
+template<typename T>
+class SnapshotPublisher {
+public:
+    static constexpr std::size_t kMaxReaders = 64;
+
+    class ReadGuard {
+    private:
+        std::atomic<std::uint64_t>* slot_;
+        const T* value_;
+
+    public:
+        ReadGuard(std::atomic<std::uint64_t>* slot, const T* value) : slot_(slot), value_(value) {}
+        ReadGuard(ReadGuard&& other) noexcept : slot_(other.slot_), value_(other.value_) {
+            other.slot_ = nullptr;
+        }
+        ReadGuard(const ReadGuard&) = delete;
+        ReadGuard& operator=(const ReadGuard&) = delete;
+        ReadGuard& operator=(ReadGuard&&) = delete;
+
+        ~ReadGuard() {
+            if (slot_) {
+                slot_->store(0, std::memory_order_release);
+            }
+        }
+
+        const T* get() const { return value_; }
+        const T& operator*() const { return *value_; }
+        const T* operator->() const { return value_; }
+    };
+
+private:
+    struct alignas(64) ReaderSlot {
+        std::atomic<std::uint64_t> epoch{0};   // 0 表示空闲
+    };
+
+    struct Retired {
+        T* value;
+        std::uint64_t epoch;
+    };
+
+    std::atomic<T*> current_;
+    std::atomic<std::uint64_t> epoch_;
+    mutable std::array<ReaderSlot, kMaxReaders> slots_;
+
+    // 仅写者访问
+    std::vector<Retired> retired_;
+    std::vector<T*> free_;
+    std::uint64_t version_;
+
+public:
+    explicit SnapshotPublisher(T initial = T()) : current_(new T(std::move(initial))), epoch_(1), version_(0) {}
+
+    ~SnapshotPublisher() {
+        // 析构时不应再有读者
+        delete current_.load();
+        for (const Retired& item : retired_) {
+            delete item.value;
+        }
+        for (T* value : free_) {
+            delete value;
+        }
+    }
+
+    SnapshotPublisher(const SnapshotPublisher&) = delete;
+    SnapshotPublisher& operator=(const SnapshotPublisher&) = delete;
+
+    /**
+     * 读取当前快照（任意线程）
+     */
+    ReadGuard read() const {
+        // 按线程分散起始槽位，减少读者之间的 CAS 竞争
+        const std::size_t start = std::hash<std::thread::id>()(std::this_thread::get_id());
+        for (;;) {
+            const std::uint64_t epoch = epoch_.load();
+            for (std::size_t i = 0; i < kMaxReaders; ++i) {
+                std::atomic<std::uint64_t>& slot = slots_[(start + i) % kMaxReaders].epoch;
+                std::uint64_t expected = 0;
+                if (slot.load(std::memory_order_relaxed) == 0 && slot.compare_exchange_strong(expected, epoch)) {
+                    // 登记之后再读取指针：写者若已越过此纪元回收，必然先替换了指针
+                    return ReadGuard(&slot, current_.load());
+                }
+            }
+            std::this_thread::yield();
+        }
+    }
+
+    /**
+     * 发布新版本（仅写者线程）
+     */
+    void publish(const T& value) {
+        T* node = acquireNode();
+        *node = value;
+        T* previous = current_.exchange(node);
+        retired_.push_back({previous, epoch_.fetch_add(1)});
+        ++version_;
+        reclaim();
+    }
+
+    /**
+     * 写者线程读取当前版本，无需登记
+     */
+    const T& current() const { return *current_.load(std::memory_order_relaxed); }
+
+    // 已发布的版本数（仅写者线程）
+    std::uint64_t version() const { return version_; }
+
+    // 尚未回收的旧版本数（仅写者线程）
+    std::size_t retiredCount() const { return retired_.size(); }
+
+private:
+    T* acquireNode() {
+        if (!free_.empty()) {
+            T* node = free_.back();
+            free_.pop_back();
+            return node;
+        }
+        return new T();
+    }
+
+    void reclaim() {
+        // 所有活动读者登记的纪元中最早的一个；在它之前退役的版本已无人引用
+        std::uint64_t oldest = epoch_.load();
+        for (const ReaderSlot& slot : slots_) {
+            const std::uint64_t epoch = slot.epoch.load();
+            if (epoch != 0 && epoch < oldest) {
+                oldest = epoch;
+            }
+        }
+        std::size_t kept = 0;
+        for (const Retired& item : retired_) {
+            if (item.epoch < oldest) {
+                free_.push_back(item.value);
+            } else {
+                retired_[kept++] = item;
+            }
+        }
+        retired_.resize(kept);
+    }
+};
+
+} // namespace mvvm
@@ -0,0 +1,143 @@
+#pragma once
+#include <QString>
+#include <atomic>
+#include <cstdint>
+
+/**
+ * 信号 / 属性通知追踪
+ *
+ * 在信号发出、槽函数、setProperty、命令执行等位置记录带时间戳的区间，
+ * 按线程分别记录并保留嵌套关系，导出为 Chrome trace JSON（chrome://tracing、ui.perfetto.dev 可直接打开）。
+ * 一次按键的完整扇出（Model 信号 → ViewModel 刷新 → 各属性通知 → 视图槽）在时间轴上是一组嵌套区间，
+ * 通知风暴和重复的级联刷新一目了然。
+ *
+ * 只有定义了 MVVM_ENABLE_TRACING（CMake 选项 MVVM_ENABLE_TRACING=ON）时才编译进来；
+ * 否则宏展开为空，参数也不会被求值，没有任何运行时开销。
+ * 编译进来后默认不记录，调用 trace::start() 或设置环境变量 MVVM_TRACE_FILE 后才开始。
+ *
+ *   MVVM_TRACE_SCOPE("model", "UserModel::setName");
+ *   MVVM_TRACE_SCOPE_DETAIL("property", "setProperty", propertyName);
+ */
+
+namespace mvvm {
+namespace trace {
+
+#ifdef MVVM_ENABLE_TRACING
+
+namespace detail {
+
+extern std::atomic<bool> enabled;
+
+struct SpanState {
+    const char* category;
+    const char* name;
+    std::int64_t startNs;
+};
+
+void begin(SpanState& state);
+void end(const SpanState& state, const QString& detail);
+
+} // namespace detail
+
+constexpr bool isCompiledIn() { return true; }
+
+inline bool isRecording() { return detail::enabled.load(std::memory_order_relaxed); }
+
+/**
+ * 作用域区间：构造时开始，析构时记录一条完整事件
+ * category / name 必须是字符串字面量（只保存指针）；detail 为可选的附加信息（例如属性名）
+ */
+class Span {
+private:
+    detail::SpanState state_;
+    QString detail_;
+    bool active_;
+
+public:
+    Span(const char* category, const char* name) : state_{category, name, 0}, active_(isRecording()) {
+        if (active_) {
+            detail::begin(state_);
+        }
+    }
+
+    Span(const char* category, const char* name, const QString& detail)
+        : state_{category, name, 0}, active_(isRecording()) {
+        if (active_) {
+            detail_ = detail;
+            detail::begin(state_);
+        }
+    }
+
+    ~Span() {
+        if (active_) {
+            detail::end(state_, detail_);
+        }
+    }
+
+    Span(const Span&) = delete;
+    Span& operator=(const Span&) = delete;
+};
+
+/**
+ * 记录一个瞬时事件（没有持续时间）
+ */
+void instant(const char* category, const char* name, const QString& detail = QString());
+
+/**
+ * 开始记录：清空已有事件，时间从此刻起算
+ * maxEventsPerThread 为每个线程最多保留的事件数，超出的事件丢弃并计数
+ */
+void start(int maxEventsPerThread = 1 << 20);
+
+// 停止记录，已记录的事件保留到下次 start()
+void stop();
+
+// 已记录 / 已丢弃的事件数
+std::uint64_t eventCount();
+std::uint64_t droppedCount();
+
+/**
+ * 导出 Chrome trace JSON（流式写出，不在内存中构造整个文档）
+ */
+bool writeChromeTrace(const QString& path, QString* error = nullptr);
+
+/**
+ * 环境变量 MVVM_TRACE_FILE 非空时开始记录，并在 QCoreApplication 析构时写入该文件
+ * 需在创建 QCoreApplication 之后调用
+ */
+void startFromEnvironment();
+
+#define MVVM_TRACE_CONCAT_IMPL(a, b) a##b
+#define MVVM_TRACE_CONCAT(a, b) MVVM_TRACE_CONCAT_IMPL(a, b)
+#define MVVM_TRACE_SCOPE(category, name) \
+    ::mvvm::trace::Span MVVM_TRACE_CONCAT(mvvmTraceSpan_, __LINE__)(category, name)
+#define MVVM_TRACE_SCOPE_DETAIL(category, name, detail) \
+    ::mvvm::trace::Span MVVM_TRACE_CONCAT(mvvmTraceSpan_, __LINE__)(category, name, detail)
+#define MVVM_TRACE_INSTANT(category, name) ::mvvm::trace::instant(category, name)
+
+#else
+
+constexpr bool isCompiledIn() { return false; }
+inline bool isRecording() { return false; }
+inline void start(int = 0) {}
+inline void stop() {}
+inline std::uint64_t eventCount() { return 0; }
+inline std::uint64_t droppedCount() { return 0; }
+
+inline bool writeChromeTrace(const QString&, QString* error = nullptr) {
+    if (error) {
+        *error = QStringLiteral("追踪未编译（MVVM_ENABLE_TRACING）");
+    }
+    return false;
+}
+
+inline void startFromEnvironment() {}
+
+#define MVVM_TRACE_SCOPE(category, name) static_cast<void>(0)
+#define MVVM_TRACE_SCOPE_DETAIL(category, name, detail) static_cast<void>(0)
+#define MVVM_TRACE_INSTANT(category, name) static_cast<void>(0)
+
+#endif
+
+} // namespace trace
+} // namespace mvvm
@@ -0,0 +1,207 @@
+#pragma once
+#include "core/InplaceFunction.h"
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+namespace mvvm {
+
+/**
+ * 撤销 / 重做历史 - 保存状态的不可变版本
+ *
+ * 每个条目是一份完整的 State 值。State 由隐式共享的成员（QString 等）组成时，
+ * 相邻版本中未修改的字段共享同一块数据，记录一步只增加引用计数，不复制内容。
+ *
+ * - 条目存放在构造时一次性分配的环形缓冲区中，记录、撤销、重做都不分配堆内存，
+ *   撤销和重做只移动下标，每步 O(1)，与历史长度和状态大小无关
+ * - 相同合并键的连续记录（例如在同一输入框中逐键输入）在合并窗口内并入同一条目
+ * - 条目的内存占用由 Measure 估算（只计与前一版本不共享的数据），
+ *   总量超过预算或条目数达到容量时丢弃最旧的条目；当前条目总是保留
+ *
+ *   UndoHistory<UserModel::State> history(1024, 256 * 1024, measure);
+ *   history.reset(model.state());
+ *   history.record(model.state(), kNameKey);
+ *   if (const auto* state = history.undo()) { model.restore(*state); }
+ */
+template<typename State>
+class UndoHistory {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // 估算一个版本独占的字节数；previous 为前一版本（最旧的条目为 nullptr）
+    using Measure = InplaceFunction<std::size_t(const State&, const State*)>;
+
+    // 不参与合并的记录
+    static constexpr int kNoMerge = 0;
+
+private:
+    struct Entry {
+        State state;
+        int mergeKey = kNoMerge;
+        Clock::time_point time;
+        std::size_t bytes = 0;
+    };
+
+    std::vector<Entry> entries_;   // 环形缓冲区，容量固定
+    std::size_t first_;            // 最旧条目的物理下标
+    std::size_t count_;            // 有效条目数（含当前条目之后可重做的条目）
+    std::size_t current_;          // 当前条目的逻辑下标（相对最旧条目）
+    std::size_t bytes_;
+    std::size_t budget_;
+    Clock::duration mergeWindow_;
+    bool mergeBroken_;
+    Measure measure_;
+
+public:
+    UndoHistory(std::size_t capacity, std::size_t memoryBudget, Measure measure = nullptr)
+        : entries_(std::max<std::size_t>(capacity, 2)),
+          first_(0),
+          count_(0),
+          current_(0),
+          bytes_(0),
+          budget_(memoryBudget),
+          mergeWindow_(std::chrono::milliseconds(1500)),
+          mergeBroken_(false),
+          measure_(std::move(measure)) {}
+
+    /**
+     * 清空历史，以 initial 作为唯一的（不可撤销的）起点
+     */
+    void reset(const State& initial) {
+        for (std::size_t i = 0; i < count_; ++i) {
+            at(i) = Entry();
+        }
+        first_ = 0;
+        count_ = 1;
+        current_ = 0;
+        Entry& entry = at(0);
+        entry.state = initial;
+        entry.time = Clock::now();
+        entry.bytes = footprint(entry.state, nullptr);
+        bytes_ = entry.bytes;
+        mergeBroken_ = true;
+    }
+
+    /**
+     * 记录新的当前状态，丢弃可重做的条目
+     * mergeKey 与当前条目相同、且距上次记录不超过合并窗口时替换当前条目，而不是新增
+     */
+    void record(const State& state, int mergeKey = kNoMerge) {
+        if (count_ == 0) {
+            reset(state);
+            return;
+        }
+        truncateRedo();
+
+        const Clock::time_point now = Clock::now();
+        Entry& top = at(current_);
+        if (mergeKey != kNoMerge && !mergeBroken_ && current_ > 0 && top.mergeKey == mergeKey &&
+            now - top.time <= mergeWindow_) {
+            bytes_ -= top.bytes;
+            top.state = state;
+            top.time = now;
+            top.bytes = footprint(top.state, &at(current_ - 1).state);
+            bytes_ += top.bytes;
+            enforceBudget();
+            return;
+        }
+
+        if (count_ == entries_.size()) {
+            dropOldest();
+        }
+        const State& previous = at(current_).state;
+        Entry& entry = at(count_);
+        entry.state = state;
+        entry.mergeKey = mergeKey;
+        entry.time = now;
+        entry.bytes = footprint(entry.state, &previous);
+        bytes_ += entry.bytes;
+        current_ = count_++;
+        mergeBroken_ = false;
+        enforceBudget();
+    }
+
+    /**
+     * 回到上一个版本；没有可撤销的条目时返回 nullptr
+     */
+    const State* undo() {
+        if (!canUndo()) {
+            return nullptr;
+        }
+        mergeBroken_ = true;
+        return &at(--current_).state;
+    }
+
+    /**
+     * 前进到下一个版本；没有可重做的条目时返回 nullptr
+     */
+    const State* redo() {
+        if (!canRedo()) {
+            return nullptr;
+        }
+        mergeBroken_ = true;
+        return &at(++current_).state;
+    }
+
+    /**
+     * 结束当前的合并：下一次记录总是新增条目（保存、失去焦点等时调用）
+     */
+    void breakMerge() { mergeBroken_ = true; }
+
+    bool canUndo() const { return current_ > 0; }
+    bool canRedo() const { return current_ + 1 < count_; }
+
+    // 可撤销、可重做的步数
+    std::size_t undoCount() const { return current_; }
+    std::size_t redoCount() const { return count_ == 0 ? 0 : count_ - current_ - 1; }
+
+    std::size_t capacity() const { return entries_.size(); }
+    std::size_t memoryUsage() const { return bytes_; }
+    std::size_t memoryBudget() const { return budget_; }
+
+    void setMemoryBudget(std::size_t bytes) {
+        budget_ = bytes;
+        enforceBudget();
+    }
+
+    void setMergeWindow(std::chrono::milliseconds window) { mergeWindow_ = window; }
+
+private:
+    Entry& at(std::size_t index) { return entries_[(first_ + index) % entries_.size()]; }
+
+    std::size_t footprint(const State& state, const State* previous) const {
+        return sizeof(Entry) + (measure_ ? measure_(state, previous) : 0);
+    }
+
+    void truncateRedo() {
+        // 释放被丢弃版本持有的引用；每个条目只会被丢弃一次，均摊 O(1)
+        while (count_ > current_ + 1) {
+            Entry& entry = at(--count_);
+            bytes_ -= entry.bytes;
+            entry = Entry();
+        }
+    }
+
+    void dropOldest() {
+        Entry& oldest = at(0);
+        bytes_ -= oldest.bytes;
+        oldest = Entry();
+        first_ = (first_ + 1) % entries_.size();
+        --count_;
+        --current_;
+        // 新的最旧条目不再有前一版本可共享，重新估算
+        Entry& front = at(0);
+        bytes_ -= front.bytes;
+        front.bytes = footprint(front.state, nullptr);
+        bytes_ += front.bytes;
+    }
+
+    void enforceBudget() {
+        while (bytes_ > budget_ && current_ > 0) {
+            dropOldest();
+        }
+    }
+};
+
+} // namespace mvvm
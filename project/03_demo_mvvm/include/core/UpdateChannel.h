@@ -0,0 +1,142 @@
+#pragma once
+#include "core/InplaceFunction.h"
+#include "core/MpscQueue.h"
+#include <QElapsedTimer>
+#include <QObject>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+class QTimer;
+
+namespace mvvm {
+
+/**
+ * 跨线程模型更新通道（非模板部分：调度与统计）
+ *
+ * 工作线程 post() 更新，只做一次无锁入队；队列由空变为非空时才向 GUI 线程投递一次唤醒事件，
+ * 之后的更新不再产生事件。GUI 线程按帧（默认 16 毫秒）取出全部积压的更新，
+ * 交给处理函数一次性合并应用，每帧最多一轮模型通知。
+ */
+class UpdateChannelBase : public QObject {
+    Q_OBJECT
+
+public:
+    struct Stats {
+        quint64 posted = 0;         // 累计提交的更新
+        quint64 drained = 0;        // 累计应用的更新
+        quint64 batches = 0;        // 累计合并批次
+        std::size_t depth = 0;      // 当前积压
+        qint64 lastLatencyUs = 0;   // 最近一批中最早更新从提交到应用的耗时
+        qint64 maxLatencyUs = 0;
+    };
+
+    static constexpr int kDefaultFrameIntervalMs = 16;
+
+private:
+    QTimer* frameTimer_;
+    QElapsedTimer sinceLastDrain_;
+    int frameIntervalMs_;
+    std::atomic<bool> wakePending_;
+
+    // 统计（posted_ 由生产者更新，其余由 GUI 线程更新，任意线程读取）
+    std::atomic<quint64> posted_;
+    std::atomic<quint64> drained_;
+    std::atomic<quint64> batches_;
+    std::atomic<qint64> lastLatencyUs_;
+    std::atomic<qint64> maxLatencyUs_;
+
+public:
+    explicit UpdateChannelBase(QObject* parent = nullptr);
+    ~UpdateChannelBase() override = default;
+
+    void setFrameInterval(int intervalMs) { frameIntervalMs_ = intervalMs; }
+    int frameInterval() const { return frameIntervalMs_; }
+
+    std::size_t depth() const { return pendingDepth(); }
+    Stats stats() const;
+
+public slots:
+    /**
+     * 立即在 GUI 线程应用积压的更新（例如保存前），不等待下一帧
+     */
+    void drainNow();
+
+signals:
+    void drained(int count, qint64 latencyUs);
+
+protected:
+    // 生产者入队之后调用（任意线程）
+    void notifyPosted();
+
+    // 取出并应用积压的更新，返回条数；oldestEnqueuedNs 返回这批中最早一条的入队时间
+    virtual std::size_t drainQueue(qint64* oldestEnqueuedNs) = 0;
+    virtual std::size_t pendingDepth() const = 0;
+
+    static qint64 nowNs();
+
+private slots:
+    void scheduleDrain();
+    void onFrame();
+};
+
+/**
+ * 类型化的更新通道
+ *
+ *   auto channel = new UpdateChannel<UserModel::Patch>([model](std::vector<UserModel::Patch>& batch) {
+ *       model->applyBatch(batch);
+ *   }, model);
+ *   channel->post(patch);   // 任意线程
+ *
+ * 处理函数在 GUI 线程调用，batch 按提交顺序排列（同一生产者内有序），调用后清空复用。
+ */
+template<typename Update>
+class UpdateChannel : public UpdateChannelBase {
+public:
+    using BatchHandler = InplaceFunction<void(std::vector<Update>& batch)>;
+
+private:
+    struct Item {
+        Update update;
+        qint64 enqueuedNs = 0;
+    };
+
+    MpscQueue<Item> queue_;
+    BatchHandler handler_;
+    std::vector<Update> batch_;
+
+public:
+    explicit UpdateChannel(BatchHandler handler, QObject* parent = nullptr)
+        : UpdateChannelBase(parent), handler_(std::move(handler)) {}
+
+    /**
+     * 提交一条更新（线程安全，无锁，不阻塞）
+     */
+    void post(Update update) {
+        queue_.push(Item{std::move(update), nowNs()});
+        notifyPosted();
+    }
+
+protected:
+    std::size_t drainQueue(qint64* oldestEnqueuedNs) override {
+        // 只取本帧开始时已经积压的条数，持续提交的生产者不会让一帧无限延长
+        const std::size_t limit = queue_.size();
+        batch_.clear();
+        Item item;
+        while (batch_.size() < limit && queue_.tryPop(item)) {
+            if (batch_.empty()) {
+                *oldestEnqueuedNs = item.enqueuedNs;
+            }
+            batch_.push_back(std::move(item.update));
+        }
+        if (!batch_.empty() && handler_) {
+            handler_(batch_);
+        }
+        return batch_.size();
+    }
+
+    std::size_t pendingDepth() const override { return queue_.size(); }
+};
+
+} // namespace mvvm
@@ -0,0 +1,45 @@
+#pragma once
+#include "io/UserImporter.h"
+#include "model/UserColumnStore.h"
+#include <QString>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace mvvm {
+namespace io {
+
+/**
+ * 导出统计
+ */
+struct ExportStats {
+    qint64 bytes = 0;
+    qint64 records = 0;
+    qint64 elapsedMs = 0;
+
+    QString summary() const;
+};
+
+/**
+ * 流式导出用户
+ * 按块持有共享锁读取存储，序列化到固定大小的缓冲区后写盘，
+ * 内存占用与导出规模无关；写入先落到临时文件，成功后再替换目标文件。
+ * 该函数会阻塞调用线程，应在后台线程中调用。
+ */
+class UserExporter {
+public:
+    /**
+     * 每写完一块调用一次，参数为已处理行数和总行数；返回 false 时放弃导出，目标文件保持不变
+     */
+    using BlockCallback = std::function<bool(std::size_t done, std::size_t total)>;
+
+    static bool exportFile(const QString& path,
+                           std::shared_ptr<const UserColumnStore> store,
+                           const std::vector<RowId>& rows,
+                           ExportStats* stats = nullptr,
+                           QString* error = nullptr,
+                           const BlockCallback& onBlock = nullptr);
+};
+
+} // namespace io
+} // namespace mvvm
@@ -0,0 +1,63 @@
+#pragma once
+#include "model/UserColumnStore.h"
+#include <QString>
+
+namespace mvvm {
+namespace io {
+
+enum class UserFileFormat {
+    Csv,
+    Json
+};
+
+/**
+ * 按扩展名判断格式：.json / .jsonl / .ndjson 为 JSON，其余按 CSV 处理
+ */
+UserFileFormat formatForPath(const QString& path);
+
+/**
+ * 当前进程的峰值常驻内存（字节），不支持的平台返回 0
+ */
+qint64 peakMemoryBytes();
+
+/**
+ * 导入统计
+ */
+struct ImportStats {
+    qint64 bytes = 0;
+    qint64 records = 0;
+    qint64 rejected = 0;
+    qint64 invalid = 0;
+    int chunks = 0;
+    bool parallel = true;
+    qint64 elapsedMs = 0;
+    double megabytesPerSecond = 0.0;
+    qint64 peakMemoryBytes = 0;
+
+    QString summary() const;
+};
+
+struct ImportResult {
+    bool ok = false;
+    QString error;
+    UserColumnStore users;
+    ImportStats stats;
+};
+
+/**
+ * 批量导入用户
+ *
+ * 文件按分块内存映射，各分块在线程池中并行解析为独立的列式存储，
+ * 最后合并（只移动字符串块，不复制字符串）并并行校验。
+ * 每个工作线程只映射并读取自己的区间，解析完立即解除映射，
+ * 因此常驻内存主要是 UTF-8 字符串本身，而不是整个文件或 QString。
+ * 该函数会阻塞调用线程，应在后台线程中调用。
+ */
+class UserImporter {
+public:
+    static ImportResult importFile(const QString& path);
+    static ImportResult importFile(const QString& path, UserFileFormat format);
+};
+
+} // namespace io
+} // namespace mvvm
@@ -0,0 +1,46 @@
+#pragma once
+#include "model/UserColumnStore.h"
+#include <cstddef>
+#include <string>
+
+namespace mvvm {
+namespace io {
+
+/**
+ * 单个分块的解析结果
+ *
+ * 分块只负责"行首位于 [begin, end) 内"的记录：从 begin 之后的第一个行首开始，
+ * 解析到越过 end 的第一个行首为止。firstRecord / endPos 记录实际起止位置，
+ * 导入器据此检查相邻分块是否首尾相接；若某条记录跨越了分块边界
+ * （例如 CSV 引号内换行、格式化过的多行 JSON），则退回单线程整体解析。
+ */
+struct ParsedChunk {
+    UserColumnStore users;
+    std::size_t firstRecord = 0;
+    std::size_t endPos = 0;
+    std::size_t rejected = 0;
+    bool syntaxError = false;
+    std::string error;
+};
+
+/**
+ * 解析 CSV：name,email,age，支持 RFC 4180 双引号转义，首行表头可选
+ * 字段数不足的行计入 rejected，不中断解析
+ */
+void parseCsvChunk(const char* data, std::size_t size,
+                   std::size_t begin, std::size_t end, ParsedChunk& out);
+
+/**
+ * 解析 JSON：对象数组或 JSON Lines，每个对象取 name / email / age 字段，
+ * 其余字段忽略；语法错误时设置 syntaxError 并停止
+ */
+void parseJsonChunk(const char* data, std::size_t size,
+                    std::size_t begin, std::size_t end, ParsedChunk& out);
+
+/**
+ * 与 UserViewModel::parseAge 一致：无法解析时为 0
+ */
+int parseAgeField(std::string_view text);
+
+} // namespace io
+} // namespace mvvm
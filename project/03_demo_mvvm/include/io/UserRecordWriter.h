@@ -0,0 +1,88 @@
+#pragma once
+#include <cstdio>
+#include <string>
+#include <string_view>
+
+namespace mvvm {
+namespace io {
+
+/**
+ * 记录序列化：直接追加到调用方的输出缓冲区，不生成中间文档
+ * 输出格式与 UserRecordParser 可以互相读写；JSON 每行一个对象，
+ * 便于导入时按行并行切分。
+ */
+
+inline void appendCsvField(std::string& out, std::string_view field) {
+    if (field.find_first_of(",\"\r\n") == std::string_view::npos) {
+        out.append(field.data(), field.size());
+        return;
+    }
+    out.push_back('"');
+    for (char c : field) {
+        if (c == '"') {
+            out.push_back('"');
+        }
+        out.push_back(c);
+    }
+    out.push_back('"');
+}
+
+inline void appendCsvHeader(std::string& out) {
+    out.append("name,email,age\n");
+}
+
+inline void appendCsvRecord(std::string& out, std::string_view name, std::string_view email, int age) {
+    appendCsvField(out, name);
+    out.push_back(',');
+    appendCsvField(out, email);
+    out.push_back(',');
+    out.append(std::to_string(age));
+    out.push_back('\n');
+}
+
+inline void appendJsonString(std::string& out, std::string_view text) {
+    out.push_back('"');
+    for (char c : text) {
+        switch (c) {
+        case '"': out.append("\\\""); break;
+        case '\\': out.append("\\\\"); break;
+        case '\n': out.append("\\n"); break;
+        case '\r': out.append("\\r"); break;
+        case '\t': out.append("\\t"); break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20) {
+                char escape[8];
+                std::snprintf(escape, sizeof(escape), "\\u%04x", static_cast<unsigned char>(c));
+                out.append(escape);
+            } else {
+                out.push_back(c);
+            }
+        }
+    }
+    out.push_back('"');
+}
+
+inline void appendJsonBegin(std::string& out) {
+    out.append("[\n");
+}
+
+inline void appendJsonRecord(std::string& out, std::string_view name, std::string_view email,
+                             int age, bool first) {
+    if (!first) {
+        out.append(",\n");
+    }
+    out.append("{\"name\":");
+    appendJsonString(out, name);
+    out.append(",\"email\":");
+    appendJsonString(out, email);
+    out.append(",\"age\":");
+    out.append(std::to_string(age));
+    out.push_back('}');
+}
+
+inline void appendJsonEnd(std::string& out, bool empty) {
+    out.append(empty ? "]\n" : "\n]\n");
+}
+
+} // namespace io
+} // namespace mvvm
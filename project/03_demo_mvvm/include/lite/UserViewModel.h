@@ -0,0 +1,230 @@
+#pragma once
+#include "lite/mvvm_lite.h"
+#include "model/UserValidation.h"
+#include <array>
+#include <charconv>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace mvvm {
+namespace lite {
+
+/**
+ * 用户数据
+ */
+struct UserRecord {
+    std::string name;
+    std::string email;
+    int age = 0;
+
+    bool isValid() const { return validation::isValidUser(name, email, age); }
+};
+
+/**
+ * 不依赖 Qt 的用户视图模型
+ *
+ * 校验规则、状态文本与 mvvm::UserViewModel 一致；字符串为 UTF-8 的 std::string。
+ * 每次修改后各属性的 propertyChanged 按需发出，观察者的 update() 只调用一次。
+ */
+class UserViewModel : public ViewModelBase {
+private:
+    UserRecord user_;
+    std::vector<UserRecord> savedUsers_;
+
+    // 显示属性
+    std::string displayName_;
+    std::string displayEmail_;
+    std::string displayAge_;
+    std::string statusMessage_;
+    bool canSave_;
+
+public:
+    Signal<const UserRecord&> userSaved;
+    Signal<> userReset;
+
+    UserViewModel() : displayAge_("0"), canSave_(false) { refresh(); }
+
+    // 属性访问器
+    const std::string& getDisplayName() const { return displayName_; }
+    const std::string& getDisplayEmail() const { return displayEmail_; }
+    const std::string& getDisplayAge() const { return displayAge_; }
+    const std::string& getStatusMessage() const { return statusMessage_; }
+    bool canSave() const { return canSave_; }
+    const UserRecord& user() const { return user_; }
+    const std::vector<UserRecord>& savedUsers() const { return savedUsers_; }
+
+    void updateName(std::string name) {
+        if (user_.name != name) {
+            user_.name = std::move(name);
+            refresh();
+        }
+    }
+
+    void updateEmail(std::string email) {
+        if (user_.email != email) {
+            user_.email = std::move(email);
+            refresh();
+        }
+    }
+
+    void updateAge(std::string_view ageText) { setAge(parseAge(ageText)); }
+
+    void setAge(int age) {
+        if (user_.age != age) {
+            user_.age = age;
+            refresh();
+        }
+    }
+
+    /**
+     * 一次替换全部字段（批处理使用），只通知一次
+     */
+    void assign(UserRecord user) {
+        user_ = std::move(user);
+        refresh();
+    }
+
+    bool save() {
+        if (!canSave_) {
+            return false;
+        }
+        savedUsers_.push_back(user_);
+        userSaved.notify(savedUsers_.back());
+        return true;
+    }
+
+    void reset() {
+        user_ = UserRecord();
+        refresh();
+        userReset.notify();
+    }
+
+    std::string getUserDisplayInfo() const {
+        std::string info;
+        info.reserve(128 + user_.name.size() + user_.email.size());
+        info += "用户信息:\n  姓名: ";
+        info += user_.name;
+        info += "\n  邮箱: ";
+        info += user_.email;
+        info += "\n  年龄: ";
+        info += std::to_string(user_.age);
+        info += "\n  状态: ";
+        info += user_.isValid() ? "有效" : "无效";
+        return info;
+    }
+
+private:
+    void refresh() {
+        bool changed = false;
+        changed |= setProperty(displayName_, user_.name, "displayName");
+        changed |= setProperty(displayEmail_, user_.email, "displayEmail");
+        changed |= setProperty(displayAge_, std::to_string(user_.age), "displayAge");
+        changed |= setProperty(canSave_, user_.isValid(), "canSave");
+        changed |= setProperty(statusMessage_, statusText(), "statusMessage");
+        if (changed) {
+            notifyObservers();
+        }
+    }
+
+    const std::string& statusText() const {
+        enum { NameError = 1, EmailError = 2, AgeError = 4 };
+        static const std::string validMessage = "✅ 数据有效，可以保存";
+        static const std::array<std::string, 8> invalidMessages = [] {
+            std::array<std::string, 8> result;
+            for (int mask = 0; mask < static_cast<int>(result.size()); ++mask) {
+                std::string errors;
+                auto append = [&errors](const char* text) {
+                    if (!errors.empty()) {
+                        errors += ", ";
+                    }
+                    errors += text;
+                };
+                if (mask & NameError) {
+                    append("姓名不能为空");
+                }
+                if (mask & EmailError) {
+                    append("邮箱格式无效");
+                }
+                if (mask & AgeError) {
+                    append("年龄无效");
+                }
+                result[mask] = "❌ 数据无效: " + errors;
+            }
+            return result;
+        }();
+
+        if (user_.isValid()) {
+            return validMessage;
+        }
+        int mask = 0;
+        if (user_.name.empty()) {
+            mask |= NameError;
+        }
+        if (user_.email.find('@') == std::string::npos) {
+            mask |= EmailError;
+        }
+        if (!validation::isValidAge(user_.age)) {
+            mask |= AgeError;
+        }
+        return invalidMessages[mask];
+    }
+
+    static int parseAge(std::string_view text) {
+        // 与 QString::toInt 一致：允许首尾空白，解析失败为 0
+        while (!text.empty() && (text.front() == ' ' || text.front() == '\t')) {
+            text.remove_prefix(1);
+        }
+        while (!text.empty() && (text.back() == ' ' || text.back() == '\t')) {
+            text.remove_suffix(1);
+        }
+        if (!text.empty() && text.front() == '+') {
+            text.remove_prefix(1);
+        }
+        int age = 0;
+        const auto result = std::from_chars(text.data(), text.data() + text.size(), age);
+        if (result.ec != std::errc() || result.ptr != text.data() + text.size()) {
+            return 0;
+        }
+        return age;
+    }
+};
+
+/**
+ * 保存命令
+ */
+class SaveUserCommand : public ICommand {
+private:
+    UserViewModel* viewModel_;
+
+public:
+    explicit SaveUserCommand(UserViewModel* viewModel) : viewModel_(viewModel) {}
+
+    void execute() override {
+        if (canExecute()) {
+            viewModel_->save();
+        }
+    }
+
+    bool canExecute() const override { return viewModel_ && viewModel_->canSave(); }
+};
+
+/**
+ * 重置命令
+ */
+class ResetUserCommand : public ICommand {
+private:
+    UserViewModel* viewModel_;
+
+public:
+    explicit ResetUserCommand(UserViewModel* viewModel) : viewModel_(viewModel) {}
+
+    void execute() override {
+        if (viewModel_) {
+            viewModel_->reset();
+        }
+    }
+};
+
+} // namespace lite
+} // namespace mvvm
@@ -0,0 +1,284 @@
+#pragma once
+#include "core/InplaceFunction.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace mvvm {
+namespace lite {
+
+/**
+ * 不依赖 Qt 的轻量 MVVM 核心（仅头文件）
+ *
+ * 不需要 QObject、moc 或 QApplication，供控制台前端和服务端批处理使用。
+ * - Signal:        线程安全的信号，发射时不加锁调用槽，只在复制槽列表指针时短暂持锁
+ * - Observable:    IObserver 风格的观察者列表，构建在 Signal 之上
+ * - ViewModelBase: 属性变化通知
+ * - ICommand / DelegateCommand: 命令
+ *
+ * 视图模型本身仍应只在一个线程中修改；信号的连接、断开和发射可在任意线程进行。
+ */
+
+namespace detail {
+
+class SignalStateBase {
+public:
+    virtual ~SignalStateBase() = default;
+    virtual void disconnect(std::uint64_t id) = 0;
+};
+
+} // namespace detail
+
+/**
+ * 连接句柄，可用于断开；信号先于句柄销毁时 disconnect() 什么也不做
+ */
+class Connection {
+private:
+    std::weak_ptr<detail::SignalStateBase> state_;
+    std::uint64_t id_ = 0;
+
+public:
+    Connection() = default;
+    Connection(std::weak_ptr<detail::SignalStateBase> state, std::uint64_t id)
+        : state_(std::move(state)), id_(id) {}
+
+    void disconnect() {
+        if (auto state = state_.lock()) {
+            state->disconnect(id_);
+        }
+        state_.reset();
+    }
+
+    bool isConnected() const { return !state_.expired(); }
+};
+
+/**
+ * 作用域连接：离开作用域时自动断开
+ */
+class ScopedConnection {
+private:
+    Connection connection_;
+
+public:
+    ScopedConnection() = default;
+    ScopedConnection(Connection connection) : connection_(std::move(connection)) {}
+    ScopedConnection(ScopedConnection&& other) noexcept : connection_(std::move(other.connection_)) {
+        other.connection_ = Connection();
+    }
+    ScopedConnection& operator=(ScopedConnection&& other) noexcept {
+        if (this != &other) {
+            connection_.disconnect();
+            connection_ = std::move(other.connection_);
+            other.connection_ = Connection();
+        }
+        return *this;
+    }
+    ScopedConnection(const ScopedConnection&) = delete;
+    ScopedConnection& operator=(const ScopedConnection&) = delete;
+    ~ScopedConnection() { connection_.disconnect(); }
+
+    void disconnect() { connection_.disconnect(); }
+};
+
+/**
+ * 信号
+ *
+ * 槽列表写时复制：connect/disconnect 生成新列表，notify 只复制列表的 shared_ptr，
+ * 随后在锁外依次调用槽，因此槽中可以安全地再连接、断开或发射同一个信号。
+ * 发射期间被断开的槽（同一线程内）不会再被调用；跨线程销毁观察者前需先断开并自行同步。
+ * 槽保存在 InplaceFunction 中，发射不分配堆内存。
+ */
+template<typename... Args>
+class Signal {
+public:
+    using Slot = InplaceFunction<void(Args...)>;
+
+private:
+    struct Entry {
+        std::uint64_t id;
+        Slot slot;
+        std::shared_ptr<std::atomic<bool>> connected;
+    };
+    using SlotList = std::vector<Entry>;
+
+    class State : public detail::SignalStateBase {
+    public:
+        std::mutex mutex;
+        std::shared_ptr<const SlotList> slots = std::make_shared<const SlotList>();
+        std::uint64_t nextId = 1;
+
+        void disconnect(std::uint64_t id) override {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto next = std::make_shared<SlotList>(*slots);
+            auto it = std::find_if(next->begin(), next->end(), [id](const Entry& entry) { return entry.id == id; });
+            if (it == next->end()) {
+                return;
+            }
+            it->connected->store(false, std::memory_order_release);
+            next->erase(it);
+            slots = std::move(next);
+        }
+    };
+
+    std::shared_ptr<State> state_;
+
+public:
+    Signal() : state_(std::make_shared<State>()) {}
+    Signal(const Signal&) = delete;
+    Signal& operator=(const Signal&) = delete;
+
+    Connection connect(Slot slot) {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        auto next = std::make_shared<SlotList>(*state_->slots);
+        const std::uint64_t id = state_->nextId++;
+        next->push_back(Entry{id, std::move(slot), std::make_shared<std::atomic<bool>>(true)});
+        state_->slots = std::move(next);
+        return Connection(state_, id);
+    }
+
+    void disconnectAll() {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        for (const Entry& entry : *state_->slots) {
+            entry.connected->store(false, std::memory_order_release);
+        }
+        state_->slots = std::make_shared<const SlotList>();
+    }
+
+    void notify(Args... args) const {
+        std::shared_ptr<const SlotList> slots;
+        {
+            std::lock_guard<std::mutex> lock(state_->mutex);
+            slots = state_->slots;
+        }
+        for (const Entry& entry : *slots) {
+            if (entry.connected->load(std::memory_order_acquire)) {
+                entry.slot(args...);
+            }
+        }
+    }
+
+    void operator()(Args... args) const { notify(args...); }
+
+    std::size_t slotCount() const {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        return state_->slots->size();
+    }
+};
+
+/**
+ * 观察者接口
+ */
+class IObserver {
+public:
+    virtual ~IObserver() = default;
+    virtual void update() = 0;
+};
+
+/**
+ * 可观察对象：数据变化后调用 notifyObservers()，每个观察者的 update() 被调用一次
+ */
+class Observable {
+private:
+    struct Registration {
+        IObserver* observer;
+        ScopedConnection connection;
+    };
+
+    Signal<> changed_;
+    std::mutex observersMutex_;
+    std::vector<Registration> observers_;
+
+public:
+    virtual ~Observable() = default;
+
+    /**
+     * 观察者由调用方持有，这里保存一份 shared_ptr 直到 removeObserver()
+     */
+    void addObserver(std::shared_ptr<IObserver> observer) {
+        if (!observer) {
+            return;
+        }
+        IObserver* raw = observer.get();
+        Connection connection = changed_.connect([observer = std::move(observer)]() { observer->update(); });
+        std::lock_guard<std::mutex> lock(observersMutex_);
+        observers_.push_back(Registration{raw, ScopedConnection(std::move(connection))});
+    }
+
+    void removeObserver(IObserver* observer) {
+        std::lock_guard<std::mutex> lock(observersMutex_);
+        observers_.erase(std::remove_if(observers_.begin(), observers_.end(),
+                                        [observer](const Registration& item) { return item.observer == observer; }),
+                         observers_.end());
+    }
+
+    // 连接一个普通回调，返回的连接需由调用方保存
+    Connection onChanged(Signal<>::Slot slot) { return changed_.connect(std::move(slot)); }
+
+protected:
+    void notifyObservers() const { changed_.notify(); }
+};
+
+/**
+ * 视图模型基类
+ */
+class ViewModelBase : public Observable {
+public:
+    // 参数为属性名（指向静态字符串）
+    Signal<std::string_view> propertyChanged;
+
+protected:
+    template<typename T>
+    bool setProperty(T& field, const T& value, std::string_view propertyName) {
+        if (field != value) {
+            field = value;
+            propertyChanged.notify(propertyName);
+            return true;
+        }
+        return false;
+    }
+};
+
+/**
+ * 命令接口
+ */
+class ICommand {
+public:
+    Signal<> canExecuteChanged;
+
+    virtual ~ICommand() = default;
+    virtual void execute() = 0;
+    virtual bool canExecute() const { return true; }
+};
+
+/**
+ * 委托命令
+ */
+class DelegateCommand : public ICommand {
+public:
+    using ExecuteFunc = InplaceFunction<void()>;
+    using CanExecuteFunc = InplaceFunction<bool()>;
+
+private:
+    ExecuteFunc executeFunc_;
+    CanExecuteFunc canExecuteFunc_;
+
+public:
+    explicit DelegateCommand(ExecuteFunc executeFunc, CanExecuteFunc canExecuteFunc = nullptr)
+        : executeFunc_(std::move(executeFunc)), canExecuteFunc_(std::move(canExecuteFunc)) {}
+
+    void execute() override {
+        if (executeFunc_ && canExecute()) {
+            executeFunc_();
+        }
+    }
+
+    bool canExecute() const override { return canExecuteFunc_ ? canExecuteFunc_() : true; }
+};
+
+} // namespace lite
+} // namespace mvvm
@@ -0,0 +1,243 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace mvvm {
+
+/**
+ * 8 字节的 UTF-8 字符串句柄
+ *
+ * - 不超过 7 字节的字符串直接内联在句柄中（常见的两三个汉字的姓名、邮箱的短本地部分），不占内存池
+ * - 更长的字符串存放在 StringArena 中，句柄记录块号、块内偏移和长度
+ * 句柄本身不拥有内存，解析需要所属的 StringArena（或其 Snapshot）。
+ */
+class CompactString {
+public:
+    static constexpr std::size_t kInlineCapacity = 7;
+    static constexpr std::size_t kMaxLength = (std::size_t(1) << 24) - 1;    // 更长的内容被截断
+    static constexpr std::size_t kMaxChunkBytes = std::size_t(1) << 20;      // 偏移 20 位
+    static constexpr std::size_t kMaxChunks = std::size_t(1) << 19;
+
+private:
+    // bytes_[0] 最低位为 1 表示内联（高 7 位为长度，内容在 bytes_[1..7]），
+    // 否则按小端拼成 64 位：[1..20] 偏移，[21..44] 长度，[45..63] 块号
+    std::uint8_t bytes_[8];
+
+    friend class StringArena;
+
+    static CompactString fromBits(std::uint64_t bits) {
+        CompactString result;
+        for (int i = 0; i < 8; ++i) {
+            result.bytes_[i] = static_cast<std::uint8_t>(bits >> (8 * i));
+        }
+        return result;
+    }
+
+    std::uint64_t bits() const {
+        std::uint64_t bits = 0;
+        for (int i = 0; i < 8; ++i) {
+            bits |= std::uint64_t(bytes_[i]) << (8 * i);
+        }
+        return bits;
+    }
+
+    std::size_t offset() const { return static_cast<std::size_t>((bits() >> 1) & 0xfffff); }
+    std::size_t chunk() const { return static_cast<std::size_t>(bits() >> 45); }
+
+public:
+    CompactString() : bytes_{1, 0, 0, 0, 0, 0, 0, 0} {}
+
+    /**
+     * 内联构造；text 超过 kInlineCapacity 时返回 false
+     */
+    static bool makeInline(std::string_view text, CompactString& out) {
+        if (text.size() > kInlineCapacity) {
+            return false;
+        }
+        out = CompactString();
+        out.bytes_[0] = static_cast<std::uint8_t>((text.size() << 1) | 1);
+        if (!text.empty()) {
+            std::memcpy(out.bytes_ + 1, text.data(), text.size());
+        }
+        return true;
+    }
+
+    bool isInline() const { return (bytes_[0] & 1) != 0; }
+    bool empty() const { return size() == 0; }
+    std::size_t size() const {
+        return isInline() ? std::size_t(bytes_[0] >> 1) : static_cast<std::size_t>((bits() >> 21) & 0xffffff);
+    }
+
+    /**
+     * 内联内容；仅在 isInline() 时有效，视图指向句柄自身
+     */
+    std::string_view inlineView() const {
+        return std::string_view(reinterpret_cast<const char*>(bytes_ + 1), size());
+    }
+
+    /**
+     * 前 8 字节按大端组成的整数：比较它即可决定大多数字符串的先后
+     */
+    static std::uint64_t sortPrefix(std::string_view text) {
+        std::uint64_t prefix = 0;
+        for (std::size_t i = 0; i < 8; ++i) {
+            prefix = (prefix << 8) | (i < text.size() ? std::uint8_t(text[i]) : 0);
+        }
+        return prefix;
+    }
+
+    // 同一内存池中的句柄按位比较：相同表示内容相同（不同不代表内容不同）
+    bool sameHandle(const CompactString& other) const { return std::memcmp(bytes_, other.bytes_, 8) == 0; }
+};
+
+static_assert(sizeof(CompactString) == 8, "CompactString 应为 8 字节");
+
+/**
+ * 只追加的 UTF-8 字符串内存池
+ * 字符串按块连续存放，写入后内容不再修改，返回的 string_view 在
+ * 内存池清空之前始终有效；修改字段时写入新字符串，旧字节保留在块中。
+ * 这样后台线程持有 string_view 时无需担心内容被并发改写。
+ *
+ * storeCompact() 返回 8 字节的 CompactString 句柄（短字符串内联）；块号在内存池生命周期内不变，
+ * adopt() 把对方的块追加在末尾，对方的句柄按返回的块号偏移 rebase() 后继续有效。
+ */
+class StringArena {
+private:
+    struct Chunk {
+        std::unique_ptr<char[]> data;
+        std::size_t capacity;
+        std::size_t used;
+    };
+
+    std::vector<std::shared_ptr<Chunk>> chunks_;
+    std::size_t chunkSize_;
+    std::size_t bytesUsed_;
+
+public:
+    /**
+     * 内存池的只读快照：持有者存在期间当前所有块都不会被释放，
+     * 后台任务在释放锁后用它解析此前取出的句柄
+     */
+    class Snapshot {
+    private:
+        std::shared_ptr<const std::vector<std::shared_ptr<Chunk>>> chunks_;
+        friend class StringArena;
+
+    public:
+        Snapshot() = default;
+
+        // 内联句柄的视图指向 text 本身，调用者需保证它在使用期间不移动
+        std::string_view view(const CompactString& text) const {
+            return text.isInline() ? text.inlineView() : resolve(*chunks_, text);
+        }
+    };
+
+    explicit StringArena(std::size_t chunkSize = 1 << 20)
+        : chunkSize_(std::min(chunkSize, CompactString::kMaxChunkBytes)), bytesUsed_(0) {}
+
+    StringArena(StringArena&&) = default;
+    StringArena& operator=(StringArena&&) = default;
+    StringArena(const StringArena&) = delete;
+    StringArena& operator=(const StringArena&) = delete;
+
+    /**
+     * 复制字符串到内存池，返回指向池内的稳定视图
+     */
+    std::string_view store(std::string_view text) {
+        if (text.empty()) {
+            return {};
+        }
+        if (chunks_.empty() || chunks_.back()->capacity - chunks_.back()->used < text.size()) {
+            // 超过块大小的字符串单独占一块（偏移为 0，句柄仍可编码）
+            auto chunk = std::make_shared<Chunk>();
+            chunk->capacity = std::max(chunkSize_, text.size());
+            chunk->data.reset(new char[chunk->capacity]);
+            chunk->used = 0;
+            chunks_.push_back(std::move(chunk));
+        }
+        Chunk& chunk = *chunks_.back();
+        char* dest = chunk.data.get() + chunk.used;
+        std::memcpy(dest, text.data(), text.size());
+        chunk.used += text.size();
+        bytesUsed_ += text.size();
+        return std::string_view(dest, text.size());
+    }
+
+    /**
+     * 复制字符串，返回句柄：不超过 7 字节时内联，不占内存池
+     */
+    CompactString storeCompact(std::string_view text) {
+        CompactString result;
+        if (CompactString::makeInline(text, result)) {
+            return result;
+        }
+        text = text.substr(0, CompactString::kMaxLength);
+        const std::string_view stored = store(text);
+        const Chunk& chunk = *chunks_.back();
+        const std::uint64_t offset = static_cast<std::uint64_t>(stored.data() - chunk.data.get());
+        const std::uint64_t index = chunks_.size() - 1;
+        return CompactString::fromBits((offset << 1) | (std::uint64_t(text.size()) << 21) | (index << 45));
+    }
+
+    /**
+     * 解析句柄；内联句柄的视图指向 text 本身
+     */
+    std::string_view view(const CompactString& text) const {
+        return text.isInline() ? text.inlineView() : resolve(chunks_, text);
+    }
+
+    /**
+     * 接管另一个内存池的全部块（并行解析后合并结果时使用），追加在自己的块之后
+     * 对方已返回的视图继续有效；返回块号偏移，对方的句柄需经 rebase() 才能在此解析
+     */
+    std::size_t adopt(StringArena&& other) {
+        const std::size_t base = chunks_.size();
+        chunks_.insert(chunks_.end(),
+                       std::make_move_iterator(other.chunks_.begin()),
+                       std::make_move_iterator(other.chunks_.end()));
+        bytesUsed_ += other.bytesUsed_;
+        other.chunks_.clear();
+        other.bytesUsed_ = 0;
+        return base;
+    }
+
+    static CompactString rebase(const CompactString& text, std::size_t chunkBase) {
+        if (text.isInline() || chunkBase == 0) {
+            return text;
+        }
+        return CompactString::fromBits(text.bits() + (std::uint64_t(chunkBase) << 45));
+    }
+
+    Snapshot snapshot() const {
+        Snapshot result;
+        result.chunks_ = std::make_shared<std::vector<std::shared_ptr<Chunk>>>(chunks_);
+        return result;
+    }
+
+    void clear() {
+        chunks_.clear();
+        bytesUsed_ = 0;
+    }
+
+    std::size_t bytesUsed() const { return bytesUsed_; }
+
+    std::size_t bytesReserved() const {
+        std::size_t total = 0;
+        for (const auto& chunk : chunks_) {
+            total += chunk->capacity;
+        }
+        return total;
+    }
+
+private:
+    static std::string_view resolve(const std::vector<std::shared_ptr<Chunk>>& chunks, const CompactString& text) {
+        return std::string_view(chunks[text.chunk()]->data.get() + text.offset(), text.size());
+    }
+};
+
+} // namespace mvvm
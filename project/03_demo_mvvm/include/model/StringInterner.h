@@ -0,0 +1,87 @@
+#pragma once
+#include "model/StringArena.h"
+#include <algorithm>
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace mvvm {
+
+/**
+ * 字符串驻留表：重复出现的值（邮箱域名等）只保存一份，以 32 位编号代替
+ *
+ * 编号从 1 开始按首次出现的顺序分配，0 保留给"无值"。相同编号即相同内容，
+ * 比较和查找只比较编号；text() 返回的视图在驻留表清空之前有效。
+ *
+ * 线程约定与所属的列存储一致：intern() 持有独占锁，读取持有共享锁。
+ */
+class StringInterner {
+public:
+    using Id = std::uint32_t;
+    static constexpr Id kNone = 0;
+
+private:
+    StringArena arena_;
+    std::vector<std::string_view> texts_;    // 编号 → 内容，texts_[0] 对应 kNone
+    std::unordered_map<std::string_view, Id> ids_;
+
+public:
+    StringInterner() : arena_(64 * 1024), texts_(1) {}
+
+    StringInterner(StringInterner&&) = default;
+    StringInterner& operator=(StringInterner&&) = default;
+    StringInterner(const StringInterner&) = delete;
+    StringInterner& operator=(const StringInterner&) = delete;
+
+    Id intern(std::string_view text) {
+        auto it = ids_.find(text);
+        if (it != ids_.end()) {
+            return it->second;
+        }
+        // 空串也分配编号，与 kNone 区分（例如 "user@" 的域名）
+        const std::string_view stored = text.empty() ? std::string_view("", 0) : arena_.store(text);
+        const Id id = static_cast<Id>(texts_.size());
+        texts_.push_back(stored);
+        ids_.emplace(stored, id);
+        return id;
+    }
+
+    /**
+     * 查找已驻留的编号，不存在时返回 kNone
+     */
+    Id find(std::string_view text) const {
+        auto it = ids_.find(text);
+        return it == ids_.end() ? kNone : it->second;
+    }
+
+    std::string_view text(Id id) const { return texts_[id]; }
+
+    // 编号数（含 kNone）
+    std::size_t size() const { return texts_.size(); }
+    std::size_t bytesUsed() const { return arena_.bytesUsed(); }
+
+    /**
+     * 各编号按内容字典序的名次（kNone 排在最前）：排序时比较名次即可
+     */
+    std::vector<Id> sortRanks() const {
+        std::vector<Id> order(texts_.size());
+        for (Id id = 0; id < order.size(); ++id) {
+            order[id] = id;
+        }
+        std::sort(order.begin() + 1, order.end(), [this](Id a, Id b) { return texts_[a] < texts_[b]; });
+        std::vector<Id> ranks(texts_.size());
+        for (Id rank = 0; rank < order.size(); ++rank) {
+            ranks[order[rank]] = rank;
+        }
+        return ranks;
+    }
+
+    void clear() {
+        arena_.clear();
+        texts_.assign(1, std::string_view());
+        ids_.clear();
+    }
+};
+
+} // namespace mvvm
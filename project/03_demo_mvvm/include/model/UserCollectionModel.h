@@ -0,0 +1,125 @@
+#pragma once
+#include "model/UserColumnStore.h"
+#include "search/UserSearchIndex.h"
+#include <QAbstractTableModel>
+#include <QFutureWatcher>
+#include <QString>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace mvvm {
+
+/**
+ * 用户集合模型 - 基于列式存储的 QAbstractTableModel
+ * 每行没有 QObject，数据只在 data() 中按需转换为 QString，
+ * 可支撑数百万用户。
+ *
+ * - 排序和过滤在线程池中计算，完成后在 GUI 线程一次性替换可见行映射
+ * - 单行修改合并到事件循环的下一轮，按连续行区间发出 dataChanged
+ * - 排序后再修改的行保持原位置，直到下一次排序
+ * - 过滤由增量维护的三元组索引求候选行，新增/修改的行在后台分批入索引
+ */
+class UserCollectionModel : public QAbstractTableModel {
+    Q_OBJECT
+    Q_PROPERTY(int userCount READ userCount NOTIFY userCountChanged)
+    Q_PROPERTY(bool busy READ isBusy NOTIFY busyChanged)
+
+public:
+    enum Column {
+        NameColumn = 0,
+        EmailColumn,
+        AgeColumn,
+        ValidColumn,
+        ColumnCount
+    };
+
+private:
+    struct ViewJobResult;
+
+    std::shared_ptr<UserColumnStore> store_;
+
+    // 可见行（视图行号 → RowId）及其反向映射（RowId → 视图行号，-1 表示不可见）
+    std::vector<RowId> visible_;
+    std::vector<int> rowOfId_;
+
+    // 排序/过滤状态
+    int sortColumn_;
+    Qt::SortOrder sortOrder_;
+    QString filterText_;
+    UserSearchIndex::Query filterQuery_;
+    UserSearchIndex::Query appliedFilterQuery_;
+
+    // 搜索索引：后台一次只运行一个索引批次
+    std::shared_ptr<UserSearchIndex> index_;
+    QFutureWatcher<void>* indexWatcher_;
+
+    // 后台任务：最新任务编号与所有任务共享，旧任务据此提前退出
+    std::shared_ptr<std::atomic<quint64>> latestJob_;
+    QFutureWatcher<std::shared_ptr<ViewJobResult>>* jobWatcher_;
+    bool jobRunning_;
+    std::vector<RowId> touchedDuringJob_;
+
+    // 待合并的行变化
+    std::vector<RowId> changedRows_;
+    bool flushScheduled_;
+
+public:
+    explicit UserCollectionModel(QObject* parent = nullptr);
+    ~UserCollectionModel() override;
+
+    // QAbstractTableModel 接口
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation,
+                        int role = Qt::DisplayRole) const override;
+    Qt::ItemFlags flags(const QModelIndex& index) const override;
+    bool setData(const QModelIndex& index, const QVariant& value, int role = Qt::EditRole) override;
+    bool removeRows(int row, int count, const QModelIndex& parent = QModelIndex()) override;
+    void sort(int column, Qt::SortOrder order = Qt::AscendingOrder) override;
+
+    // 集合操作（仅限 GUI 线程）
+    RowId addUser(const QString& name, const QString& email, int age);
+    void addUsers(UserColumnStore&& batch);
+    void updateUser(RowId id, const QString& name, const QString& email, int age);
+    void removeUser(RowId id);
+    void clear();
+
+    // 过滤：姓名或邮箱包含关键字，以 '^' 开头时为前缀匹配（ASCII 不区分大小写）
+    void setFilterText(const QString& text);
+    const QString& filterText() const { return filterText_; }
+
+    // 行映射
+    RowId rowIdAt(int row) const { return visible_[static_cast<std::size_t>(row)]; }
+    const std::vector<RowId>& visibleRows() const { return visible_; }
+    int rowOf(RowId id) const;
+
+    int userCount() const { return static_cast<int>(store_->liveCount()); }
+    bool isBusy() const { return jobRunning_; }
+    const UserColumnStore& store() const { return *store_; }
+    std::shared_ptr<const UserColumnStore> sharedStore() const { return store_; }
+    const UserSearchIndex& searchIndex() const { return *index_; }
+
+signals:
+    void userCountChanged();
+    void busyChanged();
+    void viewJobFinished(qint64 elapsedMs);
+
+private slots:
+    void onViewJobFinished();
+    void flushChangedRows();
+    void scheduleIndexing();
+
+private:
+    void startViewJob();
+    void markRowChanged(RowId id);
+    void appendVisibleRows(RowId first, RowId last);
+    void removeVisibleRow(int row);
+    void refilterRow(RowId id);
+    bool passesFilter(RowId id) const;
+    void setJobRunning(bool running);
+};
+
+} // namespace mvvm
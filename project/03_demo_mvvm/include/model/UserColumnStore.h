@@ -0,0 +1,118 @@
+#pragma once
+#include "model/StringArena.h"
+#include "model/StringInterner.h"
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace mvvm {
+
+using RowId = std::uint32_t;
+
+/**
+ * 用户数据列式存储（结构体数组）
+ * 每一列是一个连续数组，没有任何 QObject。字符串以 UTF-8 保存：
+ * - 姓名和邮箱的本地部分是 8 字节的 CompactString 句柄，短字符串内联，长的存放在 StringArena 中
+ * - 邮箱域名驻留在 StringInterner 中，每行只存 32 位编号；大量用户共用少数域名
+ * 每行共 26 字节（原先两个 string_view 即占 32 字节），只在视图边界转换为 QString。
+ *
+ * name() 返回的视图可能指向列数组本身（内联字符串），在该行被修改或追加新行之前有效，
+ * 后台线程需在持有共享锁期间使用；锁外使用的句柄用 snapshotStrings() 解析。
+ * 邮箱以 email(row, buffer) 拼接到调用者复用的缓冲区中，比较和排序直接使用本地部分和域名编号。
+ *
+ * RowId 是存储槽位编号，删除只打墓碑标记，编号永不复用或移动，
+ * 因此排序/过滤结果和索引可以长期引用 RowId。
+ *
+ * 线程约定：写操作只在 GUI 线程进行，并持有 mutex() 的独占锁；
+ * 后台线程读取时持有共享锁。GUI 线程自身读取无需加锁。
+ */
+class UserColumnStore {
+public:
+    using DomainId = StringInterner::Id;
+
+private:
+    StringArena arena_;
+    StringInterner domains_;
+    std::vector<CompactString> names_;
+    std::vector<CompactString> emailLocals_;   // 邮箱中第一个 '@' 之前的部分（无 '@' 时为整个邮箱）
+    std::vector<DomainId> emailDomains_;       // '@' 之后的部分；无 '@' 时为 kNone
+    std::vector<std::int32_t> ages_;
+    std::vector<std::uint8_t> valid_;
+    std::vector<std::uint8_t> alive_;
+    std::size_t liveCount_;
+    std::uint64_t epoch_;                      // 清空或整体替换时递增，此前取出的句柄随之失效
+    mutable std::shared_mutex mutex_;
+
+public:
+    UserColumnStore();
+
+    UserColumnStore(UserColumnStore&& other) noexcept;
+    UserColumnStore& operator=(UserColumnStore&& other) noexcept;
+    UserColumnStore(const UserColumnStore&) = delete;
+    UserColumnStore& operator=(const UserColumnStore&) = delete;
+
+    // 容量
+    std::size_t slotCount() const { return names_.size(); }
+    std::size_t liveCount() const { return liveCount_; }
+    std::uint64_t epoch() const { return epoch_; }
+    void reserve(std::size_t rows);
+
+    // 读取
+    bool isAlive(RowId row) const { return alive_[row] != 0; }
+    std::string_view name(RowId row) const { return arena_.view(names_[row]); }
+    int age(RowId row) const { return ages_[row]; }
+
+    /**
+     * 完整邮箱：拼接到 buffer（复用其容量）并返回指向它的视图
+     */
+    std::string_view email(RowId row, std::string& buffer) const;
+    std::string email(RowId row) const;
+    bool emailEquals(RowId row, std::string_view email) const;
+
+    // 邮箱的组成部分
+    std::string_view emailLocal(RowId row) const { return arena_.view(emailLocals_[row]); }
+    DomainId emailDomain(RowId row) const { return emailDomains_[row]; }
+    std::string_view domainText(DomainId id) const { return domains_.text(id); }
+    DomainId findDomain(std::string_view domain) const { return domains_.find(domain); }
+    const StringInterner& domains() const { return domains_; }
+
+    // 供排序等锁外使用的原始句柄
+    const CompactString& nameHandle(RowId row) const { return names_[row]; }
+    const CompactString& emailLocalHandle(RowId row) const { return emailLocals_[row]; }
+    bool isValid(RowId row) const { return valid_[row] != 0; }
+
+    // 写入
+    RowId append(std::string_view name, std::string_view email, int age);
+    // 追加但不校验（批量导入时先解析、后统一调用 revalidate）
+    RowId appendUnvalidated(std::string_view name, std::string_view email, int age);
+    void setName(RowId row, std::string_view name);
+    void setEmail(RowId row, std::string_view email);
+    void setAge(RowId row, int age);
+    void remove(RowId row);
+    void clear();
+
+    /**
+     * 把另一份存储的全部存活行追加到末尾（接管其字符串内存池，不复制字符串）
+     * 返回第一条追加行的 RowId
+     */
+    RowId appendAll(UserColumnStore&& other);
+
+    /**
+     * 批量重新计算校验列 [first, last)，可在多个线程上对不相交区间并行调用
+     * 返回区间内无效的存活行数
+     */
+    std::size_t revalidate(RowId first, RowId last);
+
+    std::shared_mutex& mutex() const { return mutex_; }
+    StringArena::Snapshot snapshotStrings() const { return arena_.snapshot(); }
+    std::size_t stringBytes() const { return arena_.bytesUsed() + domains_.bytesUsed(); }
+
+private:
+    void storeEmail(RowId row, std::string_view email);
+    void updateValidity(RowId row, std::string& buffer);
+};
+
+} // namespace mvvm
@@ -1,13 +1,18 @@
 #pragma once
+#include "core/UpdateChannel.h"
 #include <QObject>
 #include <QString>
-#include <QRegularExpression>
+#include <optional>
+#include <vector>
 
 namespace mvvm {
 
 /**
  * 用户数据模型 - 使用 Qt 的信号槽机制
  * 负责管理用户数据和业务逻辑
+ *
+ * setter 只能在 GUI 线程调用；其他线程通过 updates()->post(patch) 提交修改，
+ * GUI 线程每帧把积压的修改合并为一次 apply()，只发出一轮通知。
  */
 class UserModel : public QObject {
     Q_OBJECT
@@ -16,11 +21,37 @@ class UserModel : public QObject {
     Q_PROPERTY(int age READ age WRITE setAge NOTIFY ageChanged)
     Q_PROPERTY(bool isValid READ isValid NOTIFY validationChanged)
 
+public:
+    /**
+     * 部分字段的修改，未设置的字段保持不变
+     */
+    struct Patch {
+        std::optional<QString> name;
+        std::optional<QString> email;
+        std::optional<int> age;
+
+        // 合并较晚的修改：同一字段以后者为准
+        void merge(Patch&& later);
+    };
+
+    /**
+     * 全部字段的一个版本，用于撤销 / 重做
+     * QString 隐式共享：取状态只增加引用计数，未修改的字段在各版本间共享数据
+     */
+    struct State {
+        QString name;
+        QString email;
+        int age = 0;
+    };
+
+    using PatchChannel = UpdateChannel<Patch>;
+
 private:
     QString name_;
     QString email_;
     int age_;
     bool isValid_;
+    PatchChannel* updates_;
 
 public:
     explicit UserModel(QObject* parent = nullptr);
@@ -37,6 +68,18 @@ public:
     void setEmail(const QString& email);
     void setAge(int age);
 
+    /**
+     * 一次应用多个字段：各字段信号、校验和 dataChanged 都只发生一次
+     */
+    void apply(const Patch& patch);
+
+    // 当前全部字段；restore() 以一次 apply() 恢复到给定版本
+    State state() const { return State{name_, email_, age_}; }
+    void restore(const State& state);
+
+    // 跨线程更新通道（post() 线程安全）
+    PatchChannel* updates() const { return updates_; }
+
     // 业务逻辑
     Q_INVOKABLE void validateData();
     Q_INVOKABLE QString getUserInfo() const;
@@ -50,6 +93,7 @@ signals:
 
 private:
     bool isValidEmail(const QString& email) const;
+    void applyBatch(std::vector<Patch>& batch);
 };
 
 } // namespace mvvm
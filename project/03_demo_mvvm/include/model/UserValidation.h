@@ -0,0 +1,79 @@
+#pragma once
+#include <cstddef>
+#include <string_view>
+#include <type_traits>
+
+namespace mvvm {
+namespace validation {
+
+/**
+ * 不依赖 Qt 的用户数据校验
+ * 规则与 UserModel::validateData 保持一致，供批量数据路径使用，
+ * 避免为每一行构造 QString / QRegularExpression
+ */
+
+inline bool isEmailLocalChar(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') ||
+           c == '.' || c == '_' || c == '%' || c == '+' || c == '-';
+}
+
+inline bool isEmailDomainChar(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') ||
+           c == '.' || c == '-';
+}
+
+inline bool isAsciiLetter(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+/**
+ * 把 UTF-8 字节或 UTF-16 码元映射到 ASCII，非 ASCII 字符映射为 '\0'（不属于任何字符类）
+ */
+template<typename Char>
+inline char asciiOf(Char c) {
+    const auto code = static_cast<std::make_unsigned_t<Char>>(c);
+    return code < 0x80 ? static_cast<char>(code) : '\0';
+}
+
+/**
+ * 等价于正则:
+ *   [a-zA-Z0-9._%+-]+@[a-zA-Z0-9.-]+\.[a-zA-Z]{2,}
+ * 与 QRegularExpression::match 一样是"包含匹配"而不是整串匹配。
+ * 模板化字符类型，UserModel 可直接传入 QString::utf16()，无需转换或分配
+ */
+template<typename Char>
+inline bool isValidEmail(const Char* email, std::size_t size) {
+    for (std::size_t at = 1; at < size; ++at) {
+        if (asciiOf(email[at]) != '@' || !isEmailLocalChar(asciiOf(email[at - 1]))) {
+            continue;
+        }
+        // '@' 之后域名字符的最长连续段
+        std::size_t end = at + 1;
+        while (end < size && isEmailDomainChar(asciiOf(email[end]))) {
+            ++end;
+        }
+        // 段内需存在一个 '.'，其前至少一个字符、其后至少两个字母
+        for (std::size_t dot = at + 2; dot + 2 < end; ++dot) {
+            if (asciiOf(email[dot]) == '.' && isAsciiLetter(asciiOf(email[dot + 1])) &&
+                isAsciiLetter(asciiOf(email[dot + 2]))) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+inline bool isValidEmail(std::string_view email) {
+    return isValidEmail(email.data(), email.size());
+}
+
+inline bool isValidAge(int age) {
+    return age >= 0 && age <= 150;
+}
+
+inline bool isValidUser(std::string_view name, std::string_view email, int age) {
+    return !name.empty() && isValidEmail(email) && isValidAge(age);
+}
+
+} // namespace validation
+} // namespace mvvm
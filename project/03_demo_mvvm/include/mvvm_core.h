@@ -1,8 +1,22 @@
 #pragma once
+#include "core/InplaceFunction.h"
+#include "core/Trace.h"
+#include "common/Metrics.h"
+#include "common/TaskScheduler.h"
+#include <QFuture>
+#include <QFutureInterface>
+#include <QMetaMethod>
 #include <QObject>
+#include <QPointer>
 #include <QVariant>
+#include <atomic>
+#include <deque>
 #include <functional>
 #include <memory>
+#include <type_traits>
+#include <vector>
+
+class QTimer;
 
 namespace mvvm {
 
@@ -20,17 +34,47 @@ public:
 protected:
     /**
      * 设置属性并发出通知信号
+     * 属性名请传 QStringLiteral，字符串数据在编译期生成，通知时不分配内存
      */
     template<typename T>
-    bool setProperty(T& field, const T& value, const char* propertyName) {
+    bool setProperty(T& field, const T& value, const QString& propertyName) {
         if (field != value) {
+            MVVM_TRACE_SCOPE_DETAIL("property", "setProperty", propertyName);
             field = value;
-            emit propertyChanged(propertyName);
+            notifyPropertyChanged(propertyName);
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * 设置属性并发出该属性自己的 NOTIFY 信号，以及通用的 propertyChanged
+     */
+    template<typename T, typename Derived>
+    bool setProperty(T& field, const T& value, const QString& propertyName, void (Derived::*notify)()) {
+        if (field != value) {
+            MVVM_TRACE_SCOPE_DETAIL("property", "setProperty", propertyName);
+            field = value;
+            emit (static_cast<Derived*>(this)->*notify)();
+            notifyPropertyChanged(propertyName);
             return true;
         }
         return false;
     }
 
+private:
+    // 所有视图模型共用的通知计数（mvvm_property_notifications_total）
+    static common::Counter& notificationCounter();
+
+    // 没有监听者时跳过信号分发
+    void notifyPropertyChanged(const QString& propertyName) {
+        static const QMetaMethod signal = QMetaMethod::fromSignal(&ViewModelBase::propertyChanged);
+        notificationCounter().add();
+        if (isSignalConnected(signal)) {
+            emit propertyChanged(propertyName);
+        }
+    }
+
 signals:
     void propertyChanged(const QString& propertyName);
 };
@@ -51,6 +95,7 @@ public:
 
 public slots:
     void updateCanExecute() {
+        MVVM_TRACE_SCOPE("command", "Command::canExecuteChanged");
         emit canExecuteChanged();
     }
 
@@ -60,22 +105,29 @@ signals:
 
 /**
  * 委托命令实现
+ * 回调保存在 InplaceFunction 中，构造和执行都不分配堆内存；
+ * 可直接作为 ViewModel 的成员（不设父对象），省去每个命令一次 new
  */
 class DelegateCommand : public Command {
     Q_OBJECT
 
+public:
+    using ExecuteFunc = InplaceFunction<void()>;
+    using CanExecuteFunc = InplaceFunction<bool()>;
+
 private:
-    std::function<void()> executeFunc_;
-    std::function<bool()> canExecuteFunc_;
+    ExecuteFunc executeFunc_;
+    CanExecuteFunc canExecuteFunc_;
 
 public:
     explicit DelegateCommand(
-        std::function<void()> executeFunc,
-        std::function<bool()> canExecuteFunc = nullptr,
+        ExecuteFunc executeFunc,
+        CanExecuteFunc canExecuteFunc = nullptr,
         QObject* parent = nullptr)
-        : Command(parent), executeFunc_(executeFunc), canExecuteFunc_(canExecuteFunc) {}
+        : Command(parent), executeFunc_(std::move(executeFunc)), canExecuteFunc_(std::move(canExecuteFunc)) {}
 
     void execute() override {
+        MVVM_TRACE_SCOPE("command", "DelegateCommand::execute");
         if (executeFunc_ && canExecute()) {
             executeFunc_();
         }
@@ -86,4 +138,407 @@ public:
     }
 };
 
+/**
+ * 取消令牌 - 与调度器共用同一个类型，可直接传给 TaskScheduler::submit / parallelFor
+ */
+using CancellationToken = common::CancellationToken;
+
+/**
+ * 异步命令的执行上下文，在调度器的工作线程中使用
+ */
+class AsyncContext {
+private:
+    CancellationToken token_;
+    QFutureInterface<void> future_;
+
+public:
+    AsyncContext(const CancellationToken& token, const QFutureInterface<void>& future)
+        : token_(token), future_(future) {}
+
+    const CancellationToken& token() const { return token_; }
+    bool isCancelled() const { return token_.isCancelled() || future_.isCanceled(); }
+
+    void setProgressRange(int minimum, int maximum) { future_.setProgressRange(minimum, maximum); }
+    void setProgress(int value, const QString& text = QString()) {
+        future_.setProgressValueAndText(value, text);
+    }
+};
+
+/**
+ * 一次异步执行：run 在调度器中执行，finished 在 GUI 线程中执行（被取消或抛出异常时不调用）。
+ * run 不应访问 GUI 对象，所需数据在创建任务时按值捕获。
+ * 每次执行本来就要向调度器提交任务，这里仍用 std::function，捕获大小不受限制。
+ */
+struct AsyncJob {
+    std::function<void(AsyncContext&)> run;
+    std::function<void()> finished;
+};
+
+/**
+ * 异步命令 - 在任务调度器中以高优先级执行命令体，完成后回到 GUI 线程
+ *
+ * 每次执行时先在 GUI 线程调用任务工厂（可读取当前状态、接收参数），
+ * 再把返回的 run 提交给调度器。并发数超过上限时按策略处理：
+ * - Drop:    忽略新的执行请求，运行期间 canExecute() 为 false
+ * - Queue:   排队，按顺序在有空位时启动
+ * - Restart: 取消正在运行的执行并立即启动新的执行
+ */
+class AsyncCommand : public Command {
+    Q_OBJECT
+    Q_PROPERTY(bool running READ isRunning NOTIFY runningChanged)
+    Q_PROPERTY(int progress READ progress NOTIFY progressChanged)
+
+public:
+    enum class Policy {
+        Drop,
+        Queue,
+        Restart
+    };
+
+    using JobFactory = InplaceFunction<AsyncJob(const QVariant& parameter)>;
+    using CanExecuteFunc = InplaceFunction<bool()>;
+
+private:
+    struct Run;
+
+    JobFactory factory_;
+    CanExecuteFunc canExecuteFunc_;
+    Policy policy_;
+    int maxConcurrent_;
+    common::TaskScheduler* scheduler_;
+    std::vector<std::unique_ptr<Run>> runs_;
+    std::deque<QVariant> queued_;
+    QFuture<void> lastFuture_;
+    int progress_;
+    QString progressText_;
+
+public:
+    explicit AsyncCommand(
+        JobFactory factory,
+        CanExecuteFunc canExecuteFunc = nullptr,
+        QObject* parent = nullptr);
+    ~AsyncCommand() override;
+
+    void setPolicy(Policy policy, int maxConcurrent = 1);
+    Policy policy() const { return policy_; }
+    int maxConcurrent() const { return maxConcurrent_; }
+
+    // 默认使用 common::TaskScheduler::shared()
+    void setScheduler(common::TaskScheduler* scheduler) { scheduler_ = scheduler; }
+
+    void execute() override { executeWith(QVariant()); }
+    Q_INVOKABLE void executeWith(const QVariant& parameter);
+
+    /**
+     * 取消全部正在运行和排队的执行
+     */
+    Q_INVOKABLE void cancel();
+
+    bool canExecute() const override;
+    bool isRunning() const { return activeCount() > 0; }
+    int activeCount() const;
+    int queuedCount() const { return static_cast<int>(queued_.size()); }
+
+    // 最近一次启动的执行
+    QFuture<void> future() const { return lastFuture_; }
+    int progress() const { return progress_; }
+    const QString& progressText() const { return progressText_; }
+
+signals:
+    void runningChanged();
+    void progressChanged(int value, const QString& text);
+    void finished();
+    void cancelled();
+    void failed(const QString& error);
+
+private:
+    void start(const QVariant& parameter);
+    void onRunFinished(Run* run);
+    void startQueued();
+};
+
+/**
+ * 绑定限流器 - 把高频信号（如逐键输入）合并为低频动作
+ *
+ * 动作不接收信号参数，而是在执行时读取最新值（例如 edit->text()），
+ * 因此无论合并了多少次触发，执行的总是最新状态。
+ * - Debounce:        停止触发 interval 毫秒后执行一次
+ * - Throttle:        空闲时立即执行，之后每 interval 毫秒最多执行一次，期间的触发合并到周期末尾
+ * - LatestWhileBusy: 不忙时立即执行；忙时只记住"有新值"，变为空闲（再等 interval 毫秒）后执行一次
+ */
+class RateLimiter : public QObject {
+    Q_OBJECT
+
+public:
+    enum class Mode {
+        Debounce,
+        Throttle,
+        LatestWhileBusy
+    };
+
+    using Action = InplaceFunction<void()>;
+    using BusyPredicate = InplaceFunction<bool()>;
+
+private:
+    Mode mode_;
+    int intervalMs_;
+    Action action_;
+    BusyPredicate isBusy_;
+    QTimer* timer_;
+    bool pending_;
+
+public:
+    RateLimiter(Mode mode, int intervalMs, Action action, QObject* parent = nullptr);
+
+    Mode mode() const { return mode_; }
+    void setMode(Mode mode) { mode_ = mode; }
+    int interval() const { return intervalMs_; }
+    void setInterval(int intervalMs) { intervalMs_ = intervalMs; }
+    bool isPending() const { return pending_; }
+
+    // LatestWhileBusy 模式使用
+    void setBusyPredicate(BusyPredicate isBusy) { isBusy_ = std::move(isBusy); }
+
+public slots:
+    void trigger();
+    // 立即执行尚未执行的动作（例如提交前、编辑结束时）
+    void flush();
+    // 丢弃尚未执行的动作
+    void cancel();
+    // LatestWhileBusy：忙碌状态可能已变化
+    void onBusyChanged();
+
+private slots:
+    void onTimeout();
+
+private:
+    void fire();
+};
+
+/**
+ * 声明式绑定运算符：把 sender 的信号经限流器连接到动作，限流器归 owner 所有
+ *
+ *   binding::debounce(edit, &QLineEdit::textChanged, 200, [=] { vm->updateName(edit->text()); }, this);
+ */
+namespace binding {
+
+template<typename Sender, typename Signal>
+RateLimiter* debounce(Sender* sender, Signal signal, int intervalMs,
+                      RateLimiter::Action action, QObject* owner) {
+    auto limiter = new RateLimiter(RateLimiter::Mode::Debounce, intervalMs, std::move(action), owner);
+    QObject::connect(sender, signal, limiter, &RateLimiter::trigger);
+    return limiter;
+}
+
+template<typename Sender, typename Signal>
+RateLimiter* throttle(Sender* sender, Signal signal, int intervalMs,
+                      RateLimiter::Action action, QObject* owner) {
+    auto limiter = new RateLimiter(RateLimiter::Mode::Throttle, intervalMs, std::move(action), owner);
+    QObject::connect(sender, signal, limiter, &RateLimiter::trigger);
+    return limiter;
+}
+
+/**
+ * busyObject 发出 busySignal 时重新检查 isBusy()
+ */
+template<typename Sender, typename Signal, typename BusySender, typename BusySignal>
+RateLimiter* latestWhileBusy(Sender* sender, Signal signal,
+                             BusySender* busyObject, BusySignal busySignal, RateLimiter::BusyPredicate isBusy,
+                             int intervalMs, RateLimiter::Action action, QObject* owner) {
+    auto limiter = new RateLimiter(RateLimiter::Mode::LatestWhileBusy, intervalMs, std::move(action), owner);
+    limiter->setBusyPredicate(std::move(isBusy));
+    QObject::connect(sender, signal, limiter, &RateLimiter::trigger);
+    QObject::connect(busyObject, busySignal, limiter, &RateLimiter::onBusyChanged);
+    return limiter;
+}
+
+} // namespace binding
+
+namespace detail {
+
+template<typename Member>
+struct MemberTraits;
+
+template<typename Class, typename Result, typename... Args>
+struct MemberTraits<Result (Class::*)(Args...)> {
+    using Object = Class;
+};
+
+template<typename Class, typename Result, typename... Args>
+struct MemberTraits<Result (Class::*)(Args...) const> {
+    using Object = Class;
+};
+
+} // namespace detail
+
+/**
+ * 编译期属性访问器：读取函数、写入函数、变化信号
+ * 对象类型取自读取函数所属的类，三者都是模板参数，调用时没有任何查找或字符串处理。
+ *
+ *   using LineEditText = Property<&QLineEdit::text, &QLineEdit::setText, &QLineEdit::textChanged>;
+ */
+template<auto Getter, auto Setter, auto Notify>
+struct Property {
+    using Object = typename detail::MemberTraits<decltype(Getter)>::Object;
+    using Value = std::decay_t<decltype((std::declval<const Object*>()->*Getter)())>;
+
+    static Value get(const Object* object) { return (object->*Getter)(); }
+    static void set(Object* object, const Value& value) { (object->*Setter)(value); }
+    static constexpr auto notify = Notify;
+};
+
+/**
+ * 绑定基类，供 BindingSet 统一持有
+ */
+class BindingBase {
+public:
+    virtual ~BindingBase() = default;
+    virtual void flush() = 0;
+};
+
+/**
+ * 双向绑定：控件属性 <-> ViewModel 属性
+ *
+ * - 控件变化时写入 ViewModel，ViewModel 变化时写回控件
+ * - 内置重入保护：自身引起的回声通知被忽略
+ * - 值相等时直接返回，不触发写入
+ * - 建立时分配一次连接，之后每次更新都不分配堆内存
+ * - 可选 debounce / throttle，控件到 ViewModel 方向经 RateLimiter 合并
+ */
+template<typename T, typename WidgetProperty, typename ViewModelProperty>
+class Binding : public BindingBase {
+    static_assert(std::is_same<typename WidgetProperty::Value, T>::value, "控件属性类型必须为 T");
+    static_assert(std::is_same<typename ViewModelProperty::Value, T>::value, "ViewModel 属性类型必须为 T");
+
+public:
+    using Widget = typename WidgetProperty::Object;
+    using ViewModel = typename ViewModelProperty::Object;
+
+private:
+    Widget* widget_;
+    ViewModel* viewModel_;
+    bool updating_;
+    QPointer<RateLimiter> limiter_;
+    QMetaObject::Connection toViewModel_;
+    QMetaObject::Connection toWidget_;
+
+    class Guard {
+        bool& flag_;
+    public:
+        explicit Guard(bool& flag) : flag_(flag) { flag_ = true; }
+        ~Guard() { flag_ = false; }
+    };
+
+public:
+    Binding(Widget* widget, ViewModel* viewModel)
+        : widget_(widget), viewModel_(viewModel), updating_(false), limiter_(nullptr) {
+        // 以控件为上下文对象：控件销毁时连接自动断开
+        toViewModel_ = QObject::connect(widget_, WidgetProperty::notify, widget_, [this]() { pushToViewModel(); });
+        toWidget_ = QObject::connect(viewModel_, ViewModelProperty::notify, widget_, [this]() { pullFromViewModel(); });
+        pullFromViewModel();
+    }
+
+    ~Binding() override {
+        QObject::disconnect(toViewModel_);
+        QObject::disconnect(toWidget_);
+        delete limiter_.data();   // 限流器的动作引用本对象
+    }
+
+    Binding(const Binding&) = delete;
+    Binding& operator=(const Binding&) = delete;
+
+    /**
+     * 控件连续变化停顿 intervalMs 毫秒后才写入 ViewModel
+     * 每个绑定只有一个限流器：再次调用 debounce() / throttle() 替换之前的模式和间隔
+     */
+    Binding& debounce(int intervalMs) { return limit(RateLimiter::Mode::Debounce, intervalMs); }
+
+    /**
+     * 控件到 ViewModel 方向每 intervalMs 毫秒最多写入一次
+     */
+    Binding& throttle(int intervalMs) { return limit(RateLimiter::Mode::Throttle, intervalMs); }
+
+    void flush() override {
+        if (limiter_) {
+            limiter_->flush();
+        }
+    }
+
+    void pushToViewModel() {
+        if (updating_) {
+            return;
+        }
+        const T value = WidgetProperty::get(widget_);
+        if (value == ViewModelProperty::get(viewModel_)) {
+            return;
+        }
+        MVVM_TRACE_SCOPE("binding", "Binding::pushToViewModel");
+        Guard guard(updating_);
+        ViewModelProperty::set(viewModel_, value);
+    }
+
+    void pullFromViewModel() {
+        if (updating_) {
+            return;
+        }
+        const T value = ViewModelProperty::get(viewModel_);
+        if (value == WidgetProperty::get(widget_)) {
+            return;
+        }
+        MVVM_TRACE_SCOPE("binding", "Binding::pullFromViewModel");
+        Guard guard(updating_);
+        WidgetProperty::set(widget_, value);
+        // 写回的值已与 ViewModel 一致，丢弃由此触发的限流中的写入
+        if (limiter_) {
+            limiter_->cancel();
+        }
+    }
+
+private:
+    Binding& limit(RateLimiter::Mode mode, int intervalMs) {
+        if (!limiter_) {
+            limiter_ = new RateLimiter(mode, intervalMs, [this]() { pushToViewModel(); }, widget_);
+            QObject::disconnect(toViewModel_);
+            toViewModel_ = QObject::connect(widget_, WidgetProperty::notify, limiter_, &RateLimiter::trigger);
+        } else {
+            // 按旧设置尚未写入的值先写入，再切换到新的模式和间隔
+            limiter_->flush();
+            limiter_->cancel();
+            limiter_->setMode(mode);
+            limiter_->setInterval(intervalMs);
+        }
+        return *this;
+    }
+};
+
+/**
+ * 绑定集合 - 视图持有，一行声明一个字段
+ *
+ *   bindings_.bind<LineEditText, UserViewModel::NameProperty>(nameEdit_, viewModel).debounce(200);
+ */
+class BindingSet {
+private:
+    std::vector<std::unique_ptr<BindingBase>> bindings_;
+
+public:
+    template<typename WidgetProperty, typename ViewModelProperty>
+    Binding<typename WidgetProperty::Value, WidgetProperty, ViewModelProperty>&
+    bind(typename WidgetProperty::Object* widget, typename ViewModelProperty::Object* viewModel) {
+        using BindingType = Binding<typename WidgetProperty::Value, WidgetProperty, ViewModelProperty>;
+        auto binding = std::make_unique<BindingType>(widget, viewModel);
+        BindingType& result = *binding;
+        bindings_.push_back(std::move(binding));
+        return result;
+    }
+
+    // 提交所有尚在限流中的输入
+    void flush() {
+        for (auto& binding : bindings_) {
+            binding->flush();
+        }
+    }
+
+    void clear() { bindings_.clear(); }
+};
+
 } // namespace mvvm
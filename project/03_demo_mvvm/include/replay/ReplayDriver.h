@@ -0,0 +1,128 @@
+#pragma once
+#include <QHash>
+#include <QJsonObject>
+#include <QPair>
+#include <QString>
+#include <QVector>
+#include <cstdint>
+#include <vector>
+
+namespace mvvm {
+namespace replay {
+
+/**
+ * 回放操作类型
+ */
+enum class OpKind : std::uint8_t {
+    SetName,
+    SetEmail,
+    SetAge,
+    Save,
+    Reset
+};
+
+constexpr int kOpKindCount = 5;
+
+const char* opKindName(OpKind kind);
+
+/**
+ * 一条回放操作：文本参数存放在 Script::texts 中，按下标引用
+ * 百万级操作只占 8 字节/条，重复的文本共享同一个 QString
+ */
+struct Operation {
+    OpKind kind;
+    std::uint32_t text;
+};
+
+/**
+ * 操作序列
+ *
+ * 脚本格式：每行一条操作，'#' 开头的行和空行忽略
+ *   name <文本>     设置姓名（文本为空表示清空）
+ *   email <文本>    设置邮箱
+ *   age <文本>      按输入框文本设置年龄（经过 updateAge 的解析）
+ *   save            保存（等待后台保存完成）
+ *   reset           重置
+ */
+struct Script {
+    std::vector<Operation> ops;
+    QVector<QString> texts;
+    // 文本 → texts 中的下标
+    QHash<QString, std::uint32_t> textIndex;
+    QString source;
+
+    // 追加一条操作，相同的文本只存一份
+    void append(OpKind kind, const QString& text = QString());
+
+    /**
+     * 读取脚本文件，失败时返回 false 并在 error 中给出行号
+     */
+    static bool load(const QString& path, Script& script, QString& error);
+
+    /**
+     * 生成 count 条随机操作：以逐键输入为主，夹杂无效输入、保存和重置
+     * 只使用自带的 64 位随机数（不依赖标准库分布的实现），相同种子在各平台上生成相同序列
+     */
+    static Script generate(std::uint64_t count, std::uint64_t seed);
+};
+
+/**
+ * 回放统计：单条操作耗时（纳秒）的分布
+ */
+struct LatencyStats {
+    std::uint64_t count = 0;
+    double meanNs = 0.0;
+    std::uint64_t minNs = 0;
+    std::uint64_t p50Ns = 0;
+    std::uint64_t p90Ns = 0;
+    std::uint64_t p99Ns = 0;
+    std::uint64_t p999Ns = 0;
+    std::uint64_t maxNs = 0;
+
+    QJsonObject toJson() const;
+};
+
+struct ReplayOptions {
+    // 整个序列重复回放的次数
+    int repeat = 1;
+    // 正式计时前先回放的操作数（不计入统计）
+    std::uint64_t warmupOps = 0;
+};
+
+struct ReplayResult {
+    std::uint64_t ops = 0;
+    qint64 elapsedNs = 0;
+    double opsPerSecond = 0.0;
+    // 计时器自身的开销，已从各操作耗时中扣除
+    std::uint64_t timerOverheadNs = 0;
+    LatencyStats latency[kOpKindCount];
+    // "类名::信号名" → 次数，按名称排序
+    QVector<QPair<QString, std::uint64_t>> notifications;
+    std::uint64_t totalNotifications = 0;
+    // 回放结束时的状态，用于确认两次回放的行为一致
+    std::uint64_t savedUsers = 0;
+    quint64 stateVersion = 0;
+    QString finalStatus;
+    qint64 peakMemoryBytes = 0;
+};
+
+/**
+ * 无界面回放驱动
+ *
+ * 在调用线程（需已有 QCoreApplication）上创建 UserModel、UserViewModel 和已保存用户集合，
+ * 以视图的调用方式全速执行操作序列：编辑走 updateName/updateEmail/updateAge，
+ * 保存和重置走命令对象。保存是异步命令，计时包含等待后台保存完成的时间。
+ * 两个对象发出的每个信号都按名称计数。
+ */
+class ReplayDriver {
+public:
+    static ReplayResult run(const Script& script, const ReplayOptions& options = ReplayOptions());
+
+    /**
+     * 基线 JSON：键按字母序、格式固定，可以直接与以前的结果比较
+     */
+    static QJsonObject toJson(const Script& script, const ReplayOptions& options, const ReplayResult& result);
+};
+
+} // namespace replay
+} // namespace mvvm
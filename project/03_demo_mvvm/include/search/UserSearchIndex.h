@@ -0,0 +1,105 @@
+#pragma once
+#include "model/UserColumnStore.h"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace mvvm {
+
+/**
+ * 用户搜索索引 - 姓名/邮箱的三元组（trigram）倒排索引
+ *
+ * 每个字段按 ASCII 小写后切成三元组，另加两个"字段开头"锚定三元组，
+ * 因此任意长度的前缀查询和长度 >= 3 的子串查询都能直接由倒排表求出候选行；
+ * 更短的子串查询退化为全表扫描。
+ *
+ * 倒排表按 RowId 升序以差值 + 变长整数压缩存储，只追加。
+ * 修改后的行重新追加一次，旧的倒排项不删除：所有候选行最终都会
+ * 对照当前数据逐行校验，过期项只影响候选数量，不影响结果正确性。
+ *
+ * 线程约定：markDirty / clear 在 GUI 线程调用；indexPending 在一个后台线程中执行；
+ * search 可在任意线程并发调用。
+ */
+class UserSearchIndex {
+public:
+    /**
+     * 解析后的查询：key 已转为 ASCII 小写；以 '^' 开头的输入表示前缀查询
+     */
+    struct Query {
+        std::string key;
+        bool prefix = false;
+
+        bool empty() const { return key.empty(); }
+        bool operator==(const Query& other) const {
+            return prefix == other.prefix && key == other.key;
+        }
+        bool operator!=(const Query& other) const { return !(*this == other); }
+    };
+
+private:
+    struct PostingList {
+        std::vector<std::uint8_t> bytes;   // 升序 RowId 的差值编码
+        std::vector<RowId> unsorted;       // 小于 last 的追加项（行被修改后重新索引）
+        RowId last = 0;
+        std::uint32_t count = 0;
+    };
+
+    std::unordered_map<std::uint32_t, PostingList> postings_;
+    std::vector<std::pair<RowId, RowId>> pending_;   // 待索引区间 [first, last)
+    std::vector<RowId> inFlight_;                    // 已取出、尚未写入索引的行
+    std::uint64_t epoch_;                            // clear() 时递增，丢弃过期批次
+    std::size_t postingBytes_;
+    std::atomic<bool> abandoned_;
+    mutable std::shared_mutex mutex_;
+
+public:
+    UserSearchIndex();
+
+    static Query parseQuery(std::string_view text);
+    static bool matches(const UserColumnStore& store, RowId row, const Query& query);
+    // 逐行校验的循环中复用邮箱拼接缓冲区
+    static bool matches(const UserColumnStore& store, RowId row, const Query& query, std::string& emailBuffer);
+
+    // 维护
+    void markDirty(RowId row);
+    void markDirty(RowId first, RowId last);
+    void clear();
+    bool hasPending() const;
+
+    /**
+     * 索引最多 maxRows 个待处理行，返回实际处理的行数（0 表示已无待处理行）
+     * 读取 store 时分批持有其共享锁
+     */
+    std::size_t indexPending(const UserColumnStore& store, std::size_t maxRows);
+
+    /**
+     * 放弃后续索引工作（所属模型销毁时调用），正在运行的 indexPending 尽快返回
+     */
+    void abandon() { abandoned_.store(true); }
+
+    /**
+     * 查询匹配的存活行，结果按 RowId 升序写入 out
+     * cancelled 返回 true 时中止并返回 false
+     */
+    bool search(const UserColumnStore& store, const Query& query,
+                std::vector<RowId>& out, const std::function<bool()>& cancelled) const;
+
+    // 统计
+    std::size_t gramCount() const;
+    std::size_t postingBytes() const;
+
+private:
+    static void collectGrams(std::string_view field, std::vector<std::uint32_t>& grams);
+    static void queryGrams(const Query& query, std::vector<std::uint32_t>& grams);
+    static void appendPosting(PostingList& list, RowId row, std::size_t& bytes);
+    static void decodePosting(const PostingList& list, std::vector<RowId>& out);
+    void expandPending(std::vector<RowId>& out) const;
+};
+
+} // namespace mvvm
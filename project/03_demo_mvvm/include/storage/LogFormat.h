@@ -0,0 +1,70 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace mvvm {
+namespace storage {
+
+/**
+ * 用户日志记录格式（日志段与快照共用）
+ *
+ *   u32 payloadLength | u32 crc32(payload) | payload
+ *   payload = u64 seq | u8 op | i32 age | u32 nameLength | name | u32 emailLength | email
+ *
+ * 所有整数均为小端序。记录以邮箱为键：Upsert 覆盖同邮箱的旧记录，Delete 删除之。
+ * 校验和只覆盖 payload，长度字段损坏会表现为校验失败或越界，同样视为损坏。
+ */
+enum class LogOp : std::uint8_t {
+    Upsert = 1,
+    Delete = 2
+};
+
+struct LogRecord {
+    std::uint64_t seq = 0;
+    LogOp op = LogOp::Upsert;
+    std::int32_t age = 0;
+    std::string_view name;
+    std::string_view email;
+};
+
+enum class DecodeStatus {
+    Ok,
+    Incomplete,   // 数据在记录中途结束（写入被中断的尾部）
+    Corrupt       // 长度或校验和不合法
+};
+
+// 单条记录的上限，超出即视为损坏，避免被损坏的长度字段带偏
+constexpr std::uint32_t kMaxPayloadBytes = 1u << 20;
+constexpr std::size_t kRecordHeaderBytes = 8;
+
+std::uint32_t crc32(const void* data, std::size_t size);
+
+/**
+ * 把一条记录追加编码到 out 末尾
+ */
+void encodeRecord(std::string& out, const LogRecord& record);
+
+/**
+ * 快照文件：头部（魔数、最后序号、记录数）+ 记录 + 尾部魔数
+ * 快照经 QSaveFile 原子替换，尾部缺失即说明文件不完整
+ */
+constexpr std::size_t kSnapshotHeaderBytes = 24;
+constexpr std::size_t kSnapshotFooterBytes = 8;
+
+void encodeSnapshotHeader(std::string& out, std::uint64_t lastSeq, std::uint64_t count);
+bool decodeSnapshotHeader(const char* data, std::size_t size,
+                          std::uint64_t& lastSeq, std::uint64_t& count);
+void encodeSnapshotFooter(std::string& out);
+bool isSnapshotFooter(const char* data, std::size_t size);
+
+/**
+ * 从 data 解码一条记录；成功时 consumed 为整条记录的字节数，
+ * record 中的字符串视图指向 data 内部
+ */
+DecodeStatus decodeRecord(const char* data, std::size_t size,
+                          LogRecord& record, std::size_t& consumed);
+
+} // namespace storage
+} // namespace mvvm
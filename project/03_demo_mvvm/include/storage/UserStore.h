@@ -0,0 +1,191 @@
+#pragma once
+#include "model/UserColumnStore.h"
+#include <QFuture>
+#include <QFutureWatcher>
+#include <QObject>
+#include <QString>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+class QFile;
+
+namespace mvvm {
+namespace storage {
+
+/**
+ * 持久化级别
+ * - None:    写入操作系统缓存即确认，不主动刷盘（进程崩溃不丢，掉电可能丢）
+ * - Batched: 组提交，在 groupCommitMs 窗口内累积的记录一次写入、一次刷盘
+ * - Sync:    每组写入后立即刷盘，不等待窗口（刷盘期间到达的记录组成下一组）
+ */
+enum class Durability {
+    None,
+    Batched,
+    Sync
+};
+
+Durability durabilityFromString(const QString& text, Durability fallback = Durability::Batched);
+
+struct StoreOptions {
+    QString directory;
+    Durability durability = Durability::Batched;
+    int groupCommitMs = 5;
+    qint64 segmentBytes = 64 * 1024 * 1024;      // 日志段超过此大小时轮转
+    quint64 snapshotEveryRecords = 200000;      // 每写入这么多条记录生成一次快照，限制恢复时间
+};
+
+/**
+ * 以邮箱为键的已保存用户
+ */
+struct StoredUser {
+    std::string name;
+    std::int32_t age = 0;
+    std::uint64_t seq = 0;
+};
+
+using UserState = std::unordered_map<std::string, StoredUser>;
+
+struct RecoveryStats {
+    qint64 snapshotRecords = 0;
+    qint64 replayedRecords = 0;
+    qint64 truncatedBytes = 0;
+    int segments = 0;
+    qint64 elapsedMs = 0;
+
+    QString summary() const;
+};
+
+struct RecoveryResult {
+    bool ok = false;
+    QString error;
+    UserColumnStore users;      // 按保存顺序排列的存活用户，交给集合模型
+    RecoveryStats stats;
+
+    // 以下由 UserStore 内部接管
+    UserState state;
+    std::uint64_t lastSeq = 0;
+};
+
+/**
+ * 用户持久化存储 - 只追加、带校验和的日志 + 定期压缩快照
+ *
+ * 目录结构：
+ *   users.snapshot             最近一次快照（QSaveFile 原子替换）
+ *   users-<起始序号>.log        日志段，按序号递增
+ *
+ * open() 在线程池中通过内存映射回放快照和日志段完成恢复，
+ * 截断被中断写入的尾部记录，然后发出 recovered() 并启动写线程。
+ * save() / remove() 只把记录放入队列（可在任意线程调用），写线程负责编码、组提交和刷盘，
+ * 因此 GUI 线程从不等待磁盘。恢复完成前提交的记录会排队，恢复后按顺序写入。
+ *
+ * 快照由写线程先轮转日志段，再把当前状态复制一份交给线程池写出；
+ * 快照提交后删除它已覆盖的旧日志段，恢复时最多回放 snapshotEveryRecords 条记录。
+ */
+class UserStore : public QObject {
+    Q_OBJECT
+
+public:
+    struct Stats {
+        quint64 records = 0;
+        quint64 groups = 0;
+        quint64 syncs = 0;
+        quint64 snapshots = 0;
+        quint64 committedSeq = 0;
+    };
+
+private:
+    struct PendingRecord {
+        bool remove = false;
+        std::string name;
+        std::string email;
+        std::int32_t age = 0;
+    };
+
+    enum class State {
+        Closed,
+        Recovering,
+        Open,
+        Failed
+    };
+
+    StoreOptions options_;
+    std::atomic<State> state_;
+    QFutureWatcher<std::shared_ptr<RecoveryResult>>* recoveryWatcher_;
+
+    // 提交队列（任意线程写入，写线程取出）
+    std::mutex queueMutex_;
+    std::condition_variable queueCv_;
+    std::vector<PendingRecord> queue_;
+    bool stopping_;
+    std::thread writer_;
+
+    // 仅写线程访问
+    UserState userState_;
+    std::uint64_t lastSeq_;
+    std::unique_ptr<QFile> segment_;
+    qint64 segmentSize_;
+    quint64 recordsSinceSnapshot_;
+    QFuture<void> snapshotFuture_;
+
+    // 统计（写线程更新，任意线程读取）
+    std::atomic<quint64> records_;
+    std::atomic<quint64> groups_;
+    std::atomic<quint64> syncs_;
+    std::atomic<quint64> snapshots_;
+    std::atomic<quint64> committedSeq_;
+    std::atomic<bool> notifyPending_;
+
+public:
+    explicit UserStore(QObject* parent = nullptr);
+    ~UserStore() override;
+
+    /**
+     * 异步打开并恢复，完成后发出 recovered()
+     */
+    void open(const StoreOptions& options);
+
+    /**
+     * 停止写线程：写完并刷盘队列中的全部记录后返回（阻塞，仅在退出时调用）
+     */
+    void close();
+
+    // 提交（线程安全，非阻塞）
+    void save(const QString& name, const QString& email, int age);
+    void remove(const QString& email);
+
+    bool isOpen() const { return state_ == State::Open; }
+    const StoreOptions& options() const { return options_; }
+    Stats stats() const;
+
+    /**
+     * 恢复目录中的数据，可在任意线程调用（open() 在线程池中调用它）
+     */
+    static RecoveryResult recover(const QString& directory);
+
+signals:
+    void recovered(std::shared_ptr<RecoveryResult> result);
+    void committed(quint64 seq);
+    void failed(const QString& error);
+
+private slots:
+    void onRecoveryFinished();
+    void notifyCommitted();
+    void onWriterFailed(const QString& error);
+
+private:
+    void enqueue(PendingRecord&& record);
+    void writerLoop();
+    bool openSegment(QString* error);
+    bool rotateSegment(QString* error);
+    void startSnapshot();
+};
+
+} // namespace storage
+} // namespace mvvm
@@ -0,0 +1,119 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+namespace mvvm {
+namespace sync {
+
+/**
+ * 同步的用户字段（UTF-8）
+ */
+struct SharedUser {
+    std::string name;
+    std::string email;
+    int age = 0;
+};
+
+/**
+ * 同一主机上多个进程之间共享的用户模型（不依赖 Qt，仅 Linux）
+ *
+ * 命名共享内存区（shm_open）中保存：
+ * - 带版本号的当前状态（seqlock 保护），供新加入或落后太多的进程整体读取
+ * - 变更环形缓冲区：每次发布写入一条带序号的记录（修改了哪些字段及其值）
+ * 发布方递增共享区中的唤醒字（futex）。每个进程有一个等待线程，被唤醒后写本进程的 eventfd，
+ * 前端把 notifyFd() 交给自己的事件循环（QSocketNotifier、poll()），在自己的线程中调用 poll() 取更新。
+ * 读取直接访问映射的内存，不经过文件或套接字。
+ *
+ * 冲突按发布顺序以后者为准：poll() 按序号合并所有未读记录（包括自己发布的），各进程最终一致。
+ *
+ *   SharedUserChannel channel;
+ *   if (channel.open("demo", &error)) {
+ *       channel.publish(user);                  // 本地修改后
+ *       if (channel.poll(update)) { apply(update.user); }   // notifyFd() 可读时
+ *   }
+ *
+ * 共享区在最后一个进程退出后仍然保留（后启动的进程可读到上次的状态），remove() 删除它。
+ */
+class SharedUserChannel {
+public:
+    enum Field : std::uint32_t {
+        Name = 1,
+        Email = 2,
+        Age = 4,
+        AllFields = Name | Email | Age
+    };
+
+    /**
+     * poll() 的结果：user 为合并后的完整状态，fields 为其他进程修改过的字段
+     */
+    struct Update {
+        SharedUser user;
+        std::uint32_t fields = 0;
+        std::uint64_t version = 0;
+        bool resynced = false;    // 落后超过环形缓冲区容量，改为读取整体状态
+    };
+
+    // 单个文本字段的最大字节数，超出部分在 UTF-8 字符边界处截断
+    static constexpr std::size_t kMaxTextBytes = 512;
+    // 环形缓冲区条目数
+    static constexpr std::size_t kRingSize = 256;
+
+    SharedUserChannel();
+    ~SharedUserChannel();
+
+    SharedUserChannel(const SharedUserChannel&) = delete;
+    SharedUserChannel& operator=(const SharedUserChannel&) = delete;
+
+    /**
+     * 创建或连接名为 name 的共享区，并启动等待线程
+     * 共享区已有状态时 notifyFd() 立即可读，首次 poll() 返回该状态
+     */
+    bool open(const std::string& name, std::string* error = nullptr);
+    void close();
+    bool isOpen() const { return region_ != nullptr; }
+
+    /**
+     * 发布本地状态：只写入与已知共享状态不同的字段，没有差异时不发布
+     * 返回新版本号，未发布时返回 0
+     */
+    std::uint64_t publish(const SharedUser& user);
+
+    /**
+     * 取其他进程的修改（应在 notifyFd() 可读时调用，同时清除可读状态）
+     * 没有来自其他进程的修改时返回 false
+     */
+    bool poll(Update& update);
+
+    /**
+     * 有新的发布时可读的 eventfd；未打开时为 -1
+     */
+    int notifyFd() const { return eventFd_; }
+
+    // 当前共享状态的版本号（发布总次数）
+    std::uint64_t version() const;
+
+    static bool remove(const std::string& name);
+
+private:
+    struct Region;
+
+    Region* region_;
+    int eventFd_;
+    std::uint64_t writerId_;
+    std::uint64_t lastSeen_;    // 已合并的最后一个序号
+    bool needSnapshot_;
+    SharedUser known_;          // 本进程所知的共享状态
+
+    std::thread waiter_;
+    std::atomic<bool> stopping_;
+
+    void waitLoop(std::uint32_t seen);
+    bool readSnapshot(SharedUser& user, std::uint64_t& version) const;
+    void drainNotifications();
+};
+
+} // namespace sync
+} // namespace mvvm
@@ -0,0 +1,52 @@
+#pragma once
+#include "model/UserModel.h"
+#include "sync/SharedUserChannel.h"
+#include <QObject>
+#include <QString>
+#include <memory>
+
+class QSocketNotifier;
+
+namespace mvvm {
+namespace sync {
+
+/**
+ * 把 UserModel 接到 SharedUserChannel 上
+ *
+ * 模型的每次变化发布到共享区（只写有差异的字段）；其他进程的发布经 eventfd 唤醒本线程的事件循环，
+ * 以一次 UserModel::apply() 应用。应用远端修改引起的 dataChanged 与共享状态没有差异，不会再发布回去。
+ */
+class UserModelSync : public QObject {
+    Q_OBJECT
+
+private:
+    std::shared_ptr<UserModel> model_;
+    SharedUserChannel channel_;
+    QSocketNotifier* notifier_;
+    quint64 received_;
+
+public:
+    explicit UserModelSync(std::shared_ptr<UserModel> model, QObject* parent = nullptr);
+    ~UserModelSync() override;
+
+    /**
+     * 连接名为 name 的共享区；失败时模型照常单进程工作
+     */
+    bool open(const QString& name, QString* error = nullptr);
+    void close();
+    bool isOpen() const { return channel_.isOpen(); }
+
+    // 已应用的远端修改次数
+    quint64 receivedCount() const { return received_; }
+
+signals:
+    // 应用了其他进程的修改
+    void remoteChanged();
+
+private slots:
+    void onModelDataChanged();
+    void onNotified();
+};
+
+} // namespace sync
+} // namespace mvvm
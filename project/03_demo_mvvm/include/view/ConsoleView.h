@@ -1,24 +1,41 @@
 #pragma once
-#include "../mvvm_core.h"
-#include "viewmodel/UserViewModel.h"
+#include "lite/UserViewModel.h"
+#include "sync/SharedUserChannel.h"
+#include "view/TerminalRenderer.h"
 #include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
 namespace mvvm {
 
 /**
  * 控制台视图
  * 负责用户界面显示和用户交互
+ * 使用不依赖 Qt 的 lite 核心，无需 QApplication
+ *
+ * 每次刷新都在 TerminalRenderer 的后缓冲中重绘整屏，只有变化的格子被写到终端；
+ * ViewModel 变化（包括其他线程上的批处理修改）时立即刷新，输入提示保持在原位。
+ *
+ * 设置了共享通道时，本地修改发布给其他前端进程；终端上等待输入期间同时等待通道的 eventfd，
+ * 其他进程的修改到达后立即应用并刷新。
  */
-class ConsoleView : public IObserver {
+class ConsoleView : public lite::IObserver {
 private:
-    std::shared_ptr<UserViewModel> viewModel_;
-    std::shared_ptr<SaveUserCommand> saveCommand_;
-    std::shared_ptr<ResetUserCommand> resetCommand_;
+    std::shared_ptr<lite::UserViewModel> viewModel_;
+    std::shared_ptr<lite::SaveUserCommand> saveCommand_;
+    std::shared_ptr<lite::ResetUserCommand> resetCommand_;
+
+    TerminalRenderer renderer_;
+    std::mutex renderMutex_;
+    std::vector<std::string> messageLines_;
+    TerminalRenderer::Style messageStyle_;
+    std::string prompt_;
+    std::shared_ptr<sync::SharedUserChannel> channel_;
 
 public:
-    explicit ConsoleView(std::shared_ptr<UserViewModel> viewModel);
-    ~ConsoleView() = default;
+    explicit ConsoleView(std::shared_ptr<lite::UserViewModel> viewModel);
+    ~ConsoleView() override;
 
     // IObserver 接口实现
     void update() override;
@@ -27,13 +44,18 @@ public:
     void show();
     void run();
 
+    // 与其他进程同步当前用户（可选）
+    void setSharedChannel(std::shared_ptr<sync::SharedUserChannel> channel);
+
 private:
+    void render();
+    void displayHeader();
     void displayMenu();
     void displayUserInfo();
-    void handleUserInput();
-    void clearScreen();
+    void displayMessage();
+    void setMessage(const std::string& text, TerminalRenderer::Style style);
     void pauseForUser();
-    
+
     // 输入处理方法
     void handleNameInput();
     void handleEmailInput();
@@ -41,8 +63,11 @@ private:
     void handleSaveCommand();
     void handleResetCommand();
     void handleDisplayInfo();
-    
+
     std::string getInputLine(const std::string& prompt);
+    void waitForInput();
+    void applyRemoteChanges();
+    void publishUser();
 };
 
 } // namespace mvvm
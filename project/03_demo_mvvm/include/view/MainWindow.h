@@ -1,6 +1,10 @@
 #pragma once
 #include "../mvvm_core.h"
 #include "viewmodel/UserViewModel.h"
+#include "viewmodel/UserListViewModel.h"
+#include "view/UserTableView.h"
+#include "view/WidgetProperties.h"
+#include "common/LogView.h"
 #include <QMainWindow>
 #include <QVBoxLayout>
 #include <QHBoxLayout>
@@ -9,7 +13,6 @@
 #include <QSpinBox>
 #include <QLabel>
 #include <QPushButton>
-#include <QTextEdit>
 #include <QGroupBox>
 #include <QStatusBar>
 #include <memory>
@@ -25,6 +28,7 @@ class MainWindow : public QMainWindow {
 
 private:
     std::shared_ptr<UserViewModel> viewModel_;
+    std::shared_ptr<UserListViewModel> listViewModel_;
 
     // UI 控件
     QLineEdit* nameEdit_;
@@ -33,23 +37,42 @@ private:
     QLabel* statusLabel_;
     QPushButton* saveButton_;
     QPushButton* resetButton_;
+    QPushButton* undoButton_;
+    QPushButton* redoButton_;
     QPushButton* showInfoButton_;
-    QTextEdit* infoDisplay_;
+    common::LogView* infoDisplay_;
+    QLineEdit* filterEdit_;
+    UserTableView* userTable_;
+    QLabel* userCountLabel_;
+    QPushButton* importButton_;
+    QPushButton* exportButton_;
+    QLabel* reportLabel_;
+
+    // 表单字段与 ViewModel 的双向绑定（逐键输入经限流合并）
+    BindingSet bindings_;
+    RateLimiter* filterBinding_;
 
 public:
-    explicit MainWindow(std::shared_ptr<UserViewModel> viewModel, QWidget* parent = nullptr);
+    explicit MainWindow(std::shared_ptr<UserViewModel> viewModel,
+                        std::shared_ptr<UserListViewModel> listViewModel = nullptr,
+                        QWidget* parent = nullptr);
     ~MainWindow() = default;
 
 private slots:
-    void onNameChanged();
-    void onEmailChanged();
-    void onAgeChanged();
     void onSaveClicked();
     void onResetClicked();
+    void onUndoClicked();
+    void onRedoClicked();
     void onShowInfoClicked();
-    void onViewModelPropertyChanged(const QString& propertyName);
+    void onStatusMessageChanged();
     void onUserSaved();
     void onUserReset();
+    void onFilterChanged();
+    void onUserCountChanged();
+    void onImportClicked();
+    void onExportClicked();
+    void onListBusyChanged();
+    void onReportMessageChanged();
 
 private:
     void setupUI();
@@ -0,0 +1,120 @@
+#pragma once
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace mvvm {
+
+/**
+ * 差量终端渲染器
+ *
+ * 维护前后两帧字符网格：视图每帧在后缓冲中重新绘制全部内容，present() 与上一帧逐格比较，
+ * 只为变化的格子生成 ANSI 光标移动、样式和字符，整帧拼成一个字符串后一次写出。
+ * 不调用 system("clear")，不逐行刷新，慢速 SSH 链路上也不会闪烁。
+ *
+ * 字符按 UTF-8 解码，中日韩文字和常见 emoji 占两列；控制字符显示为 '?'，
+ * 用户输入中的转义序列不会被终端解释。
+ */
+class TerminalRenderer {
+public:
+    enum class Style : std::uint8_t {
+        Normal,
+        Bold,
+        Dim,
+        Good,    // 绿色
+        Bad,     // 红色
+        Accent   // 青色
+    };
+
+    struct Stats {
+        std::uint64_t frames = 0;
+        std::uint64_t cellsWritten = 0;
+        std::uint64_t bytesWritten = 0;
+    };
+
+private:
+    struct Cell {
+        char32_t ch = U' ';
+        Style style = Style::Normal;
+
+        bool operator==(const Cell& other) const { return ch == other.ch && style == other.style; }
+        bool operator!=(const Cell& other) const { return !(*this == other); }
+    };
+
+    // 宽字符右半格
+    static constexpr char32_t kContinuation = 0xFFFFFFFEu;
+    // 前缓冲中的"未知"内容，与任何格子都不相等，强制重绘
+    static constexpr char32_t kUnknown = 0xFFFFFFFFu;
+
+    std::FILE* out_;
+    int cols_;
+    int rows_;
+    std::vector<Cell> back_;
+    std::vector<Cell> front_;
+    bool fullRedraw_;
+    int cursorRow_;
+    int cursorCol_;
+    std::string frame_;
+    Stats stats_;
+
+public:
+    /**
+     * cols / rows 为 0 时查询终端大小（查询失败时为 80x24）
+     */
+    explicit TerminalRenderer(std::FILE* out = stdout, int cols = 0, int rows = 0);
+    ~TerminalRenderer();
+
+    TerminalRenderer(const TerminalRenderer&) = delete;
+    TerminalRenderer& operator=(const TerminalRenderer&) = delete;
+
+    int cols() const { return cols_; }
+    int rows() const { return rows_; }
+    const Stats& stats() const { return stats_; }
+
+    void resize(int cols, int rows);
+
+    // 重新查询终端大小，变化时调整缓冲并整屏重绘
+    void updateSize();
+
+    // 后缓冲清为空白，开始绘制新的一帧
+    void clear();
+
+    /**
+     * 在 (row, col) 写入一行 UTF-8 文本，超出屏幕的部分被裁掉，返回写入后的列
+     */
+    int putText(int row, int col, std::string_view utf8, Style style = Style::Normal);
+
+    // present() 后光标停留的位置（例如输入提示之后）
+    void setCursor(int row, int col);
+
+    /**
+     * 把后缓冲与上一帧的差异写到终端（一次写出）
+     */
+    void present();
+
+    // 终端内容已被外部改动（例如输入回显），下一帧重绘整行 / 整屏
+    void invalidateRow(int row);
+    void invalidate();
+
+    /**
+     * 结束渲染：恢复样式，把光标移到最后一行之后
+     */
+    void finish();
+
+    // 字符占用的列数（0、1 或 2）
+    static int charWidth(char32_t ch);
+
+    // UTF-8 文本的显示宽度
+    static int textWidth(std::string_view utf8);
+
+private:
+    Cell& at(int row, int col) { return back_[static_cast<std::size_t>(row) * cols_ + col]; }
+    void breakWideChar(int row, int col);
+    void appendStyle(Style style);
+    void appendChar(char32_t ch);
+    void write(const std::string& data);
+};
+
+} // namespace mvvm
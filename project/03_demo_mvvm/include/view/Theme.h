@@ -0,0 +1,61 @@
+#pragma once
+#include <QString>
+#include <QtGlobal>
+
+class QApplication;
+class QWidget;
+
+namespace mvvm {
+
+/**
+ * 应用主题
+ *
+ * 取代全局样式表：外观由 QProxyStyle（基于 Fusion）直接绘制，颜色在 apply() 时一次性解析为调色板。
+ * Qt 不必为每个控件解析、匹配样式表规则，状态切换也不会触发重新 polish：
+ * setStatus() 只比较动态属性并换上预先生成的调色板。
+ *
+ *   Theme::apply(app);
+ *   Theme::setStatus(statusLabel_, Theme::Status::Valid);
+ */
+class Theme {
+public:
+    enum class Status {
+        Neutral,    // 蓝色
+        Valid,      // 绿色
+        Invalid     // 红色
+    };
+
+    /**
+     * 主题开销统计
+     */
+    struct Stats {
+        qint64 applyNs = 0;           // apply() 的耗时（启动开销）
+        quint64 statusChanges = 0;    // 实际切换了状态的次数
+        quint64 statusUnchanged = 0;  // 状态未变、直接返回的次数
+        qint64 statusTotalNs = 0;     // 全部 setStatus() 的累计耗时
+
+        QString summary() const;
+    };
+
+    // 动态属性名，值为 Status 的整数值
+    static constexpr const char* kStatusProperty = "themeStatus";
+
+    /**
+     * 安装主题样式和调色板，需在创建窗口之前调用
+     */
+    static void apply(QApplication& app);
+
+    /**
+     * 初始化状态标签：加粗，设为 Neutral
+     */
+    static void styleStatusLabel(QWidget* label);
+
+    /**
+     * 切换状态颜色：状态未变时直接返回，否则换上预先生成的调色板（不重新 polish）
+     */
+    static void setStatus(QWidget* widget, Status status);
+
+    static const Stats& stats();
+};
+
+} // namespace mvvm
@@ -0,0 +1,19 @@
+#pragma once
+#include <QTableView>
+
+namespace mvvm {
+
+/**
+ * 面向大数据量的用户表格视图
+ * 固定行高、关闭按内容调整列宽，使 QTableView 只布局和绘制可见行，
+ * 排序请求交给模型在后台完成
+ */
+class UserTableView : public QTableView {
+    Q_OBJECT
+
+public:
+    explicit UserTableView(QWidget* parent = nullptr);
+    ~UserTableView() = default;
+};
+
+} // namespace mvvm
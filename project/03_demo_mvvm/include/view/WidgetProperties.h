@@ -0,0 +1,15 @@
+#pragma once
+#include "../mvvm_core.h"
+#include <QLineEdit>
+#include <QSpinBox>
+
+namespace mvvm {
+
+/**
+ * 常用控件的可绑定属性（编译期访问器，供 Binding 使用）
+ */
+using LineEditText = Property<&QLineEdit::text, &QLineEdit::setText, &QLineEdit::textChanged>;
+using SpinBoxValue = Property<&QSpinBox::value, &QSpinBox::setValue,
+                              static_cast<void (QSpinBox::*)(int)>(&QSpinBox::valueChanged)>;
+
+} // namespace mvvm
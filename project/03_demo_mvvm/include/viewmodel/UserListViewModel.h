@@ -0,0 +1,71 @@
+#pragma once
+#include "../mvvm_core.h"
+#include "io/UserImporter.h"
+#include "model/UserCollectionModel.h"
+#include <QObject>
+#include <QString>
+#include <memory>
+
+namespace mvvm {
+
+/**
+ * 用户列表视图模型
+ * 管理用户集合的过滤以及 CSV/JSON 批量导入导出。
+ * 导入导出是异步命令：在线程池中执行，完成后回到 GUI 线程更新集合和报告信息，
+ * 运行期间命令不可执行，可通过 cancel() 取消。
+ */
+class UserListViewModel : public ViewModelBase {
+    Q_OBJECT
+    Q_PROPERTY(bool busy READ isBusy NOTIFY busyChanged)
+    Q_PROPERTY(QString reportMessage READ reportMessage NOTIFY reportMessageChanged)
+    Q_PROPERTY(UserCollectionModel* users READ users CONSTANT)
+    Q_PROPERTY(AsyncCommand* importCommand READ importCommand CONSTANT)
+    Q_PROPERTY(AsyncCommand* exportCommand READ exportCommand CONSTANT)
+
+private:
+    std::shared_ptr<UserCollectionModel> users_;
+
+    // UI 绑定属性
+    bool busy_;
+    QString reportMessage_;
+
+    // 命令对象（参数为文件路径），作为成员内联存放
+    AsyncCommand importCommand_;
+    AsyncCommand exportCommand_;
+
+public:
+    explicit UserListViewModel(std::shared_ptr<UserCollectionModel> users, QObject* parent = nullptr);
+    ~UserListViewModel() = default;
+
+    // 属性访问器
+    bool isBusy() const { return busy_; }
+    const QString& reportMessage() const { return reportMessage_; }
+    UserCollectionModel* users() const { return users_.get(); }
+
+    // 命令访问器
+    AsyncCommand* importCommand() { return &importCommand_; }
+    AsyncCommand* exportCommand() { return &exportCommand_; }
+
+    // 可从 QML 调用的方法
+    Q_INVOKABLE void importUsers(const QString& path);
+    Q_INVOKABLE void exportUsers(const QString& path);
+    Q_INVOKABLE void cancel();
+    Q_INVOKABLE void setFilterText(const QString& text);
+
+signals:
+    void busyChanged();
+    void reportMessageChanged();
+    void importFinished(bool ok);
+    void exportFinished(bool ok);
+
+private slots:
+    void updateBusy();
+
+private:
+    bool isIdle() const { return users_ && !busy_; }
+    void setReportMessage(const QString& message);
+    AsyncJob makeImportJob(const QString& path);
+    AsyncJob makeExportJob(const QString& path);
+};
+
+} // namespace mvvm
@@ -1,12 +1,32 @@
 #pragma once
 #include "../mvvm_core.h"
+#include "core/SnapshotPublisher.h"
+#include "core/UndoHistory.h"
 #include "model/UserModel.h"
+#include "model/UserCollectionModel.h"
+#include "storage/UserStore.h"
 #include <QObject>
 #include <QString>
 #include <memory>
+#include <string>
+#include <unordered_map>
 
 namespace mvvm {
 
+/**
+ * 用户视图模型的一个不可变状态版本
+ * QString 隐式共享，生成快照只增加引用计数，不复制字符数据
+ */
+struct UserViewState {
+    QString displayName;
+    QString displayEmail;
+    QString displayAge;
+    QString statusMessage;
+    int age = 0;
+    bool canSave = false;
+    quint64 version = 0;
+};
+
 /**
  * 用户视图模型 - 使用 Qt 的属性系统和信号槽
  * 作为 Model 和 View 之间的桥梁
@@ -16,24 +36,43 @@ class UserViewModel : public ViewModelBase {
     Q_PROPERTY(QString displayName READ displayName NOTIFY displayNameChanged)
     Q_PROPERTY(QString displayEmail READ displayEmail NOTIFY displayEmailChanged)
     Q_PROPERTY(QString displayAge READ displayAge NOTIFY displayAgeChanged)
+    Q_PROPERTY(int age READ age WRITE setAge NOTIFY ageChanged)
     Q_PROPERTY(QString statusMessage READ statusMessage NOTIFY statusMessageChanged)
     Q_PROPERTY(bool canSave READ canSave NOTIFY canSaveChanged)
     Q_PROPERTY(Command* saveCommand READ saveCommand CONSTANT)
     Q_PROPERTY(Command* resetCommand READ resetCommand CONSTANT)
+    Q_PROPERTY(Command* undoCommand READ undoCommand CONSTANT)
+    Q_PROPERTY(Command* redoCommand READ redoCommand CONSTANT)
 
 private:
     std::shared_ptr<UserModel> userModel_;
+    std::shared_ptr<UserCollectionModel> userCollection_;
+    std::shared_ptr<storage::UserStore> userStore_;
+
+    // 已保存用户：邮箱 → 集合中的行，保存同一邮箱时更新而不是重复追加
+    std::unordered_map<std::string, RowId> savedRows_;
     
     // UI 绑定属性
     QString displayName_;
     QString displayEmail_;
     QString displayAge_;
+    int age_;
     QString statusMessage_;
     bool canSave_;
 
-    // 命令对象
-    DelegateCommand* saveCommand_;
-    DelegateCommand* resetCommand_;
+    // 以上属性的快照，供任意线程上的多个视图一致地读取
+    SnapshotPublisher<UserViewState> state_;
+
+    // 命令对象：作为成员内联存放；保存在线程池中提交到存储，按顺序排队执行
+    AsyncCommand saveCommand_;
+    DelegateCommand resetCommand_;
+
+    // 编辑历史：模型的每个版本，同一字段的连续输入合并为一步
+    UndoHistory<UserModel::State> history_;
+    int editKey_;       // 正在进行的编辑所属的字段（合并键）
+    bool restoring_;    // 撤销 / 重做恢复模型期间不记录
+    DelegateCommand undoCommand_;
+    DelegateCommand redoCommand_;
 
 public:
     explicit UserViewModel(std::shared_ptr<UserModel> model, QObject* parent = nullptr);
@@ -43,36 +82,80 @@ public:
     const QString& displayName() const { return displayName_; }
     const QString& displayEmail() const { return displayEmail_; }
     const QString& displayAge() const { return displayAge_; }
+    int age() const { return age_; }
     const QString& statusMessage() const { return statusMessage_; }
     bool canSave() const { return canSave_; }
 
+    /**
+     * 当前状态快照（任意线程可调用，不加锁）
+     * 返回的守卫存活期间快照保持不变，应尽快释放，不要跨事件循环持有
+     */
+    SnapshotPublisher<UserViewState>::ReadGuard snapshot() const { return state_.read(); }
+
+    // 已保存用户集合（可选）
+    void setUserCollection(std::shared_ptr<UserCollectionModel> collection);
+    UserCollectionModel* userCollection() const { return userCollection_.get(); }
+
+    // 持久化存储（可选）：恢复出的用户载入集合，保存时写入日志
+    void setUserStore(std::shared_ptr<storage::UserStore> store);
+
     // 命令访问器
-    Command* saveCommand() const { return saveCommand_; }
-    Command* resetCommand() const { return resetCommand_; }
+    Command* saveCommand() { return &saveCommand_; }
+    Command* resetCommand() { return &resetCommand_; }
+    Command* undoCommand() { return &undoCommand_; }
+    Command* redoCommand() { return &redoCommand_; }
+
+    // 编辑历史
+    bool canUndo() const { return history_.canUndo(); }
+    bool canRedo() const { return history_.canRedo(); }
+    const UndoHistory<UserModel::State>& history() const { return history_; }
+    void setHistoryMemoryBudget(std::size_t bytes);
 
     // 可从 QML 调用的方法
     Q_INVOKABLE void updateName(const QString& name);
     Q_INVOKABLE void updateEmail(const QString& email);
     Q_INVOKABLE void updateAge(const QString& ageStr);
+    Q_INVOKABLE void setAge(int age);
     Q_INVOKABLE QString getUserDisplayInfo() const;
+    Q_INVOKABLE void undo();
+    Q_INVOKABLE void redo();
 
 signals:
     void displayNameChanged();
     void displayEmailChanged();
     void displayAgeChanged();
+    void ageChanged();
     void statusMessageChanged();
     void canSaveChanged();
     void userSaved();
     void userReset();
+    // 发布了新的状态快照（每次模型变化最多一次）
+    void stateChanged();
+    // 可撤销 / 可重做的步数变化
+    void historyChanged();
+
+public:
+    // 可双向绑定的属性（编译期访问器，供 Binding 使用）；引用了上面的信号，必须声明在信号之后
+    using NameProperty = Property<&UserViewModel::displayName, &UserViewModel::updateName,
+                                  &UserViewModel::displayNameChanged>;
+    using EmailProperty = Property<&UserViewModel::displayEmail, &UserViewModel::updateEmail,
+                                   &UserViewModel::displayEmailChanged>;
+    using AgeProperty = Property<&UserViewModel::age, &UserViewModel::setAge, &UserViewModel::ageChanged>;
 
 private slots:
     void onModelDataChanged();
+    void onStoreRecovered(std::shared_ptr<storage::RecoveryResult> result);
 
 private:
     void updateDisplayProperties();
-    void updateStatusMessage();
-    void saveUser();
+    bool updateStatusMessage();
+    void publishState();
+    static QString displayAgeText(int age);
+    AsyncJob makeSaveJob();
+    void applySavedUser(const QString& name, const QString& email, int age);
     void resetUser();
+    void restoreState(const UserModel::State* state);
+    void notifyHistoryChanged();
     int parseAge(const QString& ageStr) const;
 };
 
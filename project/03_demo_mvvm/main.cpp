@@ -1,13 +1,21 @@
 #include <QApplication>
-#include <QStyleFactory>
 #include <QDir>
+#include <QStandardPaths>
 #include <QDebug>
 #include <memory>
 
 #include "mvvm_core.h"
+#include "core/Trace.h"
+#include "common/MetricsExporter.h"
+#include "common/QtStallWatchdog.h"
 #include "model/UserModel.h"
+#include "model/UserCollectionModel.h"
 #include "viewmodel/UserViewModel.h"
+#include "viewmodel/UserListViewModel.h"
+#include "storage/UserStore.h"
+#include "sync/UserModelSync.h"
 #include "view/MainWindow.h"
+#include "view/Theme.h"
 
 /**
  * Qt MVVM 框架演示程序
@@ -56,53 +64,23 @@ int main(int argc, char *argv[]) {
     app.setApplicationVersion("1.0");
     app.setOrganizationName("MyLargeProject");
     
-    // 设置应用程序样式
-    app.setStyle(QStyleFactory::create("Fusion"));
+    // 设置 MVVM_TRACE_FILE 时记录信号/属性通知追踪，退出时写出 Chrome trace JSON
+    trace::startFromEnvironment();
     
-    // 设置应用程序图标和样式表
-    app.setStyleSheet(
-        "QMainWindow {"
-        "    background-color: #f0f0f0;"
-        "}"
-        "QGroupBox {"
-        "    font-weight: bold;"
-        "    border: 2px solid #cccccc;"
-        "    border-radius: 5px;"
-        "    margin-top: 10px;"
-        "    padding-top: 10px;"
-        "}"
-        "QGroupBox::title {"
-        "    subcontrol-origin: margin;"
-        "    left: 10px;"
-        "    padding: 0 5px 0 5px;"
-        "}"
-        "QPushButton {"
-        "    background-color: #0078d4;"
-        "    color: white;"
-        "    border: none;"
-        "    padding: 8px 16px;"
-        "    border-radius: 4px;"
-        "    font-weight: bold;"
-        "}"
-        "QPushButton:hover {"
-        "    background-color: #106ebe;"
-        "}"
-        "QPushButton:pressed {"
-        "    background-color: #005a9e;"
-        "}"
-        "QPushButton:disabled {"
-        "    background-color: #cccccc;"
-        "    color: #666666;"
-        "}"
-        "QLineEdit, QSpinBox {"
-        "    padding: 5px;"
-        "    border: 1px solid #cccccc;"
-        "    border-radius: 3px;"
-        "}"
-        "QLineEdit:focus, QSpinBox:focus {"
-        "    border: 2px solid #0078d4;"
-        "}"
-    );
+    // 设置 METRICS_SOCKET / METRICS_FILE 时导出运行指标（通知数、保存耗时等）
+    common::MetricsExporter metricsExporter;
+    metricsExporter.startFromEnvironment();
+    
+    // GUI 线程卡顿超过 GUI_STALL_THRESHOLD_MS（默认 500，0 关闭）时记录时长和调用栈
+    common::StallWatchdog stallWatchdog(common::StallWatchdog::Options::fromEnvironment());
+    stallWatchdog.setReporter([](const common::StallWatchdog::StallEvent& event) {
+        qWarning().noquote() << QString::fromStdString(event.toString());
+    });
+    common::qt::startStallWatchdog(stallWatchdog, &app);
+    
+    // 应用主题：样式和调色板一次性解析，不使用全局样式表
+    Theme::apply(app);
+    qDebug().noquote() << Theme::stats().summary();
     
     try {
         qDebug() << "正在初始化 Qt MVVM 演示程序...";
@@ -115,8 +93,35 @@ int main(int argc, char *argv[]) {
         auto userViewModel = std::make_shared<UserViewModel>(userModel);
         qDebug() << "✅ UserViewModel 已创建";
         
+        // 多进程同步 - 设置 MVVM_SYNC_NAME 时与同名的其他前端进程（界面或控制台）共享当前用户
+        sync::UserModelSync modelSync(userModel);
+        const QString syncName = QString::fromLocal8Bit(qgetenv("MVVM_SYNC_NAME"));
+        if (!syncName.isEmpty()) {
+            QString error;
+            if (modelSync.open(syncName, &error)) {
+                qDebug() << "✅ 共享内存同步已连接:" << syncName;
+            } else {
+                qWarning() << "共享内存同步不可用:" << error;
+            }
+        }
+        
+        // 已保存用户集合 - 列式存储的表格模型
+        auto userCollection = std::make_shared<UserCollectionModel>();
+        userViewModel->setUserCollection(userCollection);
+        auto userListViewModel = std::make_shared<UserListViewModel>(userCollection);
+        qDebug() << "✅ UserCollectionModel / UserListViewModel 已创建";
+        
+        // 持久化存储 - 后台恢复后载入用户集合，持久化级别可由 MVVM_DURABILITY 指定
+        storage::StoreOptions storeOptions;
+        storeOptions.directory = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/users";
+        storeOptions.durability = storage::durabilityFromString(QString::fromLocal8Bit(qgetenv("MVVM_DURABILITY")));
+        auto userStore = std::make_shared<storage::UserStore>();
+        userViewModel->setUserStore(userStore);
+        userStore->open(storeOptions);
+        qDebug() << "✅ UserStore 已创建:" << storeOptions.directory;
+        
         // 3. 创建 View - 用户界面层
-        auto mainWindow = std::make_shared<MainWindow>(userViewModel);
+        auto mainWindow = std::make_shared<MainWindow>(userViewModel, userListViewModel);
         qDebug() << "✅ MainWindow 已创建";
         
         qDebug() << "🚀 Qt MVVM 架构初始化完成！";
@@ -126,7 +131,9 @@ int main(int argc, char *argv[]) {
         mainWindow->show();
         
         // 启动应用程序事件循环
-        return app.exec();
+        const int result = app.exec();
+        qDebug().noquote() << Theme::stats().summary();
+        return result;
         
     } catch (const std::exception& e) {
         qCritical() << "❌ 程序运行出错:" << e.what();
@@ -0,0 +1,111 @@
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDebug>
+#include <QFile>
+#include <QJsonDocument>
+#include <QTextStream>
+#include <cstdio>
+
+#include "core/Trace.h"
+#include "replay/ReplayDriver.h"
+
+/**
+ * MVVM 回放与吞吐基准程序
+ *
+ * 不创建窗口，把脚本或随机生成的操作序列全速回放到 UserModel / UserViewModel，
+ * 输出吞吐、各类操作的耗时分布和信号次数（JSON 基线）。
+ *
+ *   demo_mvvm_replay --ops 1000000 --seed 1 --output baseline.json
+ *   demo_mvvm_replay --script edits.txt --repeat 100
+ *
+ * 相同的种子和参数每次生成相同的操作序列，信号次数和最终状态应当完全一致；
+ * 修改 MVVM 核心后用同样的参数重新运行，与旧基线比较。
+ */
+
+using namespace mvvm;
+
+namespace {
+
+QtMessageHandler previousHandler = nullptr;
+
+// 保存路径上的 qDebug 每次都会输出，回放时默认丢弃（格式化的开销仍然计入）
+void quietMessageHandler(QtMsgType type, const QMessageLogContext& context, const QString& message) {
+    if (type != QtDebugMsg && previousHandler) {
+        previousHandler(type, context, message);
+    }
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    QCoreApplication app(argc, argv);
+    app.setApplicationName("Qt MVVM Replay");
+    app.setApplicationVersion("1.0");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Headless replay and throughput benchmark for the MVVM pipeline");
+    parser.addHelpOption();
+    const QCommandLineOption scriptOption("script", "Replay operations from <file>.", "file");
+    const QCommandLineOption opsOption("ops", "Generate <count> operations (default 1000000).", "count", "1000000");
+    const QCommandLineOption seedOption("seed", "Seed for generated operations (default 1).", "seed", "1");
+    const QCommandLineOption repeatOption("repeat", "Replay the sequence <n> times (default 1).", "n", "1");
+    const QCommandLineOption warmupOption("warmup", "Untimed operations before measuring (default 10000).",
+                                          "count", "10000");
+    const QCommandLineOption outputOption("output", "Write the JSON report to <file> instead of stdout.", "file");
+    const QCommandLineOption verboseOption("verbose", "Keep qDebug output from the view model.");
+    parser.addOptions({scriptOption, opsOption, seedOption, repeatOption, warmupOption, outputOption, verboseOption});
+    parser.process(app);
+
+    if (!parser.isSet(verboseOption)) {
+        previousHandler = qInstallMessageHandler(quietMessageHandler);
+    }
+
+    // 追踪会明显拖慢回放，只用于查看时间轴，不要与基线比较
+    trace::startFromEnvironment();
+
+    replay::Script script;
+    if (parser.isSet(scriptOption)) {
+        QString error;
+        if (!replay::Script::load(parser.value(scriptOption), script, error)) {
+            qCritical().noquote() << error;
+            return 2;
+        }
+    } else {
+        bool countOk = false;
+        bool seedOk = false;
+        const qulonglong count = parser.value(opsOption).toULongLong(&countOk);
+        const qulonglong seed = parser.value(seedOption).toULongLong(&seedOk);
+        if (!countOk || !seedOk || count == 0) {
+            qCritical() << "--ops 和 --seed 必须是正整数";
+            return 2;
+        }
+        script = replay::Script::generate(count, seed);
+    }
+
+    replay::ReplayOptions options;
+    options.repeat = qMax(1, parser.value(repeatOption).toInt());
+    options.warmupOps = parser.value(warmupOption).toULongLong();
+
+    const replay::ReplayResult result = replay::ReplayDriver::run(script, options);
+    const QByteArray report =
+        QJsonDocument(replay::ReplayDriver::toJson(script, options, result)).toJson(QJsonDocument::Indented);
+
+    if (parser.isSet(outputOption)) {
+        QFile file(parser.value(outputOption));
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate) || file.write(report) != report.size()) {
+            qCritical().noquote() << "无法写入报告:" << file.errorString();
+            return 1;
+        }
+    } else {
+        std::fwrite(report.constData(), 1, static_cast<size_t>(report.size()), stdout);
+    }
+
+    // 摘要输出到 stderr，不影响重定向的 JSON
+    QTextStream err(stderr);
+    err << QString("%1 ops in %2 ms, %3 ops/s, %4 notifications\n")
+               .arg(result.ops)
+               .arg(result.elapsedNs / 1000000)
+               .arg(result.opsPerSecond, 0, 'f', 0)
+               .arg(result.totalNotifications);
+    return 0;
+}
@@ -0,0 +1,288 @@
+#include "core/Trace.h"
+
+#ifdef MVVM_ENABLE_TRACING
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QFile>
+#include <QThread>
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace mvvm {
+namespace trace {
+
+namespace detail {
+
+std::atomic<bool> enabled{false};
+
+} // namespace detail
+
+namespace {
+
+// 持续时间为负表示瞬时事件
+struct Event {
+    const char* category;
+    const char* name;
+    QString detail;
+    std::int64_t startNs;
+    std::int64_t durationNs;
+    int depth;
+};
+
+/**
+ * 每个线程一个缓冲区：记录时只锁自己的互斥量，只有导出和清空时才会与其他线程竞争
+ * 由注册表共同持有，线程退出后事件仍然保留
+ */
+struct ThreadBuffer {
+    std::mutex mutex;
+    int tid = 0;
+    QString threadName;
+    int depth = 0;
+    std::vector<Event> events;
+    std::uint64_t dropped = 0;
+};
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    int nextTid = 1;
+    std::atomic<std::int64_t> originNs{0};
+    std::atomic<int> maxEventsPerThread{1 << 20};
+    QString outputPath;
+};
+
+Registry& registry() {
+    static Registry instance;
+    return instance;
+}
+
+std::int64_t clockNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+std::int64_t nowNs() {
+    return clockNs() - registry().originNs.load(std::memory_order_relaxed);
+}
+
+ThreadBuffer& threadBuffer() {
+    thread_local std::shared_ptr<ThreadBuffer> buffer = [] {
+        auto created = std::make_shared<ThreadBuffer>();
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        created->tid = reg.nextTid++;
+        QThread* thread = QThread::currentThread();
+        QCoreApplication* app = QCoreApplication::instance();
+        if (app && thread == app->thread()) {
+            created->threadName = QStringLiteral("main");
+        } else if (thread && !thread->objectName().isEmpty()) {
+            created->threadName = QStringLiteral("%1 #%2").arg(thread->objectName()).arg(created->tid);
+        } else {
+            created->threadName = QStringLiteral("thread #%1").arg(created->tid);
+        }
+        reg.buffers.push_back(created);
+        return created;
+    }();
+    return *buffer;
+}
+
+void record(ThreadBuffer& buffer, Event&& event) {
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+    if (buffer.events.size() >= static_cast<size_t>(registry().maxEventsPerThread.load(std::memory_order_relaxed))) {
+        ++buffer.dropped;
+        return;
+    }
+    buffer.events.push_back(std::move(event));
+}
+
+std::vector<std::shared_ptr<ThreadBuffer>> allBuffers() {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    return reg.buffers;
+}
+
+void appendJsonString(QByteArray& out, const char* text) {
+    out += '"';
+    for (const char* p = text; *p; ++p) {
+        const unsigned char c = static_cast<unsigned char>(*p);
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += static_cast<char>(c);
+        } else if (c < 0x20) {
+            static const char hex[] = "0123456789abcdef";
+            out += "\\u00";
+            out += hex[c >> 4];
+            out += hex[c & 0xF];
+        } else {
+            out += static_cast<char>(c);
+        }
+    }
+    out += '"';
+}
+
+void appendTimeUs(QByteArray& out, std::int64_t ns) {
+    // 微秒，保留纳秒精度
+    out += QByteArray::number(static_cast<double>(ns) / 1000.0, 'f', 3);
+}
+
+void writeAtExit() {
+    const QString path = registry().outputPath;
+    stop();
+    QString error;
+    if (!writeChromeTrace(path, &error)) {
+        qWarning().noquote() << "追踪写入失败:" << error;
+    }
+}
+
+} // namespace
+
+namespace detail {
+
+void begin(SpanState& state) {
+    ++threadBuffer().depth;
+    state.startNs = nowNs();
+}
+
+void end(const SpanState& state, const QString& detail) {
+    const std::int64_t endNs = nowNs();
+    ThreadBuffer& buffer = threadBuffer();
+    const int depth = --buffer.depth;
+    record(buffer, Event{state.category, state.name, detail, state.startNs, endNs - state.startNs, depth});
+}
+
+} // namespace detail
+
+void instant(const char* category, const char* name, const QString& detail) {
+    if (!isRecording()) {
+        return;
+    }
+    ThreadBuffer& buffer = threadBuffer();
+    record(buffer, Event{category, name, detail, nowNs(), -1, buffer.depth});
+}
+
+void start(int maxEventsPerThread) {
+    Registry& reg = registry();
+    detail::enabled.store(false, std::memory_order_relaxed);
+    for (const auto& buffer : allBuffers()) {
+        std::lock_guard<std::mutex> lock(buffer->mutex);
+        buffer->events.clear();
+        buffer->dropped = 0;
+    }
+    reg.maxEventsPerThread.store(std::max(1, maxEventsPerThread), std::memory_order_relaxed);
+    reg.originNs.store(clockNs(), std::memory_order_relaxed);
+    detail::enabled.store(true, std::memory_order_release);
+}
+
+void stop() {
+    detail::enabled.store(false, std::memory_order_release);
+}
+
+std::uint64_t eventCount() {
+    std::uint64_t count = 0;
+    for (const auto& buffer : allBuffers()) {
+        std::lock_guard<std::mutex> lock(buffer->mutex);
+        count += buffer->events.size();
+    }
+    return count;
+}
+
+std::uint64_t droppedCount() {
+    std::uint64_t count = 0;
+    for (const auto& buffer : allBuffers()) {
+        std::lock_guard<std::mutex> lock(buffer->mutex);
+        count += buffer->dropped;
+    }
+    return count;
+}
+
+bool writeChromeTrace(const QString& path, QString* error) {
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        if (error) {
+            *error = file.errorString();
+        }
+        return false;
+    }
+
+    const QByteArray pid = QByteArray::number(QCoreApplication::applicationPid());
+    constexpr int kFlushBytes = 1 << 20;
+    QByteArray out;
+    out.reserve(kFlushBytes + 4096);
+    out += "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    bool first = true;
+    std::uint64_t dropped = 0;
+
+    const auto separator = [&out, &first]() {
+        out += first ? "\n" : ",\n";
+        first = false;
+    };
+
+    for (const auto& buffer : allBuffers()) {
+        std::lock_guard<std::mutex> lock(buffer->mutex);
+        const QByteArray tid = QByteArray::number(buffer->tid);
+        dropped += buffer->dropped;
+
+        separator();
+        out += "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":" + pid + ",\"tid\":" + tid + ",\"args\":{\"name\":";
+        appendJsonString(out, buffer->threadName.toUtf8().constData());
+        out += "}}";
+
+        // 区间在结束时记录，内层先于外层；按开始时间排序后外层在前
+        std::stable_sort(buffer->events.begin(), buffer->events.end(), [](const Event& a, const Event& b) {
+            return a.startNs != b.startNs ? a.startNs < b.startNs : a.depth < b.depth;
+        });
+
+        for (const Event& event : buffer->events) {
+            separator();
+            out += event.durationNs < 0 ? "{\"ph\":\"i\",\"s\":\"t\",\"cat\":" : "{\"ph\":\"X\",\"cat\":";
+            appendJsonString(out, event.category);
+            out += ",\"name\":";
+            appendJsonString(out, event.name);
+            out += ",\"pid\":" + pid + ",\"tid\":" + tid + ",\"ts\":";
+            appendTimeUs(out, event.startNs);
+            if (event.durationNs >= 0) {
+                out += ",\"dur\":";
+                appendTimeUs(out, event.durationNs);
+            }
+            out += ",\"args\":{\"depth\":" + QByteArray::number(event.depth);
+            if (!event.detail.isEmpty()) {
+                out += ",\"detail\":";
+                appendJsonString(out, event.detail.toUtf8().constData());
+            }
+            out += "}}";
+
+            if (out.size() >= kFlushBytes) {
+                file.write(out);
+                out.clear();
+            }
+        }
+    }
+
+    out += "\n],\"otherData\":{\"droppedEvents\":" + QByteArray::number(static_cast<qulonglong>(dropped)) + "}}\n";
+    if (file.write(out) != out.size() || !file.flush()) {
+        if (error) {
+            *error = file.errorString();
+        }
+        return false;
+    }
+    return true;
+}
+
+void startFromEnvironment() {
+    const QString path = qEnvironmentVariable("MVVM_TRACE_FILE");
+    if (path.isEmpty()) {
+        return;
+    }
+    registry().outputPath = path;
+    start();
+    qAddPostRoutine(writeAtExit);
+}
+
+} // namespace trace
+} // namespace mvvm
+
+#endif
@@ -0,0 +1,91 @@
+#include "core/UpdateChannel.h"
+#include "core/Trace.h"
+#include <QTimer>
+#include <algorithm>
+#include <chrono>
+
+namespace mvvm {
+
+UpdateChannelBase::UpdateChannelBase(QObject* parent)
+    : QObject(parent),
+      frameTimer_(new QTimer(this)),
+      frameIntervalMs_(kDefaultFrameIntervalMs),
+      wakePending_(false),
+      posted_(0),
+      drained_(0),
+      batches_(0),
+      lastLatencyUs_(0),
+      maxLatencyUs_(0) {
+
+    frameTimer_->setSingleShot(true);
+    connect(frameTimer_, &QTimer::timeout, this, &UpdateChannelBase::onFrame);
+    sinceLastDrain_.start();
+}
+
+UpdateChannelBase::Stats UpdateChannelBase::stats() const {
+    Stats stats;
+    stats.posted = posted_.load();
+    stats.drained = drained_.load();
+    stats.batches = batches_.load();
+    stats.depth = pendingDepth();
+    stats.lastLatencyUs = lastLatencyUs_.load();
+    stats.maxLatencyUs = maxLatencyUs_.load();
+    return stats;
+}
+
+qint64 UpdateChannelBase::nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void UpdateChannelBase::notifyPosted() {
+    posted_.fetch_add(1, std::memory_order_relaxed);
+    // 每帧只投递一次唤醒事件
+    if (!wakePending_.exchange(true)) {
+        QMetaObject::invokeMethod(this, "scheduleDrain", Qt::QueuedConnection);
+    }
+}
+
+void UpdateChannelBase::scheduleDrain() {
+    if (frameTimer_->isActive()) {
+        return;
+    }
+    // 距上一帧不足一个帧间隔时等到下一帧，否则尽快处理
+    const qint64 wait = std::max<qint64>(0, frameIntervalMs_ - sinceLastDrain_.elapsed());
+    frameTimer_->start(static_cast<int>(wait));
+}
+
+void UpdateChannelBase::onFrame() {
+    drainNow();
+}
+
+void UpdateChannelBase::drainNow() {
+    MVVM_TRACE_SCOPE("model", "UpdateChannel::drain");
+    frameTimer_->stop();
+    // 先清除标志再取队列：取的过程中新到的更新会重新投递唤醒
+    wakePending_.store(false);
+
+    qint64 oldestNs = 0;
+    const std::size_t count = drainQueue(&oldestNs);
+    sinceLastDrain_.restart();
+
+    if (count > 0) {
+        const qint64 latencyUs = (nowNs() - oldestNs) / 1000;
+        drained_.fetch_add(count, std::memory_order_relaxed);
+        batches_.fetch_add(1, std::memory_order_relaxed);
+        lastLatencyUs_.store(latencyUs, std::memory_order_relaxed);
+        if (latencyUs > maxLatencyUs_.load(std::memory_order_relaxed)) {
+            maxLatencyUs_.store(latencyUs, std::memory_order_relaxed);
+        }
+        emit drained(static_cast<int>(count), latencyUs);
+    }
+
+    // 本帧上限之外或尚未链接完成的更新留到下一帧
+    if (pendingDepth() > 0) {
+        scheduleDrain();
+    }
+}
+
+} // namespace mvvm
+
+#include "UpdateChannel.moc"
@@ -0,0 +1,123 @@
+#include "io/UserExporter.h"
+#include "io/UserRecordWriter.h"
+#include <QElapsedTimer>
+#include <QSaveFile>
+#include <algorithm>
+#include <shared_mutex>
+#include <string>
+
+namespace mvvm {
+namespace io {
+
+namespace {
+
+constexpr std::size_t kBufferBytes = 1024 * 1024;
+constexpr std::size_t kBlockRows = 16 * 1024;
+
+} // namespace
+
+QString ExportStats::summary() const {
+    return QString("导出 %1 条记录，%2 MB 用时 %3 ms")
+        .arg(records)
+        .arg(bytes / (1024.0 * 1024.0), 0, 'f', 1)
+        .arg(elapsedMs);
+}
+
+bool UserExporter::exportFile(const QString& path,
+                              std::shared_ptr<const UserColumnStore> store,
+                              const std::vector<RowId>& rows,
+                              ExportStats* stats,
+                              QString* error,
+                              const BlockCallback& onBlock) {
+    QElapsedTimer timer;
+    timer.start();
+
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        if (error) {
+            *error = file.errorString();
+        }
+        return false;
+    }
+
+    const bool json = formatForPath(path) == UserFileFormat::Json;
+    std::string buffer;
+    buffer.reserve(kBufferBytes + 4096);
+    qint64 written = 0;
+    qint64 records = 0;
+
+    auto flush = [&]() {
+        if (buffer.empty()) {
+            return true;
+        }
+        const qint64 size = static_cast<qint64>(buffer.size());
+        if (file.write(buffer.data(), size) != size) {
+            return false;
+        }
+        written += size;
+        buffer.clear();
+        return true;
+    };
+
+    if (json) {
+        appendJsonBegin(buffer);
+    } else {
+        appendCsvHeader(buffer);
+    }
+
+    std::string emailBuffer;
+    for (std::size_t begin = 0; begin < rows.size(); begin += kBlockRows) {
+        const std::size_t end = std::min(rows.size(), begin + kBlockRows);
+        {
+            std::shared_lock<std::shared_mutex> lock(store->mutex());
+            for (std::size_t i = begin; i < end; ++i) {
+                const RowId id = rows[i];
+                if (id >= store->slotCount() || !store->isAlive(id)) {
+                    continue;
+                }
+                const std::string_view email = store->email(id, emailBuffer);
+                if (json) {
+                    appendJsonRecord(buffer, store->name(id), email, store->age(id), records == 0);
+                } else {
+                    appendCsvRecord(buffer, store->name(id), email, store->age(id));
+                }
+                ++records;
+            }
+        }
+        // 在锁外写盘
+        if (buffer.size() >= kBufferBytes && !flush()) {
+            if (error) {
+                *error = file.errorString();
+            }
+            file.cancelWriting();
+            return false;
+        }
+        if (onBlock && !onBlock(end, rows.size())) {
+            if (error) {
+                *error = QStringLiteral("已取消");
+            }
+            file.cancelWriting();
+            return false;
+        }
+    }
+
+    if (json) {
+        appendJsonEnd(buffer, records == 0);
+    }
+    if (!flush() || !file.commit()) {
+        if (error) {
+            *error = file.errorString();
+        }
+        return false;
+    }
+
+    if (stats) {
+        stats->bytes = written;
+        stats->records = records;
+        stats->elapsedMs = timer.elapsed();
+    }
+    return true;
+}
+
+} // namespace io
+} // namespace mvvm
@@ -0,0 +1,225 @@
+#include "io/UserImporter.h"
+#include "io/UserRecordParser.h"
+#include "common/TaskScheduler.h"
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <algorithm>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace mvvm {
+namespace io {
+
+namespace {
+
+// 分块大小：足够大以摊薄调度开销，又足够小以限制同时映射的页数
+constexpr qint64 kMinChunkBytes = 8 * 1024 * 1024;
+constexpr qint64 kMaxChunkBytes = 64 * 1024 * 1024;
+
+struct ChunkTask {
+    qint64 begin = 0;
+    qint64 end = 0;
+    ParsedChunk parsed;
+    QString ioError;
+};
+
+void parseChunk(const QString& path, qint64 fileSize, UserFileFormat format, ChunkTask& task) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        task.ioError = file.errorString();
+        return;
+    }
+
+    // 多映射前一个字节，用于判断 begin 是否恰好是行首
+    const qint64 mapStart = task.begin > 0 ? task.begin - 1 : 0;
+    const qint64 mapSize = fileSize - mapStart;
+    uchar* mapped = file.map(mapStart, mapSize);
+    if (!mapped) {
+        task.ioError = file.errorString();
+        return;
+    }
+
+    const char* data = reinterpret_cast<const char*>(mapped);
+    const std::size_t begin = static_cast<std::size_t>(task.begin - mapStart);
+    const std::size_t end = static_cast<std::size_t>(task.end - mapStart);
+    if (format == UserFileFormat::Json) {
+        parseJsonChunk(data, static_cast<std::size_t>(mapSize), begin, end, task.parsed);
+    } else {
+        parseCsvChunk(data, static_cast<std::size_t>(mapSize), begin, end, task.parsed);
+    }
+    task.parsed.firstRecord += static_cast<std::size_t>(mapStart);
+    task.parsed.endPos += static_cast<std::size_t>(mapStart);
+
+    // 解除映射后这些文件页不再计入本进程的常驻内存
+    file.unmap(mapped);
+}
+
+std::vector<ChunkTask> makeChunks(qint64 fileSize, int threadCount) {
+    const qint64 target = fileSize / (std::max(1, threadCount) * 4);
+    const qint64 chunkBytes = std::clamp(target, kMinChunkBytes, kMaxChunkBytes);
+
+    std::vector<ChunkTask> chunks;
+    for (qint64 begin = 0; begin < fileSize; begin += chunkBytes) {
+        ChunkTask task;
+        task.begin = begin;
+        task.end = std::min(fileSize, begin + chunkBytes);
+        chunks.push_back(std::move(task));
+    }
+    return chunks;
+}
+
+/**
+ * 相邻分块必须首尾相接：前一块停下的位置就是后一块开始的位置，
+ * 否则说明有记录跨越了分块边界，并行结果不可信
+ */
+bool chunksTile(const std::vector<ChunkTask>& chunks) {
+    for (std::size_t i = 0; i < chunks.size(); ++i) {
+        if (!chunks[i].ioError.isEmpty() || chunks[i].parsed.syntaxError) {
+            return false;
+        }
+        if (i + 1 < chunks.size() && chunks[i].parsed.endPos != chunks[i + 1].parsed.firstRecord) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+UserFileFormat formatForPath(const QString& path) {
+    const QString suffix = QFileInfo(path).suffix().toLower();
+    if (suffix == "json" || suffix == "jsonl" || suffix == "ndjson") {
+        return UserFileFormat::Json;
+    }
+    return UserFileFormat::Csv;
+}
+
+qint64 peakMemoryBytes() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return static_cast<qint64>(counters.PeakWorkingSetSize);
+    }
+    return 0;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+#ifdef __APPLE__
+    return static_cast<qint64>(usage.ru_maxrss);
+#else
+    return static_cast<qint64>(usage.ru_maxrss) * 1024;
+#endif
+#endif
+}
+
+QString ImportStats::summary() const {
+    return QString("导入 %1 条记录（拒绝 %2 条，校验未通过 %3 条），%4 MB 用时 %5 ms，"
+                   "%6 MB/s，%7 个分块%8，峰值内存 %9 MB")
+        .arg(records)
+        .arg(rejected)
+        .arg(invalid)
+        .arg(bytes / (1024.0 * 1024.0), 0, 'f', 1)
+        .arg(elapsedMs)
+        .arg(megabytesPerSecond, 0, 'f', 1)
+        .arg(chunks)
+        .arg(parallel ? "并行" : "（单线程）")
+        .arg(peakMemoryBytes / (1024.0 * 1024.0), 0, 'f', 1);
+}
+
+ImportResult UserImporter::importFile(const QString& path) {
+    return importFile(path, formatForPath(path));
+}
+
+ImportResult UserImporter::importFile(const QString& path, UserFileFormat format) {
+    QElapsedTimer timer;
+    timer.start();
+
+    ImportResult result;
+    const QFileInfo info(path);
+    if (!info.exists() || !info.isFile()) {
+        result.error = QString("文件不存在: %1").arg(path);
+        return result;
+    }
+
+    const qint64 fileSize = info.size();
+    result.stats.bytes = fileSize;
+    if (fileSize == 0) {
+        result.ok = true;
+        return result;
+    }
+
+    // 1. 并行解析各分块
+    common::TaskScheduler& scheduler = common::TaskScheduler::shared();
+    std::vector<ChunkTask> chunks = makeChunks(fileSize, static_cast<int>(scheduler.workerCount()));
+    scheduler.parallelFor(0, chunks.size(), 1, [&](std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; ++i) {
+            parseChunk(path, fileSize, format, chunks[i]);
+        }
+    });
+
+    // 2. 分块未能首尾相接时退回单线程整体解析
+    if (!chunksTile(chunks)) {
+        if (chunks.size() > 1) {
+            chunks.clear();
+            ChunkTask whole;
+            whole.begin = 0;
+            whole.end = fileSize;
+            chunks.push_back(std::move(whole));
+            parseChunk(path, fileSize, format, chunks.front());
+        }
+
+        const ChunkTask& task = chunks.front();
+        if (!task.ioError.isEmpty()) {
+            result.error = task.ioError;
+            return result;
+        }
+        if (task.parsed.syntaxError) {
+            result.error = QString("解析失败: %1").arg(QString::fromStdString(task.parsed.error));
+            return result;
+        }
+    }
+    result.stats.parallel = chunks.size() > 1;
+    result.stats.chunks = static_cast<int>(chunks.size());
+
+    // 3. 合并：只移动列和字符串块
+    std::size_t total = 0;
+    for (const ChunkTask& task : chunks) {
+        total += task.parsed.users.liveCount();
+        result.stats.rejected += static_cast<qint64>(task.parsed.rejected);
+    }
+    result.users.reserve(total);
+    for (ChunkTask& task : chunks) {
+        result.users.appendAll(std::move(task.parsed.users));
+    }
+    chunks.clear();
+
+    // 4. 批量并行校验，每块至少 64K 行
+    UserColumnStore& users = result.users;
+    const qint64 invalid = scheduler.parallelReduce(
+        0, users.slotCount(), 64 * 1024, qint64(0),
+        [&](std::size_t first, std::size_t last) {
+            return static_cast<qint64>(users.revalidate(static_cast<RowId>(first), static_cast<RowId>(last)));
+        },
+        [](qint64 a, qint64 b) { return a + b; });
+
+    result.stats.records = static_cast<qint64>(result.users.liveCount());
+    result.stats.invalid = invalid;
+    result.stats.elapsedMs = timer.elapsed();
+    result.stats.megabytesPerSecond = result.stats.elapsedMs > 0
+        ? (fileSize / (1024.0 * 1024.0)) / (result.stats.elapsedMs / 1000.0)
+        : 0.0;
+    result.stats.peakMemoryBytes = peakMemoryBytes();
+    result.ok = true;
+    return result;
+}
+
+} // namespace io
+} // namespace mvvm
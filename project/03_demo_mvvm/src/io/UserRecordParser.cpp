@@ -0,0 +1,501 @@
+#include "io/UserRecordParser.h"
+#include <charconv>
+#include <string_view>
+
+namespace mvvm {
+namespace io {
+
+namespace {
+
+bool isLineStart(const char* data, std::size_t pos) {
+    return pos == 0 || data[pos - 1] == '\n';
+}
+
+std::size_t firstLineStart(const char* data, std::size_t size, std::size_t begin) {
+    std::size_t pos = begin;
+    while (pos < size && !isLineStart(data, pos)) {
+        ++pos;
+    }
+    return pos;
+}
+
+std::size_t skipBom(const char* data, std::size_t size, std::size_t pos) {
+    if (pos == 0 && size >= 3 && static_cast<unsigned char>(data[0]) == 0xEF &&
+        static_cast<unsigned char>(data[1]) == 0xBB && static_cast<unsigned char>(data[2]) == 0xBF) {
+        return 3;
+    }
+    return pos;
+}
+
+bool equalsIgnoreCase(std::string_view a, std::string_view b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        char c = a[i];
+        if (c >= 'A' && c <= 'Z') {
+            c = static_cast<char>(c - 'A' + 'a');
+        }
+        if (c != b[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * 一个已解析字段：无转义时直接引用输入缓冲区，否则引用 buffer
+ */
+struct Field {
+    std::string_view view;
+    std::string buffer;
+};
+
+// ---------------------------------------------------------------- CSV
+
+/**
+ * 解析从 pos 开始的一条 CSV 记录，返回下一行行首
+ * 引号未闭合直到输入结尾时 unterminated 置为 true
+ */
+std::size_t parseCsvRecord(const char* data, std::size_t size, std::size_t pos,
+                           Field* fields, std::size_t maxFields, std::size_t& fieldCount,
+                           bool& unterminated) {
+    fieldCount = 0;
+    unterminated = false;
+
+    while (true) {
+        Field scratch;
+        Field& field = fieldCount < maxFields ? fields[fieldCount] : scratch;
+        field.buffer.clear();
+
+        if (pos < size && data[pos] == '"') {
+            // 带引号字段
+            std::size_t start = ++pos;
+            bool escaped = false;
+            while (true) {
+                if (pos >= size) {
+                    unterminated = true;
+                    ++fieldCount;
+                    return size;
+                }
+                if (data[pos] == '"') {
+                    if (pos + 1 < size && data[pos + 1] == '"') {
+                        if (!escaped) {
+                            field.buffer.assign(data + start, pos - start);
+                            escaped = true;
+                        }
+                        field.buffer.push_back('"');
+                        pos += 2;
+                        continue;
+                    }
+                    break;
+                }
+                if (escaped) {
+                    field.buffer.push_back(data[pos]);
+                }
+                ++pos;
+            }
+            field.view = escaped ? std::string_view(field.buffer)
+                                 : std::string_view(data + start, pos - start);
+            ++pos; // 结束引号
+            // 引号后到分隔符之间的多余字符忽略
+            while (pos < size && data[pos] != ',' && data[pos] != '\n') {
+                ++pos;
+            }
+        } else {
+            std::size_t start = pos;
+            while (pos < size && data[pos] != ',' && data[pos] != '\n') {
+                ++pos;
+            }
+            std::size_t stop = pos;
+            if (stop > start && data[stop - 1] == '\r') {
+                --stop;
+            }
+            field.view = std::string_view(data + start, stop - start);
+        }
+        ++fieldCount;
+
+        if (pos >= size) {
+            return size;
+        }
+        if (data[pos] == '\n') {
+            return pos + 1;
+        }
+        ++pos; // ','
+    }
+}
+
+// ---------------------------------------------------------------- JSON
+
+class JsonCursor {
+public:
+    JsonCursor(const char* data, std::size_t size, std::size_t pos)
+        : data_(data), size_(size), pos_(pos) {}
+
+    std::size_t pos() const { return pos_; }
+    const std::string& error() const { return error_; }
+
+    void skipWhitespace() {
+        while (pos_ < size_ && isWhitespace(data_[pos_])) {
+            ++pos_;
+        }
+    }
+
+    bool parseObject(Field& name, Field& email, int& age) {
+        name = Field();
+        email = Field();
+        age = 0;
+
+        if (!expect('{')) {
+            return false;
+        }
+        skipWhitespace();
+        if (peek() == '}') {
+            ++pos_;
+            return true;
+        }
+        while (true) {
+            skipWhitespace();
+            Field key;
+            if (!parseString(key)) {
+                return false;
+            }
+            skipWhitespace();
+            if (!expect(':')) {
+                return false;
+            }
+            skipWhitespace();
+
+            bool ok;
+            if (key.view == "name") {
+                ok = parseStringOrSkip(name);
+            } else if (key.view == "email") {
+                ok = parseStringOrSkip(email);
+            } else if (key.view == "age") {
+                ok = parseAge(age);
+            } else {
+                ok = skipValue();
+            }
+            if (!ok) {
+                return false;
+            }
+
+            skipWhitespace();
+            const char c = peek();
+            ++pos_;
+            if (c == '}') {
+                return true;
+            }
+            if (c != ',') {
+                return fail("对象中期望 ',' 或 '}'");
+            }
+        }
+    }
+
+private:
+    static bool isWhitespace(char c) {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+    }
+
+    char peek() const { return pos_ < size_ ? data_[pos_] : '\0'; }
+
+    bool fail(const char* message) {
+        error_ = std::string(message) + "（偏移 " + std::to_string(pos_) + "）";
+        return false;
+    }
+
+    bool expect(char c) {
+        if (peek() != c) {
+            return fail(c == '{' ? "期望 '{'" : c == ':' ? "期望 ':'" : "意外的字符");
+        }
+        ++pos_;
+        return true;
+    }
+
+    static void appendUtf8(std::string& out, unsigned int cp) {
+        if (cp < 0x80) {
+            out.push_back(static_cast<char>(cp));
+        } else if (cp < 0x800) {
+            out.push_back(static_cast<char>(0xC0 | (cp >> 6)));
+            out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+        } else if (cp < 0x10000) {
+            out.push_back(static_cast<char>(0xE0 | (cp >> 12)));
+            out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+        } else {
+            out.push_back(static_cast<char>(0xF0 | (cp >> 18)));
+            out.push_back(static_cast<char>(0x80 | ((cp >> 12) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+        }
+    }
+
+    bool parseHex4(unsigned int& value) {
+        if (pos_ + 4 > size_) {
+            return fail("\\u 转义不完整");
+        }
+        value = 0;
+        for (int i = 0; i < 4; ++i) {
+            const char c = data_[pos_++];
+            value <<= 4;
+            if (c >= '0' && c <= '9') {
+                value |= static_cast<unsigned int>(c - '0');
+            } else if (c >= 'a' && c <= 'f') {
+                value |= static_cast<unsigned int>(c - 'a' + 10);
+            } else if (c >= 'A' && c <= 'F') {
+                value |= static_cast<unsigned int>(c - 'A' + 10);
+            } else {
+                return fail("\\u 转义包含非法字符");
+            }
+        }
+        return true;
+    }
+
+    bool parseString(Field& out) {
+        if (peek() != '"') {
+            return fail("期望字符串");
+        }
+        const std::size_t start = ++pos_;
+        bool escaped = false;
+        out.buffer.clear();
+
+        while (true) {
+            if (pos_ >= size_) {
+                return fail("字符串未结束");
+            }
+            const char c = data_[pos_];
+            if (c == '"') {
+                break;
+            }
+            if (c != '\\') {
+                if (escaped) {
+                    out.buffer.push_back(c);
+                }
+                ++pos_;
+                continue;
+            }
+
+            if (!escaped) {
+                out.buffer.assign(data_ + start, pos_ - start);
+                escaped = true;
+            }
+            if (++pos_ >= size_) {
+                return fail("转义未结束");
+            }
+            const char e = data_[pos_++];
+            switch (e) {
+            case '"': out.buffer.push_back('"'); break;
+            case '\\': out.buffer.push_back('\\'); break;
+            case '/': out.buffer.push_back('/'); break;
+            case 'b': out.buffer.push_back('\b'); break;
+            case 'f': out.buffer.push_back('\f'); break;
+            case 'n': out.buffer.push_back('\n'); break;
+            case 'r': out.buffer.push_back('\r'); break;
+            case 't': out.buffer.push_back('\t'); break;
+            case 'u': {
+                unsigned int cp;
+                if (!parseHex4(cp)) {
+                    return false;
+                }
+                // 代理对
+                if (cp >= 0xD800 && cp <= 0xDBFF && pos_ + 1 < size_ &&
+                    data_[pos_] == '\\' && data_[pos_ + 1] == 'u') {
+                    pos_ += 2;
+                    unsigned int low;
+                    if (!parseHex4(low)) {
+                        return false;
+                    }
+                    cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                }
+                appendUtf8(out.buffer, cp);
+                break;
+            }
+            default:
+                return fail("未知的转义字符");
+            }
+        }
+
+        out.view = escaped ? std::string_view(out.buffer)
+                           : std::string_view(data_ + start, pos_ - start);
+        ++pos_;
+        return true;
+    }
+
+    bool parseStringOrSkip(Field& out) {
+        if (peek() == '"') {
+            return parseString(out);
+        }
+        return skipValue();
+    }
+
+    bool parseAge(int& age) {
+        if (peek() == '"') {
+            Field text;
+            if (!parseString(text)) {
+                return false;
+            }
+            age = parseAgeField(text.view);
+            return true;
+        }
+        const std::size_t start = pos_;
+        if (!skipValue()) {
+            return false;
+        }
+        age = parseAgeField(std::string_view(data_ + start, pos_ - start));
+        return true;
+    }
+
+    bool skipValue() {
+        const char c = peek();
+        if (c == '"') {
+            Field ignored;
+            return parseString(ignored);
+        }
+        if (c == '{' || c == '[') {
+            // 嵌套结构：按括号深度跳过，注意跳过字符串中的括号
+            int depth = 0;
+            while (pos_ < size_) {
+                const char d = data_[pos_];
+                if (d == '"') {
+                    Field ignored;
+                    if (!parseString(ignored)) {
+                        return false;
+                    }
+                    continue;
+                }
+                if (d == '{' || d == '[') {
+                    ++depth;
+                } else if (d == '}' || d == ']') {
+                    if (--depth == 0) {
+                        ++pos_;
+                        return true;
+                    }
+                }
+                ++pos_;
+            }
+            return fail("嵌套结构未结束");
+        }
+        // 数字 / true / false / null
+        const std::size_t start = pos_;
+        while (pos_ < size_ && data_[pos_] != ',' && data_[pos_] != '}' &&
+               data_[pos_] != ']' && !isWhitespace(data_[pos_])) {
+            ++pos_;
+        }
+        return pos_ > start ? true : fail("期望值");
+    }
+
+    const char* data_;
+    std::size_t size_;
+    std::size_t pos_;
+    std::string error_;
+};
+
+} // namespace
+
+int parseAgeField(std::string_view text) {
+    while (!text.empty() && (text.front() == ' ' || text.front() == '\t')) {
+        text.remove_prefix(1);
+    }
+    while (!text.empty() && (text.back() == ' ' || text.back() == '\t' || text.back() == '\r')) {
+        text.remove_suffix(1);
+    }
+    int age = 0;
+    const char* first = text.data();
+    const char* last = text.data() + text.size();
+    if (!text.empty() && text.front() == '+') {
+        ++first;
+    }
+    auto [ptr, ec] = std::from_chars(first, last, age);
+    // 与 QString::toInt 一致：必须整段都是整数
+    if (ec != std::errc() || ptr != last) {
+        return 0;
+    }
+    return age;
+}
+
+void parseCsvChunk(const char* data, std::size_t size,
+                   std::size_t begin, std::size_t end, ParsedChunk& out) {
+    std::size_t pos = firstLineStart(data, size, begin);
+    out.firstRecord = pos;
+    const bool atFileStart = pos == 0;
+    pos = skipBom(data, size, pos);
+
+    Field fields[3];
+    bool firstRecord = atFileStart;
+    while (pos < size && pos < end) {
+        std::size_t fieldCount = 0;
+        bool unterminated = false;
+        pos = parseCsvRecord(data, size, pos, fields, 3, fieldCount, unterminated);
+
+        // 空行
+        if (fieldCount == 1 && fields[0].view.empty() && !unterminated) {
+            continue;
+        }
+        if (firstRecord) {
+            firstRecord = false;
+            if (fieldCount >= 2 && equalsIgnoreCase(fields[0].view, "name") &&
+                equalsIgnoreCase(fields[1].view, "email")) {
+                continue; // 表头
+            }
+        }
+        if (unterminated || fieldCount < 3) {
+            ++out.rejected;
+            continue;
+        }
+        out.users.appendUnvalidated(fields[0].view, fields[1].view, parseAgeField(fields[2].view));
+    }
+    out.endPos = pos < size ? pos : size;
+}
+
+void parseJsonChunk(const char* data, std::size_t size,
+                    std::size_t begin, std::size_t end, ParsedChunk& out) {
+    std::size_t pos = firstLineStart(data, size, begin);
+    out.firstRecord = pos;
+    pos = skipBom(data, size, pos);
+
+    JsonCursor cursor(data, size, pos);
+    Field name;
+    Field email;
+    int age = 0;
+
+    if (pos >= end) {
+        out.endPos = pos < size ? pos : size;
+        return;
+    }
+
+    while (true) {
+        // 跳过记录之间的分隔符；越过属于下一分块的行首时停止
+        std::size_t p = cursor.pos();
+        bool stop = false;
+        while (p < size) {
+            const char c = data[p];
+            if (c == '\n') {
+                ++p;
+                if (p >= end) {
+                    stop = true;
+                    break;
+                }
+            } else if (c == ' ' || c == '\t' || c == '\r' || c == ',' || c == '[' || c == ']') {
+                ++p;
+            } else {
+                break;
+            }
+        }
+        if (stop || p >= size) {
+            out.endPos = p < size ? p : size;
+            return;
+        }
+
+        cursor = JsonCursor(data, size, p);
+        if (!cursor.parseObject(name, email, age)) {
+            out.syntaxError = true;
+            out.error = cursor.error();
+            out.endPos = cursor.pos();
+            return;
+        }
+        out.users.appendUnvalidated(name.view, email.view, age);
+    }
+}
+
+} // namespace io
+} // namespace mvvm
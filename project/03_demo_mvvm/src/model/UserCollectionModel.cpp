@@ -0,0 +1,660 @@
+#include "model/UserCollectionModel.h"
+#include "core/Trace.h"
+#include "common/QtTaskBridge.h"
+#include <QElapsedTimer>
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <shared_mutex>
+#include <utility>
+
+namespace mvvm {
+
+namespace {
+
+// 后台任务每处理这么多行释放一次共享锁，让 GUI 线程的写操作插队
+constexpr RowId kJobBlockRows = 16 * 1024;
+
+// 每个索引批次处理的行数：批次之间让出线程池，GUI 线程的写操作也不会长时间等锁
+constexpr std::size_t kIndexBatchRows = 64 * 1024;
+
+QString toQString(std::string_view text) {
+    return QString::fromUtf8(text.data(), static_cast<int>(text.size()));
+}
+
+template<typename Key>
+void sortByKey(std::vector<std::pair<Key, RowId>>& keyed, Qt::SortOrder order) {
+    // 相同键按 RowId 排序，保证结果稳定可复现
+    if (order == Qt::AscendingOrder) {
+        std::sort(keyed.begin(), keyed.end());
+    } else {
+        std::sort(keyed.begin(), keyed.end(), [](const auto& a, const auto& b) {
+            return a.first != b.first ? b.first < a.first : a.second < b.second;
+        });
+    }
+}
+
+/**
+ * 姓名 / 邮箱的排序键
+ * prefix 是全文前 8 字节的大端整数，多数比较只比较它；相同时才经快照解析句柄。
+ * 邮箱的本地部分相同时直接比较域名的字典序名次，不再比较域名文本。
+ */
+struct TextSortKey {
+    std::uint64_t prefix;
+    CompactString text;            // 姓名，或邮箱的本地部分
+    std::uint32_t domain;          // 提取时为域名编号，排序前换成名次；姓名为 0
+    RowId row;
+};
+
+std::uint64_t emailSortPrefix(std::string_view local, std::string_view domain, bool hasDomain) {
+    char bytes[8];
+    std::size_t size = std::min<std::size_t>(local.size(), sizeof(bytes));
+    std::memcpy(bytes, local.data(), size);
+    if (hasDomain && size < sizeof(bytes)) {
+        bytes[size++] = '@';
+        const std::size_t more = std::min(domain.size(), sizeof(bytes) - size);
+        std::memcpy(bytes + size, domain.data(), more);
+        size += more;
+    }
+    return CompactString::sortPrefix(std::string_view(bytes, size));
+}
+
+// 按字节（无符号）比较，返回负数、0 或正数
+int compareBytes(std::string_view a, std::string_view b) {
+    const int result = a.compare(b);
+    return result < 0 ? -1 : (result > 0 ? 1 : 0);
+}
+
+int compareTextKeys(const TextSortKey& a, const TextSortKey& b, const StringArena::Snapshot& strings, bool email) {
+    if (a.prefix != b.prefix) {
+        return a.prefix < b.prefix ? -1 : 1;
+    }
+    const std::string_view textA = strings.view(a.text);
+    const std::string_view textB = strings.view(b.text);
+    if (!email) {
+        return compareBytes(textA, textB);
+    }
+    if (textA == textB) {
+        // 本地部分相同：由域名决定，无 '@' 的名次为 0 排在最前
+        return a.domain == b.domain ? 0 : (a.domain < b.domain ? -1 : 1);
+    }
+    // 本地部分在第一个 '@' 处截断，不含 '@'：较短的一方在结尾处接 '@'（或结束）后比较
+    const std::size_t common = std::min(textA.size(), textB.size());
+    const int head = compareBytes(textA.substr(0, common), textB.substr(0, common));
+    if (head != 0) {
+        return head;
+    }
+    const bool aShorter = textA.size() < textB.size();
+    const TextSortKey& shorter = aShorter ? a : b;
+    const unsigned char next = static_cast<unsigned char>(aShorter ? textB[common] : textA[common]);
+    const bool shorterFirst = shorter.domain == 0 || static_cast<unsigned char>('@') < next;
+    return (shorterFirst == aShorter) ? -1 : 1;
+}
+
+} // namespace
+
+/**
+ * 后台排序/过滤任务的结果
+ */
+struct UserCollectionModel::ViewJobResult {
+    quint64 generation = 0;
+    std::size_t slotCount = 0;
+    UserSearchIndex::Query filter;
+    std::vector<RowId> visible;
+    std::vector<int> rowOfId;
+    qint64 elapsedMs = 0;
+};
+
+UserCollectionModel::UserCollectionModel(QObject* parent)
+    : QAbstractTableModel(parent),
+      store_(std::make_shared<UserColumnStore>()),
+      sortColumn_(-1),
+      sortOrder_(Qt::AscendingOrder),
+      index_(std::make_shared<UserSearchIndex>()),
+      indexWatcher_(new QFutureWatcher<void>(this)),
+      latestJob_(std::make_shared<std::atomic<quint64>>(0)),
+      jobWatcher_(new QFutureWatcher<std::shared_ptr<ViewJobResult>>(this)),
+      jobRunning_(false),
+      flushScheduled_(false) {
+
+    connect(jobWatcher_, &QFutureWatcherBase::finished,
+            this, &UserCollectionModel::onViewJobFinished);
+    connect(indexWatcher_, &QFutureWatcherBase::finished,
+            this, &UserCollectionModel::scheduleIndexing);
+}
+
+UserCollectionModel::~UserCollectionModel() {
+    // 让仍在运行的任务尽快退出；任务持有 store_ 的共享所有权，不会访问已释放内存
+    latestJob_->fetch_add(1);
+    index_->abandon();
+}
+
+int UserCollectionModel::rowCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : static_cast<int>(visible_.size());
+}
+
+int UserCollectionModel::columnCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : ColumnCount;
+}
+
+QVariant UserCollectionModel::data(const QModelIndex& index, int role) const {
+    if (!index.isValid() || index.row() >= static_cast<int>(visible_.size())) {
+        return QVariant();
+    }
+    if (role != Qt::DisplayRole && role != Qt::EditRole) {
+        return QVariant();
+    }
+
+    const RowId id = visible_[static_cast<std::size_t>(index.row())];
+    switch (index.column()) {
+    case NameColumn:
+        return toQString(store_->name(id));
+    case EmailColumn: {
+        std::string buffer;
+        return toQString(store_->email(id, buffer));
+    }
+    case AgeColumn:
+        return store_->age(id);
+    case ValidColumn:
+        if (role == Qt::EditRole) {
+            return store_->isValid(id);
+        }
+        return store_->isValid(id) ? QStringLiteral("有效") : QStringLiteral("无效");
+    default:
+        return QVariant();
+    }
+}
+
+QVariant UserCollectionModel::headerData(int section, Qt::Orientation orientation, int role) const {
+    if (role != Qt::DisplayRole) {
+        return QVariant();
+    }
+    if (orientation == Qt::Vertical) {
+        return section + 1;
+    }
+    switch (section) {
+    case NameColumn:
+        return QStringLiteral("姓名");
+    case EmailColumn:
+        return QStringLiteral("邮箱");
+    case AgeColumn:
+        return QStringLiteral("年龄");
+    case ValidColumn:
+        return QStringLiteral("状态");
+    default:
+        return QVariant();
+    }
+}
+
+Qt::ItemFlags UserCollectionModel::flags(const QModelIndex& index) const {
+    Qt::ItemFlags result = QAbstractTableModel::flags(index);
+    if (index.isValid() && index.column() != ValidColumn) {
+        result |= Qt::ItemIsEditable;
+    }
+    return result;
+}
+
+bool UserCollectionModel::setData(const QModelIndex& index, const QVariant& value, int role) {
+    if (!index.isValid() || role != Qt::EditRole || index.row() >= rowCount()) {
+        return false;
+    }
+
+    const RowId id = rowIdAt(index.row());
+    {
+        std::unique_lock<std::shared_mutex> lock(store_->mutex());
+        switch (index.column()) {
+        case NameColumn:
+            store_->setName(id, value.toString().toStdString());
+            break;
+        case EmailColumn:
+            store_->setEmail(id, value.toString().toStdString());
+            break;
+        case AgeColumn:
+            store_->setAge(id, value.toInt());
+            break;
+        default:
+            return false;
+        }
+    }
+    index_->markDirty(id);
+    scheduleIndexing();
+    markRowChanged(id);
+    refilterRow(id);
+    return true;
+}
+
+bool UserCollectionModel::removeRows(int row, int count, const QModelIndex& parent) {
+    if (parent.isValid() || row < 0 || count <= 0 || row + count > rowCount()) {
+        return false;
+    }
+
+    beginRemoveRows(QModelIndex(), row, row + count - 1);
+    {
+        std::unique_lock<std::shared_mutex> lock(store_->mutex());
+        for (int i = row; i < row + count; ++i) {
+            const RowId id = visible_[static_cast<std::size_t>(i)];
+            store_->remove(id);
+            rowOfId_[id] = -1;
+            if (jobRunning_) {
+                touchedDuringJob_.push_back(id);
+            }
+        }
+    }
+    visible_.erase(visible_.begin() + row, visible_.begin() + row + count);
+    for (std::size_t i = static_cast<std::size_t>(row); i < visible_.size(); ++i) {
+        rowOfId_[visible_[i]] = static_cast<int>(i);
+    }
+    endRemoveRows();
+
+    emit userCountChanged();
+    return true;
+}
+
+void UserCollectionModel::sort(int column, Qt::SortOrder order) {
+    if (column < 0 || column >= ColumnCount) {
+        return;
+    }
+    sortColumn_ = column;
+    sortOrder_ = order;
+    startViewJob();
+}
+
+RowId UserCollectionModel::addUser(const QString& name, const QString& email, int age) {
+    MVVM_TRACE_SCOPE("model", "UserCollectionModel::addUser");
+    RowId id;
+    {
+        std::unique_lock<std::shared_mutex> lock(store_->mutex());
+        id = store_->append(name.toStdString(), email.toStdString(), age);
+    }
+    index_->markDirty(id);
+    scheduleIndexing();
+    appendVisibleRows(id, id + 1);
+    emit userCountChanged();
+    return id;
+}
+
+void UserCollectionModel::addUsers(UserColumnStore&& batch) {
+    MVVM_TRACE_SCOPE("model", "UserCollectionModel::addUsers");
+    if (batch.liveCount() == 0) {
+        return;
+    }
+
+    RowId first;
+    RowId last;
+    {
+        std::unique_lock<std::shared_mutex> lock(store_->mutex());
+        first = store_->appendAll(std::move(batch));
+        last = static_cast<RowId>(store_->slotCount());
+    }
+    index_->markDirty(first, last);
+    scheduleIndexing();
+    appendVisibleRows(first, last);
+    emit userCountChanged();
+
+    // 批量追加后重新排序，新行会在后台任务完成时归位
+    if (sortColumn_ >= 0) {
+        startViewJob();
+    }
+}
+
+void UserCollectionModel::updateUser(RowId id, const QString& name, const QString& email, int age) {
+    MVVM_TRACE_SCOPE("model", "UserCollectionModel::updateUser");
+    if (id >= store_->slotCount() || !store_->isAlive(id)) {
+        return;
+    }
+    {
+        std::unique_lock<std::shared_mutex> lock(store_->mutex());
+        store_->setName(id, name.toStdString());
+        store_->setEmail(id, email.toStdString());
+        store_->setAge(id, age);
+    }
+    index_->markDirty(id);
+    scheduleIndexing();
+    markRowChanged(id);
+    refilterRow(id);
+}
+
+void UserCollectionModel::removeUser(RowId id) {
+    MVVM_TRACE_SCOPE("model", "UserCollectionModel::removeUser");
+    const int row = rowOf(id);
+    if (row >= 0) {
+        removeRows(row, 1);
+        return;
+    }
+    if (id < store_->slotCount() && store_->isAlive(id)) {
+        std::unique_lock<std::shared_mutex> lock(store_->mutex());
+        store_->remove(id);
+        lock.unlock();
+        // 当前不可见的行也可能已被运行中的任务算进结果（例如新的过滤条件下可见），完成时需重新判断
+        if (jobRunning_) {
+            touchedDuringJob_.push_back(id);
+        }
+        emit userCountChanged();
+    }
+}
+
+void UserCollectionModel::clear() {
+    latestJob_->fetch_add(1);
+    beginResetModel();
+    {
+        std::unique_lock<std::shared_mutex> lock(store_->mutex());
+        store_->clear();
+    }
+    index_->clear();
+    visible_.clear();
+    rowOfId_.clear();
+    changedRows_.clear();
+    touchedDuringJob_.clear();
+    endResetModel();
+    setJobRunning(false);
+    emit userCountChanged();
+}
+
+void UserCollectionModel::setFilterText(const QString& text) {
+    MVVM_TRACE_SCOPE("model", "UserCollectionModel::setFilterText");
+    if (filterText_ == text) {
+        return;
+    }
+    filterText_ = text;
+    filterQuery_ = UserSearchIndex::parseQuery(text.toStdString());
+    startViewJob();
+}
+
+int UserCollectionModel::rowOf(RowId id) const {
+    return id < rowOfId_.size() ? rowOfId_[id] : -1;
+}
+
+void UserCollectionModel::startViewJob() {
+    const quint64 generation = latestJob_->fetch_add(1) + 1;
+    const std::size_t slotCount = store_->slotCount();
+    touchedDuringJob_.clear();
+
+    auto store = store_;
+    auto index = index_;
+    auto latest = latestJob_;
+    const int sortColumn = sortColumn_;
+    const Qt::SortOrder sortOrder = sortOrder_;
+    const UserSearchIndex::Query filter = filterQuery_;
+
+    auto job = [store, index, latest, generation, slotCount, sortColumn, sortOrder, filter]()
+        -> std::shared_ptr<ViewJobResult> {
+        QElapsedTimer timer;
+        timer.start();
+
+        auto result = std::make_shared<ViewJobResult>();
+        result->generation = generation;
+        result->slotCount = slotCount;
+        result->filter = filter;
+        auto cancelled = [&]() { return latest->load(std::memory_order_relaxed) != generation; };
+
+        // 1. 过滤：无关键字时分块持有共享锁收集存活行，否则由索引求候选行并逐行校验
+        std::vector<RowId>& rows = result->visible;
+        if (filter.empty()) {
+            rows.reserve(slotCount);
+            for (RowId begin = 0; begin < slotCount; begin += kJobBlockRows) {
+                if (cancelled()) {
+                    return nullptr;
+                }
+                std::shared_lock<std::shared_mutex> lock(store->mutex());
+                const RowId end = static_cast<RowId>(
+                    std::min<std::size_t>({slotCount, store->slotCount(), std::size_t(begin) + kJobBlockRows}));
+                for (RowId id = begin; id < end; ++id) {
+                    if (store->isAlive(id)) {
+                        rows.push_back(id);
+                    }
+                }
+            }
+        } else {
+            if (!index->search(*store, filter, rows, cancelled)) {
+                return nullptr;
+            }
+            // 任务开始后追加的行由 GUI 线程在完成时补上
+            rows.erase(std::lower_bound(rows.begin(), rows.end(), static_cast<RowId>(slotCount)), rows.end());
+        }
+
+        // 2. 排序：分块提取键后在锁外排序；字符串字节不可变，由内存池快照保证生命周期
+        if (sortColumn >= 0) {
+            if (sortColumn == NameColumn || sortColumn == EmailColumn) {
+                const bool email = sortColumn == EmailColumn;
+                std::vector<TextSortKey> keyed;
+                keyed.reserve(rows.size());
+                StringArena::Snapshot strings;
+                std::uint64_t epoch = 0;
+                for (std::size_t begin = 0; begin < rows.size(); begin += kJobBlockRows) {
+                    if (cancelled()) {
+                        return nullptr;
+                    }
+                    std::shared_lock<std::shared_mutex> lock(store->mutex());
+                    if (begin == 0) {
+                        epoch = store->epoch();
+                    } else if (store->epoch() != epoch) {
+                        return nullptr;   // 存储已被清空，句柄失效
+                    }
+                    const std::size_t end = std::min(rows.size(), begin + kJobBlockRows);
+                    for (std::size_t i = begin; i < end; ++i) {
+                        const RowId id = rows[i];
+                        if (email) {
+                            const UserColumnStore::DomainId domain = store->emailDomain(id);
+                            const bool hasDomain = domain != StringInterner::kNone;
+                            keyed.push_back({emailSortPrefix(store->emailLocal(id),
+                                                             hasDomain ? store->domainText(domain) : std::string_view(),
+                                                             hasDomain),
+                                             store->emailLocalHandle(id), domain, id});
+                        } else {
+                            keyed.push_back({CompactString::sortPrefix(store->name(id)), store->nameHandle(id), 0, id});
+                        }
+                    }
+                    if (end == rows.size()) {
+                        // 已提取的句柄都在这份快照里；域名编号换成字典序名次
+                        strings = store->snapshotStrings();
+                        if (email) {
+                            const std::vector<StringInterner::Id> ranks = store->domains().sortRanks();
+                            for (TextSortKey& key : keyed) {
+                                key.domain = ranks[key.domain];
+                            }
+                        }
+                    }
+                }
+                // 相同键按 RowId 排序，保证结果稳定可复现
+                const bool ascending = sortOrder == Qt::AscendingOrder;
+                std::sort(keyed.begin(), keyed.end(), [&](const TextSortKey& a, const TextSortKey& b) {
+                    const int order = compareTextKeys(a, b, strings, email);
+                    return order != 0 ? (ascending ? order < 0 : order > 0) : a.row < b.row;
+                });
+                for (std::size_t i = 0; i < keyed.size(); ++i) {
+                    rows[i] = keyed[i].row;
+                }
+            } else {
+                std::vector<std::pair<int, RowId>> keyed;
+                keyed.reserve(rows.size());
+                for (std::size_t begin = 0; begin < rows.size(); begin += kJobBlockRows) {
+                    if (cancelled()) {
+                        return nullptr;
+                    }
+                    std::shared_lock<std::shared_mutex> lock(store->mutex());
+                    const std::size_t end = std::min(rows.size(), begin + kJobBlockRows);
+                    for (std::size_t i = begin; i < end; ++i) {
+                        const RowId id = rows[i];
+                        keyed.emplace_back(sortColumn == AgeColumn ? store->age(id)
+                                                                   : int(store->isValid(id)), id);
+                    }
+                }
+                sortByKey(keyed, sortOrder);
+                for (std::size_t i = 0; i < keyed.size(); ++i) {
+                    rows[i] = keyed[i].second;
+                }
+            }
+        }
+
+        if (cancelled()) {
+            return nullptr;
+        }
+
+        // 3. 反向映射也在后台算好，GUI 线程只需交换
+        result->rowOfId.assign(slotCount, -1);
+        for (std::size_t i = 0; i < rows.size(); ++i) {
+            result->rowOfId[rows[i]] = static_cast<int>(i);
+        }
+        result->elapsedMs = timer.elapsed();
+        return result;
+    };
+
+    setJobRunning(true);
+    jobWatcher_->setFuture(common::qt::future(job, common::TaskPriority::High));
+}
+
+void UserCollectionModel::onViewJobFinished() {
+    MVVM_TRACE_SCOPE("model", "UserCollectionModel::onViewJobFinished");
+    std::shared_ptr<ViewJobResult> result = jobWatcher_->future().result();
+    if (!result || result->generation != latestJob_->load()) {
+        return; // 已被更新的任务取代
+    }
+
+    // 过滤条件不变且期间没有增删改时，结果只是当前可见行的重排
+    const bool sameRows = result->filter == appliedFilterQuery_ && touchedDuringJob_.empty() &&
+                          result->visible.size() == visible_.size() &&
+                          result->slotCount == store_->slotCount();
+    appliedFilterQuery_ = result->filter;
+
+    if (sameRows) {
+        // 纯重排：保持选择和当前项
+        emit layoutAboutToBeChanged({}, QAbstractItemModel::VerticalSortHint);
+        const QModelIndexList oldIndexes = persistentIndexList();
+        QModelIndexList newIndexes;
+        newIndexes.reserve(oldIndexes.size());
+        for (const QModelIndex& old : oldIndexes) {
+            const int newRow = result->rowOfId[visible_[static_cast<std::size_t>(old.row())]];
+            newIndexes.append(newRow >= 0 ? index(newRow, old.column()) : QModelIndex());
+        }
+        visible_.swap(result->visible);
+        rowOfId_.swap(result->rowOfId);
+        changePersistentIndexList(oldIndexes, newIndexes);
+        emit layoutChanged({}, QAbstractItemModel::VerticalSortHint);
+    } else {
+        beginResetModel();
+        visible_.swap(result->visible);
+        rowOfId_.swap(result->rowOfId);
+        rowOfId_.resize(store_->slotCount(), -1);
+        endResetModel();
+
+        // 任务期间追加的行放到末尾，期间修改或删除的行重新判断过滤条件
+        appendVisibleRows(static_cast<RowId>(result->slotCount), static_cast<RowId>(store_->slotCount()));
+        std::vector<RowId> touched;
+        touched.swap(touchedDuringJob_);
+        for (RowId id : touched) {
+            refilterRow(id);
+        }
+    }
+
+    setJobRunning(false);
+    emit viewJobFinished(result->elapsedMs);
+}
+
+void UserCollectionModel::markRowChanged(RowId id) {
+    if (jobRunning_) {
+        touchedDuringJob_.push_back(id);
+    }
+    changedRows_.push_back(id);
+    if (!flushScheduled_) {
+        flushScheduled_ = true;
+        QMetaObject::invokeMethod(this, "flushChangedRows", Qt::QueuedConnection);
+    }
+}
+
+void UserCollectionModel::flushChangedRows() {
+    flushScheduled_ = false;
+
+    std::vector<int> rows;
+    rows.reserve(changedRows_.size());
+    for (RowId id : changedRows_) {
+        const int row = rowOf(id);
+        if (row >= 0) {
+            rows.push_back(row);
+        }
+    }
+    changedRows_.clear();
+
+    std::sort(rows.begin(), rows.end());
+    rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+
+    // 连续行合并为一个区间，避免整表刷新
+    const QVector<int> roles{Qt::DisplayRole, Qt::EditRole};
+    std::size_t i = 0;
+    while (i < rows.size()) {
+        std::size_t j = i;
+        while (j + 1 < rows.size() && rows[j + 1] == rows[j] + 1) {
+            ++j;
+        }
+        emit dataChanged(index(rows[i], 0), index(rows[j], ColumnCount - 1), roles);
+        i = j + 1;
+    }
+}
+
+void UserCollectionModel::appendVisibleRows(RowId first, RowId last) {
+    rowOfId_.resize(store_->slotCount(), -1);
+
+    std::vector<RowId> added;
+    for (RowId id = first; id < last; ++id) {
+        if (store_->isAlive(id) && rowOf(id) < 0 && passesFilter(id)) {
+            added.push_back(id);
+        }
+    }
+    if (added.empty()) {
+        return;
+    }
+
+    const int firstRow = static_cast<int>(visible_.size());
+    beginInsertRows(QModelIndex(), firstRow, firstRow + static_cast<int>(added.size()) - 1);
+    for (RowId id : added) {
+        rowOfId_[id] = static_cast<int>(visible_.size());
+        visible_.push_back(id);
+    }
+    endInsertRows();
+}
+
+void UserCollectionModel::removeVisibleRow(int row) {
+    beginRemoveRows(QModelIndex(), row, row);
+    rowOfId_[visible_[static_cast<std::size_t>(row)]] = -1;
+    visible_.erase(visible_.begin() + row);
+    for (std::size_t i = static_cast<std::size_t>(row); i < visible_.size(); ++i) {
+        rowOfId_[visible_[i]] = static_cast<int>(i);
+    }
+    endRemoveRows();
+}
+
+void UserCollectionModel::refilterRow(RowId id) {
+    const int row = rowOf(id);
+    const bool visible = id < store_->slotCount() && store_->isAlive(id) && passesFilter(id);
+    if (row >= 0 && !visible) {
+        removeVisibleRow(row);
+    } else if (row < 0 && visible) {
+        appendVisibleRows(id, id + 1);
+    }
+}
+
+bool UserCollectionModel::passesFilter(RowId id) const {
+    return UserSearchIndex::matches(*store_, id, filterQuery_);
+}
+
+void UserCollectionModel::scheduleIndexing() {
+    if (indexWatcher_->isRunning() || !index_->hasPending()) {
+        return;
+    }
+    auto index = index_;
+    auto store = store_;
+    // 建索引是后台维护，排在排序/过滤和命令之后
+    indexWatcher_->setFuture(common::qt::future([index, store]() {
+        index->indexPending(*store, kIndexBatchRows);
+    }, common::TaskPriority::Low));
+}
+
+void UserCollectionModel::setJobRunning(bool running) {
+    if (jobRunning_ != running) {
+        jobRunning_ = running;
+        emit busyChanged();
+    }
+}
+
+} // namespace mvvm
+
+#include "UserCollectionModel.moc"
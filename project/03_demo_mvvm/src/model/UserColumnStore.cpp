@@ -0,0 +1,222 @@
+#include "model/UserColumnStore.h"
+#include "model/UserValidation.h"
+#include <algorithm>
+
+namespace mvvm {
+
+namespace {
+
+// 在第一个 '@' 处拆分（本地部分不含 '@'，排序时可按段比较）；没有 '@' 时 hasDomain 为 false
+struct EmailParts {
+    std::string_view local;
+    std::string_view domain;
+    bool hasDomain = false;
+};
+
+EmailParts splitEmail(std::string_view email) {
+    EmailParts parts;
+    const std::size_t at = email.find('@');
+    if (at == std::string_view::npos) {
+        parts.local = email;
+    } else {
+        parts.local = email.substr(0, at);
+        parts.domain = email.substr(at + 1);
+        parts.hasDomain = true;
+    }
+    return parts;
+}
+
+} // namespace
+
+UserColumnStore::UserColumnStore() : liveCount_(0), epoch_(0) {
+}
+
+UserColumnStore::UserColumnStore(UserColumnStore&& other) noexcept
+    : arena_(std::move(other.arena_)),
+      domains_(std::move(other.domains_)),
+      names_(std::move(other.names_)),
+      emailLocals_(std::move(other.emailLocals_)),
+      emailDomains_(std::move(other.emailDomains_)),
+      ages_(std::move(other.ages_)),
+      valid_(std::move(other.valid_)),
+      alive_(std::move(other.alive_)),
+      liveCount_(other.liveCount_),
+      epoch_(other.epoch_) {
+    other.liveCount_ = 0;
+    ++other.epoch_;
+}
+
+UserColumnStore& UserColumnStore::operator=(UserColumnStore&& other) noexcept {
+    if (this != &other) {
+        arena_ = std::move(other.arena_);
+        domains_ = std::move(other.domains_);
+        names_ = std::move(other.names_);
+        emailLocals_ = std::move(other.emailLocals_);
+        emailDomains_ = std::move(other.emailDomains_);
+        ages_ = std::move(other.ages_);
+        valid_ = std::move(other.valid_);
+        alive_ = std::move(other.alive_);
+        liveCount_ = other.liveCount_;
+        epoch_ = std::max(epoch_, other.epoch_) + 1;
+        other.liveCount_ = 0;
+        ++other.epoch_;
+    }
+    return *this;
+}
+
+void UserColumnStore::reserve(std::size_t rows) {
+    names_.reserve(rows);
+    emailLocals_.reserve(rows);
+    emailDomains_.reserve(rows);
+    ages_.reserve(rows);
+    valid_.reserve(rows);
+    alive_.reserve(rows);
+}
+
+std::string_view UserColumnStore::email(RowId row, std::string& buffer) const {
+    const std::string_view local = arena_.view(emailLocals_[row]);
+    const DomainId domain = emailDomains_[row];
+    if (domain == StringInterner::kNone) {
+        return local;
+    }
+    const std::string_view domainPart = domains_.text(domain);
+    buffer.clear();
+    buffer.reserve(local.size() + 1 + domainPart.size());
+    buffer.append(local.data(), local.size());
+    buffer.push_back('@');
+    buffer.append(domainPart.data(), domainPart.size());
+    return buffer;
+}
+
+std::string UserColumnStore::email(RowId row) const {
+    std::string buffer;
+    return std::string(email(row, buffer));
+}
+
+bool UserColumnStore::emailEquals(RowId row, std::string_view email) const {
+    const EmailParts parts = splitEmail(email);
+    const DomainId domain = emailDomains_[row];
+    if (parts.hasDomain != (domain != StringInterner::kNone)) {
+        return false;
+    }
+    // 先比较域名编号：未驻留的域名一定不相等，无需比较字符
+    if (parts.hasDomain && domains_.find(parts.domain) != domain) {
+        return false;
+    }
+    return arena_.view(emailLocals_[row]) == parts.local;
+}
+
+RowId UserColumnStore::append(std::string_view name, std::string_view email, int age) {
+    const RowId row = appendUnvalidated(name, email, age);
+    std::string buffer;
+    updateValidity(row, buffer);
+    return row;
+}
+
+RowId UserColumnStore::appendUnvalidated(std::string_view name, std::string_view email, int age) {
+    const RowId row = static_cast<RowId>(names_.size());
+    names_.push_back(arena_.storeCompact(name));
+    emailLocals_.emplace_back();
+    emailDomains_.push_back(StringInterner::kNone);
+    storeEmail(row, email);
+    ages_.push_back(age);
+    valid_.push_back(0);
+    alive_.push_back(1);
+    ++liveCount_;
+    return row;
+}
+
+void UserColumnStore::setName(RowId row, std::string_view name) {
+    if (arena_.view(names_[row]) != name) {
+        names_[row] = arena_.storeCompact(name);
+        std::string buffer;
+        updateValidity(row, buffer);
+    }
+}
+
+void UserColumnStore::setEmail(RowId row, std::string_view email) {
+    if (!emailEquals(row, email)) {
+        storeEmail(row, email);
+        std::string buffer;
+        updateValidity(row, buffer);
+    }
+}
+
+void UserColumnStore::setAge(RowId row, int age) {
+    if (ages_[row] != age) {
+        ages_[row] = age;
+        std::string buffer;
+        updateValidity(row, buffer);
+    }
+}
+
+void UserColumnStore::remove(RowId row) {
+    if (alive_[row]) {
+        alive_[row] = 0;
+        --liveCount_;
+    }
+}
+
+void UserColumnStore::clear() {
+    arena_.clear();
+    domains_.clear();
+    names_.clear();
+    emailLocals_.clear();
+    emailDomains_.clear();
+    ages_.clear();
+    valid_.clear();
+    alive_.clear();
+    liveCount_ = 0;
+    ++epoch_;
+}
+
+RowId UserColumnStore::appendAll(UserColumnStore&& other) {
+    const RowId first = static_cast<RowId>(names_.size());
+    reserve(names_.size() + other.liveCount_);
+
+    // 对方的块追加在后面，句柄按块号偏移改写；域名编号按对方的驻留表逐个映射
+    const std::size_t chunkBase = arena_.adopt(std::move(other.arena_));
+    std::vector<DomainId> domainMap(other.domains_.size(), StringInterner::kNone);
+    for (DomainId id = 1; id < domainMap.size(); ++id) {
+        domainMap[id] = domains_.intern(other.domains_.text(id));
+    }
+
+    for (std::size_t i = 0; i < other.names_.size(); ++i) {
+        if (!other.alive_[i]) {
+            continue;
+        }
+        names_.push_back(StringArena::rebase(other.names_[i], chunkBase));
+        emailLocals_.push_back(StringArena::rebase(other.emailLocals_[i], chunkBase));
+        emailDomains_.push_back(domainMap[other.emailDomains_[i]]);
+        ages_.push_back(other.ages_[i]);
+        valid_.push_back(other.valid_[i]);
+        alive_.push_back(1);
+        ++liveCount_;
+    }
+    other.clear();
+    return first;
+}
+
+std::size_t UserColumnStore::revalidate(RowId first, RowId last) {
+    std::size_t invalid = 0;
+    std::string buffer;
+    for (RowId row = first; row < last; ++row) {
+        updateValidity(row, buffer);
+        if (alive_[row] && !valid_[row]) {
+            ++invalid;
+        }
+    }
+    return invalid;
+}
+
+void UserColumnStore::storeEmail(RowId row, std::string_view email) {
+    const EmailParts parts = splitEmail(email);
+    emailLocals_[row] = arena_.storeCompact(parts.local);
+    emailDomains_[row] = parts.hasDomain ? domains_.intern(parts.domain) : StringInterner::kNone;
+}
+
+void UserColumnStore::updateValidity(RowId row, std::string& buffer) {
+    valid_[row] = validation::isValidUser(name(row), email(row, buffer), ages_[row]) ? 1 : 0;
+}
+
+} // namespace mvvm
@@ -1,13 +1,28 @@
 #include "model/UserModel.h"
-#include <QRegularExpression>
+#include "model/UserValidation.h"
+#include "core/Trace.h"
 
 namespace mvvm {
 
 UserModel::UserModel(QObject* parent) 
-    : QObject(parent), name_(""), email_(""), age_(0), isValid_(false) {
+    : QObject(parent), name_(""), email_(""), age_(0), isValid_(false),
+      updates_(new PatchChannel([this](std::vector<Patch>& batch) { applyBatch(batch); }, this)) {
+}
+
+void UserModel::Patch::merge(Patch&& later) {
+    if (later.name) {
+        name = std::move(later.name);
+    }
+    if (later.email) {
+        email = std::move(later.email);
+    }
+    if (later.age) {
+        age = later.age;
+    }
 }
 
 void UserModel::setName(const QString& name) {
+    MVVM_TRACE_SCOPE("model", "UserModel::setName");
     if (name_ != name) {
         name_ = name;
         emit nameChanged();
@@ -17,6 +32,7 @@ void UserModel::setName(const QString& name) {
 }
 
 void UserModel::setEmail(const QString& email) {
+    MVVM_TRACE_SCOPE("model", "UserModel::setEmail");
     if (email_ != email) {
         email_ = email;
         emit emailChanged();
@@ -26,6 +42,7 @@ void UserModel::setEmail(const QString& email) {
 }
 
 void UserModel::setAge(int age) {
+    MVVM_TRACE_SCOPE("model", "UserModel::setAge");
     if (age_ != age) {
         age_ = age;
         emit ageChanged();
@@ -34,7 +51,49 @@ void UserModel::setAge(int age) {
     }
 }
 
+void UserModel::apply(const Patch& patch) {
+    MVVM_TRACE_SCOPE("model", "UserModel::apply");
+    bool changed = false;
+    if (patch.name && name_ != *patch.name) {
+        name_ = *patch.name;
+        emit nameChanged();
+        changed = true;
+    }
+    if (patch.email && email_ != *patch.email) {
+        email_ = *patch.email;
+        emit emailChanged();
+        changed = true;
+    }
+    if (patch.age && age_ != *patch.age) {
+        age_ = *patch.age;
+        emit ageChanged();
+        changed = true;
+    }
+    if (changed) {
+        validateData();
+        emit dataChanged();
+    }
+}
+
+void UserModel::restore(const State& state) {
+    Patch patch;
+    patch.name = state.name;
+    patch.email = state.email;
+    patch.age = state.age;
+    apply(patch);
+}
+
+void UserModel::applyBatch(std::vector<Patch>& batch) {
+    // 一帧内积压的修改合并为一次，中间状态不会产生通知
+    Patch merged;
+    for (Patch& patch : batch) {
+        merged.merge(std::move(patch));
+    }
+    apply(merged);
+}
+
 void UserModel::validateData() {
+    MVVM_TRACE_SCOPE("model", "UserModel::validateData");
     bool oldValid = isValid_;
     isValid_ = !name_.isEmpty() && 
                isValidEmail(email_) && 
@@ -58,8 +117,8 @@ QString UserModel::getUserInfo() const {
 }
 
 bool UserModel::isValidEmail(const QString& email) const {
-    QRegularExpression regex(R"([a-zA-Z0-9._%+-]+@[a-zA-Z0-9.-]+\.[a-zA-Z]{2,})");
-    return regex.match(email).hasMatch();
+    // 每次输入都会校验：直接扫描 UTF-16 数据，不构造正则对象
+    return validation::isValidEmail(email.utf16(), static_cast<std::size_t>(email.size()));
 }
 
 } // namespace mvvm
@@ -1,3 +1,287 @@
 #include "mvvm_core.h"
+#include <QFutureWatcher>
+#include <QTimer>
+#include <algorithm>
+#include <exception>
+
+namespace mvvm {
+
+namespace {
+
+/**
+ * 在调度器的工作线程中执行任务体，并通过 QFutureInterface 报告结束；
+ * 即使已被取消也要 reportFinished，GUI 线程依靠 finished 信号回收这次执行
+ */
+void runAsyncBody(const std::function<void(AsyncContext&)>& body, const CancellationToken& token,
+                  QFutureInterface<void> future, QString& error) {
+    MVVM_TRACE_SCOPE("command", "AsyncCommand::run");
+    if (!token.isCancelled() && !future.isCanceled() && body) {
+        AsyncContext context(token, future);
+        try {
+            body(context);
+        } catch (const std::exception& e) {
+            error = QString::fromLocal8Bit(e.what());
+        } catch (...) {
+            error = QStringLiteral("未知错误");
+        }
+    }
+    future.reportFinished();
+}
+
+} // namespace
+
+common::Counter& ViewModelBase::notificationCounter() {
+    static common::Counter& counter = common::MetricsRegistry::global().counter(
+        "mvvm_property_notifications_total", "视图模型发出的属性变化通知数");
+    return counter;
+}
+
+/**
+ * 一次执行的 GUI 线程侧状态
+ */
+struct AsyncCommand::Run {
+    CancellationToken token;
+    QFutureInterface<void> future;
+    QFutureWatcher<void>* watcher = nullptr;
+    std::function<void()> finished;
+    std::shared_ptr<QString> error = std::make_shared<QString>();
+};
+
+AsyncCommand::AsyncCommand(JobFactory factory, CanExecuteFunc canExecuteFunc, QObject* parent)
+    : Command(parent),
+      factory_(std::move(factory)),
+      canExecuteFunc_(std::move(canExecuteFunc)),
+      policy_(Policy::Drop),
+      maxConcurrent_(1),
+      scheduler_(nullptr),
+      progress_(0) {
+}
+
+AsyncCommand::~AsyncCommand() {
+    // 只请求取消，不等待：任务体按值持有所需数据，结束后不会再回调本对象
+    queued_.clear();
+    for (auto& run : runs_) {
+        run->token.cancel();
+        run->future.cancel();
+        run->watcher->disconnect(this);
+    }
+}
+
+void AsyncCommand::setPolicy(Policy policy, int maxConcurrent) {
+    policy_ = policy;
+    maxConcurrent_ = std::max(1, maxConcurrent);
+    emit canExecuteChanged();
+}
+
+void AsyncCommand::executeWith(const QVariant& parameter) {
+    MVVM_TRACE_SCOPE("command", "AsyncCommand::execute");
+    if (canExecuteFunc_ && !canExecuteFunc_()) {
+        return;
+    }
+    if (activeCount() < maxConcurrent_) {
+        start(parameter);
+        return;
+    }
+    switch (policy_) {
+    case Policy::Drop:
+        break;
+    case Policy::Queue:
+        queued_.push_back(parameter);
+        break;
+    case Policy::Restart:
+        for (auto& run : runs_) {
+            run->token.cancel();
+            run->future.cancel();
+        }
+        start(parameter);
+        break;
+    }
+}
+
+void AsyncCommand::cancel() {
+    queued_.clear();
+    const bool wasRunning = isRunning();
+    for (auto& run : runs_) {
+        run->token.cancel();
+        run->future.cancel();
+    }
+    if (wasRunning) {
+        emit runningChanged();
+        emit canExecuteChanged();
+    }
+}
+
+bool AsyncCommand::canExecute() const {
+    if (canExecuteFunc_ && !canExecuteFunc_()) {
+        return false;
+    }
+    return policy_ != Policy::Drop || activeCount() < maxConcurrent_;
+}
+
+int AsyncCommand::activeCount() const {
+    // 已取消但尚未退出的执行不占用并发名额
+    return static_cast<int>(std::count_if(runs_.begin(), runs_.end(), [](const auto& run) {
+        return !run->token.isCancelled();
+    }));
+}
+
+void AsyncCommand::start(const QVariant& parameter) {
+    AsyncJob job = factory_ ? factory_(parameter) : AsyncJob();
+    if (!job.run) {
+        return;
+    }
+
+    const bool wasRunning = isRunning();
+    auto run = std::make_unique<Run>();
+    run->finished = std::move(job.finished);
+    run->future.reportStarted();
+    run->watcher = new QFutureWatcher<void>(this);
+
+    Run* raw = run.get();
+    connect(run->watcher, &QFutureWatcherBase::finished, this, [this, raw]() { onRunFinished(raw); });
+    connect(run->watcher, &QFutureWatcherBase::progressValueChanged, this, [this, raw](int value) {
+        if (!raw->token.isCancelled()) {
+            progress_ = value;
+            progressText_ = raw->watcher->progressText();
+            emit progressChanged(progress_, progressText_);
+        }
+    });
+
+    lastFuture_ = run->future.future();
+    run->watcher->setFuture(lastFuture_);
+    progress_ = 0;
+    progressText_.clear();
+
+    common::TaskScheduler& scheduler = scheduler_ ? *scheduler_ : common::TaskScheduler::shared();
+    scheduler.submit([body = std::move(job.run), token = run->token, future = run->future, error = run->error]() {
+        runAsyncBody(body, token, future, *error);
+    }, common::TaskPriority::High);
+    runs_.push_back(std::move(run));
+
+    if (!wasRunning) {
+        emit runningChanged();
+    }
+    emit canExecuteChanged();
+}
+
+void AsyncCommand::onRunFinished(Run* run) {
+    MVVM_TRACE_SCOPE("command", "AsyncCommand::finished");
+    auto it = std::find_if(runs_.begin(), runs_.end(), [run](const auto& item) { return item.get() == run; });
+    if (it == runs_.end()) {
+        return;
+    }
+    const bool wasRunning = isRunning();
+    std::unique_ptr<Run> finishedRun = std::move(*it);
+    runs_.erase(it);
+    finishedRun->watcher->deleteLater();
+
+    if (finishedRun->token.isCancelled()) {
+        emit cancelled();
+    } else if (!finishedRun->error->isEmpty()) {
+        emit failed(*finishedRun->error);
+    } else {
+        if (finishedRun->finished) {
+            finishedRun->finished();
+        }
+        emit finished();
+    }
+
+    startQueued();
+    if (wasRunning != isRunning()) {
+        emit runningChanged();
+    }
+    emit canExecuteChanged();
+}
+
+void AsyncCommand::startQueued() {
+    while (!queued_.empty() && activeCount() < maxConcurrent_) {
+        const QVariant parameter = queued_.front();
+        queued_.pop_front();
+        start(parameter);
+    }
+}
+
+RateLimiter::RateLimiter(Mode mode, int intervalMs, Action action, QObject* parent)
+    : QObject(parent),
+      mode_(mode),
+      intervalMs_(intervalMs),
+      action_(std::move(action)),
+      timer_(new QTimer(this)),
+      pending_(false) {
+
+    timer_->setSingleShot(true);
+    connect(timer_, &QTimer::timeout, this, &RateLimiter::onTimeout);
+}
+
+void RateLimiter::trigger() {
+    switch (mode_) {
+    case Mode::Debounce:
+        pending_ = true;
+        timer_->start(intervalMs_);
+        break;
+    case Mode::Throttle:
+        if (timer_->isActive()) {
+            pending_ = true;
+        } else {
+            fire();
+            timer_->start(intervalMs_);
+        }
+        break;
+    case Mode::LatestWhileBusy:
+        if ((isBusy_ && isBusy_()) || timer_->isActive()) {
+            pending_ = true;
+        } else {
+            fire();
+        }
+        break;
+    }
+}
+
+void RateLimiter::flush() {
+    if (pending_) {
+        timer_->stop();
+        fire();
+    }
+}
+
+void RateLimiter::cancel() {
+    pending_ = false;
+    timer_->stop();
+}
+
+void RateLimiter::onBusyChanged() {
+    if (mode_ != Mode::LatestWhileBusy || !pending_ || (isBusy_ && isBusy_())) {
+        return;
+    }
+    if (intervalMs_ > 0) {
+        timer_->start(intervalMs_);
+    } else {
+        fire();
+    }
+}
+
+void RateLimiter::onTimeout() {
+    if (!pending_) {
+        return;
+    }
+    if (mode_ == Mode::LatestWhileBusy && isBusy_ && isBusy_()) {
+        return; // 再次变忙，等下一次 onBusyChanged
+    }
+    fire();
+    if (mode_ == Mode::Throttle) {
+        // 周期末尾执行后开始新的周期
+        timer_->start(intervalMs_);
+    }
+}
+
+void RateLimiter::fire() {
+    MVVM_TRACE_SCOPE("binding", "RateLimiter::fire");
+    pending_ = false;
+    if (action_) {
+        action_();
+    }
+}
+
+} // namespace mvvm
 
 #include "mvvm_core.moc"
@@ -0,0 +1,458 @@
+#include "replay/ReplayDriver.h"
+#include "io/UserImporter.h"
+#include "model/UserCollectionModel.h"
+#include "model/UserModel.h"
+#include "viewmodel/UserViewModel.h"
+#include <QCoreApplication>
+#include <QFile>
+#include <QMetaMethod>
+#include <QTextStream>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace mvvm {
+namespace replay {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+inline std::uint64_t elapsedNs(Clock::time_point start, Clock::time_point end) {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+}
+
+/**
+ * splitmix64：输出只取决于种子，与平台和标准库无关
+ */
+class Random {
+private:
+    std::uint64_t state_;
+
+public:
+    explicit Random(std::uint64_t seed) : state_(seed) {}
+
+    std::uint64_t next() {
+        std::uint64_t z = (state_ += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    // [0, bound)
+    std::uint32_t below(std::uint32_t bound) { return static_cast<std::uint32_t>(next() % bound); }
+};
+
+/**
+ * 按名称统计信号次数
+ *
+ * 连接发送者类及其基类（QObject 之外）声明的全部信号，槽中用 senderSignalIndex() 区分。
+ * 发送者很少，按发送者线性查找、按信号下标直接索引，计数本身的开销可以忽略。
+ */
+class SignalCounter : public QObject {
+    Q_OBJECT
+
+private:
+    struct Source {
+        const QObject* sender;
+        std::vector<std::uint64_t> counts;
+    };
+
+    std::vector<Source> sources_;
+
+public:
+    void watch(QObject* sender) {
+        const QMetaObject* meta = sender->metaObject();
+        const QMetaMethod slot = metaObject()->method(metaObject()->indexOfSlot("count()"));
+        Source source{sender, std::vector<std::uint64_t>(static_cast<size_t>(meta->methodCount()), 0)};
+        for (int i = QObject::staticMetaObject.methodCount(); i < meta->methodCount(); ++i) {
+            const QMetaMethod method = meta->method(i);
+            if (method.methodType() == QMetaMethod::Signal) {
+                connect(sender, method, this, slot, Qt::DirectConnection);
+            }
+        }
+        sources_.push_back(std::move(source));
+    }
+
+    void reset() {
+        for (Source& source : sources_) {
+            std::fill(source.counts.begin(), source.counts.end(), 0);
+        }
+    }
+
+    void collect(ReplayResult& result) const {
+        for (const Source& source : sources_) {
+            const QMetaObject* meta = source.sender->metaObject();
+            for (int i = 0; i < static_cast<int>(source.counts.size()); ++i) {
+                if (source.counts[i] == 0) {
+                    continue;
+                }
+                const QString name = QString::fromLatin1(meta->className()) + QLatin1String("::") +
+                                     QString::fromLatin1(meta->method(i).name());
+                result.notifications.append(qMakePair(name, source.counts[i]));
+                result.totalNotifications += source.counts[i];
+            }
+        }
+        std::sort(result.notifications.begin(), result.notifications.end());
+    }
+
+public slots:
+    void count() {
+        const QObject* from = sender();
+        for (Source& source : sources_) {
+            if (source.sender == from) {
+                const int index = senderSignalIndex();
+                if (index >= 0 && index < static_cast<int>(source.counts.size())) {
+                    ++source.counts[static_cast<size_t>(index)];
+                }
+                return;
+            }
+        }
+    }
+};
+
+/**
+ * 连续两次读时钟的耗时（取中位数），作为每次测量的固定开销
+ */
+std::uint64_t measureTimerOverhead() {
+    constexpr int kSamples = 10001;
+    std::vector<std::uint64_t> samples(kSamples);
+    for (auto& sample : samples) {
+        const auto start = Clock::now();
+        sample = elapsedNs(start, Clock::now());
+    }
+    std::nth_element(samples.begin(), samples.begin() + kSamples / 2, samples.end());
+    return samples[kSamples / 2];
+}
+
+LatencyStats summarize(std::vector<std::uint32_t>& samples) {
+    LatencyStats stats;
+    if (samples.empty()) {
+        return stats;
+    }
+    std::sort(samples.begin(), samples.end());
+    // 最近秩法：第 ceil(p * n) 个样本
+    const auto rank = [&samples](double p) -> std::uint64_t {
+        const size_t n = samples.size();
+        size_t index = static_cast<size_t>(std::ceil(p * static_cast<double>(n)));
+        index = std::min(std::max<size_t>(index, 1), n);
+        return samples[index - 1];
+    };
+    double sum = 0.0;
+    for (std::uint32_t sample : samples) {
+        sum += sample;
+    }
+    stats.count = samples.size();
+    stats.meanNs = sum / static_cast<double>(samples.size());
+    stats.minNs = samples.front();
+    stats.p50Ns = rank(0.50);
+    stats.p90Ns = rank(0.90);
+    stats.p99Ns = rank(0.99);
+    stats.p999Ns = rank(0.999);
+    stats.maxNs = samples.back();
+    return stats;
+}
+
+QString compilerName() {
+#if defined(__clang__)
+    return QStringLiteral("clang " __clang_version__);
+#elif defined(__GNUC__)
+    return QStringLiteral("gcc " __VERSION__);
+#elif defined(_MSC_VER)
+    return QStringLiteral("msvc %1").arg(_MSC_FULL_VER);
+#else
+    return QStringLiteral("unknown");
+#endif
+}
+
+} // namespace
+
+const char* opKindName(OpKind kind) {
+    switch (kind) {
+    case OpKind::SetName:
+        return "setName";
+    case OpKind::SetEmail:
+        return "setEmail";
+    case OpKind::SetAge:
+        return "setAge";
+    case OpKind::Save:
+        return "save";
+    case OpKind::Reset:
+        return "reset";
+    }
+    return "unknown";
+}
+
+void Script::append(OpKind kind, const QString& text) {
+    auto it = textIndex.constFind(text);
+    if (it == textIndex.constEnd()) {
+        it = textIndex.insert(text, static_cast<std::uint32_t>(texts.size()));
+        texts.append(text);
+    }
+    ops.push_back(Operation{kind, it.value()});
+}
+
+bool Script::load(const QString& path, Script& script, QString& error) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        error = QStringLiteral("无法打开脚本: %1").arg(file.errorString());
+        return false;
+    }
+
+    script = Script();
+    script.source = path;
+    QTextStream in(&file);
+    in.setCodec("UTF-8");
+    int lineNumber = 0;
+    while (!in.atEnd()) {
+        const QString line = in.readLine();
+        ++lineNumber;
+        if (line.trimmed().isEmpty() || line.trimmed().startsWith('#')) {
+            continue;
+        }
+        // 命令之后的第一个空格之后全部是参数，保留首尾空白
+        const int space = line.indexOf(' ');
+        const QString command = space < 0 ? line.trimmed() : line.left(space);
+        const QString argument = space < 0 ? QString() : line.mid(space + 1);
+
+        if (command == QLatin1String("name")) {
+            script.append(OpKind::SetName, argument);
+        } else if (command == QLatin1String("email")) {
+            script.append(OpKind::SetEmail, argument);
+        } else if (command == QLatin1String("age")) {
+            script.append(OpKind::SetAge, argument);
+        } else if (command == QLatin1String("save")) {
+            script.append(OpKind::Save);
+        } else if (command == QLatin1String("reset")) {
+            script.append(OpKind::Reset);
+        } else {
+            error = QStringLiteral("%1:%2: 未知操作 \"%3\"").arg(path).arg(lineNumber).arg(command);
+            return false;
+        }
+    }
+    return true;
+}
+
+Script Script::generate(std::uint64_t count, std::uint64_t seed) {
+    static const char* const kFamilyNames[] = {"张", "王", "李", "赵", "陈", "刘", "Smith", "García", "Müller", "O'Brien"};
+    static const char* const kGivenNames[] = {"伟", "芳", "娜", "敏", "静", "Alice", "Bob", "Chloé", "Dmitri", "Zoë"};
+    static const char* const kDomains[] = {"example.com", "mail.example.org", "公司.中国", "test.io"};
+    static const char* const kBadAges[] = {"", "-1", "200", "abc", " 42 ", "+7"};
+
+    Script script;
+    script.source = QStringLiteral("generated(count=%1, seed=%2)").arg(count).arg(seed);
+    script.ops.reserve(static_cast<size_t>(count));
+    Random random(seed);
+
+    // 逐键输入：依次追加文本的每个前缀，与输入框的 textChanged 一致
+    const auto type = [&script, count](OpKind kind, const QString& text) {
+        for (int length = 1; length <= text.size() && script.ops.size() < count; ++length) {
+            script.append(kind, text.left(length));
+        }
+    };
+
+    while (script.ops.size() < count) {
+        const std::uint32_t action = random.below(100);
+        if (action < 40) {
+            // 两次取随机数分开写：同一表达式中的实参求值顺序由编译器决定，会使各平台生成的序列不同
+            const char* family = kFamilyNames[random.below(10)];
+            const char* given = kGivenNames[random.below(10)];
+            const QString name = QString::fromUtf8(family) + QString::fromUtf8(given);
+            type(OpKind::SetName, name);
+            // 偶尔删除整个输入
+            if (random.below(10) == 0 && script.ops.size() < count) {
+                script.append(OpKind::SetName, QString());
+            }
+        } else if (action < 75) {
+            QString email = QStringLiteral("user%1").arg(random.below(1000));
+            // 约 20% 缺少 '@'
+            if (random.below(5) != 0) {
+                email += '@';
+                email += QString::fromUtf8(kDomains[random.below(4)]);
+            }
+            type(OpKind::SetEmail, email);
+        } else if (action < 88) {
+            if (random.below(5) == 0) {
+                script.append(OpKind::SetAge, QString::fromUtf8(kBadAges[random.below(6)]));
+            } else {
+                type(OpKind::SetAge, QString::number(random.below(100) + 1));
+            }
+        } else if (action < 97) {
+            script.append(OpKind::Save);
+        } else {
+            script.append(OpKind::Reset);
+        }
+    }
+    return script;
+}
+
+QJsonObject LatencyStats::toJson() const {
+    QJsonObject json;
+    json["count"] = static_cast<double>(count);
+    json["meanNs"] = std::round(meanNs * 10.0) / 10.0;
+    json["minNs"] = static_cast<double>(minNs);
+    json["p50Ns"] = static_cast<double>(p50Ns);
+    json["p90Ns"] = static_cast<double>(p90Ns);
+    json["p99Ns"] = static_cast<double>(p99Ns);
+    json["p999Ns"] = static_cast<double>(p999Ns);
+    json["maxNs"] = static_cast<double>(maxNs);
+    return json;
+}
+
+ReplayResult ReplayDriver::run(const Script& script, const ReplayOptions& options) {
+    ReplayResult result;
+    if (script.ops.empty()) {
+        return result;
+    }
+
+    auto model = std::make_shared<UserModel>();
+    auto viewModel = std::make_shared<UserViewModel>(model);
+    auto collection = std::make_shared<UserCollectionModel>();
+    viewModel->setUserCollection(collection);
+    Command* saveCommand = viewModel->saveCommand();
+    Command* resetCommand = viewModel->resetCommand();
+    auto* asyncSave = qobject_cast<AsyncCommand*>(saveCommand);
+
+    SignalCounter counter;
+    counter.watch(model.get());
+    counter.watch(viewModel.get());
+    counter.watch(collection.get());
+    counter.watch(saveCommand);
+    counter.watch(resetCommand);
+
+    // 文本按下标取出，传参只增加引用计数
+    const auto apply = [&](const Operation& op) {
+        switch (op.kind) {
+        case OpKind::SetName:
+            viewModel->updateName(script.texts[op.text]);
+            break;
+        case OpKind::SetEmail:
+            viewModel->updateEmail(script.texts[op.text]);
+            break;
+        case OpKind::SetAge:
+            viewModel->updateAge(script.texts[op.text]);
+            break;
+        case OpKind::Save:
+            if (saveCommand->canExecute()) {
+                saveCommand->execute();
+                // 等待后台保存完成并在本线程应用到集合
+                while (asyncSave && (asyncSave->isRunning() || asyncSave->queuedCount() > 0)) {
+                    QCoreApplication::processEvents(QEventLoop::WaitForMoreEvents);
+                }
+                QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+            }
+            break;
+        case OpKind::Reset:
+            resetCommand->execute();
+            break;
+        }
+    };
+
+    const size_t scriptSize = script.ops.size();
+    for (std::uint64_t i = 0; i < options.warmupOps; ++i) {
+        apply(script.ops[i % scriptSize]);
+    }
+    counter.reset();
+
+    const int repeat = std::max(options.repeat, 1);
+    std::vector<std::uint32_t> samples[kOpKindCount];
+    {
+        size_t perKind[kOpKindCount] = {};
+        for (const Operation& op : script.ops) {
+            ++perKind[static_cast<int>(op.kind)];
+        }
+        for (int kind = 0; kind < kOpKindCount; ++kind) {
+            samples[kind].reserve(perKind[kind] * static_cast<size_t>(repeat));
+        }
+    }
+
+    result.timerOverheadNs = measureTimerOverhead();
+    const auto begin = Clock::now();
+    for (int pass = 0; pass < repeat; ++pass) {
+        for (const Operation& op : script.ops) {
+            const auto start = Clock::now();
+            apply(op);
+            const std::uint64_t ns = elapsedNs(start, Clock::now());
+            const std::uint64_t net = ns > result.timerOverheadNs ? ns - result.timerOverheadNs : 0;
+            samples[static_cast<int>(op.kind)].push_back(
+                static_cast<std::uint32_t>(std::min<std::uint64_t>(net, UINT32_MAX)));
+        }
+    }
+    result.elapsedNs = static_cast<qint64>(elapsedNs(begin, Clock::now()));
+
+    result.ops = static_cast<std::uint64_t>(scriptSize) * static_cast<std::uint64_t>(repeat);
+    result.opsPerSecond = result.elapsedNs > 0
+        ? static_cast<double>(result.ops) * 1e9 / static_cast<double>(result.elapsedNs)
+        : 0.0;
+    for (int kind = 0; kind < kOpKindCount; ++kind) {
+        result.latency[kind] = summarize(samples[kind]);
+    }
+    counter.collect(result);
+
+    result.savedUsers = static_cast<std::uint64_t>(collection->store().liveCount());
+    result.stateVersion = viewModel->snapshot()->version;
+    result.finalStatus = viewModel->statusMessage();
+    result.peakMemoryBytes = io::peakMemoryBytes();
+    return result;
+}
+
+QJsonObject ReplayDriver::toJson(const Script& script, const ReplayOptions& options, const ReplayResult& result) {
+    QJsonObject config;
+    config["source"] = script.source;
+    config["scriptOps"] = static_cast<double>(script.ops.size());
+    config["distinctTexts"] = script.texts.size();
+    config["repeat"] = std::max(options.repeat, 1);
+    config["warmupOps"] = static_cast<double>(options.warmupOps);
+
+    QJsonObject environment;
+    environment["qt"] = QString::fromLatin1(qVersion());
+    environment["compiler"] = compilerName();
+#ifdef NDEBUG
+    environment["build"] = QStringLiteral("release");
+#else
+    environment["build"] = QStringLiteral("debug");
+#endif
+
+    QJsonObject throughput;
+    throughput["ops"] = static_cast<double>(result.ops);
+    throughput["elapsedMs"] = std::round(static_cast<double>(result.elapsedNs) / 1e3) / 1e3;
+    throughput["opsPerSecond"] = std::round(result.opsPerSecond);
+    throughput["timerOverheadNs"] = static_cast<double>(result.timerOverheadNs);
+
+    QJsonObject latency;
+    for (int kind = 0; kind < kOpKindCount; ++kind) {
+        latency[QLatin1String(opKindName(static_cast<OpKind>(kind)))] = result.latency[kind].toJson();
+    }
+
+    QJsonObject signalCounts;
+    for (const auto& entry : result.notifications) {
+        signalCounts[entry.first] = static_cast<double>(entry.second);
+    }
+    QJsonObject notifications;
+    notifications["total"] = static_cast<double>(result.totalNotifications);
+    notifications["perOp"] = result.ops > 0
+        ? std::round(static_cast<double>(result.totalNotifications) * 1000.0 / static_cast<double>(result.ops)) / 1000.0
+        : 0.0;
+    notifications["signals"] = signalCounts;
+
+    QJsonObject finalState;
+    finalState["savedUsers"] = static_cast<double>(result.savedUsers);
+    finalState["stateVersion"] = static_cast<double>(result.stateVersion);
+    finalState["status"] = result.finalStatus;
+
+    QJsonObject json;
+    json["schema"] = QStringLiteral("mvvm-replay/1");
+    json["config"] = config;
+    json["environment"] = environment;
+    json["throughput"] = throughput;
+    json["latency"] = latency;
+    json["notifications"] = notifications;
+    json["finalState"] = finalState;
+    json["peakMemoryBytes"] = static_cast<double>(result.peakMemoryBytes);
+    return json;
+}
+
+} // namespace replay
+} // namespace mvvm
+
+#include "ReplayDriver.moc"
@@ -0,0 +1,377 @@
+#include "search/UserSearchIndex.h"
+#include <algorithm>
+#include <iterator>
+#include <mutex>
+
+namespace mvvm {
+
+namespace {
+
+// 字段开头锚定字符，不会出现在正常文本中
+constexpr char kAnchor = '\x01';
+
+// 读取 store 时每批持锁的行数
+constexpr std::size_t kStoreBlockRows = 4096;
+
+// 候选集已经很小时，跳过比它大得多的倒排表，交给逐行校验过滤
+constexpr std::size_t kSkipListFactor = 16;
+
+char toLowerAscii(char c) {
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+std::uint32_t makeGram(char a, char b, char c) {
+    return (std::uint32_t(std::uint8_t(a)) << 16) |
+           (std::uint32_t(std::uint8_t(b)) << 8) |
+           std::uint32_t(std::uint8_t(c));
+}
+
+void gramsOf(std::string_view text, std::vector<std::uint32_t>& grams) {
+    for (std::size_t i = 0; i + 2 < text.size(); ++i) {
+        grams.push_back(makeGram(toLowerAscii(text[i]), toLowerAscii(text[i + 1]),
+                                 toLowerAscii(text[i + 2])));
+    }
+}
+
+bool startsWithIgnoreCase(std::string_view text, std::string_view lowerPrefix) {
+    if (text.size() < lowerPrefix.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < lowerPrefix.size(); ++i) {
+        if (toLowerAscii(text[i]) != lowerPrefix[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool containsIgnoreCase(std::string_view text, std::string_view lowerNeedle) {
+    if (text.size() < lowerNeedle.size()) {
+        return false;
+    }
+    const std::size_t last = text.size() - lowerNeedle.size();
+    for (std::size_t i = 0; i <= last; ++i) {
+        if (startsWithIgnoreCase(text.substr(i), lowerNeedle)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void sortUnique(std::vector<RowId>& rows) {
+    std::sort(rows.begin(), rows.end());
+    rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+}
+
+} // namespace
+
+UserSearchIndex::UserSearchIndex()
+    : epoch_(0), postingBytes_(0), abandoned_(false) {
+}
+
+UserSearchIndex::Query UserSearchIndex::parseQuery(std::string_view text) {
+    Query query;
+    if (!text.empty() && text.front() == '^') {
+        query.prefix = true;
+        text.remove_prefix(1);
+    }
+    query.key.reserve(text.size());
+    for (char c : text) {
+        query.key.push_back(toLowerAscii(c));
+    }
+    return query;
+}
+
+bool UserSearchIndex::matches(const UserColumnStore& store, RowId row, const Query& query) {
+    std::string emailBuffer;
+    return matches(store, row, query, emailBuffer);
+}
+
+bool UserSearchIndex::matches(const UserColumnStore& store, RowId row, const Query& query, std::string& emailBuffer) {
+    if (query.empty()) {
+        return true;
+    }
+    if (query.prefix) {
+        return startsWithIgnoreCase(store.name(row), query.key) ||
+               startsWithIgnoreCase(store.email(row, emailBuffer), query.key);
+    }
+    return containsIgnoreCase(store.name(row), query.key) ||
+           containsIgnoreCase(store.email(row, emailBuffer), query.key);
+}
+
+void UserSearchIndex::markDirty(RowId row) {
+    markDirty(row, row + 1);
+}
+
+void UserSearchIndex::markDirty(RowId first, RowId last) {
+    if (first >= last) {
+        return;
+    }
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    if (!pending_.empty() && pending_.back().second == first) {
+        pending_.back().second = last;
+    } else {
+        pending_.emplace_back(first, last);
+    }
+}
+
+void UserSearchIndex::clear() {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    postings_.clear();
+    pending_.clear();
+    inFlight_.clear();
+    postingBytes_ = 0;
+    ++epoch_;
+}
+
+bool UserSearchIndex::hasPending() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return !pending_.empty();
+}
+
+std::size_t UserSearchIndex::indexPending(const UserColumnStore& store, std::size_t maxRows) {
+    if (abandoned_.load()) {
+        return 0;
+    }
+
+    // 1. 取出一批待索引行，期间它们作为 inFlight 继续参与查询
+    std::vector<RowId> batch;
+    std::uint64_t epoch;
+    {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        std::size_t consumed = 0;
+        while (consumed < pending_.size() && batch.size() < maxRows) {
+            auto& range = pending_[consumed];
+            const RowId take = static_cast<RowId>(
+                std::min<std::size_t>(range.second - range.first, maxRows - batch.size()));
+            for (RowId row = range.first; row < range.first + take; ++row) {
+                batch.push_back(row);
+            }
+            range.first += take;
+            if (range.first == range.second) {
+                ++consumed;
+            }
+        }
+        pending_.erase(pending_.begin(), pending_.begin() + static_cast<std::ptrdiff_t>(consumed));
+        inFlight_.insert(inFlight_.end(), batch.begin(), batch.end());
+        epoch = epoch_;
+    }
+    if (batch.empty()) {
+        return 0;
+    }
+
+    // 2. 不持有索引锁计算三元组
+    std::vector<std::pair<std::uint32_t, RowId>> entries;
+    entries.reserve(batch.size() * 24);
+    std::vector<std::uint32_t> grams;
+    std::string emailBuffer;
+    for (std::size_t begin = 0; begin < batch.size(); begin += kStoreBlockRows) {
+        if (abandoned_.load()) {
+            return 0;
+        }
+        std::shared_lock<std::shared_mutex> storeLock(store.mutex());
+        const std::size_t end = std::min(batch.size(), begin + kStoreBlockRows);
+        for (std::size_t i = begin; i < end; ++i) {
+            const RowId row = batch[i];
+            if (row >= store.slotCount() || !store.isAlive(row)) {
+                continue;
+            }
+            grams.clear();
+            collectGrams(store.name(row), grams);
+            collectGrams(store.email(row, emailBuffer), grams);
+            std::sort(grams.begin(), grams.end());
+            grams.erase(std::unique(grams.begin(), grams.end()), grams.end());
+            for (std::uint32_t gram : grams) {
+                entries.emplace_back(gram, row);
+            }
+        }
+    }
+    // 按 (三元组, 行) 排序后，每个倒排表都按 RowId 升序追加
+    std::sort(entries.begin(), entries.end());
+
+    // 3. 写入索引
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    if (epoch != epoch_) {
+        return batch.size(); // 期间被 clear()，结果作废
+    }
+    for (const auto& entry : entries) {
+        appendPosting(postings_[entry.first], entry.second, postingBytes_);
+    }
+    inFlight_.clear();
+    return batch.size();
+}
+
+bool UserSearchIndex::search(const UserColumnStore& store, const Query& query,
+                             std::vector<RowId>& out, const std::function<bool()>& cancelled) const {
+    out.clear();
+
+    std::vector<std::uint32_t> grams;
+    queryGrams(query, grams);
+    const bool scanAll = query.empty() || grams.empty();
+
+    // 1. 由倒排表求候选行
+    std::vector<RowId> candidates;
+    if (!scanAll) {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+
+        std::vector<const PostingList*> lists;
+        bool missing = false;
+        for (std::uint32_t gram : grams) {
+            auto it = postings_.find(gram);
+            if (it == postings_.end()) {
+                missing = true;
+                break;
+            }
+            lists.push_back(&it->second);
+        }
+
+        if (!missing && !lists.empty()) {
+            std::sort(lists.begin(), lists.end(), [](const PostingList* a, const PostingList* b) {
+                return a->count < b->count;
+            });
+            decodePosting(*lists.front(), candidates);
+            if (!lists.front()->unsorted.empty()) {
+                sortUnique(candidates);
+            }
+
+            std::vector<RowId> next;
+            std::vector<RowId> merged;
+            for (std::size_t i = 1; i < lists.size(); ++i) {
+                if (cancelled()) {
+                    return false;
+                }
+                if (lists[i]->count > candidates.size() * kSkipListFactor + 1024) {
+                    break; // 其余表更大，收益不抵解码成本
+                }
+                next.clear();
+                decodePosting(*lists[i], next);
+                if (!lists[i]->unsorted.empty()) {
+                    sortUnique(next);
+                }
+                merged.clear();
+                std::set_intersection(candidates.begin(), candidates.end(),
+                                      next.begin(), next.end(), std::back_inserter(merged));
+                candidates.swap(merged);
+            }
+        }
+
+        // 尚未进入索引的行全部作为候选
+        expandPending(candidates);
+    }
+    if (!scanAll) {
+        sortUnique(candidates);
+    }
+
+    // 2. 对照当前数据逐行校验
+    const std::size_t total = scanAll ? store.slotCount() : candidates.size();
+    std::string emailBuffer;
+    for (std::size_t begin = 0; begin < total; begin += kStoreBlockRows) {
+        if (cancelled()) {
+            return false;
+        }
+        std::shared_lock<std::shared_mutex> storeLock(store.mutex());
+        const std::size_t end = std::min(total, begin + kStoreBlockRows);
+        for (std::size_t i = begin; i < end; ++i) {
+            const RowId row = scanAll ? static_cast<RowId>(i) : candidates[i];
+            if (row < store.slotCount() && store.isAlive(row) && matches(store, row, query, emailBuffer)) {
+                out.push_back(row);
+            }
+        }
+    }
+    return true;
+}
+
+std::size_t UserSearchIndex::gramCount() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return postings_.size();
+}
+
+std::size_t UserSearchIndex::postingBytes() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return postingBytes_;
+}
+
+void UserSearchIndex::collectGrams(std::string_view field, std::vector<std::uint32_t>& grams) {
+    if (field.empty()) {
+        return;
+    }
+    // 两个锚定三元组："^^a" 与 "^ab"，支持长度 1、2 的前缀查询
+    grams.push_back(makeGram(kAnchor, kAnchor, toLowerAscii(field[0])));
+    if (field.size() >= 2) {
+        grams.push_back(makeGram(kAnchor, toLowerAscii(field[0]), toLowerAscii(field[1])));
+    }
+    gramsOf(field, grams);
+}
+
+void UserSearchIndex::queryGrams(const Query& query, std::vector<std::uint32_t>& grams) {
+    if (query.empty()) {
+        return;
+    }
+    if (query.prefix) {
+        std::string anchored(2, kAnchor);
+        anchored += query.key;
+        gramsOf(anchored, grams);
+    } else {
+        gramsOf(query.key, grams);
+    }
+    std::sort(grams.begin(), grams.end());
+    grams.erase(std::unique(grams.begin(), grams.end()), grams.end());
+}
+
+void UserSearchIndex::appendPosting(PostingList& list, RowId row, std::size_t& bytes) {
+    if (list.count > 0 && row == list.last) {
+        return;
+    }
+    if (list.count > 0 && row < list.last) {
+        list.unsorted.push_back(row);
+        bytes += sizeof(RowId);
+        ++list.count;
+        return;
+    }
+
+    // LEB128 变长整数
+    std::uint32_t delta = list.count == 0 ? row : row - list.last;
+    do {
+        std::uint8_t byte = delta & 0x7F;
+        delta >>= 7;
+        if (delta) {
+            byte |= 0x80;
+        }
+        list.bytes.push_back(byte);
+        ++bytes;
+    } while (delta);
+    list.last = row;
+    ++list.count;
+}
+
+void UserSearchIndex::decodePosting(const PostingList& list, std::vector<RowId>& out) {
+    out.reserve(out.size() + list.count);
+    RowId current = 0;
+    bool first = true;
+    std::size_t i = 0;
+    while (i < list.bytes.size()) {
+        std::uint32_t delta = 0;
+        int shift = 0;
+        std::uint8_t byte;
+        do {
+            byte = list.bytes[i++];
+            delta |= std::uint32_t(byte & 0x7F) << shift;
+            shift += 7;
+        } while (byte & 0x80);
+        current = first ? delta : current + delta;
+        first = false;
+        out.push_back(current);
+    }
+    out.insert(out.end(), list.unsorted.begin(), list.unsorted.end());
+}
+
+void UserSearchIndex::expandPending(std::vector<RowId>& out) const {
+    for (const auto& range : pending_) {
+        for (RowId row = range.first; row < range.second; ++row) {
+            out.push_back(row);
+        }
+    }
+    out.insert(out.end(), inFlight_.begin(), inFlight_.end());
+}
+
+} // namespace mvvm
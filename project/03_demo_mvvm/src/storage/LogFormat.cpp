@@ -0,0 +1,164 @@
+#include "storage/LogFormat.h"
+#include <array>
+#include <cstring>
+
+namespace mvvm {
+namespace storage {
+
+namespace {
+
+constexpr std::size_t kFixedPayloadBytes = 8 + 1 + 4 + 4 + 4;
+constexpr char kSnapshotMagic[] = "MVUSNAP1";
+constexpr char kSnapshotEndMagic[] = "MVUSEND1";
+
+std::array<std::uint32_t, 256> makeCrcTable() {
+    std::array<std::uint32_t, 256> table{};
+    for (std::uint32_t i = 0; i < 256; ++i) {
+        std::uint32_t c = i;
+        for (int k = 0; k < 8; ++k) {
+            c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+        }
+        table[i] = c;
+    }
+    return table;
+}
+
+void putU32(std::string& out, std::uint32_t value) {
+    for (int i = 0; i < 4; ++i) {
+        out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+    }
+}
+
+void putU64(std::string& out, std::uint64_t value) {
+    for (int i = 0; i < 8; ++i) {
+        out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+    }
+}
+
+void patchU32(std::string& out, std::size_t pos, std::uint32_t value) {
+    for (int i = 0; i < 4; ++i) {
+        out[pos + i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+    }
+}
+
+std::uint32_t getU32(const char* p) {
+    std::uint32_t value = 0;
+    for (int i = 0; i < 4; ++i) {
+        value |= std::uint32_t(std::uint8_t(p[i])) << (8 * i);
+    }
+    return value;
+}
+
+std::uint64_t getU64(const char* p) {
+    std::uint64_t value = 0;
+    for (int i = 0; i < 8; ++i) {
+        value |= std::uint64_t(std::uint8_t(p[i])) << (8 * i);
+    }
+    return value;
+}
+
+} // namespace
+
+std::uint32_t crc32(const void* data, std::size_t size) {
+    static const std::array<std::uint32_t, 256> table = makeCrcTable();
+    const auto* bytes = static_cast<const std::uint8_t*>(data);
+    std::uint32_t c = 0xFFFFFFFFu;
+    for (std::size_t i = 0; i < size; ++i) {
+        c = table[(c ^ bytes[i]) & 0xFF] ^ (c >> 8);
+    }
+    return c ^ 0xFFFFFFFFu;
+}
+
+void encodeRecord(std::string& out, const LogRecord& record) {
+    const std::size_t headerPos = out.size();
+    putU32(out, 0);
+    putU32(out, 0);
+
+    const std::size_t payloadPos = out.size();
+    putU64(out, record.seq);
+    out.push_back(static_cast<char>(record.op));
+    putU32(out, static_cast<std::uint32_t>(record.age));
+    putU32(out, static_cast<std::uint32_t>(record.name.size()));
+    out.append(record.name.data(), record.name.size());
+    putU32(out, static_cast<std::uint32_t>(record.email.size()));
+    out.append(record.email.data(), record.email.size());
+
+    const std::size_t payloadSize = out.size() - payloadPos;
+    patchU32(out, headerPos, static_cast<std::uint32_t>(payloadSize));
+    patchU32(out, headerPos + 4, crc32(out.data() + payloadPos, payloadSize));
+}
+
+void encodeSnapshotHeader(std::string& out, std::uint64_t lastSeq, std::uint64_t count) {
+    out.append(kSnapshotMagic, 8);
+    putU64(out, lastSeq);
+    putU64(out, count);
+}
+
+bool decodeSnapshotHeader(const char* data, std::size_t size,
+                          std::uint64_t& lastSeq, std::uint64_t& count) {
+    if (size < kSnapshotHeaderBytes || std::memcmp(data, kSnapshotMagic, 8) != 0) {
+        return false;
+    }
+    lastSeq = getU64(data + 8);
+    count = getU64(data + 16);
+    return true;
+}
+
+void encodeSnapshotFooter(std::string& out) {
+    out.append(kSnapshotEndMagic, 8);
+}
+
+bool isSnapshotFooter(const char* data, std::size_t size) {
+    return size == kSnapshotFooterBytes && std::memcmp(data, kSnapshotEndMagic, 8) == 0;
+}
+
+DecodeStatus decodeRecord(const char* data, std::size_t size,
+                          LogRecord& record, std::size_t& consumed) {
+    if (size < kRecordHeaderBytes) {
+        return DecodeStatus::Incomplete;
+    }
+    const std::uint32_t payloadSize = getU32(data);
+    if (payloadSize < kFixedPayloadBytes || payloadSize > kMaxPayloadBytes) {
+        return DecodeStatus::Corrupt;
+    }
+    if (size - kRecordHeaderBytes < payloadSize) {
+        return DecodeStatus::Incomplete;
+    }
+
+    const char* p = data + kRecordHeaderBytes;
+    if (crc32(p, payloadSize) != getU32(data + 4)) {
+        return DecodeStatus::Corrupt;
+    }
+
+    const char* end = p + payloadSize;
+    record.seq = getU64(p);
+    p += 8;
+    const auto op = static_cast<std::uint8_t>(*p++);
+    if (op != static_cast<std::uint8_t>(LogOp::Upsert) && op != static_cast<std::uint8_t>(LogOp::Delete)) {
+        return DecodeStatus::Corrupt;
+    }
+    record.op = static_cast<LogOp>(op);
+    record.age = static_cast<std::int32_t>(getU32(p));
+    p += 4;
+
+    const std::uint32_t nameSize = getU32(p);
+    p += 4;
+    if (static_cast<std::size_t>(end - p) < std::size_t(nameSize) + 4) {
+        return DecodeStatus::Corrupt;
+    }
+    record.name = std::string_view(p, nameSize);
+    p += nameSize;
+
+    const std::uint32_t emailSize = getU32(p);
+    p += 4;
+    if (static_cast<std::size_t>(end - p) != emailSize) {
+        return DecodeStatus::Corrupt;
+    }
+    record.email = std::string_view(p, emailSize);
+
+    consumed = kRecordHeaderBytes + payloadSize;
+    return DecodeStatus::Ok;
+}
+
+} // namespace storage
+} // namespace mvvm
@@ -0,0 +1,556 @@
+#include "storage/UserStore.h"
+#include "storage/LogFormat.h"
+#include "common/Metrics.h"
+#include "common/QtTaskBridge.h"
+#include <QDebug>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <algorithm>
+#include <chrono>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace mvvm {
+namespace storage {
+
+namespace {
+
+const char* const kSnapshotName = "users.snapshot";
+
+// 单组记录的上限，避免 Batched 窗口内积压过多导致单次写入过大
+constexpr std::size_t kMaxGroupRecords = 64 * 1024;
+constexpr std::size_t kSnapshotBufferBytes = 1024 * 1024;
+
+struct CommitMetrics {
+    common::Counter& records;
+    common::Histogram& groupSize;
+    common::Histogram& latency;
+};
+
+const CommitMetrics& commitMetrics() {
+    static const CommitMetrics metrics{
+        common::MetricsRegistry::global().counter("mvvm_store_records_total", "写入日志的记录数"),
+        common::MetricsRegistry::global().histogram(
+            "mvvm_store_commit_records", "每次组提交包含的记录数", kMaxGroupRecords),
+        common::MetricsRegistry::global().latencyHistogram(
+            "mvvm_store_commit_duration_seconds", "一次组提交写入并刷盘的耗时")};
+    return metrics;
+}
+
+QString segmentName(std::uint64_t firstSeq) {
+    // 定长十进制序号，文件名的字典序即序号顺序
+    return QString("users-%1.log").arg(qulonglong(firstSeq), 20, 10, QChar('0'));
+}
+
+std::uint64_t segmentFirstSeq(const QString& fileName) {
+    return fileName.mid(6, 20).toULongLong();
+}
+
+QStringList listSegments(const QDir& dir) {
+    return dir.entryList({"users-*.log"}, QDir::Files, QDir::Name);
+}
+
+bool syncFile(QFile& file) {
+#ifdef _WIN32
+    return _commit(file.handle()) == 0;
+#elif defined(__linux__)
+    return ::fdatasync(file.handle()) == 0;
+#else
+    return ::fsync(file.handle()) == 0;
+#endif
+}
+
+// 新建或删除文件后刷新目录项，保证文件本身在掉电后仍可见
+void syncDirectory(const QString& path) {
+#ifndef _WIN32
+    const int fd = ::open(QFile::encodeName(path).constData(), O_RDONLY);
+    if (fd >= 0) {
+        ::fsync(fd);
+        ::close(fd);
+    }
+#else
+    Q_UNUSED(path);
+#endif
+}
+
+void applyRecord(UserState& state, const LogRecord& record) {
+    std::string email(record.email);
+    if (record.op == LogOp::Delete) {
+        state.erase(email);
+        return;
+    }
+    StoredUser& user = state[std::move(email)];
+    user.name.assign(record.name.data(), record.name.size());
+    user.age = record.age;
+    user.seq = record.seq;
+}
+
+/**
+ * 回放一个内存映射的区间，返回成功解码的字节数
+ */
+std::size_t replay(const char* data, std::size_t size, std::uint64_t afterSeq,
+                   UserState& state, std::uint64_t& lastSeq, qint64& applied, DecodeStatus& stop) {
+    std::size_t pos = 0;
+    stop = DecodeStatus::Ok;
+    while (pos < size) {
+        LogRecord record;
+        std::size_t consumed = 0;
+        stop = decodeRecord(data + pos, size - pos, record, consumed);
+        if (stop != DecodeStatus::Ok) {
+            break;
+        }
+        if (record.seq > afterSeq) {
+            applyRecord(state, record);
+            lastSeq = std::max(lastSeq, record.seq);
+            ++applied;
+        }
+        pos += consumed;
+    }
+    return pos;
+}
+
+const char* durabilityName(Durability durability) {
+    switch (durability) {
+    case Durability::None:
+        return "none";
+    case Durability::Sync:
+        return "sync";
+    default:
+        return "batched";
+    }
+}
+
+} // namespace
+
+Durability durabilityFromString(const QString& text, Durability fallback) {
+    const QString key = text.trimmed().toLower();
+    if (key == "none") {
+        return Durability::None;
+    }
+    if (key == "batched") {
+        return Durability::Batched;
+    }
+    if (key == "sync") {
+        return Durability::Sync;
+    }
+    return fallback;
+}
+
+QString RecoveryStats::summary() const {
+    return QString("恢复完成：快照 %1 条，回放日志 %2 条（%3 个日志段），截断尾部 %4 字节，用时 %5 ms")
+        .arg(snapshotRecords)
+        .arg(replayedRecords)
+        .arg(segments)
+        .arg(truncatedBytes)
+        .arg(elapsedMs);
+}
+
+UserStore::UserStore(QObject* parent)
+    : QObject(parent),
+      state_(State::Closed),
+      recoveryWatcher_(new QFutureWatcher<std::shared_ptr<RecoveryResult>>(this)),
+      stopping_(false),
+      lastSeq_(0),
+      segmentSize_(0),
+      recordsSinceSnapshot_(0),
+      records_(0),
+      groups_(0),
+      syncs_(0),
+      snapshots_(0),
+      committedSeq_(0),
+      notifyPending_(false) {
+
+    connect(recoveryWatcher_, &QFutureWatcherBase::finished,
+            this, &UserStore::onRecoveryFinished);
+}
+
+UserStore::~UserStore() {
+    recoveryWatcher_->waitForFinished();
+    close();
+}
+
+void UserStore::open(const StoreOptions& options) {
+    if (state_ != State::Closed) {
+        return;
+    }
+    options_ = options;
+    state_ = State::Recovering;
+
+    const QString directory = options_.directory;
+    recoveryWatcher_->setFuture(common::qt::future([directory]() {
+        return std::make_shared<RecoveryResult>(UserStore::recover(directory));
+    }, common::TaskPriority::High));
+}
+
+void UserStore::close() {
+    if (writer_.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(queueMutex_);
+            stopping_ = true;
+        }
+        queueCv_.notify_one();
+        writer_.join();
+    }
+    snapshotFuture_.waitForFinished();
+    if (state_ == State::Open) {
+        state_ = State::Closed;
+    }
+}
+
+void UserStore::save(const QString& name, const QString& email, int age) {
+    PendingRecord record;
+    record.name = name.toStdString();
+    record.email = email.toStdString();
+    record.age = age;
+    enqueue(std::move(record));
+}
+
+void UserStore::remove(const QString& email) {
+    PendingRecord record;
+    record.remove = true;
+    record.email = email.toStdString();
+    enqueue(std::move(record));
+}
+
+UserStore::Stats UserStore::stats() const {
+    Stats result;
+    result.records = records_.load();
+    result.groups = groups_.load();
+    result.syncs = syncs_.load();
+    result.snapshots = snapshots_.load();
+    result.committedSeq = committedSeq_.load();
+    return result;
+}
+
+RecoveryResult UserStore::recover(const QString& directory) {
+    QElapsedTimer timer;
+    timer.start();
+
+    RecoveryResult result;
+    QDir dir(directory);
+    if (!dir.mkpath(".")) {
+        result.error = QString("无法创建存储目录: %1").arg(directory);
+        return result;
+    }
+
+    // 1. 快照
+    std::uint64_t snapshotSeq = 0;
+    QFile snapshot(dir.filePath(kSnapshotName));
+    if (snapshot.exists() && snapshot.size() > 0) {
+        if (!snapshot.open(QIODevice::ReadOnly)) {
+            result.error = snapshot.errorString();
+            return result;
+        }
+        const qint64 size = snapshot.size();
+        const uchar* mapped = snapshot.map(0, size);
+        if (!mapped) {
+            result.error = snapshot.errorString();
+            return result;
+        }
+        const char* data = reinterpret_cast<const char*>(mapped);
+        std::uint64_t count = 0;
+        bool valid = size >= qint64(kSnapshotHeaderBytes + kSnapshotFooterBytes) &&
+                     decodeSnapshotHeader(data, std::size_t(size), snapshotSeq, count);
+        if (valid) {
+            const std::size_t bodySize = std::size_t(size) - kSnapshotHeaderBytes - kSnapshotFooterBytes;
+            std::uint64_t unusedSeq = 0;
+            DecodeStatus stop;
+            const std::size_t used = replay(data + kSnapshotHeaderBytes, bodySize, 0, result.state,
+                                            unusedSeq, result.stats.snapshotRecords, stop);
+            valid = used == bodySize && std::uint64_t(result.stats.snapshotRecords) == count &&
+                    isSnapshotFooter(data + kSnapshotHeaderBytes + bodySize, kSnapshotFooterBytes);
+        }
+        snapshot.unmap(const_cast<uchar*>(mapped));
+        if (!valid) {
+            result.error = QString("快照文件已损坏: %1").arg(snapshot.fileName());
+            return result;
+        }
+    }
+    result.lastSeq = snapshotSeq;
+
+    // 2. 日志段：跳过快照已覆盖的记录，只有最后一段允许有被中断的尾部
+    const QStringList segments = listSegments(dir);
+    for (int i = 0; i < segments.size(); ++i) {
+        QFile file(dir.filePath(segments[i]));
+        const qint64 size = file.size();
+        ++result.stats.segments;
+        if (size == 0) {
+            continue;
+        }
+        if (!file.open(QIODevice::ReadWrite)) {
+            result.error = file.errorString();
+            return result;
+        }
+        const uchar* mapped = file.map(0, size);
+        if (!mapped) {
+            result.error = file.errorString();
+            return result;
+        }
+        DecodeStatus stop;
+        const std::size_t used = replay(reinterpret_cast<const char*>(mapped), std::size_t(size),
+                                        snapshotSeq, result.state, result.lastSeq,
+                                        result.stats.replayedRecords, stop);
+        file.unmap(const_cast<uchar*>(mapped));
+
+        if (used < std::size_t(size)) {
+            const bool lastSegment = i + 1 == segments.size();
+            if (!lastSegment) {
+                // 中间的日志段损坏时继续回放会跳过一段历史，交给人工处理
+                result.error = QString("日志段 %1 在偏移 %2 处损坏").arg(segments[i]).arg(used);
+                return result;
+            }
+            if (!file.resize(qint64(used))) {
+                result.error = file.errorString();
+                return result;
+            }
+            result.stats.truncatedBytes += size - qint64(used);
+            qWarning() << "截断日志尾部" << segments[i] << (size - qint64(used)) << "字节"
+                       << (stop == DecodeStatus::Corrupt ? "(校验失败)" : "(写入未完成)");
+        }
+    }
+
+    // 3. 按保存顺序生成列式存储
+    std::vector<std::pair<std::uint64_t, const UserState::value_type*>> ordered;
+    ordered.reserve(result.state.size());
+    for (const auto& entry : result.state) {
+        ordered.emplace_back(entry.second.seq, &entry);
+    }
+    std::sort(ordered.begin(), ordered.end(),
+              [](const auto& a, const auto& b) { return a.first < b.first; });
+    result.users.reserve(ordered.size());
+    for (const auto& item : ordered) {
+        result.users.appendUnvalidated(item.second->second.name, item.second->first, item.second->second.age);
+    }
+    result.users.revalidate(0, static_cast<RowId>(result.users.slotCount()));
+
+    result.stats.elapsedMs = timer.elapsed();
+    result.ok = true;
+    return result;
+}
+
+void UserStore::onRecoveryFinished() {
+    std::shared_ptr<RecoveryResult> result = recoveryWatcher_->future().result();
+    if (!result->ok) {
+        state_ = State::Failed;
+        {
+            std::lock_guard<std::mutex> lock(queueMutex_);
+            queue_.clear();
+        }
+        qWarning() << "用户存储打开失败:" << result->error;
+        emit failed(result->error);
+        return;
+    }
+
+    // 写线程接管恢复出的状态
+    userState_ = std::move(result->state);
+    lastSeq_ = result->lastSeq;
+    committedSeq_.store(lastSeq_);
+    recordsSinceSnapshot_ = quint64(result->stats.replayedRecords);
+
+    QString error;
+    if (!openSegment(&error)) {
+        state_ = State::Failed;
+        emit failed(error);
+        return;
+    }
+    state_ = State::Open;
+    qDebug() << result->stats.summary() << "持久化级别:" << durabilityName(options_.durability);
+
+    emit recovered(result);
+    writer_ = std::thread([this]() { writerLoop(); });
+}
+
+void UserStore::notifyCommitted() {
+    notifyPending_.store(false);
+    emit committed(committedSeq_.load());
+}
+
+void UserStore::onWriterFailed(const QString& error) {
+    state_ = State::Failed;
+    qWarning() << "用户存储写入失败:" << error;
+    emit failed(error);
+}
+
+void UserStore::enqueue(PendingRecord&& record) {
+    if (state_ == State::Failed) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        queue_.push_back(std::move(record));
+    }
+    queueCv_.notify_one();
+}
+
+void UserStore::writerLoop() {
+    const CommitMetrics& metrics = commitMetrics();
+    std::vector<PendingRecord> batch;
+    std::string buffer;
+
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(queueMutex_);
+            queueCv_.wait(lock, [this]() { return !queue_.empty() || stopping_; });
+            if (queue_.empty()) {
+                break; // stopping_ 且队列已清空
+            }
+            // 组提交窗口：等待更多记录加入同一组
+            if (options_.durability == Durability::Batched && !stopping_) {
+                const auto deadline = std::chrono::steady_clock::now() +
+                                      std::chrono::milliseconds(options_.groupCommitMs);
+                queueCv_.wait_until(lock, deadline, [this]() {
+                    return stopping_ || queue_.size() >= kMaxGroupRecords;
+                });
+            }
+            batch.swap(queue_);
+        }
+
+        // 1. 编码并应用到内存状态
+        buffer.clear();
+        for (const PendingRecord& pending : batch) {
+            LogRecord record;
+            record.seq = ++lastSeq_;
+            record.op = pending.remove ? LogOp::Delete : LogOp::Upsert;
+            record.age = pending.age;
+            record.name = pending.name;
+            record.email = pending.email;
+            encodeRecord(buffer, record);
+            applyRecord(userState_, record);
+        }
+
+        // 2. 一次写入，按级别刷盘
+        const qint64 size = qint64(buffer.size());
+        bool ok;
+        {
+            common::LatencyTimer timer(metrics.latency);
+            ok = segment_->write(buffer.data(), size) == size;
+            if (ok && options_.durability != Durability::None) {
+                ok = syncFile(*segment_);
+                syncs_.fetch_add(1);
+            }
+        }
+        if (!ok) {
+            QMetaObject::invokeMethod(this, "onWriterFailed", Qt::QueuedConnection,
+                                      Q_ARG(QString, segment_->errorString()));
+            return;
+        }
+        segmentSize_ += size;
+        records_.fetch_add(batch.size());
+        groups_.fetch_add(1);
+        metrics.records.add(batch.size());
+        metrics.groupSize.record(static_cast<std::int64_t>(batch.size()));
+        recordsSinceSnapshot_ += batch.size();
+        batch.clear();
+
+        // 3. 通知 GUI 线程（合并为一次排队调用）
+        committedSeq_.store(lastSeq_);
+        if (!notifyPending_.exchange(true)) {
+            QMetaObject::invokeMethod(this, "notifyCommitted", Qt::QueuedConnection);
+        }
+
+        // 4. 轮转与快照
+        QString error;
+        if (recordsSinceSnapshot_ >= options_.snapshotEveryRecords && !snapshotFuture_.isRunning()) {
+            if (!rotateSegment(&error)) {
+                QMetaObject::invokeMethod(this, "onWriterFailed", Qt::QueuedConnection, Q_ARG(QString, error));
+                return;
+            }
+            startSnapshot();
+        } else if (segmentSize_ >= options_.segmentBytes && !rotateSegment(&error)) {
+            QMetaObject::invokeMethod(this, "onWriterFailed", Qt::QueuedConnection, Q_ARG(QString, error));
+            return;
+        }
+    }
+
+    syncFile(*segment_);
+    segment_->close();
+}
+
+bool UserStore::openSegment(QString* error) {
+    const QDir dir(options_.directory);
+    segment_ = std::make_unique<QFile>(dir.filePath(segmentName(lastSeq_ + 1)));
+    // 不经过 QFile 自身的缓冲，每组记录直接一次写入操作系统
+    if (!segment_->open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Unbuffered)) {
+        *error = segment_->errorString();
+        return false;
+    }
+    segmentSize_ = segment_->size();
+    syncDirectory(options_.directory);
+    return true;
+}
+
+bool UserStore::rotateSegment(QString* error) {
+    if (segmentSize_ == 0) {
+        return true;
+    }
+    syncFile(*segment_);
+    segment_->close();
+    return openSegment(error);
+}
+
+void UserStore::startSnapshot() {
+    // 复制当前状态，写线程立即继续处理新的提交
+    auto entries = std::make_shared<std::vector<std::pair<std::string, StoredUser>>>(
+        userState_.begin(), userState_.end());
+    const std::uint64_t lastSeq = lastSeq_;
+    const QString directory = options_.directory;
+    recordsSinceSnapshot_ = 0;
+
+    // 快照是后台维护，低优先级；写线程本身是专用线程，不占用调度器
+    snapshotFuture_ = common::qt::future([this, entries, lastSeq, directory]() {
+        std::sort(entries->begin(), entries->end(),
+                  [](const auto& a, const auto& b) { return a.second.seq < b.second.seq; });
+
+        QDir dir(directory);
+        QSaveFile file(dir.filePath(kSnapshotName));
+        if (!file.open(QIODevice::WriteOnly)) {
+            qWarning() << "快照写入失败:" << file.errorString();
+            return;
+        }
+        std::string buffer;
+        buffer.reserve(kSnapshotBufferBytes + 4096);
+        encodeSnapshotHeader(buffer, lastSeq, entries->size());
+        for (const auto& entry : *entries) {
+            LogRecord record;
+            record.seq = entry.second.seq;
+            record.op = LogOp::Upsert;
+            record.age = entry.second.age;
+            record.name = entry.second.name;
+            record.email = entry.first;
+            encodeRecord(buffer, record);
+            if (buffer.size() >= kSnapshotBufferBytes) {
+                file.write(buffer.data(), qint64(buffer.size()));
+                buffer.clear();
+            }
+        }
+        encodeSnapshotFooter(buffer);
+        file.write(buffer.data(), qint64(buffer.size()));
+        if (!file.commit()) {
+            qWarning() << "快照写入失败:" << file.errorString();
+            return;
+        }
+
+        // 快照已覆盖 lastSeq 之前的全部记录，删除完全落在其中的旧日志段
+        const QStringList segments = listSegments(dir);
+        for (const QString& name : segments) {
+            if (segmentFirstSeq(name) <= lastSeq) {
+                QFile::remove(dir.filePath(name));
+            }
+        }
+        syncDirectory(directory);
+        snapshots_.fetch_add(1);
+    }, common::TaskPriority::Low);
+}
+
+} // namespace storage
+} // namespace mvvm
+
+#include "UserStore.moc"
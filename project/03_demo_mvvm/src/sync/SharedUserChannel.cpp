@@ -0,0 +1,491 @@
+#include "sync/SharedUserChannel.h"
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cstring>
+
+#ifdef __linux__
+#include <cerrno>
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <pthread.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+namespace mvvm {
+namespace sync {
+
+#ifdef __linux__
+
+namespace {
+
+constexpr std::uint32_t kMagic = 0x5356564d;    // "MVVS"
+constexpr std::uint32_t kLayoutVersion = 1;
+
+static_assert(std::atomic<std::uint32_t>::is_always_lock_free &&
+              std::atomic<std::uint64_t>::is_always_lock_free,
+              "共享内存中的原子量必须无锁");
+
+struct SharedText {
+    std::uint32_t size;
+    char data[SharedUserChannel::kMaxTextBytes];
+};
+
+struct SharedRecord {
+    SharedText name;
+    SharedText email;
+    std::int32_t age;
+    std::uint32_t fields;
+    std::uint64_t writer;
+};
+
+struct RingSlot {
+    // 写入期间为 0，写完后为该条记录的序号
+    std::atomic<std::uint64_t> sequence;
+    SharedRecord record;
+};
+
+std::size_t utf8Prefix(const std::string& text) {
+    if (text.size() <= SharedUserChannel::kMaxTextBytes) {
+        return text.size();
+    }
+    std::size_t size = SharedUserChannel::kMaxTextBytes;
+    // 不截断在多字节字符中间
+    while (size > 0 && (static_cast<unsigned char>(text[size]) & 0xc0) == 0x80) {
+        --size;
+    }
+    return size;
+}
+
+void storeText(SharedText& target, const std::string& text) {
+    const std::size_t size = utf8Prefix(text);
+    std::memcpy(target.data, text.data(), size);
+    target.size = static_cast<std::uint32_t>(size);
+}
+
+void loadText(const SharedText& source, std::string& text) {
+    text.assign(source.data, std::min<std::size_t>(source.size, SharedUserChannel::kMaxTextBytes));
+}
+
+void storeRecord(SharedRecord& record, const SharedUser& user, std::uint32_t fields, std::uint64_t writer) {
+    storeText(record.name, user.name);
+    storeText(record.email, user.email);
+    record.age = user.age;
+    record.fields = fields;
+    record.writer = writer;
+}
+
+// 整体状态只覆盖本次发布的字段，与读者按序号逐条合并环形缓冲区的结果一致
+void mergeRecord(SharedRecord& state, const SharedUser& user, std::uint32_t fields, std::uint64_t writer) {
+    if (fields & SharedUserChannel::Name) {
+        storeText(state.name, user.name);
+    }
+    if (fields & SharedUserChannel::Email) {
+        storeText(state.email, user.email);
+    }
+    if (fields & SharedUserChannel::Age) {
+        state.age = user.age;
+    }
+    state.fields = SharedUserChannel::AllFields;
+    state.writer = writer;
+}
+
+std::uint32_t differingFields(const SharedUser& a, const SharedUser& b) {
+    std::uint32_t fields = 0;
+    if (a.name.compare(0, std::string::npos, b.name.data(), utf8Prefix(b.name)) != 0) {
+        fields |= SharedUserChannel::Name;
+    }
+    if (a.email.compare(0, std::string::npos, b.email.data(), utf8Prefix(b.email)) != 0) {
+        fields |= SharedUserChannel::Email;
+    }
+    if (a.age != b.age) {
+        fields |= SharedUserChannel::Age;
+    }
+    return fields;
+}
+
+} // namespace
+
+/**
+ * 共享区布局；所有进程以相同的布局版本映射
+ */
+struct SharedUserChannel::Region {
+    std::atomic<std::uint32_t> magic;
+    std::uint32_t layoutVersion;
+    std::uint32_t regionSize;
+    pthread_mutex_t writeLock;                // 进程间共享、健壮的写锁
+    std::atomic<std::uint32_t> wakeWord;      // futex：每次发布加一
+    std::atomic<std::uint64_t> head;          // 最后发布的序号（即状态版本号）
+    std::atomic<std::uint32_t> stateSequence; // 状态的 seqlock，写入期间为奇数
+    SharedRecord state;
+    RingSlot ring[kRingSize];
+};
+
+namespace {
+
+std::string shmName(const std::string& name) {
+    return "/mvvm-" + name;
+}
+
+long futex(std::atomic<std::uint32_t>* word, int op, std::uint32_t value, const timespec* timeout) {
+    // 不用 FUTEX_PRIVATE_FLAG：等待者在其他进程中
+    return syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(word), op, value, timeout, nullptr, 0);
+}
+
+void setError(std::string* error, const std::string& message) {
+    if (error) {
+        *error = message + ": " + std::strerror(errno);
+    }
+}
+
+class WriteLock {
+public:
+    explicit WriteLock(pthread_mutex_t* mutex, std::atomic<std::uint32_t>& stateSequence) : mutex_(mutex) {
+        if (pthread_mutex_lock(mutex_) == EOWNERDEAD) {
+            // 持锁的进程在写入途中退出：状态可能不完整，让读者不再等待
+            if (stateSequence.load(std::memory_order_relaxed) & 1) {
+                stateSequence.fetch_add(1, std::memory_order_release);
+            }
+            pthread_mutex_consistent(mutex_);
+        }
+    }
+    ~WriteLock() { pthread_mutex_unlock(mutex_); }
+
+private:
+    pthread_mutex_t* mutex_;
+};
+
+bool initializeLock(pthread_mutex_t* mutex) {
+    pthread_mutexattr_t attributes;
+    pthread_mutexattr_init(&attributes);
+    pthread_mutexattr_setpshared(&attributes, PTHREAD_PROCESS_SHARED);
+    pthread_mutexattr_setrobust(&attributes, PTHREAD_MUTEX_ROBUST);
+    const bool ok = pthread_mutex_init(mutex, &attributes) == 0;
+    pthread_mutexattr_destroy(&attributes);
+    return ok;
+}
+
+} // namespace
+
+SharedUserChannel::SharedUserChannel()
+    : region_(nullptr), eventFd_(-1), writerId_(0), lastSeen_(0), needSnapshot_(false), stopping_(false) {
+}
+
+SharedUserChannel::~SharedUserChannel() {
+    close();
+}
+
+bool SharedUserChannel::open(const std::string& name, std::string* error) {
+    close();
+    if (name.empty() || name.find('/') != std::string::npos) {
+        errno = EINVAL;
+        setError(error, "无效的共享区名称");
+        return false;
+    }
+
+    const std::string path = shmName(name);
+    bool created = true;
+    int fd = shm_open(path.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0600);
+    if (fd < 0 && errno == EEXIST) {
+        created = false;
+        fd = shm_open(path.c_str(), O_RDWR | O_CLOEXEC, 0600);
+    }
+    if (fd < 0) {
+        setError(error, "无法打开共享区 " + path);
+        return false;
+    }
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+    if (created) {
+        if (ftruncate(fd, sizeof(Region)) != 0) {
+            setError(error, "无法设置共享区大小");
+            ::close(fd);
+            shm_unlink(path.c_str());
+            return false;
+        }
+    } else {
+        // 创建者可能还没有设置大小
+        struct stat info;
+        while (fstat(fd, &info) == 0 && static_cast<std::size_t>(info.st_size) < sizeof(Region)) {
+            if (info.st_size != 0 || std::chrono::steady_clock::now() > deadline) {
+                errno = EPROTO;
+                setError(error, "共享区 " + path + " 的布局不兼容");
+                ::close(fd);
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    void* memory = mmap(nullptr, sizeof(Region), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (memory == MAP_FAILED) {
+        setError(error, "无法映射共享区");
+        return false;
+    }
+    Region* region = static_cast<Region*>(memory);
+
+    if (created) {
+        // 新建的共享区全为零，只需初始化锁和头部
+        if (!initializeLock(&region->writeLock)) {
+            setError(error, "无法初始化共享区写锁");
+            munmap(memory, sizeof(Region));
+            shm_unlink(path.c_str());
+            return false;
+        }
+        region->layoutVersion = kLayoutVersion;
+        region->regionSize = sizeof(Region);
+        region->magic.store(kMagic, std::memory_order_release);
+    } else {
+        while (region->magic.load(std::memory_order_acquire) != kMagic) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                break;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        if (region->magic.load(std::memory_order_acquire) != kMagic ||
+            region->layoutVersion != kLayoutVersion || region->regionSize != sizeof(Region)) {
+            errno = EPROTO;
+            setError(error, "共享区 " + path + " 的布局不兼容");
+            munmap(memory, sizeof(Region));
+            return false;
+        }
+    }
+
+    eventFd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (eventFd_ < 0) {
+        setError(error, "无法创建 eventfd");
+        munmap(memory, sizeof(Region));
+        return false;
+    }
+
+    region_ = region;
+    static std::atomic<std::uint32_t> instances{0};
+    writerId_ = (static_cast<std::uint64_t>(getpid()) << 32) | (instances.fetch_add(1) + 1);
+    known_ = SharedUser();
+    // 先读唤醒字再读序号：此后的发布必然改变唤醒字，等待线程不会错过在它启动前发生的发布
+    const std::uint32_t wakeWord = region_->wakeWord.load(std::memory_order_acquire);
+    lastSeen_ = region_->head.load(std::memory_order_acquire);
+    needSnapshot_ = lastSeen_ > 0;
+    if (needSnapshot_) {
+        const std::uint64_t one = 1;
+        static_cast<void>(::write(eventFd_, &one, sizeof(one)));
+    }
+
+    stopping_.store(false);
+    waiter_ = std::thread([this, wakeWord]() { waitLoop(wakeWord); });
+    return true;
+}
+
+void SharedUserChannel::close() {
+    if (!region_) {
+        return;
+    }
+    stopping_.store(true);
+    // 也会唤醒其他进程的等待线程，它们发现唤醒字未变后继续等待
+    futex(&region_->wakeWord, FUTEX_WAKE, INT_MAX, nullptr);
+    waiter_.join();
+    munmap(region_, sizeof(Region));
+    region_ = nullptr;
+    ::close(eventFd_);
+    eventFd_ = -1;
+}
+
+std::uint64_t SharedUserChannel::publish(const SharedUser& user) {
+    if (!region_) {
+        return 0;
+    }
+    const std::uint32_t fields = differingFields(known_, user);
+    if (fields == 0) {
+        return 0;
+    }
+
+    std::uint64_t sequence = 0;
+    {
+        WriteLock lock(&region_->writeLock, region_->stateSequence);
+        sequence = region_->head.load(std::memory_order_relaxed) + 1;
+
+        RingSlot& slot = region_->ring[sequence % kRingSize];
+        slot.sequence.store(0, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        storeRecord(slot.record, user, fields, writerId_);
+        slot.sequence.store(sequence, std::memory_order_release);
+
+        region_->stateSequence.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        mergeRecord(region_->state, user, fields, writerId_);
+        region_->stateSequence.fetch_add(1, std::memory_order_release);
+
+        region_->head.store(sequence, std::memory_order_release);
+        region_->wakeWord.fetch_add(1, std::memory_order_release);
+    }
+    futex(&region_->wakeWord, FUTEX_WAKE, INT_MAX, nullptr);
+
+    // 与共享状态保持一致的截断结果，下次比较不会把截断当作差异
+    known_.name.assign(user.name, 0, utf8Prefix(user.name));
+    known_.email.assign(user.email, 0, utf8Prefix(user.email));
+    known_.age = user.age;
+    return sequence;
+}
+
+bool SharedUserChannel::poll(Update& update) {
+    if (!region_) {
+        return false;
+    }
+    drainNotifications();
+
+    const std::uint64_t head = region_->head.load(std::memory_order_acquire);
+    std::uint32_t fields = 0;
+    bool resynced = false;
+
+    if (!needSnapshot_) {
+        // 按序号合并未读记录；自己的记录也参与合并，保证各进程的结果一致
+        SharedUser merged = known_;
+        std::uint64_t next = lastSeen_ + 1;
+        for (; next <= head; ++next) {
+            const RingSlot& slot = region_->ring[next % kRingSize];
+            if (slot.sequence.load(std::memory_order_acquire) != next) {
+                break;
+            }
+            const SharedRecord& record = slot.record;
+            const std::uint32_t recordFields = record.fields;
+            const std::uint64_t writer = record.writer;
+            SharedUser value;
+            if (recordFields & Name) {
+                loadText(record.name, value.name);
+            }
+            if (recordFields & Email) {
+                loadText(record.email, value.email);
+            }
+            value.age = record.age;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.sequence.load(std::memory_order_relaxed) != next) {
+                break;   // 读取期间被覆盖
+            }
+            if (recordFields & Name) {
+                merged.name = std::move(value.name);
+            }
+            if (recordFields & Email) {
+                merged.email = std::move(value.email);
+            }
+            if (recordFields & Age) {
+                merged.age = value.age;
+            }
+            if (writer != writerId_) {
+                fields |= recordFields;
+            }
+        }
+        if (next > head) {
+            known_ = std::move(merged);
+            lastSeen_ = head;
+        } else {
+            needSnapshot_ = true;   // 落后超过一圈
+        }
+    }
+
+    if (needSnapshot_) {
+        SharedUser user;
+        std::uint64_t version = 0;
+        if (!readSnapshot(user, version)) {
+            return false;
+        }
+        fields = differingFields(known_, user);
+        known_ = std::move(user);
+        lastSeen_ = version;
+        needSnapshot_ = false;
+        resynced = true;
+    }
+
+    if (fields == 0) {
+        return false;
+    }
+    update.user = known_;
+    update.fields = fields;
+    update.version = lastSeen_;
+    update.resynced = resynced;
+    return true;
+}
+
+std::uint64_t SharedUserChannel::version() const {
+    return region_ ? region_->head.load(std::memory_order_acquire) : 0;
+}
+
+bool SharedUserChannel::remove(const std::string& name) {
+    return shm_unlink(shmName(name).c_str()) == 0;
+}
+
+void SharedUserChannel::waitLoop(std::uint32_t seen) {
+    // 超时只是保险：唤醒字未变时继续等待
+    const timespec timeout = {1, 0};
+    while (!stopping_.load()) {
+        futex(&region_->wakeWord, FUTEX_WAIT, seen, &timeout);
+        const std::uint32_t current = region_->wakeWord.load(std::memory_order_acquire);
+        if (current != seen) {
+            seen = current;
+            const std::uint64_t one = 1;
+            static_cast<void>(::write(eventFd_, &one, sizeof(one)));
+        }
+    }
+}
+
+bool SharedUserChannel::readSnapshot(SharedUser& user, std::uint64_t& version) const {
+    // 写者只在持锁时短暂修改状态，重试次数有限
+    for (int attempt = 0; attempt < 1000; ++attempt) {
+        const std::uint32_t before = region_->stateSequence.load(std::memory_order_acquire);
+        if (before & 1) {
+            std::this_thread::yield();
+            continue;
+        }
+        version = region_->head.load(std::memory_order_acquire);
+        loadText(region_->state.name, user.name);
+        loadText(region_->state.email, user.email);
+        user.age = region_->state.age;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (region_->stateSequence.load(std::memory_order_relaxed) == before) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void SharedUserChannel::drainNotifications() {
+    std::uint64_t count = 0;
+    static_cast<void>(::read(eventFd_, &count, sizeof(count)));
+}
+
+#else
+
+// 其他平台：open() 总是失败，前端照常单进程运行
+struct SharedUserChannel::Region {};
+
+SharedUserChannel::SharedUserChannel()
+    : region_(nullptr), eventFd_(-1), writerId_(0), lastSeen_(0), needSnapshot_(false), stopping_(false) {
+}
+
+SharedUserChannel::~SharedUserChannel() = default;
+
+bool SharedUserChannel::open(const std::string&, std::string* error) {
+    if (error) {
+        *error = "共享内存同步仅支持 Linux";
+    }
+    return false;
+}
+
+void SharedUserChannel::close() {}
+std::uint64_t SharedUserChannel::publish(const SharedUser&) { return 0; }
+bool SharedUserChannel::poll(Update&) { return false; }
+std::uint64_t SharedUserChannel::version() const { return 0; }
+bool SharedUserChannel::remove(const std::string&) { return false; }
+void SharedUserChannel::waitLoop(std::uint32_t) {}
+bool SharedUserChannel::readSnapshot(SharedUser&, std::uint64_t&) const { return false; }
+void SharedUserChannel::drainNotifications() {}
+
+#endif
+
+} // namespace sync
+} // namespace mvvm
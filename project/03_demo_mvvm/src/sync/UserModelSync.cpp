@@ -0,0 +1,79 @@
+#include "sync/UserModelSync.h"
+#include "core/Trace.h"
+#include <QSocketNotifier>
+
+namespace mvvm {
+namespace sync {
+
+UserModelSync::UserModelSync(std::shared_ptr<UserModel> model, QObject* parent)
+    : QObject(parent), model_(std::move(model)), notifier_(nullptr), received_(0) {
+}
+
+UserModelSync::~UserModelSync() {
+    close();
+}
+
+bool UserModelSync::open(const QString& name, QString* error) {
+    close();
+    std::string message;
+    if (!model_ || !channel_.open(name.toStdString(), &message)) {
+        if (error) {
+            *error = model_ ? QString::fromStdString(message) : QStringLiteral("没有数据模型");
+        }
+        return false;
+    }
+
+    notifier_ = new QSocketNotifier(channel_.notifyFd(), QSocketNotifier::Read, this);
+    connect(notifier_, &QSocketNotifier::activated, this, &UserModelSync::onNotified);
+    connect(model_.get(), &UserModel::dataChanged, this, &UserModelSync::onModelDataChanged);
+
+    // 先采用共享区中已有的状态，再发布本地与之不同的字段
+    onNotified();
+    onModelDataChanged();
+    return true;
+}
+
+void UserModelSync::close() {
+    if (!channel_.isOpen()) {
+        return;
+    }
+    disconnect(model_.get(), nullptr, this, nullptr);
+    delete notifier_;
+    notifier_ = nullptr;
+    channel_.close();
+}
+
+void UserModelSync::onModelDataChanged() {
+    MVVM_TRACE_SCOPE("sync", "UserModelSync::publish");
+    SharedUser user;
+    user.name = model_->name().toStdString();
+    user.email = model_->email().toStdString();
+    user.age = model_->age();
+    channel_.publish(user);
+}
+
+void UserModelSync::onNotified() {
+    MVVM_TRACE_SCOPE("sync", "UserModelSync::apply");
+    SharedUserChannel::Update update;
+    if (!channel_.poll(update)) {
+        return;
+    }
+    UserModel::Patch patch;
+    if (update.fields & SharedUserChannel::Name) {
+        patch.name = QString::fromStdString(update.user.name);
+    }
+    if (update.fields & SharedUserChannel::Email) {
+        patch.email = QString::fromStdString(update.user.email);
+    }
+    if (update.fields & SharedUserChannel::Age) {
+        patch.age = update.user.age;
+    }
+    ++received_;
+    model_->apply(patch);
+    emit remoteChanged();
+}
+
+} // namespace sync
+} // namespace mvvm
+
+#include "UserModelSync.moc"
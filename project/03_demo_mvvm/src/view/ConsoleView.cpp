@@ -1,51 +1,109 @@
 #include "view/ConsoleView.h"
+#include <algorithm>
 #include <iostream>
-#include <limits>
 #include <sstream>
 
-#ifdef _WIN32
-#include <cstdlib>
-#define CLEAR_COMMAND "cls"
-#else
-#define CLEAR_COMMAND "clear"
+#ifdef __linux__
+#include <cerrno>
+#include <poll.h>
+#include <unistd.h>
 #endif
 
 namespace mvvm {
 
-ConsoleView::ConsoleView(std::shared_ptr<UserViewModel> viewModel)
-    : viewModel_(viewModel) {
-    
+namespace {
+
+using Style = TerminalRenderer::Style;
+
+// 屏幕布局：消息区在菜单右侧，整屏 21 行，80x24 终端内不会滚动
+constexpr int kHeaderRow = 0;
+constexpr int kUserInfoRow = 4;
+constexpr int kMenuRow = 10;
+constexpr int kMessageRow = 10;
+constexpr int kMessageCol = 28;
+constexpr int kMessageLines = 8;
+constexpr int kPromptRow = 19;
+
+const std::string kRule(47, '=');
+
+} // namespace
+
+ConsoleView::ConsoleView(std::shared_ptr<lite::UserViewModel> viewModel)
+    : viewModel_(viewModel), messageStyle_(Style::Normal) {
+
     if (viewModel_) {
-        viewModel_->addObserver(std::shared_ptr<IObserver>(this, [](IObserver*){}));
-        saveCommand_ = std::make_shared<SaveUserCommand>(viewModel_.get());
-        resetCommand_ = std::make_shared<ResetUserCommand>(viewModel_.get());
+        // 视图自己管理生命周期，析构时注销
+        viewModel_->addObserver(std::shared_ptr<lite::IObserver>(this, [](lite::IObserver*){}));
+        saveCommand_ = std::make_shared<lite::SaveUserCommand>(viewModel_.get());
+        resetCommand_ = std::make_shared<lite::ResetUserCommand>(viewModel_.get());
+    }
+}
+
+ConsoleView::~ConsoleView() {
+    if (viewModel_) {
+        viewModel_->removeObserver(this);
     }
 }
 
 void ConsoleView::update() {
-    // 在 ViewModel 数据变化时，可以在这里更新UI
-    // 对于控制台应用，这里暂时不需要特殊处理
+    // ViewModel 变化后立即刷新，只有变化的字段会写到终端
+    render();
+    publishUser();
+}
+
+void ConsoleView::setSharedChannel(std::shared_ptr<sync::SharedUserChannel> channel) {
+    channel_ = std::move(channel);
+    // 先采用共享区中已有的状态，再发布本地与之不同的字段
+    applyRemoteChanges();
+    publishUser();
+}
+
+void ConsoleView::publishUser() {
+    if (!channel_ || !viewModel_) {
+        return;
+    }
+    const lite::UserRecord& user = viewModel_->user();
+    sync::SharedUser shared;
+    shared.name = user.name;
+    shared.email = user.email;
+    shared.age = user.age;
+    // 与共享状态相同（例如刚应用的远端修改）时不会发布
+    channel_->publish(shared);
+}
+
+void ConsoleView::applyRemoteChanges() {
+    sync::SharedUserChannel::Update update;
+    if (!channel_ || !viewModel_ || !channel_->poll(update)) {
+        return;
+    }
+    lite::UserRecord user = viewModel_->user();
+    if (update.fields & sync::SharedUserChannel::Name) {
+        user.name = std::move(update.user.name);
+    }
+    if (update.fields & sync::SharedUserChannel::Email) {
+        user.email = std::move(update.user.email);
+    }
+    if (update.fields & sync::SharedUserChannel::Age) {
+        user.age = update.user.age;
+    }
+    viewModel_->assign(std::move(user));
 }
 
 void ConsoleView::show() {
-    clearScreen();
-    std::cout << "===============================================\n";
-    std::cout << "           MVVM 框架演示程序\n";
-    std::cout << "===============================================\n\n";
+    render();
 }
 
 void ConsoleView::run() {
     bool running = true;
-    
+
     while (running) {
-        show();
-        displayUserInfo();
-        displayMenu();
-        
-        std::cout << "请选择操作 (1-6): ";
-        std::string choice;
-        std::getline(std::cin, choice);
-        
+        const std::string choice = getInputLine("请选择操作 (1-6): ");
+        {
+            // 上一次操作的消息在下一次选择后清除
+            std::lock_guard<std::mutex> lock(renderMutex_);
+            messageLines_.clear();
+        }
+
         if (choice == "1") {
             handleNameInput();
         } else if (choice == "2") {
@@ -58,48 +116,100 @@ void ConsoleView::run() {
             handleResetCommand();
         } else if (choice == "6") {
             handleDisplayInfo();
-        } else if (choice == "0" || choice == "q" || choice == "Q") {
+        } else if (choice == "0" || choice == "q" || choice == "Q" || !std::cin) {
             running = false;
-            std::cout << "\n感谢使用 MVVM 演示程序！再见！\n" << std::endl;
         } else {
-            std::cout << "\n❌ 无效选择，请重新输入！" << std::endl;
-            pauseForUser();
+            setMessage("❌ 无效选择，请重新输入！", Style::Bad);
         }
     }
+
+    renderer_.finish();
+    std::cout << "感谢使用 MVVM 演示程序！再见！" << std::endl;
+}
+
+void ConsoleView::render() {
+    std::lock_guard<std::mutex> lock(renderMutex_);
+    renderer_.updateSize();
+    renderer_.clear();
+    displayHeader();
+    displayUserInfo();
+    displayMenu();
+    displayMessage();
+
+    const int promptRow = std::min(kPromptRow, renderer_.rows() - 2);
+    const int promptEnd = renderer_.putText(promptRow, 0, prompt_, Style::Bold);
+    renderer_.setCursor(promptRow, promptEnd);
+    renderer_.present();
+}
+
+void ConsoleView::displayHeader() {
+    renderer_.putText(kHeaderRow, 0, kRule, Style::Accent);
+    renderer_.putText(kHeaderRow + 1, 11, "MVVM 框架演示程序", Style::Bold);
+    renderer_.putText(kHeaderRow + 2, 0, kRule, Style::Accent);
 }
 
 void ConsoleView::displayMenu() {
-    std::cout << "操作菜单:\n";
-    std::cout << "  1. 设置姓名\n";
-    std::cout << "  2. 设置邮箱\n";
-    std::cout << "  3. 设置年龄\n";
-    std::cout << "  4. 保存用户信息\n";
-    std::cout << "  5. 重置用户信息\n";
-    std::cout << "  6. 显示完整信息\n";
-    std::cout << "  0. 退出程序\n\n";
+    static const char* const items[] = {
+        "  1. 设置姓名",
+        "  2. 设置邮箱",
+        "  3. 设置年龄",
+        "  4. 保存用户信息",
+        "  5. 重置用户信息",
+        "  6. 显示完整信息",
+        "  0. 退出程序",
+    };
+    renderer_.putText(kMenuRow, 0, "操作菜单:", Style::Bold);
+    int row = kMenuRow + 1;
+    for (const char* item : items) {
+        renderer_.putText(row++, 0, item);
+    }
 }
 
 void ConsoleView::displayUserInfo() {
     if (!viewModel_) return;
-    
-    std::cout << "当前用户信息:\n";
-    std::cout << "  姓名: " << (viewModel_->getDisplayName().empty() ? "[未设置]" : viewModel_->getDisplayName()) << "\n";
-    std::cout << "  邮箱: " << (viewModel_->getDisplayEmail().empty() ? "[未设置]" : viewModel_->getDisplayEmail()) << "\n";
-    std::cout << "  年龄: " << (viewModel_->getDisplayAge() == "0" ? "[未设置]" : viewModel_->getDisplayAge()) << "\n";
-    std::cout << "  状态: " << viewModel_->getStatusMessage() << "\n\n";
+
+    const auto field = [this](int row, const char* label, const std::string& value, bool unset) {
+        const int col = renderer_.putText(row, 0, label);
+        if (unset) {
+            renderer_.putText(row, col, "[未设置]", Style::Dim);
+        } else {
+            renderer_.putText(row, col, value);
+        }
+    };
+
+    renderer_.putText(kUserInfoRow, 0, "当前用户信息:", Style::Bold);
+    field(kUserInfoRow + 1, "  姓名: ", viewModel_->getDisplayName(), viewModel_->getDisplayName().empty());
+    field(kUserInfoRow + 2, "  邮箱: ", viewModel_->getDisplayEmail(), viewModel_->getDisplayEmail().empty());
+    field(kUserInfoRow + 3, "  年龄: ", viewModel_->getDisplayAge(), viewModel_->getDisplayAge() == "0");
+    const int col = renderer_.putText(kUserInfoRow + 4, 0, "  状态: ");
+    renderer_.putText(kUserInfoRow + 4, col, viewModel_->getStatusMessage(),
+                      viewModel_->canSave() ? Style::Good : Style::Bad);
 }
 
-void ConsoleView::handleUserInput() {
-    // 在实际应用中，这里可以处理更复杂的用户交互
+void ConsoleView::displayMessage() {
+    const int lines = std::min<int>(kMessageLines, static_cast<int>(messageLines_.size()));
+    for (int i = 0; i < lines; ++i) {
+        renderer_.putText(kMessageRow + i, kMessageCol, messageLines_[i], messageStyle_);
+    }
 }
 
-void ConsoleView::clearScreen() {
-    std::system(CLEAR_COMMAND);
+void ConsoleView::setMessage(const std::string& text, Style style) {
+    {
+        std::lock_guard<std::mutex> lock(renderMutex_);
+        messageLines_.clear();
+        std::istringstream stream(text);
+        std::string line;
+        while (std::getline(stream, line)) {
+            messageLines_.push_back(line);
+        }
+        messageStyle_ = style;
+    }
+    render();
 }
 
 void ConsoleView::pauseForUser() {
-    std::cout << "\n按 Enter 键继续...";
-    std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+    getInputLine("按 Enter 键继续...");
+    setMessage(std::string(), Style::Normal);
 }
 
 void ConsoleView::handleNameInput() {
@@ -126,33 +236,72 @@ void ConsoleView::handleAgeInput() {
 void ConsoleView::handleSaveCommand() {
     if (saveCommand_ && saveCommand_->canExecute()) {
         saveCommand_->execute();
+        setMessage("✅ 用户信息已保存！(共 " + std::to_string(viewModel_->savedUsers().size()) + " 条)",
+                   Style::Good);
     } else {
-        std::cout << "\n❌ 无法保存：数据验证失败！" << std::endl;
+        setMessage("❌ 无法保存：数据验证失败！", Style::Bad);
     }
-    pauseForUser();
 }
 
 void ConsoleView::handleResetCommand() {
     if (resetCommand_) {
         resetCommand_->execute();
     }
-    pauseForUser();
+    setMessage("用户信息已重置", Style::Normal);
 }
 
 void ConsoleView::handleDisplayInfo() {
-    std::cout << "\n" << std::string(50, '=') << std::endl;
     if (viewModel_) {
-        std::cout << viewModel_->getUserDisplayInfo() << std::endl;
+        setMessage(viewModel_->getUserDisplayInfo(), Style::Accent);
     }
-    std::cout << std::string(50, '=') << std::endl;
     pauseForUser();
 }
 
 std::string ConsoleView::getInputLine(const std::string& prompt) {
-    std::cout << "\n" << prompt;
+    {
+        std::lock_guard<std::mutex> lock(renderMutex_);
+        prompt_ = prompt;
+    }
+    render();
+
     std::string input;
+    waitForInput();
     std::getline(std::cin, input);
+
+    // 终端回显了输入并换行，提示行的内容已不是上一帧，下次整行重绘
+    std::lock_guard<std::mutex> lock(renderMutex_);
+    const int promptRow = std::min(kPromptRow, renderer_.rows() - 2);
+    renderer_.invalidateRow(promptRow);
+    renderer_.invalidateRow(promptRow + 1);
     return input;
 }
 
+void ConsoleView::waitForInput() {
+    if (!channel_) {
+        return;
+    }
+#ifdef __linux__
+    // 终端在规范模式下一次只交出一行，可以安全地 poll；管道输入可能已被 stdio 缓冲，不等待
+    if (channel_->notifyFd() >= 0 && isatty(STDIN_FILENO)) {
+        while (true) {
+            pollfd fds[2] = {{STDIN_FILENO, POLLIN, 0}, {channel_->notifyFd(), POLLIN, 0}};
+            if (::poll(fds, 2, -1) < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                break;
+            }
+            if (fds[1].revents & POLLIN) {
+                applyRemoteChanges();
+            }
+            if (fds[0].revents) {
+                break;
+            }
+        }
+        return;
+    }
+#endif
+    applyRemoteChanges();
+}
+
 } // namespace mvvm
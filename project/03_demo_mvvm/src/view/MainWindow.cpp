@@ -1,15 +1,29 @@
 #include "view/MainWindow.h"
+#include "core/Trace.h"
+#include "view/Theme.h"
 #include <QApplication>
+#include <QFileDialog>
 #include <QMessageBox>
 #include <QSplitter>
 
 namespace mvvm {
 
-MainWindow::MainWindow(std::shared_ptr<UserViewModel> viewModel, QWidget* parent)
-    : QMainWindow(parent), viewModel_(viewModel) {
+namespace {
+
+// 输入停顿多久后才把值推给 ViewModel（触发校验和状态刷新）
+constexpr int kInputDebounceMs = 200;
+// 年龄微调框按住箭头时的最大刷新频率
+constexpr int kSpinThrottleMs = 100;
+
+} // namespace
+
+MainWindow::MainWindow(std::shared_ptr<UserViewModel> viewModel,
+                       std::shared_ptr<UserListViewModel> listViewModel,
+                       QWidget* parent)
+    : QMainWindow(parent), viewModel_(viewModel), listViewModel_(listViewModel), filterBinding_(nullptr) {
     
     setWindowTitle("Qt MVVM 框架演示程序");
-    setMinimumSize(600, 400);
+    setMinimumSize(900, 400);
     
     setupUI();
     connectSignals();
@@ -50,7 +64,7 @@ void MainWindow::setupUI() {
     // 状态标签
     statusLabel_ = new QLabel("准备就绪", this);
     statusLabel_->setWordWrap(true);
-    statusLabel_->setStyleSheet("QLabel { color: blue; font-weight: bold; }");
+    Theme::styleStatusLabel(statusLabel_);
     leftLayout->addWidget(statusLabel_);
     
     // 按钮布局
@@ -63,6 +77,16 @@ void MainWindow::setupUI() {
     resetButton_ = new QPushButton("重置", this);
     buttonLayout->addWidget(resetButton_);
     
+    undoButton_ = new QPushButton("撤销", this);
+    undoButton_->setShortcut(QKeySequence::Undo);
+    undoButton_->setEnabled(false);
+    buttonLayout->addWidget(undoButton_);
+    
+    redoButton_ = new QPushButton("重做", this);
+    redoButton_->setShortcut(QKeySequence::Redo);
+    redoButton_->setEnabled(false);
+    buttonLayout->addWidget(redoButton_);
+    
     showInfoButton_ = new QPushButton("显示信息", this);
     buttonLayout->addWidget(showInfoButton_);
     
@@ -75,13 +99,43 @@ void MainWindow::setupUI() {
     auto rightGroup = new QGroupBox("用户信息显示", this);
     auto rightLayout = new QVBoxLayout(rightGroup);
     
-    infoDisplay_ = new QTextEdit(this);
-    infoDisplay_->setReadOnly(true);
+    infoDisplay_ = new common::LogView(this);
     infoDisplay_->setFont(QFont("Consolas", 10));
     rightLayout->addWidget(infoDisplay_);
     
     splitter->addWidget(rightGroup);
-    splitter->setSizes({300, 300});
+    
+    // 最右侧：已保存用户列表
+    auto listGroup = new QGroupBox("用户列表", this);
+    auto listLayout = new QVBoxLayout(listGroup);
+    
+    filterEdit_ = new QLineEdit(this);
+    filterEdit_->setPlaceholderText("按姓名或邮箱过滤，^ 开头为前缀匹配");
+    filterEdit_->setClearButtonEnabled(true);
+    listLayout->addWidget(filterEdit_);
+    
+    userTable_ = new UserTableView(this);
+    if (listViewModel_) {
+        userTable_->setModel(listViewModel_->users());
+    }
+    listLayout->addWidget(userTable_);
+    
+    userCountLabel_ = new QLabel(this);
+    listLayout->addWidget(userCountLabel_);
+    
+    auto listButtonLayout = new QHBoxLayout();
+    importButton_ = new QPushButton("导入...", this);
+    listButtonLayout->addWidget(importButton_);
+    exportButton_ = new QPushButton("导出...", this);
+    listButtonLayout->addWidget(exportButton_);
+    listLayout->addLayout(listButtonLayout);
+    
+    reportLabel_ = new QLabel(this);
+    reportLabel_->setWordWrap(true);
+    listLayout->addWidget(reportLabel_);
+    
+    splitter->addWidget(listGroup);
+    splitter->setSizes({300, 300, 400});
     
     // 状态栏
     statusBar()->showMessage("Qt MVVM 框架演示程序已准备就绪");
@@ -90,117 +144,181 @@ void MainWindow::setupUI() {
 void MainWindow::connectSignals() {
     if (!viewModel_) return;
     
-    // 连接 UI 控件信号
-    connect(nameEdit_, &QLineEdit::textChanged, this, &MainWindow::onNameChanged);
-    connect(emailEdit_, &QLineEdit::textChanged, this, &MainWindow::onEmailChanged);
-    connect(ageSpinBox_, QOverload<int>::of(&QSpinBox::valueChanged), this, &MainWindow::onAgeChanged);
+    // 表单字段双向绑定：输入经限流后再更新 ViewModel，编辑结束时立即提交
+    UserViewModel* viewModel = viewModel_.get();
+    bindings_.bind<LineEditText, UserViewModel::NameProperty>(nameEdit_, viewModel).debounce(kInputDebounceMs);
+    bindings_.bind<LineEditText, UserViewModel::EmailProperty>(emailEdit_, viewModel).debounce(kInputDebounceMs);
+    bindings_.bind<SpinBoxValue, UserViewModel::AgeProperty>(ageSpinBox_, viewModel).throttle(kSpinThrottleMs);
+    connect(nameEdit_, &QLineEdit::editingFinished, this, [this]() { bindings_.flush(); });
+    connect(emailEdit_, &QLineEdit::editingFinished, this, [this]() { bindings_.flush(); });
     
     connect(saveButton_, &QPushButton::clicked, this, &MainWindow::onSaveClicked);
     connect(resetButton_, &QPushButton::clicked, this, &MainWindow::onResetClicked);
+    connect(undoButton_, &QPushButton::clicked, this, &MainWindow::onUndoClicked);
+    connect(redoButton_, &QPushButton::clicked, this, &MainWindow::onRedoClicked);
     connect(showInfoButton_, &QPushButton::clicked, this, &MainWindow::onShowInfoClicked);
     
     // 连接 ViewModel 信号
-    connect(viewModel_.get(), &ViewModelBase::propertyChanged, 
-            this, &MainWindow::onViewModelPropertyChanged);
+    connect(viewModel_.get(), &UserViewModel::statusMessageChanged,
+            this, &MainWindow::onStatusMessageChanged);
+    connect(viewModel_.get(), &UserViewModel::canSaveChanged,
+            this, &MainWindow::updateButtonStates);
+    connect(viewModel_.get(), &UserViewModel::historyChanged,
+            this, &MainWindow::updateButtonStates);
     connect(viewModel_.get(), &UserViewModel::userSaved, 
             this, &MainWindow::onUserSaved);
     connect(viewModel_.get(), &UserViewModel::userReset, 
             this, &MainWindow::onUserReset);
-}
-
-void MainWindow::onNameChanged() {
-    if (viewModel_) {
-        viewModel_->updateName(nameEdit_->text());
-    }
-}
-
-void MainWindow::onEmailChanged() {
-    if (viewModel_) {
-        viewModel_->updateEmail(emailEdit_->text());
-    }
-}
-
-void MainWindow::onAgeChanged() {
-    if (viewModel_) {
-        viewModel_->updateAge(QString::number(ageSpinBox_->value()));
+    
+    // 连接用户列表
+    if (listViewModel_) {
+        // 后台过滤任务运行期间只保留最新的关键字，任务结束后再执行一次
+        UserCollectionModel* users = listViewModel_->users();
+        filterBinding_ = binding::latestWhileBusy(
+            filterEdit_, &QLineEdit::textChanged,
+            users, &UserCollectionModel::busyChanged, [users]() { return users->isBusy(); },
+            0, [this]() { onFilterChanged(); }, this);
+        connect(importButton_, &QPushButton::clicked, this, &MainWindow::onImportClicked);
+        connect(exportButton_, &QPushButton::clicked, this, &MainWindow::onExportClicked);
+        connect(listViewModel_->users(), &UserCollectionModel::userCountChanged,
+                this, &MainWindow::onUserCountChanged);
+        connect(listViewModel_.get(), &UserListViewModel::busyChanged,
+                this, &MainWindow::onListBusyChanged);
+        connect(listViewModel_.get(), &UserListViewModel::reportMessageChanged,
+                this, &MainWindow::onReportMessageChanged);
     }
 }
 
 void MainWindow::onSaveClicked() {
+    MVVM_TRACE_SCOPE("view", "MainWindow::onSaveClicked");
+    // 保存前先提交尚在限流中的输入
+    bindings_.flush();
     if (viewModel_ && viewModel_->saveCommand()) {
         viewModel_->saveCommand()->execute();
     }
 }
 
 void MainWindow::onResetClicked() {
+    MVVM_TRACE_SCOPE("view", "MainWindow::onResetClicked");
+    // 先提交再重置，保证重置后的空值会回显到输入框
+    bindings_.flush();
     if (viewModel_ && viewModel_->resetCommand()) {
         viewModel_->resetCommand()->execute();
     }
 }
 
+void MainWindow::onUndoClicked() {
+    MVVM_TRACE_SCOPE("view", "MainWindow::onUndoClicked");
+    // 限流中的输入先记入历史，撤销的正是这次输入
+    bindings_.flush();
+    if (viewModel_) {
+        viewModel_->undoCommand()->execute();
+    }
+}
+
+void MainWindow::onRedoClicked() {
+    MVVM_TRACE_SCOPE("view", "MainWindow::onRedoClicked");
+    bindings_.flush();
+    if (viewModel_) {
+        viewModel_->redoCommand()->execute();
+    }
+}
+
 void MainWindow::onShowInfoClicked() {
+    MVVM_TRACE_SCOPE("view", "MainWindow::onShowInfoClicked");
+    bindings_.flush();
     if (viewModel_) {
         QString info = viewModel_->getUserDisplayInfo();
         infoDisplay_->setPlainText(info);
     }
 }
 
-void MainWindow::onViewModelPropertyChanged(const QString& propertyName) {
-    if (propertyName == "displayName") {
-        if (nameEdit_->text() != viewModel_->displayName()) {
-            nameEdit_->setText(viewModel_->displayName());
-        }
-    } else if (propertyName == "displayEmail") {
-        if (emailEdit_->text() != viewModel_->displayEmail()) {
-            emailEdit_->setText(viewModel_->displayEmail());
-        }
-    } else if (propertyName == "displayAge") {
-        int age = viewModel_->displayAge().toInt();
-        if (ageSpinBox_->value() != age) {
-            ageSpinBox_->setValue(age);
-        }
-    } else if (propertyName == "statusMessage") {
-        statusLabel_->setText(viewModel_->statusMessage());
-        
-        // 根据状态设置颜色
-        if (viewModel_->statusMessage().contains("✅")) {
-            statusLabel_->setStyleSheet("QLabel { color: green; font-weight: bold; }");
-        } else if (viewModel_->statusMessage().contains("❌")) {
-            statusLabel_->setStyleSheet("QLabel { color: red; font-weight: bold; }");
-        } else {
-            statusLabel_->setStyleSheet("QLabel { color: blue; font-weight: bold; }");
-        }
-    } else if (propertyName == "canSave") {
-        updateButtonStates();
+void MainWindow::onStatusMessageChanged() {
+    MVVM_TRACE_SCOPE("view", "MainWindow::onStatusMessageChanged");
+    const QString& message = viewModel_->statusMessage();
+    statusLabel_->setText(message);
+    
+    // 根据状态切换颜色：只换预先生成的调色板，不重新解析样式表
+    if (message.contains("✅")) {
+        Theme::setStatus(statusLabel_, Theme::Status::Valid);
+    } else if (message.contains("❌")) {
+        Theme::setStatus(statusLabel_, Theme::Status::Invalid);
+    } else {
+        Theme::setStatus(statusLabel_, Theme::Status::Neutral);
     }
 }
 
 void MainWindow::onUserSaved() {
+    MVVM_TRACE_SCOPE("view", "MainWindow::onUserSaved");
     QMessageBox::information(this, "成功", "用户信息已成功保存！");
     statusBar()->showMessage("用户信息已保存", 3000);
     onShowInfoClicked(); // 自动显示保存的信息
 }
 
 void MainWindow::onUserReset() {
+    MVVM_TRACE_SCOPE("view", "MainWindow::onUserReset");
     QMessageBox::information(this, "重置", "用户信息已重置！");
     statusBar()->showMessage("用户信息已重置", 3000);
     infoDisplay_->clear();
 }
 
+void MainWindow::onFilterChanged() {
+    MVVM_TRACE_SCOPE("view", "MainWindow::onFilterChanged");
+    if (listViewModel_) {
+        listViewModel_->setFilterText(filterEdit_->text());
+    }
+}
+
+void MainWindow::onUserCountChanged() {
+    MVVM_TRACE_SCOPE("view", "MainWindow::onUserCountChanged");
+    if (listViewModel_) {
+        userCountLabel_->setText(QString("共 %1 个用户").arg(listViewModel_->users()->userCount()));
+    }
+}
+
+void MainWindow::onImportClicked() {
+    const QString path = QFileDialog::getOpenFileName(
+        this, "导入用户", QString(), "用户数据 (*.csv *.json *.jsonl);;所有文件 (*)");
+    if (!path.isEmpty() && listViewModel_) {
+        listViewModel_->importUsers(path);
+    }
+}
+
+void MainWindow::onExportClicked() {
+    const QString path = QFileDialog::getSaveFileName(
+        this, "导出用户", "users.csv", "CSV (*.csv);;JSON (*.json)");
+    if (!path.isEmpty() && listViewModel_) {
+        listViewModel_->exportUsers(path);
+    }
+}
+
+void MainWindow::onListBusyChanged() {
+    MVVM_TRACE_SCOPE("view", "MainWindow::onListBusyChanged");
+    importButton_->setEnabled(!listViewModel_->isBusy());
+    exportButton_->setEnabled(!listViewModel_->isBusy());
+}
+
+void MainWindow::onReportMessageChanged() {
+    MVVM_TRACE_SCOPE("view", "MainWindow::onReportMessageChanged");
+    reportLabel_->setText(listViewModel_->reportMessage());
+}
+
 void MainWindow::updateUI() {
     if (!viewModel_) return;
     
-    nameEdit_->setText(viewModel_->displayName());
-    emailEdit_->setText(viewModel_->displayEmail());
-    ageSpinBox_->setValue(viewModel_->displayAge().toInt());
-    statusLabel_->setText(viewModel_->statusMessage());
+    // 表单字段由绑定在建立时同步
+    onStatusMessageChanged();
     updateButtonStates();
+    onUserCountChanged();
 }
 
 void MainWindow::updateButtonStates() {
+    MVVM_TRACE_SCOPE("view", "MainWindow::updateButtonStates");
     if (!viewModel_) return;
     
     saveButton_->setEnabled(viewModel_->canSave());
+    undoButton_->setEnabled(viewModel_->canUndo());
+    redoButton_->setEnabled(viewModel_->canRedo());
 }
 
 } // namespace mvvm
@@ -0,0 +1,355 @@
+#include "view/TerminalRenderer.h"
+#include <algorithm>
+#include <iterator>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/ioctl.h>
+#include <unistd.h>
+#endif
+
+namespace mvvm {
+
+namespace {
+
+/**
+ * 解码一个 UTF-8 字符，非法序列返回 U+FFFD 并只前进一个字节
+ */
+char32_t decodeUtf8(std::string_view text, std::size_t& pos) {
+    const auto byte = [&text](std::size_t i) { return static_cast<unsigned char>(text[i]); };
+    const unsigned char lead = byte(pos);
+    if (lead < 0x80) {
+        ++pos;
+        return lead;
+    }
+    int length = 0;
+    char32_t ch = 0;
+    if ((lead & 0xE0) == 0xC0) {
+        length = 2;
+        ch = lead & 0x1F;
+    } else if ((lead & 0xF0) == 0xE0) {
+        length = 3;
+        ch = lead & 0x0F;
+    } else if ((lead & 0xF8) == 0xF0) {
+        length = 4;
+        ch = lead & 0x07;
+    } else {
+        ++pos;
+        return 0xFFFD;
+    }
+    if (pos + length > text.size()) {
+        ++pos;
+        return 0xFFFD;
+    }
+    for (int i = 1; i < length; ++i) {
+        const unsigned char next = byte(pos + i);
+        if ((next & 0xC0) != 0x80) {
+            ++pos;
+            return 0xFFFD;
+        }
+        ch = (ch << 6) | (next & 0x3F);
+    }
+    pos += length;
+    return ch;
+}
+
+struct Range {
+    char32_t first;
+    char32_t last;
+};
+
+// 东亚宽字符（East Asian Width W/F）及终端中按两列显示的 emoji
+constexpr Range kWideRanges[] = {
+    {0x1100, 0x115F}, {0x231A, 0x231B}, {0x2329, 0x232A}, {0x23E9, 0x23EC}, {0x23F0, 0x23F0},
+    {0x23F3, 0x23F3}, {0x25FD, 0x25FE}, {0x2614, 0x2615}, {0x2648, 0x2653}, {0x267F, 0x267F},
+    {0x2693, 0x2693}, {0x26A1, 0x26A1}, {0x26AA, 0x26AB}, {0x26BD, 0x26BE}, {0x26C4, 0x26C5},
+    {0x26CE, 0x26CE}, {0x26D4, 0x26D4}, {0x26EA, 0x26EA}, {0x26F2, 0x26F3}, {0x26F5, 0x26F5},
+    {0x26FA, 0x26FA}, {0x26FD, 0x26FD}, {0x2705, 0x2705}, {0x270A, 0x270B}, {0x2728, 0x2728},
+    {0x274C, 0x274C}, {0x274E, 0x274E}, {0x2753, 0x2755}, {0x2757, 0x2757}, {0x2795, 0x2797},
+    {0x27B0, 0x27B0}, {0x27BF, 0x27BF}, {0x2B1B, 0x2B1C}, {0x2B50, 0x2B50}, {0x2B55, 0x2B55},
+    {0x2E80, 0x303E}, {0x3041, 0x33FF}, {0x3400, 0x4DBF}, {0x4E00, 0x9FFF}, {0xA000, 0xA4CF},
+    {0xA960, 0xA97F}, {0xAC00, 0xD7A3}, {0xF900, 0xFAFF}, {0xFE10, 0xFE19}, {0xFE30, 0xFE6F},
+    {0xFF00, 0xFF60}, {0xFFE0, 0xFFE6}, {0x1F300, 0x1F64F}, {0x1F900, 0x1F9FF}, {0x20000, 0x2FFFD},
+    {0x30000, 0x3FFFD},
+};
+
+bool querySize(std::FILE* out, int& cols, int& rows) {
+#ifdef _WIN32
+    (void)out;
+    CONSOLE_SCREEN_BUFFER_INFO info;
+    if (GetConsoleScreenBufferInfo(GetStdHandle(STD_OUTPUT_HANDLE), &info)) {
+        cols = info.srWindow.Right - info.srWindow.Left + 1;
+        rows = info.srWindow.Bottom - info.srWindow.Top + 1;
+        return cols > 0 && rows > 0;
+    }
+    return false;
+#else
+    winsize size{};
+    if (ioctl(fileno(out), TIOCGWINSZ, &size) == 0 && size.ws_col > 0 && size.ws_row > 0) {
+        cols = size.ws_col;
+        rows = size.ws_row;
+        return true;
+    }
+    return false;
+#endif
+}
+
+void enableVirtualTerminal() {
+#ifdef _WIN32
+    HANDLE handle = GetStdHandle(STD_OUTPUT_HANDLE);
+    DWORD mode = 0;
+    if (GetConsoleMode(handle, &mode)) {
+        SetConsoleMode(handle, mode | ENABLE_VIRTUAL_TERMINAL_PROCESSING);
+    }
+#endif
+}
+
+} // namespace
+
+TerminalRenderer::TerminalRenderer(std::FILE* out, int cols, int rows)
+    : out_(out), cols_(0), rows_(0), fullRedraw_(true), cursorRow_(0), cursorCol_(0) {
+    enableVirtualTerminal();
+    if (cols <= 0 || rows <= 0) {
+        cols = 80;
+        rows = 24;
+        querySize(out_, cols, rows);
+    }
+    resize(cols, rows);
+}
+
+TerminalRenderer::~TerminalRenderer() = default;
+
+void TerminalRenderer::resize(int cols, int rows) {
+    cols_ = std::max(1, cols);
+    rows_ = std::max(1, rows);
+    const std::size_t cells = static_cast<std::size_t>(cols_) * rows_;
+    back_.assign(cells, Cell());
+    front_.assign(cells, Cell());
+    frame_.reserve(cells * 4);
+    cursorRow_ = std::min(cursorRow_, rows_ - 1);
+    cursorCol_ = std::min(cursorCol_, cols_ - 1);
+    fullRedraw_ = true;
+}
+
+void TerminalRenderer::updateSize() {
+    int cols = cols_;
+    int rows = rows_;
+    if (querySize(out_, cols, rows) && (cols != cols_ || rows != rows_)) {
+        resize(cols, rows);
+    }
+}
+
+void TerminalRenderer::clear() {
+    std::fill(back_.begin(), back_.end(), Cell());
+}
+
+int TerminalRenderer::putText(int row, int col, std::string_view utf8, Style style) {
+    if (row < 0 || row >= rows_) {
+        return col;
+    }
+    std::size_t pos = 0;
+    while (pos < utf8.size() && col < cols_) {
+        char32_t ch = decodeUtf8(utf8, pos);
+        if (ch < 0x20 || ch == 0x7F || (ch >= 0x80 && ch < 0xA0)) {
+            ch = U'?';
+        }
+        const int width = charWidth(ch);
+        if (width == 0) {
+            continue;   // 组合字符等零宽字符不单独占格
+        }
+        if (col + width > cols_) {
+            break;
+        }
+        if (col >= 0) {
+            breakWideChar(row, col);
+            if (width == 2) {
+                breakWideChar(row, col + 1);
+            }
+            at(row, col) = Cell{ch, style};
+            if (width == 2) {
+                at(row, col + 1) = Cell{kContinuation, style};
+            }
+        }
+        col += width;
+    }
+    return col;
+}
+
+void TerminalRenderer::breakWideChar(int row, int col) {
+    // 覆盖宽字符的任意一半时，另一半变为空白，保证每个宽字符都完整占两格
+    if (at(row, col).ch == kContinuation && col > 0) {
+        at(row, col - 1) = Cell();
+    }
+    if (col + 1 < cols_ && at(row, col + 1).ch == kContinuation) {
+        at(row, col + 1) = Cell();
+    }
+}
+
+void TerminalRenderer::setCursor(int row, int col) {
+    cursorRow_ = std::clamp(row, 0, rows_ - 1);
+    cursorCol_ = std::clamp(col, 0, cols_ - 1);
+}
+
+void TerminalRenderer::present() {
+    frame_.clear();
+    if (fullRedraw_) {
+        // 清屏后终端全是默认样式的空白，只需写出非空白的格子
+        frame_ += "\x1b[0m\x1b[2J";
+        std::fill(front_.begin(), front_.end(), Cell());
+        fullRedraw_ = false;
+    }
+    // 同步更新期间隐藏光标，避免光标在屏幕上跳动
+    frame_ += "\x1b[?25l";
+
+    int writeRow = -1;
+    int writeCol = -1;
+    bool styleKnown = false;
+    Style currentStyle = Style::Normal;
+    std::uint64_t cells = 0;
+
+    for (int row = 0; row < rows_; ++row) {
+        const std::size_t base = static_cast<std::size_t>(row) * cols_;
+        for (int col = 0; col < cols_; ++col) {
+            const Cell& cell = back_[base + col];
+            if (cell.ch == kContinuation) {
+                continue;   // 随左半格一起输出
+            }
+            const bool wide = col + 1 < cols_ && back_[base + col + 1].ch == kContinuation;
+            const bool changed = cell != front_[base + col] ||
+                                 (wide && back_[base + col + 1] != front_[base + col + 1]);
+            if (!changed) {
+                continue;
+            }
+            if (row != writeRow || col != writeCol) {
+                frame_ += "\x1b[";
+                frame_ += std::to_string(row + 1);
+                frame_ += ';';
+                frame_ += std::to_string(col + 1);
+                frame_ += 'H';
+            }
+            if (!styleKnown || cell.style != currentStyle) {
+                appendStyle(cell.style);
+                currentStyle = cell.style;
+                styleKnown = true;
+            }
+            appendChar(cell.ch);
+            ++cells;
+            writeRow = row;
+            writeCol = col + (wide ? 2 : 1);
+        }
+    }
+
+    front_ = back_;
+    if (styleKnown) {
+        frame_ += "\x1b[0m";
+    }
+    frame_ += "\x1b[";
+    frame_ += std::to_string(cursorRow_ + 1);
+    frame_ += ';';
+    frame_ += std::to_string(cursorCol_ + 1);
+    frame_ += "H\x1b[?25h";
+
+    ++stats_.frames;
+    stats_.cellsWritten += cells;
+    write(frame_);
+}
+
+void TerminalRenderer::invalidateRow(int row) {
+    if (row < 0 || row >= rows_) {
+        return;
+    }
+    const auto first = front_.begin() + static_cast<std::ptrdiff_t>(row) * cols_;
+    std::fill(first, first + cols_, Cell{kUnknown, Style::Normal});
+}
+
+void TerminalRenderer::invalidate() {
+    fullRedraw_ = true;
+}
+
+void TerminalRenderer::finish() {
+    frame_.clear();
+    frame_ += "\x1b[0m\x1b[";
+    frame_ += std::to_string(rows_);
+    frame_ += ";1H\x1b[?25h\n";
+    write(frame_);
+    fullRedraw_ = true;
+}
+
+int TerminalRenderer::charWidth(char32_t ch) {
+    if (ch == 0) {
+        return 0;
+    }
+    // 组合附加符号、零宽空格与连接符、变体选择符
+    if ((ch >= 0x0300 && ch <= 0x036F) || (ch >= 0x200B && ch <= 0x200F) ||
+        (ch >= 0xFE00 && ch <= 0xFE0F)) {
+        return 0;
+    }
+    if (ch < 0x1100) {
+        return 1;
+    }
+    const auto it = std::upper_bound(std::begin(kWideRanges), std::end(kWideRanges), ch,
+                                     [](char32_t value, const Range& range) { return value < range.first; });
+    if (it != std::begin(kWideRanges) && ch <= std::prev(it)->last) {
+        return 2;
+    }
+    return 1;
+}
+
+int TerminalRenderer::textWidth(std::string_view utf8) {
+    int width = 0;
+    std::size_t pos = 0;
+    while (pos < utf8.size()) {
+        width += charWidth(decodeUtf8(utf8, pos));
+    }
+    return width;
+}
+
+void TerminalRenderer::appendStyle(Style style) {
+    switch (style) {
+    case Style::Normal:
+        frame_ += "\x1b[0m";
+        break;
+    case Style::Bold:
+        frame_ += "\x1b[0;1m";
+        break;
+    case Style::Dim:
+        frame_ += "\x1b[0;2m";
+        break;
+    case Style::Good:
+        frame_ += "\x1b[0;32m";
+        break;
+    case Style::Bad:
+        frame_ += "\x1b[0;31m";
+        break;
+    case Style::Accent:
+        frame_ += "\x1b[0;36m";
+        break;
+    }
+}
+
+void TerminalRenderer::appendChar(char32_t ch) {
+    if (ch < 0x80) {
+        frame_ += static_cast<char>(ch);
+    } else if (ch < 0x800) {
+        frame_ += static_cast<char>(0xC0 | (ch >> 6));
+        frame_ += static_cast<char>(0x80 | (ch & 0x3F));
+    } else if (ch < 0x10000) {
+        frame_ += static_cast<char>(0xE0 | (ch >> 12));
+        frame_ += static_cast<char>(0x80 | ((ch >> 6) & 0x3F));
+        frame_ += static_cast<char>(0x80 | (ch & 0x3F));
+    } else {
+        frame_ += static_cast<char>(0xF0 | (ch >> 18));
+        frame_ += static_cast<char>(0x80 | ((ch >> 12) & 0x3F));
+        frame_ += static_cast<char>(0x80 | ((ch >> 6) & 0x3F));
+        frame_ += static_cast<char>(0x80 | (ch & 0x3F));
+    }
+}
+
+void TerminalRenderer::write(const std::string& data) {
+    std::fwrite(data.data(), 1, data.size(), out_);
+    std::fflush(out_);
+    stats_.bytesWritten += data.size();
+}
+
+} // namespace mvvm
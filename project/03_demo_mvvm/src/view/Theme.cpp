@@ -0,0 +1,250 @@
+#include "view/Theme.h"
+#include "core/Trace.h"
+#include <QApplication>
+#include <QElapsedTimer>
+#include <QPainter>
+#include <QProxyStyle>
+#include <QPushButton>
+#include <QStyleFactory>
+#include <QStyleOption>
+#include <QVariant>
+#include <QWidget>
+#include <algorithm>
+#include <array>
+
+namespace mvvm {
+
+namespace {
+
+// 原样式表中的颜色
+const QColor kWindowColor(0xf0, 0xf0, 0xf0);
+const QColor kAccentColor(0x00, 0x78, 0xd4);
+const QColor kAccentHoverColor(0x10, 0x6e, 0xbe);
+const QColor kAccentPressedColor(0x00, 0x5a, 0x9e);
+const QColor kDisabledColor(0xcc, 0xcc, 0xcc);
+const QColor kDisabledTextColor(0x66, 0x66, 0x66);
+const QColor kBorderColor(0xcc, 0xcc, 0xcc);
+
+constexpr int kButtonRadius = 4;
+constexpr int kButtonPaddingX = 16;
+constexpr int kButtonPaddingY = 8;
+constexpr int kGroupBoxRadius = 5;
+constexpr int kGroupBoxBorder = 2;
+
+QFont boldFont(const QWidget* widget) {
+    QFont font = widget ? widget->font() : QApplication::font();
+    font.setBold(true);
+    return font;
+}
+
+/**
+ * 基于 Fusion 的主题样式：按钮、分组框直接绘制，其余交给 Fusion
+ * 输入框的焦点边框由调色板的 Highlight 决定
+ */
+class ThemeStyle : public QProxyStyle {
+public:
+    ThemeStyle() : QProxyStyle(QStyleFactory::create(QStringLiteral("Fusion"))) {}
+
+    using QProxyStyle::polish;
+
+    void polish(QPalette& palette) override {
+        QProxyStyle::polish(palette);
+        palette.setColor(QPalette::Window, kWindowColor);
+        palette.setColor(QPalette::Highlight, kAccentColor);
+    }
+
+    void polish(QWidget* widget) override {
+        QProxyStyle::polish(widget);
+        if (qobject_cast<QPushButton*>(widget)) {
+            widget->setAttribute(Qt::WA_Hover);
+        }
+    }
+
+    void drawControl(ControlElement element, const QStyleOption* option, QPainter* painter,
+                     const QWidget* widget) const override {
+        switch (element) {
+        case CE_PushButtonBevel:
+            drawButtonPanel(option, painter);
+            return;
+        case CE_PushButtonLabel:
+            if (const auto* button = qstyleoption_cast<const QStyleOptionButton*>(option)) {
+                QStyleOptionButton label(*button);
+                label.palette.setColor(QPalette::ButtonText,
+                                       (option->state & State_Enabled) ? QColor(Qt::white) : kDisabledTextColor);
+                painter->save();
+                painter->setFont(boldFont(widget));
+                QProxyStyle::drawControl(element, &label, painter, widget);
+                painter->restore();
+                return;
+            }
+            break;
+        default:
+            break;
+        }
+        QProxyStyle::drawControl(element, option, painter, widget);
+    }
+
+    void drawPrimitive(PrimitiveElement element, const QStyleOption* option, QPainter* painter,
+                       const QWidget* widget) const override {
+        if (element == PE_PanelButtonCommand) {
+            drawButtonPanel(option, painter);
+            return;
+        }
+        QProxyStyle::drawPrimitive(element, option, painter, widget);
+    }
+
+    void drawComplexControl(ComplexControl control, const QStyleOptionComplex* option, QPainter* painter,
+                            const QWidget* widget) const override {
+        const auto* box = qstyleoption_cast<const QStyleOptionGroupBox*>(option);
+        if (control != CC_GroupBox || !box || (box->subControls & SC_GroupBoxCheckBox)) {
+            QProxyStyle::drawComplexControl(control, option, painter, widget);
+            return;
+        }
+
+        painter->save();
+        painter->setRenderHint(QPainter::Antialiasing);
+        const QRect frame = subControlRect(CC_GroupBox, box, SC_GroupBoxFrame, widget);
+        painter->setPen(QPen(kBorderColor, kGroupBoxBorder));
+        painter->setBrush(Qt::NoBrush);
+        const qreal inset = kGroupBoxBorder / 2.0;
+        painter->drawRoundedRect(QRectF(frame).adjusted(inset, inset, -inset, -inset), kGroupBoxRadius, kGroupBoxRadius);
+
+        if (!box->text.isEmpty()) {
+            const QRect label = subControlRect(CC_GroupBox, box, SC_GroupBoxLabel, widget);
+            painter->setFont(boldFont(widget));
+            painter->setPen(box->palette.color(QPalette::WindowText));
+            painter->drawText(label, Qt::AlignLeft | Qt::AlignVCenter | Qt::TextShowMnemonic, box->text);
+        }
+        painter->restore();
+    }
+
+    QRect subControlRect(ComplexControl control, const QStyleOptionComplex* option, SubControl subControl,
+                         const QWidget* widget) const override {
+        QRect rect = QProxyStyle::subControlRect(control, option, subControl, widget);
+        if (control == CC_GroupBox && subControl == SC_GroupBoxLabel) {
+            // 标题加粗后更宽
+            if (const auto* box = qstyleoption_cast<const QStyleOptionGroupBox*>(option)) {
+                rect.setWidth(QFontMetrics(boldFont(widget)).horizontalAdvance(box->text) + 2);
+            }
+        }
+        return rect;
+    }
+
+    QSize sizeFromContents(ContentsType type, const QStyleOption* option, const QSize& contentsSize,
+                           const QWidget* widget) const override {
+        const QSize size = QProxyStyle::sizeFromContents(type, option, contentsSize, widget);
+        const auto* button = qstyleoption_cast<const QStyleOptionButton*>(option);
+        if (type != CT_PushButton || !button) {
+            return size;
+        }
+        const QFontMetrics metrics(boldFont(widget));
+        int width = metrics.horizontalAdvance(button->text) + 2 * kButtonPaddingX;
+        int height = metrics.height() + 2 * kButtonPaddingY;
+        if (!button->icon.isNull()) {
+            width += button->iconSize.width() + 4;
+            height = std::max(height, button->iconSize.height() + 2 * kButtonPaddingY);
+        }
+        return size.expandedTo(QSize(width, height));
+    }
+
+private:
+    static void drawButtonPanel(const QStyleOption* option, QPainter* painter) {
+        QColor color = kAccentColor;
+        if (!(option->state & State_Enabled)) {
+            color = kDisabledColor;
+        } else if (option->state & (State_Sunken | State_On)) {
+            color = kAccentPressedColor;
+        } else if (option->state & State_MouseOver) {
+            color = kAccentHoverColor;
+        }
+        painter->save();
+        painter->setRenderHint(QPainter::Antialiasing);
+        painter->setPen(Qt::NoPen);
+        painter->setBrush(color);
+        painter->drawRoundedRect(QRectF(option->rect), kButtonRadius, kButtonRadius);
+        painter->restore();
+    }
+};
+
+/**
+ * 预先解析的状态调色板和统计
+ */
+struct ThemeState {
+    std::array<QPalette, 3> statusPalettes;
+    bool ready = false;
+    Theme::Stats stats;
+
+    void build(const QPalette& base) {
+        // 与原样式表的 green / red / blue 相同
+        static const QColor colors[] = {QColor(0x00, 0x00, 0xff), QColor(0x00, 0x80, 0x00), QColor(0xff, 0x00, 0x00)};
+        for (size_t i = 0; i < statusPalettes.size(); ++i) {
+            statusPalettes[i] = base;
+            statusPalettes[i].setColor(QPalette::WindowText, colors[i]);
+        }
+        ready = true;
+    }
+};
+
+ThemeState& themeState() {
+    static ThemeState state;
+    return state;
+}
+
+} // namespace
+
+QString Theme::Stats::summary() const {
+    const qint64 calls = static_cast<qint64>(statusChanges + statusUnchanged);
+    return QString("主题: 应用耗时 %1 µs，状态切换 %2 次（未变 %3 次），平均每次 %4 ns")
+        .arg(applyNs / 1000)
+        .arg(statusChanges)
+        .arg(statusUnchanged)
+        .arg(calls > 0 ? statusTotalNs / calls : 0);
+}
+
+void Theme::apply(QApplication& app) {
+    QElapsedTimer timer;
+    timer.start();
+
+    auto* style = new ThemeStyle();
+    app.setStyle(style);   // QApplication 接管样式对象
+    QPalette palette = style->standardPalette();
+    style->polish(palette);
+    app.setPalette(palette);
+
+    ThemeState& state = themeState();
+    state.build(palette);
+    state.stats.applyNs = timer.nsecsElapsed();
+}
+
+void Theme::styleStatusLabel(QWidget* label) {
+    label->setFont(boldFont(label));
+    setStatus(label, Status::Neutral);
+}
+
+void Theme::setStatus(QWidget* widget, Status status) {
+    MVVM_TRACE_SCOPE("view", "Theme::setStatus");
+    QElapsedTimer timer;
+    timer.start();
+    ThemeState& state = themeState();
+
+    const int value = static_cast<int>(status);
+    const QVariant current = widget->property(kStatusProperty);
+    if (current.isValid() && current.toInt() == value) {
+        ++state.stats.statusUnchanged;
+    } else {
+        if (!state.ready) {
+            state.build(QApplication::palette());
+        }
+        widget->setProperty(kStatusProperty, value);
+        // 只换调色板：触发一次重绘，不重新 polish，也不解析任何样式规则
+        widget->setPalette(state.statusPalettes[static_cast<size_t>(value)]);
+        ++state.stats.statusChanges;
+    }
+    state.stats.statusTotalNs += timer.nsecsElapsed();
+}
+
+const Theme::Stats& Theme::stats() {
+    return themeState().stats;
+}
+
+} // namespace mvvm
@@ -0,0 +1,27 @@
+#include "view/UserTableView.h"
+#include <QHeaderView>
+
+namespace mvvm {
+
+UserTableView::UserTableView(QWidget* parent)
+    : QTableView(parent) {
+
+    // 固定行高：滚动和定位都是 O(1)，不会逐行询问 sizeHint
+    verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    verticalHeader()->setDefaultSectionSize(fontMetrics().height() + 6);
+    verticalHeader()->hide();
+
+    // ResizeToContents 会遍历所有行，这里只允许交互调整
+    horizontalHeader()->setSectionResizeMode(QHeaderView::Interactive);
+    horizontalHeader()->setStretchLastSection(true);
+
+    setWordWrap(false);
+    setSelectionBehavior(QAbstractItemView::SelectRows);
+    setHorizontalScrollMode(QAbstractItemView::ScrollPerPixel);
+    setVerticalScrollMode(QAbstractItemView::ScrollPerItem);
+    setSortingEnabled(true);
+}
+
+} // namespace mvvm
+
+#include "UserTableView.moc"
@@ -0,0 +1,116 @@
+#include "viewmodel/UserListViewModel.h"
+#include "io/UserExporter.h"
+#include <QDebug>
+
+namespace mvvm {
+
+UserListViewModel::UserListViewModel(std::shared_ptr<UserCollectionModel> users, QObject* parent)
+    : ViewModelBase(parent),
+      users_(users),
+      busy_(false),
+      // 导入和导出互斥：任一运行时两者都不可执行
+      importCommand_([this](const QVariant& path) { return makeImportJob(path.toString()); },
+                     [this]() { return isIdle(); }),
+      exportCommand_([this](const QVariant& path) { return makeExportJob(path.toString()); },
+                     [this]() { return isIdle(); }) {
+
+    for (AsyncCommand* command : {&importCommand_, &exportCommand_}) {
+        connect(command, &AsyncCommand::runningChanged, this, &UserListViewModel::updateBusy);
+        connect(command, &AsyncCommand::progressChanged, this, [this](int, const QString& text) {
+            if (!text.isEmpty()) {
+                setReportMessage(text);
+            }
+        });
+        connect(command, &AsyncCommand::cancelled, this, [this]() {
+            setReportMessage(QString("已取消"));
+        });
+        connect(command, &AsyncCommand::failed, this, [this](const QString& error) {
+            setReportMessage(QString("操作失败: %1").arg(error));
+        });
+    }
+}
+
+void UserListViewModel::importUsers(const QString& path) {
+    importCommand_.executeWith(path);
+}
+
+void UserListViewModel::exportUsers(const QString& path) {
+    exportCommand_.executeWith(path);
+}
+
+void UserListViewModel::cancel() {
+    importCommand_.cancel();
+    exportCommand_.cancel();
+}
+
+void UserListViewModel::setFilterText(const QString& text) {
+    if (users_) {
+        users_->setFilterText(text);
+    }
+}
+
+void UserListViewModel::setReportMessage(const QString& message) {
+    setProperty(reportMessage_, message, QStringLiteral("reportMessage"), &UserListViewModel::reportMessageChanged);
+}
+
+void UserListViewModel::updateBusy() {
+    const bool busy = importCommand_.isRunning() || exportCommand_.isRunning();
+    if (setProperty(busy_, busy, QStringLiteral("busy"), &UserListViewModel::busyChanged)) {
+        importCommand_.updateCanExecute();
+        exportCommand_.updateCanExecute();
+    }
+}
+
+AsyncJob UserListViewModel::makeImportJob(const QString& path) {
+    setReportMessage(QString("正在导入 %1 ...").arg(path));
+
+    auto result = std::make_shared<io::ImportResult>();
+    AsyncJob job;
+    job.run = [path, result](AsyncContext&) {
+        *result = io::UserImporter::importFile(path);
+    };
+    job.finished = [this, result]() {
+        if (result->ok) {
+            users_->addUsers(std::move(result->users));
+            qDebug() << result->stats.summary();
+            setReportMessage(result->stats.summary());
+        } else {
+            setReportMessage(QString("导入失败: %1").arg(result->error));
+        }
+        emit importFinished(result->ok);
+    };
+    return job;
+}
+
+AsyncJob UserListViewModel::makeExportJob(const QString& path) {
+    setReportMessage(QString("正在导出 %1 ...").arg(path));
+
+    // 按当前可见顺序导出（即过滤、排序后的结果）
+    auto store = users_->sharedStore();
+    auto rows = std::make_shared<std::vector<RowId>>(users_->visibleRows());
+    auto outcome = std::make_shared<std::pair<bool, QString>>();
+    AsyncJob job;
+    job.run = [path, store, rows, outcome](AsyncContext& context) {
+        context.setProgressRange(0, 100);
+        io::ExportStats stats;
+        QString error;
+        const bool ok = io::UserExporter::exportFile(
+            path, store, *rows, &stats, &error,
+            [&context, &path](std::size_t done, std::size_t total) {
+                const int percent = total ? static_cast<int>(done * 100 / total) : 100;
+                context.setProgress(percent, QString("正在导出 %1 ... %2%").arg(path).arg(percent));
+                return !context.isCancelled();
+            });
+        *outcome = {ok, ok ? stats.summary() : QString("导出失败: %1").arg(error)};
+    };
+    job.finished = [this, outcome]() {
+        qDebug() << outcome->second;
+        setReportMessage(outcome->second);
+        emit exportFinished(outcome->first);
+    };
+    return job;
+}
+
+} // namespace mvvm
+
+#include "UserListViewModel.moc"
@@ -1,30 +1,68 @@
 #include "viewmodel/UserViewModel.h"
+#include "model/UserValidation.h"
 #include <QDebug>
+#include <QStringList>
+#include <array>
+#include <chrono>
 
 namespace mvvm {
 
+namespace {
+
+// 历史容量：环形缓冲区在构造时一次分配，之后记录不再分配
+constexpr std::size_t kHistoryCapacity = 4096;
+constexpr std::size_t kHistoryMemoryBudget = 1024 * 1024;
+
+// 编辑的合并键：同一字段的连续修改并为一步
+enum EditKey { NoEdit = UndoHistory<UserModel::State>::kNoMerge, NameEdit, EmailEdit, AgeEdit };
+
+// 字符串独占的字节数：与前一版本共享同一块数据（字段未修改）时不计
+std::size_t stringFootprint(const QString& text, const QString* previous) {
+    if (text.capacity() == 0 || (previous && previous->constData() == text.constData())) {
+        return 0;
+    }
+    return sizeof(QArrayData) + (static_cast<std::size_t>(text.capacity()) + 1) * sizeof(QChar);
+}
+
+std::size_t stateFootprint(const UserModel::State& state, const UserModel::State* previous) {
+    return stringFootprint(state.name, previous ? &previous->name : nullptr) +
+           stringFootprint(state.email, previous ? &previous->email : nullptr);
+}
+
+struct SaveMetrics {
+    common::Counter& saves;
+    common::Histogram& latency;
+};
+
+const SaveMetrics& saveMetrics() {
+    static const SaveMetrics metrics{
+        common::MetricsRegistry::global().counter("mvvm_saves_total", "完成的保存次数"),
+        common::MetricsRegistry::global().latencyHistogram(
+            "mvvm_save_duration_seconds", "从执行保存命令到保存完成并更新列表的耗时")};
+    return metrics;
+}
+
+} // namespace
+
 UserViewModel::UserViewModel(std::shared_ptr<UserModel> model, QObject* parent)
-    : ViewModelBase(parent), userModel_(model), canSave_(false) {
-    
+    : ViewModelBase(parent), userModel_(model), displayAge_(displayAgeText(0)), age_(0), canSave_(false),
+      saveCommand_([this](const QVariant&) { return makeSaveJob(); },
+                   [this]() { return canSave_; }),
+      resetCommand_([this]() { resetUser(); }),
+      history_(kHistoryCapacity, kHistoryMemoryBudget, &stateFootprint),
+      editKey_(NoEdit),
+      restoring_(false),
+      undoCommand_([this]() { undo(); }, [this]() { return history_.canUndo(); }),
+      redoCommand_([this]() { redo(); }, [this]() { return history_.canRedo(); }) {
+
+    saveCommand_.setPolicy(AsyncCommand::Policy::Queue);
+
     if (userModel_) {
+        history_.reset(userModel_->state());
+
         // 连接模型信号
         connect(userModel_.get(), &UserModel::dataChanged, 
                 this, &UserViewModel::onModelDataChanged);
-        connect(userModel_.get(), &UserModel::validationChanged, 
-                this, &UserViewModel::canSaveChanged);
-        
-        // 创建命令
-        saveCommand_ = new DelegateCommand(
-            [this]() { saveUser(); },
-            [this]() { return canSave_; },
-            this
-        );
-        
-        resetCommand_ = new DelegateCommand(
-            [this]() { resetUser(); },
-            nullptr,
-            this
-        );
         
         // 初始化显示属性
         updateDisplayProperties();
@@ -32,43 +70,164 @@ UserViewModel::UserViewModel(std::shared_ptr<UserModel> model, QObject* parent)
 }
 
 void UserViewModel::onModelDataChanged() {
+    MVVM_TRACE_SCOPE("viewmodel", "UserViewModel::onModelDataChanged");
+    if (userModel_ && !restoring_) {
+        // 无论修改来自本视图模型、绑定还是跨线程的补丁，都记入历史
+        history_.record(userModel_->state(), editKey_);
+        notifyHistoryChanged();
+    }
     updateDisplayProperties();
 }
 
 void UserViewModel::updateName(const QString& name) {
+    MVVM_TRACE_SCOPE("viewmodel", "UserViewModel::updateName");
     if (userModel_) {
+        editKey_ = NameEdit;
         userModel_->setName(name);
+        editKey_ = NoEdit;
     }
 }
 
 void UserViewModel::updateEmail(const QString& email) {
+    MVVM_TRACE_SCOPE("viewmodel", "UserViewModel::updateEmail");
     if (userModel_) {
+        editKey_ = EmailEdit;
         userModel_->setEmail(email);
+        editKey_ = NoEdit;
     }
 }
 
 void UserViewModel::updateAge(const QString& ageStr) {
+    MVVM_TRACE_SCOPE("viewmodel", "UserViewModel::updateAge");
     if (userModel_) {
         int age = parseAge(ageStr);
+        editKey_ = AgeEdit;
         userModel_->setAge(age);
+        editKey_ = NoEdit;
+    }
+}
+
+void UserViewModel::setAge(int age) {
+    MVVM_TRACE_SCOPE("viewmodel", "UserViewModel::setAge");
+    if (userModel_) {
+        editKey_ = AgeEdit;
+        userModel_->setAge(age);
+        editKey_ = NoEdit;
+    }
+}
+
+void UserViewModel::undo() {
+    MVVM_TRACE_SCOPE("viewmodel", "UserViewModel::undo");
+    restoreState(history_.undo());
+}
+
+void UserViewModel::redo() {
+    MVVM_TRACE_SCOPE("viewmodel", "UserViewModel::redo");
+    restoreState(history_.redo());
+}
+
+void UserViewModel::restoreState(const UserModel::State* state) {
+    if (!state || !userModel_) {
+        return;
+    }
+    restoring_ = true;
+    userModel_->restore(*state);
+    restoring_ = false;
+    notifyHistoryChanged();
+}
+
+void UserViewModel::notifyHistoryChanged() {
+    undoCommand_.updateCanExecute();
+    redoCommand_.updateCanExecute();
+    emit historyChanged();
+}
+
+void UserViewModel::setHistoryMemoryBudget(std::size_t bytes) {
+    history_.setMemoryBudget(bytes);
+    notifyHistoryChanged();
+}
+
+void UserViewModel::setUserCollection(std::shared_ptr<UserCollectionModel> collection) {
+    userCollection_ = collection;
+}
+
+void UserViewModel::setUserStore(std::shared_ptr<storage::UserStore> store) {
+    if (userStore_) {
+        disconnect(userStore_.get(), nullptr, this, nullptr);
+    }
+    userStore_ = store;
+    if (userStore_) {
+        connect(userStore_.get(), &storage::UserStore::recovered,
+                this, &UserViewModel::onStoreRecovered);
     }
 }
 
-void UserViewModel::saveUser() {
-    if (userModel_ && userModel_->isValid()) {
-        qDebug() << "=== 保存用户信息 ===";
-        qDebug() << userModel_->getUserInfo();
+void UserViewModel::onStoreRecovered(std::shared_ptr<storage::RecoveryResult> result) {
+    if (!userCollection_ || result->users.liveCount() == 0) {
+        return;
+    }
+    const RowId first = static_cast<RowId>(userCollection_->store().slotCount());
+    userCollection_->addUsers(std::move(result->users));
+    const UserColumnStore& rows = userCollection_->store();
+    for (RowId id = first; id < rows.slotCount(); ++id) {
+        savedRows_[rows.email(id)] = id;
+    }
+}
+
+AsyncJob UserViewModel::makeSaveJob() {
+    AsyncJob job;
+    if (!userModel_ || !userModel_->isValid()) {
+        return job;
+    }
+    // 保存点之后的输入另起一步
+    history_.breakMerge();
+    qDebug() << "=== 保存用户信息 ===";
+    qDebug() << userModel_->getUserInfo();
+
+    // 在 GUI 线程取当前值，线程池中只做提交
+    const QString name = userModel_->name();
+    const QString email = userModel_->email();
+    const int age = userModel_->age();
+    const auto started = std::chrono::steady_clock::now();
+    auto store = userStore_;
+    job.run = [store, name, email, age](AsyncContext&) {
+        if (store) {
+            store->save(name, email, age);
+        }
+    };
+    job.finished = [this, name, email, age, started]() {
+        applySavedUser(name, email, age);
+        const SaveMetrics& metrics = saveMetrics();
+        metrics.saves.add();
+        metrics.latency.record(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                   std::chrono::steady_clock::now() - started).count());
         qDebug() << "用户信息已成功保存!";
         emit userSaved();
+    };
+    return job;
+}
+
+void UserViewModel::applySavedUser(const QString& name, const QString& email, int age) {
+    MVVM_TRACE_SCOPE("viewmodel", "UserViewModel::applySavedUser");
+    if (!userCollection_) {
+        return;
+    }
+    // 与存储一致，以邮箱为键：已保存过的用户原地更新
+    const std::string key = email.toStdString();
+    const UserColumnStore& rows = userCollection_->store();
+    auto it = savedRows_.find(key);
+    if (it != savedRows_.end() && it->second < rows.slotCount() &&
+        rows.isAlive(it->second) && rows.emailEquals(it->second, key)) {
+        userCollection_->updateUser(it->second, name, email, age);
+    } else {
+        savedRows_[key] = userCollection_->addUser(name, email, age);
     }
 }
 
 void UserViewModel::resetUser() {
     if (userModel_) {
-        userModel_->setName("");
-        userModel_->setEmail("");
-        userModel_->setAge(0);
-        qDebug() << "用户信息已重置!";
+        // 一次应用：重置在历史中只占一步
+        userModel_->restore(UserModel::State());
         emit userReset();
     }
 }
@@ -82,42 +241,99 @@ QString UserViewModel::getUserDisplayInfo() const {
 
 void UserViewModel::updateDisplayProperties() {
     if (userModel_) {
-        setProperty(displayName_, userModel_->name(), "displayName");
-        setProperty(displayEmail_, userModel_->email(), "displayEmail");
-        setProperty(displayAge_, QString::number(userModel_->age()), "displayAge");
-        setProperty(canSave_, userModel_->isValid(), "canSave");
-        updateStatusMessage();
+        bool changed = false;
+        changed |= setProperty(displayName_, userModel_->name(), QStringLiteral("displayName"),
+                               &UserViewModel::displayNameChanged);
+        changed |= setProperty(displayEmail_, userModel_->email(), QStringLiteral("displayEmail"),
+                               &UserViewModel::displayEmailChanged);
+        if (setProperty(age_, userModel_->age(), QStringLiteral("age"), &UserViewModel::ageChanged)) {
+            setProperty(displayAge_, displayAgeText(age_), QStringLiteral("displayAge"),
+                        &UserViewModel::displayAgeChanged);
+            changed = true;
+        }
+        changed |= setProperty(canSave_, userModel_->isValid(), QStringLiteral("canSave"),
+                               &UserViewModel::canSaveChanged);
+        changed |= updateStatusMessage();
         
         // 通知命令状态可能已更改
-        saveCommand_->updateCanExecute();
+        saveCommand_.updateCanExecute();
+
+        if (changed) {
+            publishState();
+        }
     }
 }
 
-void UserViewModel::updateStatusMessage() {
+void UserViewModel::publishState() {
+    MVVM_TRACE_SCOPE("viewmodel", "UserViewModel::publishState");
+    UserViewState state;
+    state.displayName = displayName_;
+    state.displayEmail = displayEmail_;
+    state.displayAge = displayAge_;
+    state.statusMessage = statusMessage_;
+    state.age = age_;
+    state.canSave = canSave_;
+    state.version = state_.version() + 1;
+    state_.publish(state);
+    emit stateChanged();
+}
+
+QString UserViewModel::displayAgeText(int age) {
+    // 有效年龄的文本预先生成，逐键输入年龄时只做引用计数复制
+    static const std::array<QString, 151> texts = [] {
+        std::array<QString, 151> result;
+        for (int i = 0; i < static_cast<int>(result.size()); ++i) {
+            result[i] = QString::number(i);
+        }
+        return result;
+    }();
+    return validation::isValidAge(age) ? texts[age] : QString::number(age);
+}
+
+bool UserViewModel::updateStatusMessage() {
     if (!userModel_) {
-        setProperty(statusMessage_, QString("错误: 无数据模型"), "statusMessage");
-        return;
+        return setProperty(statusMessage_, QString("错误: 无数据模型"), QStringLiteral("statusMessage"),
+                           &UserViewModel::statusMessageChanged);
     }
 
-    QString newStatusMessage;
-    if (userModel_->isValid()) {
-        newStatusMessage = "✅ 数据有效，可以保存";
-    } else {
-        QStringList errors;
+    // 状态文本只有"有效"和 8 种错误位组合，预先生成，按位掩码取用
+    enum { NameError = 1, EmailError = 2, AgeError = 4 };
+    static const std::array<QString, 8> invalidMessages = [] {
+        std::array<QString, 8> result;
+        for (int mask = 0; mask < static_cast<int>(result.size()); ++mask) {
+            QStringList errors;
+            if (mask & NameError) {
+                errors << "姓名不能为空";
+            }
+            if (mask & EmailError) {
+                errors << "邮箱格式无效";
+            }
+            if (mask & AgeError) {
+                errors << "年龄无效";
+            }
+            result[mask] = QString("❌ 数据无效: %1").arg(errors.join(", "));
+        }
+        return result;
+    }();
+    static const QString validMessage("✅ 数据有效，可以保存");
+
+    const QString* newStatusMessage = &validMessage;
+    if (!userModel_->isValid()) {
+        int mask = 0;
         if (userModel_->name().isEmpty()) {
-            errors << "姓名不能为空";
+            mask |= NameError;
         }
         if (userModel_->email().isEmpty() || !userModel_->email().contains('@')) {
-            errors << "邮箱格式无效";
+            mask |= EmailError;
         }
-        if (userModel_->age() < 0 || userModel_->age() > 150) {
-            errors << "年龄无效";
+        if (!validation::isValidAge(userModel_->age())) {
+            mask |= AgeError;
         }
-        
-        newStatusMessage = QString("❌ 数据无效: %1").arg(errors.join(", "));
+        newStatusMessage = &invalidMessages[mask];
     }
     
-    setProperty(statusMessage_, newStatusMessage, "statusMessage");
+    return setProperty(statusMessage_, *newStatusMessage, QStringLiteral("statusMessage"),
+                       &UserViewModel::statusMessageChanged);
 }
 
 int UserViewModel::parseAge(const QString& ageStr) const {
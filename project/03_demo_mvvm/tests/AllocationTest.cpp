@@ -0,0 +1,243 @@
+#include "core/InplaceFunction.h"
+#include "model/UserModel.h"
+#include "viewmodel/UserViewModel.h"
+#include <gtest/gtest.h>
+#include <QString>
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <new>
+
+/**
+ * 堆分配计数
+ *
+ * 替换全局 operator new；glibc 下同时拦截 malloc 系列（QString 等 Qt 容器直接调用 malloc）。
+ * 其他平台只能看到 operator new，依赖 Qt 容器的用例在那里跳过，而不是在没有计数的情况下通过。
+ * 只在 AllocationScope 存活期间计数，gtest 自身的分配不受影响。
+ */
+namespace {
+
+#if defined(__GLIBC__)
+constexpr bool kCountsMalloc = true;
+#else
+constexpr bool kCountsMalloc = false;
+#endif
+
+std::atomic<bool> counting{false};
+std::atomic<long> allocations{0};
+
+void countAllocation() {
+    if (counting.load(std::memory_order_relaxed)) {
+        allocations.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+class AllocationScope {
+public:
+    AllocationScope() {
+        allocations = 0;
+        counting = true;
+    }
+    ~AllocationScope() { counting = false; }
+
+    long count() const { return allocations.load(); }
+};
+
+} // namespace
+
+#if defined(__GLIBC__)
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* pointer, size_t size);
+
+void* malloc(size_t size) {
+    countAllocation();
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size) {
+    countAllocation();
+    return __libc_calloc(count, size);
+}
+
+void* realloc(void* pointer, size_t size) {
+    countAllocation();
+    return __libc_realloc(pointer, size);
+}
+}
+#endif
+
+void* operator new(std::size_t size) {
+#if !defined(__GLIBC__)
+    countAllocation();
+#endif
+    if (void* pointer = std::malloc(size ? size : 1)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+#if !defined(__GLIBC__)
+    countAllocation();
+#endif
+    return std::malloc(size ? size : 1);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept {
+    return operator new(size, tag);
+}
+
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+void operator delete[](void* pointer) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::size_t) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, std::size_t) noexcept { std::free(pointer); }
+
+namespace mvvm {
+namespace {
+
+class UserViewModelAllocationTest : public ::testing::Test {
+protected:
+    std::shared_ptr<UserModel> model_ = std::make_shared<UserModel>();
+    UserViewModel viewModel_{model_};
+
+    // 输入值预先构造好，模拟控件已经持有的字符串
+    const QString names_[2] = {QStringLiteral("张三"), QStringLiteral("李四")};
+    const QString emails_[2] = {QStringLiteral("zhang@example.com"), QStringLiteral("li@bad")};
+    const QString ages_[2] = {QStringLiteral("25"), QStringLiteral("80")};
+
+    int notifications_ = 0;
+
+    void SetUp() override {
+        QObject::connect(&viewModel_, &ViewModelBase::propertyChanged,
+                         [this](const QString&) { ++notifications_; });
+    }
+
+    // 一轮典型的编辑：逐字段修改、合法与非法状态来回切换、执行重置命令
+    void editCycle() {
+        for (int i = 0; i < 2; ++i) {
+            viewModel_.updateName(names_[i]);
+            viewModel_.updateEmail(emails_[i]);
+            viewModel_.updateAge(ages_[i]);
+            viewModel_.setAge(30 + i);
+            viewModel_.saveCommand()->canExecute();
+        }
+        viewModel_.resetCommand()->execute();
+    }
+};
+
+TEST(AllocationCounterTest, CountsHeapAllocations) {
+    // 计数钩子本身失效时（例如被静态链接的分配器绕过），下面的"零分配"断言都没有意义
+    long count = 0;
+    {
+        AllocationScope scope;
+        int* volatile pointer = new int(42);   // volatile：防止编译器省略这次分配
+        delete pointer;
+        count = scope.count();
+    }
+    EXPECT_EQ(count, 1);
+
+    if (!kCountsMalloc) {
+        GTEST_SKIP() << "此平台无法拦截 malloc，看不到 Qt 容器的分配";
+    }
+    {
+        AllocationScope scope;
+        QString text(64, QLatin1Char('x'));
+        count = scope.count();
+    }
+    EXPECT_GE(count, 1);
+}
+
+TEST_F(UserViewModelAllocationTest, SteadyStateEditsDoNotAllocate) {
+    if (!kCountsMalloc) {
+        GTEST_SKIP() << "此平台无法拦截 malloc，看不到 QString 的分配";
+    }
+
+    // 预热：首次使用时生成的静态文本表等
+    editCycle();
+    editCycle();
+
+    const int before = notifications_;
+    long count = 0;
+    {
+        AllocationScope scope;
+        for (int i = 0; i < 100; ++i) {
+            editCycle();
+        }
+        count = scope.count();
+    }
+
+    EXPECT_GT(notifications_, before);
+    EXPECT_EQ(count, 0) << "属性更新或命令执行期间发生了 " << count << " 次堆分配";
+}
+
+TEST_F(UserViewModelAllocationTest, UndoRedoDoesNotAllocate) {
+    if (!kCountsMalloc) {
+        GTEST_SKIP() << "此平台无法拦截 malloc，恢复模型时复制 QString 的分配不可见";
+    }
+
+    viewModel_.updateName(names_[0]);
+    viewModel_.updateEmail(emails_[0]);
+    viewModel_.setAge(30);
+    // 预热：历史节点和快照空闲列表
+    viewModel_.undo();
+    viewModel_.redo();
+
+    long count = 0;
+    {
+        AllocationScope scope;
+        for (int i = 0; i < 100; ++i) {
+            viewModel_.undoCommand()->execute();
+            viewModel_.undoCommand()->execute();
+            viewModel_.redoCommand()->execute();
+            viewModel_.redoCommand()->execute();
+        }
+        count = scope.count();
+    }
+    EXPECT_EQ(viewModel_.age(), 30);
+    EXPECT_EQ(count, 0) << "撤销 / 重做期间发生了 " << count << " 次堆分配";
+}
+
+TEST(InplaceFunctionTest, CopyAndCallDoNotAllocate) {
+    int calls = 0;
+    long count = 0;
+    {
+        AllocationScope scope;
+        InplaceFunction<void()> function = [&calls]() { ++calls; };
+        InplaceFunction<void()> copy = function;
+        InplaceFunction<void()> moved = std::move(copy);
+        function();
+        moved();
+        count = scope.count();
+    }
+    EXPECT_EQ(calls, 2);
+    EXPECT_EQ(count, 0);
+}
+
+TEST(InplaceFunctionTest, EmptyTargetsAreFalse) {
+    InplaceFunction<bool()> empty = nullptr;
+    EXPECT_FALSE(empty);
+
+    std::function<bool()> emptyFunction;
+    InplaceFunction<bool()> wrapped = emptyFunction;
+    EXPECT_FALSE(wrapped);
+
+    // 任何平台上默认容量都放得下 std::function
+    static_assert(sizeof(std::function<bool()>) <= defaultInplaceCapacity<bool()>, "默认容量应能容纳 std::function");
+    std::function<bool()> function = []() { return true; };
+    InplaceFunction<bool()> wrappedFunction = function;
+    ASSERT_TRUE(wrappedFunction);
+    EXPECT_TRUE(wrappedFunction());
+
+    InplaceFunction<bool()> set = []() { return true; };
+    ASSERT_TRUE(set);
+    EXPECT_TRUE(set());
+}
+
+} // namespace
+} // namespace mvvm
@@ -0,0 +1,66 @@
+#include "TestSupport.h"
+#include "model/UserModel.h"
+#include "viewmodel/UserViewModel.h"
+#include <gtest/gtest.h>
+#include <memory>
+
+namespace mvvm {
+namespace {
+
+/**
+ * 以另一个视图模型的姓名属性充当"控件"属性，测试不需要 Widgets
+ */
+using NameBinding = Binding<QString, UserViewModel::NameProperty, UserViewModel::NameProperty>;
+
+class BindingTest : public ::testing::Test {
+protected:
+    UserViewModel source_{std::make_shared<UserModel>()};   // 控件一侧
+    UserViewModel target_{std::make_shared<UserModel>()};   // ViewModel 一侧
+    NameBinding binding_{&source_, &target_};
+};
+
+TEST_F(BindingTest, WritesThroughWithoutLimiter) {
+    source_.updateName(QStringLiteral("张三"));
+    EXPECT_EQ(target_.displayName(), QStringLiteral("张三"));
+
+    target_.updateName(QStringLiteral("李四"));
+    EXPECT_EQ(source_.displayName(), QStringLiteral("李四"));
+}
+
+TEST_F(BindingTest, DebounceHoldsWriteUntilFlush) {
+    binding_.debounce(60 * 1000);
+    source_.updateName(QStringLiteral("张三"));
+    EXPECT_TRUE(target_.displayName().isEmpty());
+
+    binding_.flush();
+    EXPECT_EQ(target_.displayName(), QStringLiteral("张三"));
+}
+
+TEST_F(BindingTest, SecondLimitReplacesFirst) {
+    // 限流后改为节流：空闲时的第一次变化立即写入
+    binding_.debounce(60 * 1000).throttle(60 * 1000);
+    source_.updateName(QStringLiteral("张三"));
+    EXPECT_EQ(target_.displayName(), QStringLiteral("张三"));
+
+    // 节流周期内的变化合并到周期末尾
+    source_.updateName(QStringLiteral("张三丰"));
+    EXPECT_EQ(target_.displayName(), QStringLiteral("张三"));
+
+    // 再改回防抖：周期内未写入的值先按旧设置写入，之后的变化等待停顿
+    binding_.debounce(60 * 1000);
+    EXPECT_EQ(target_.displayName(), QStringLiteral("张三丰"));
+    source_.updateName(QStringLiteral("李四"));
+    EXPECT_EQ(target_.displayName(), QStringLiteral("张三丰"));
+    binding_.flush();
+    EXPECT_EQ(target_.displayName(), QStringLiteral("李四"));
+}
+
+TEST_F(BindingTest, ReplacedIntervalTakesEffect) {
+    binding_.debounce(60 * 1000).debounce(10);
+    source_.updateName(QStringLiteral("张三"));
+    EXPECT_TRUE(target_.displayName().isEmpty());
+    EXPECT_TRUE(test::processEventsUntil([this]() { return target_.displayName() == QStringLiteral("张三"); }));
+}
+
+} // namespace
+} // namespace mvvm
@@ -0,0 +1,242 @@
+#include "sync/SharedUserChannel.h"
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+namespace mvvm {
+namespace sync {
+namespace {
+
+SharedUser makeUser(const std::string& name, const std::string& email, int age) {
+    SharedUser user;
+    user.name = name;
+    user.email = email;
+    user.age = age;
+    return user;
+}
+
+#ifdef __linux__
+bool waitReadable(int fd, int timeoutMs) {
+    pollfd entry = {fd, POLLIN, 0};
+    return ::poll(&entry, 1, timeoutMs) == 1 && (entry.revents & POLLIN);
+}
+#endif
+
+/**
+ * 同一进程内的多个通道各自映射共享区，与多个进程走相同的路径
+ */
+class SharedUserChannelTest : public ::testing::Test {
+protected:
+    std::string name_;
+
+    void SetUp() override {
+#ifndef __linux__
+        GTEST_SKIP() << "共享内存同步仅支持 Linux";
+#else
+        name_ = "test-" + std::to_string(getpid()) + "-" +
+                ::testing::UnitTest::GetInstance()->current_test_info()->name();
+        SharedUserChannel::remove(name_);
+#endif
+    }
+
+    void TearDown() override {
+        if (!name_.empty()) {
+            SharedUserChannel::remove(name_);
+        }
+    }
+
+    void open(SharedUserChannel& channel) {
+        std::string error;
+        ASSERT_TRUE(channel.open(name_, &error)) << error;
+    }
+};
+
+TEST_F(SharedUserChannelTest, PublishesChangedFieldsToOtherChannels) {
+    SharedUserChannel a, b;
+    open(a);
+    open(b);
+
+    EXPECT_EQ(a.publish(makeUser("张三", "zhang@example.com", 25)), 1u);
+    SharedUserChannel::Update update;
+    ASSERT_TRUE(b.poll(update));
+    EXPECT_EQ(update.user.name, "张三");
+    EXPECT_EQ(update.user.email, "zhang@example.com");
+    EXPECT_EQ(update.user.age, 25);
+    EXPECT_EQ(update.fields, std::uint32_t(SharedUserChannel::AllFields));
+    EXPECT_EQ(update.version, 1u);
+    EXPECT_FALSE(update.resynced);
+
+    // 只发布有差异的字段
+    EXPECT_EQ(a.publish(makeUser("张三", "zhang@example.com", 26)), 2u);
+    ASSERT_TRUE(b.poll(update));
+    EXPECT_EQ(update.fields, std::uint32_t(SharedUserChannel::Age));
+    EXPECT_EQ(update.user.age, 26);
+    EXPECT_EQ(update.user.name, "张三");
+
+    EXPECT_FALSE(b.poll(update));
+}
+
+TEST_F(SharedUserChannelTest, OwnAndUnchangedPublishesAreNotReported) {
+    SharedUserChannel a;
+    open(a);
+    const SharedUser user = makeUser("张三", "zhang@example.com", 25);
+    ASSERT_EQ(a.publish(user), 1u);
+    EXPECT_EQ(a.publish(user), 0u);
+    EXPECT_EQ(a.version(), 1u);
+
+    SharedUserChannel::Update update;
+    EXPECT_FALSE(a.poll(update));
+}
+
+TEST_F(SharedUserChannelTest, NotifyFdBecomesReadableOnPublish) {
+    SharedUserChannel a, b;
+    open(a);
+    open(b);
+    ASSERT_GE(b.notifyFd(), 0);
+#ifdef __linux__
+    EXPECT_FALSE(waitReadable(b.notifyFd(), 0));
+    a.publish(makeUser("张三", "", 0));
+    EXPECT_TRUE(waitReadable(b.notifyFd(), 5000));
+
+    // poll() 清除可读状态
+    SharedUserChannel::Update update;
+    ASSERT_TRUE(b.poll(update));
+    EXPECT_FALSE(waitReadable(b.notifyFd(), 0));
+#endif
+}
+
+TEST_F(SharedUserChannelTest, LateJoinerReadsCurrentState) {
+    SharedUserChannel a;
+    open(a);
+    a.publish(makeUser("张三", "zhang@example.com", 25));
+    a.publish(makeUser("李四", "zhang@example.com", 25));
+    a.close();
+
+    // 共享区在所有通道关闭后保留
+    SharedUserChannel b;
+    open(b);
+#ifdef __linux__
+    EXPECT_TRUE(waitReadable(b.notifyFd(), 0));
+#endif
+    SharedUserChannel::Update update;
+    ASSERT_TRUE(b.poll(update));
+    EXPECT_TRUE(update.resynced);
+    EXPECT_EQ(update.version, 2u);
+    EXPECT_EQ(update.user.name, "李四");
+    EXPECT_EQ(update.user.email, "zhang@example.com");
+    EXPECT_EQ(update.user.age, 25);
+}
+
+TEST_F(SharedUserChannelTest, FallingBehindRingResyncsFromState) {
+    SharedUserChannel a, b;
+    open(a);
+    open(b);
+    const int publishes = static_cast<int>(SharedUserChannel::kRingSize) * 2 + 3;
+    for (int i = 1; i <= publishes; ++i) {
+        ASSERT_NE(a.publish(makeUser("张三", "", i)), 0u);
+    }
+
+    SharedUserChannel::Update update;
+    ASSERT_TRUE(b.poll(update));
+    EXPECT_TRUE(update.resynced);
+    EXPECT_EQ(update.version, std::uint64_t(publishes));
+    EXPECT_EQ(update.user.age, publishes);
+    EXPECT_EQ(update.fields, std::uint32_t(SharedUserChannel::Name | SharedUserChannel::Age));
+}
+
+TEST_F(SharedUserChannelTest, LongTextIsTruncatedAtCharacterBoundary) {
+    SharedUserChannel a, b;
+    open(a);
+    open(b);
+    // "张" 为 3 字节，512 不是 3 的倍数：截断不能落在字符中间
+    std::string name;
+    while (name.size() <= SharedUserChannel::kMaxTextBytes) {
+        name += "张";
+    }
+    ASSERT_NE(a.publish(makeUser(name, "", 0)), 0u);
+    // 截断后的值与已发布状态相同，再次发布原文不算差异
+    EXPECT_EQ(a.publish(makeUser(name, "", 0)), 0u);
+
+    SharedUserChannel::Update update;
+    ASSERT_TRUE(b.poll(update));
+    EXPECT_LE(update.user.name.size(), SharedUserChannel::kMaxTextBytes);
+    EXPECT_EQ(update.user.name.size() % 3, 0u);
+    EXPECT_EQ(update.user.name, name.substr(0, update.user.name.size()));
+}
+
+TEST_F(SharedUserChannelTest, ConcurrentPublishersConverge) {
+    SharedUserChannel observer;
+    open(observer);
+
+    // 两个发布者交错写入不同字段；总数不超过环形缓冲区，观察者按序号逐条合并
+    constexpr int kPerWriter = static_cast<int>(SharedUserChannel::kRingSize) / 2 - 1;
+    std::vector<std::thread> writers;
+    for (int writer = 0; writer < 2; ++writer) {
+        writers.emplace_back([this, writer]() {
+            SharedUserChannel channel;
+            ASSERT_TRUE(channel.open(name_));
+            for (int i = 1; i <= kPerWriter; ++i) {
+                const std::string text = "w" + std::to_string(writer) + "-" + std::to_string(i);
+                channel.publish(makeUser(text, writer == 0 ? text : std::string(), writer * 1000 + i));
+            }
+        });
+    }
+    for (auto& writer : writers) {
+        writer.join();
+    }
+
+    SharedUserChannel::Update merged;
+    ASSERT_TRUE(observer.poll(merged));
+    EXPECT_FALSE(merged.resynced);
+
+    // 逐条合并的结果与写者维护的整体状态一致
+    SharedUserChannel late;
+    open(late);
+    SharedUserChannel::Update snapshot;
+    ASSERT_TRUE(late.poll(snapshot));
+    EXPECT_TRUE(snapshot.resynced);
+    EXPECT_EQ(merged.version, snapshot.version);
+    EXPECT_EQ(merged.user.name, snapshot.user.name);
+    EXPECT_EQ(merged.user.email, snapshot.user.email);
+    EXPECT_EQ(merged.user.age, snapshot.user.age);
+}
+
+#ifdef __linux__
+TEST_F(SharedUserChannelTest, ReceivesPublishFromAnotherProcess) {
+    SharedUserChannel channel;
+    open(channel);
+
+    const pid_t child = fork();
+    ASSERT_GE(child, 0);
+    if (child == 0) {
+        SharedUserChannel other;
+        const bool ok = other.open(name_) && other.publish(makeUser("李四", "li@example.com", 40)) != 0;
+        other.close();
+        _exit(ok ? 0 : 1);
+    }
+
+    int status = 0;
+    ASSERT_EQ(waitpid(child, &status, 0), child);
+    ASSERT_TRUE(WIFEXITED(status));
+    ASSERT_EQ(WEXITSTATUS(status), 0);
+
+    ASSERT_TRUE(waitReadable(channel.notifyFd(), 5000));
+    SharedUserChannel::Update update;
+    ASSERT_TRUE(channel.poll(update));
+    EXPECT_EQ(update.user.name, "李四");
+    EXPECT_EQ(update.user.email, "li@example.com");
+    EXPECT_EQ(update.user.age, 40);
+    EXPECT_EQ(update.fields, std::uint32_t(SharedUserChannel::AllFields));
+}
+#endif
+
+} // namespace
+} // namespace sync
+} // namespace mvvm
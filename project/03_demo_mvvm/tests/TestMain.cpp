@@ -0,0 +1,11 @@
+#include <QCoreApplication>
+#include <gtest/gtest.h>
+
+/**
+ * 测试入口：模型的后台任务通过 QFutureWatcher 和排队调用回到本线程，需要 QCoreApplication
+ */
+int main(int argc, char *argv[]) {
+    QCoreApplication app(argc, argv);
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <chrono>
+#include <thread>
+
+namespace mvvm {
+namespace test {
+
+/**
+ * 处理本线程的事件直到 condition() 为真；超时返回 false
+ */
+template<typename Condition>
+bool processEventsUntil(Condition condition, int timeoutMs = 5000) {
+    QElapsedTimer timer;
+    timer.start();
+    while (!condition()) {
+        if (timer.elapsed() > timeoutMs) {
+            return false;
+        }
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+    }
+    return true;
+}
+
+/**
+ * 不处理事件，只等待后台线程使 condition() 为真（排队到本线程的回调保持未执行）；超时返回 false
+ */
+template<typename Condition>
+bool waitWithoutEvents(Condition condition, int timeoutMs = 5000) {
+    QElapsedTimer timer;
+    timer.start();
+    while (!condition()) {
+        if (timer.elapsed() > timeoutMs) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+} // namespace test
+} // namespace mvvm
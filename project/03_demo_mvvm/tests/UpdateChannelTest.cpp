@@ -0,0 +1,124 @@
+#include "TestSupport.h"
+#include "core/MpscQueue.h"
+#include "core/UpdateChannel.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace mvvm {
+namespace {
+
+constexpr int kProducers = 4;
+constexpr int kPerProducer = 20000;
+
+struct Update {
+    int producer = -1;
+    int seq = -1;
+};
+
+/**
+ * 检查按出队顺序收到的更新：每个生产者的序号从 0 开始连续递增，既不丢失也不重复
+ */
+class OrderChecker {
+    std::vector<int> next_ = std::vector<int>(kProducers, 0);
+    int received_ = 0;
+
+public:
+    void receive(const Update& update) {
+        ASSERT_GE(update.producer, 0);
+        ASSERT_LT(update.producer, kProducers);
+        ASSERT_EQ(update.seq, next_[update.producer]) << "生产者 " << update.producer << " 的更新乱序或丢失";
+        ++next_[update.producer];
+        ++received_;
+    }
+
+    int received() const { return received_; }
+
+    void expectComplete() const {
+        for (int producer = 0; producer < kProducers; ++producer) {
+            EXPECT_EQ(next_[producer], kPerProducer) << "生产者 " << producer;
+        }
+    }
+};
+
+// 所有生产者就绪后同时开始，增加入队交错的机会
+template<typename Post>
+std::vector<std::thread> startProducers(std::atomic<bool>& go, Post post) {
+    std::vector<std::thread> producers;
+    for (int producer = 0; producer < kProducers; ++producer) {
+        producers.emplace_back([&go, post, producer]() {
+            while (!go.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            for (int seq = 0; seq < kPerProducer; ++seq) {
+                post(Update{producer, seq});
+            }
+        });
+    }
+    return producers;
+}
+
+TEST(MpscQueueTest, KeepsPerProducerOrderUnderContention) {
+    MpscQueue<Update> queue;
+    std::atomic<bool> go{false};
+    auto producers = startProducers(go, [&queue](Update update) { queue.push(update); });
+
+    // 消费者与生产者并发出队，覆盖"链接尚未完成"的中间状态
+    OrderChecker checker;
+    go.store(true, std::memory_order_release);
+    Update update;
+    while (checker.received() < kProducers * kPerProducer) {
+        if (queue.tryPop(update)) {
+            checker.receive(update);
+            if (::testing::Test::HasFatalFailure()) {
+                break;
+            }
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+
+    checker.expectComplete();
+    EXPECT_FALSE(queue.tryPop(update));
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(UpdateChannelTest, BatchesKeepPerProducerOrder) {
+    OrderChecker checker;
+    int batches = 0;
+    UpdateChannel<Update> channel([&checker, &batches](std::vector<Update>& batch) {
+        ++batches;
+        for (const Update& update : batch) {
+            checker.receive(update);
+        }
+    });
+    channel.setFrameInterval(1);
+
+    std::atomic<bool> go{false};
+    auto producers = startProducers(go, [&channel](Update update) { channel.post(update); });
+    go.store(true, std::memory_order_release);
+
+    // 本线程充当 GUI 线程：处理唤醒事件和帧定时器，直到全部更新应用完毕
+    const bool done = test::processEventsUntil(
+        [&checker]() { return ::testing::Test::HasFatalFailure() || checker.received() == kProducers * kPerProducer; },
+        30000);
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    ASSERT_TRUE(done);
+    ASSERT_FALSE(::testing::Test::HasFatalFailure());
+
+    checker.expectComplete();
+    const auto stats = channel.stats();
+    EXPECT_EQ(stats.posted, quint64(kProducers * kPerProducer));
+    EXPECT_EQ(stats.drained, stats.posted);
+    EXPECT_EQ(stats.depth, 0u);
+    EXPECT_EQ(stats.batches, quint64(batches));
+}
+
+} // namespace
+} // namespace mvvm
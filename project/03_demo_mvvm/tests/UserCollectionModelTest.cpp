@@ -0,0 +1,80 @@
+#include "TestSupport.h"
+#include "model/UserCollectionModel.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+
+namespace mvvm {
+namespace {
+
+class UserCollectionModelTest : public ::testing::Test {
+protected:
+    UserCollectionModel model_;
+
+    // 没有后台任务持有存储（排序/过滤任务和建索引批次都捕获 store 的共享所有权）
+    bool backgroundDone() const {
+        return model_.sharedStore().use_count() == 2;   // 模型自身 + 这里的临时副本
+    }
+
+    // 后台任务全部结束，且结果已在本线程应用
+    bool settle() {
+        return test::processEventsUntil([this]() { return !model_.isBusy() && backgroundDone(); });
+    }
+
+    bool isVisible(RowId id) const {
+        const auto& rows = model_.visibleRows();
+        return std::find(rows.begin(), rows.end(), id) != rows.end();
+    }
+};
+
+TEST_F(UserCollectionModelTest, FilterShowsMatchingRows) {
+    const RowId alice = model_.addUser(QStringLiteral("Alice"), QStringLiteral("alice@example.com"), 30);
+    const RowId bob = model_.addUser(QStringLiteral("Bob"), QStringLiteral("bob@example.com"), 40);
+    ASSERT_TRUE(settle());
+
+    model_.setFilterText(QStringLiteral("alice"));
+    ASSERT_TRUE(settle());
+    EXPECT_TRUE(isVisible(alice));
+    EXPECT_FALSE(isVisible(bob));
+    EXPECT_EQ(model_.rowCount(), 1);
+}
+
+TEST_F(UserCollectionModelTest, RowRemovedWhileFilteredOutStaysGoneAfterJob) {
+    const RowId alice = model_.addUser(QStringLiteral("Alice"), QStringLiteral("alice@example.com"), 30);
+    const RowId bob = model_.addUser(QStringLiteral("Bob"), QStringLiteral("bob@example.com"), 40);
+    model_.setFilterText(QStringLiteral("alice"));
+    ASSERT_TRUE(settle());
+    ASSERT_FALSE(isVisible(bob));
+
+    // 清除过滤：任务在后台算出包含 bob 的结果，但完成通知还没有在本线程处理
+    model_.setFilterText(QString());
+    ASSERT_TRUE(model_.isBusy());
+    ASSERT_TRUE(test::waitWithoutEvents([this]() { return backgroundDone(); }));
+
+    // bob 在旧的过滤条件下不可见，此时删除
+    model_.removeUser(bob);
+    EXPECT_EQ(model_.userCount(), 1);
+
+    ASSERT_TRUE(settle());
+    EXPECT_FALSE(isVisible(bob));
+    EXPECT_EQ(model_.rowOf(bob), -1);
+    EXPECT_TRUE(isVisible(alice));
+    EXPECT_EQ(model_.rowCount(), 1);
+}
+
+TEST_F(UserCollectionModelTest, RowRemovedWhileVisibleStaysGoneAfterJob) {
+    const RowId alice = model_.addUser(QStringLiteral("Alice"), QStringLiteral("alice@example.com"), 30);
+    const RowId bob = model_.addUser(QStringLiteral("Bob"), QStringLiteral("bob@example.com"), 40);
+    ASSERT_TRUE(settle());
+
+    model_.sort(UserCollectionModel::AgeColumn, Qt::DescendingOrder);
+    ASSERT_TRUE(test::waitWithoutEvents([this]() { return backgroundDone(); }));
+    model_.removeUser(alice);
+
+    ASSERT_TRUE(settle());
+    EXPECT_FALSE(isVisible(alice));
+    ASSERT_EQ(model_.rowCount(), 1);
+    EXPECT_EQ(model_.rowIdAt(0), bob);
+}
+
+} // namespace
+} // namespace mvvm
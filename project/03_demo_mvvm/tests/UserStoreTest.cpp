@@ -0,0 +1,144 @@
+#include "TestSupport.h"
+#include "storage/LogFormat.h"
+#include "storage/UserStore.h"
+#include <gtest/gtest.h>
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+#include <string>
+#include <vector>
+
+namespace mvvm {
+namespace storage {
+namespace {
+
+// 与 UserStore 的日志段命名一致：users-<20 位起始序号>.log
+QString segmentPath(const QTemporaryDir& dir, std::uint64_t firstSeq) {
+    return dir.filePath(QString("users-%1.log").arg(qulonglong(firstSeq), 20, 10, QChar('0')));
+}
+
+std::string encode(std::uint64_t seq, LogOp op, const char* name, const char* email, int age) {
+    LogRecord record;
+    record.seq = seq;
+    record.op = op;
+    record.age = age;
+    record.name = name;
+    record.email = email;
+    std::string out;
+    encodeRecord(out, record);
+    return out;
+}
+
+void writeFile(const QString& path, const std::string& bytes) {
+    QFile file(path);
+    ASSERT_TRUE(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    ASSERT_EQ(file.write(bytes.data(), qint64(bytes.size())), qint64(bytes.size()));
+}
+
+// 按保存顺序排列的 "姓名/邮箱/年龄"
+std::vector<std::string> usersOf(const RecoveryResult& result) {
+    std::vector<std::string> users;
+    std::string buffer;
+    for (RowId id = 0; id < result.users.slotCount(); ++id) {
+        if (result.users.isAlive(id)) {
+            users.push_back(std::string(result.users.name(id)) + "/" + std::string(result.users.email(id, buffer)) +
+                            "/" + std::to_string(result.users.age(id)));
+        }
+    }
+    return users;
+}
+
+class UserStoreRecoveryTest : public ::testing::Test {
+protected:
+    QTemporaryDir dir_;
+    std::string complete_;   // 三条完整记录
+
+    void SetUp() override {
+        ASSERT_TRUE(dir_.isValid());
+        complete_ = encode(1, LogOp::Upsert, "Alice", "alice@example.com", 30) +
+                    encode(2, LogOp::Upsert, "Bob", "bob@example.com", 40) +
+                    encode(3, LogOp::Upsert, "Alice", "alice@example.com", 31);
+    }
+};
+
+TEST_F(UserStoreRecoveryTest, ReplaysCompleteLog) {
+    writeFile(segmentPath(dir_, 1), complete_);
+
+    const RecoveryResult result = UserStore::recover(dir_.path());
+    ASSERT_TRUE(result.ok) << result.error.toStdString();
+    EXPECT_EQ(result.stats.replayedRecords, 3);
+    EXPECT_EQ(result.stats.truncatedBytes, 0);
+    EXPECT_EQ(result.lastSeq, 3u);
+    EXPECT_EQ(usersOf(result), (std::vector<std::string>{"Bob/bob@example.com/40", "Alice/alice@example.com/31"}));
+}
+
+TEST_F(UserStoreRecoveryTest, TruncatesPartiallyWrittenTail) {
+    // 第四条记录只写了一半（进程在写入中途被杀死）
+    const std::string partial = encode(4, LogOp::Delete, "", "bob@example.com", 0);
+    const std::string tail = partial.substr(0, partial.size() / 2);
+    writeFile(segmentPath(dir_, 1), complete_ + tail);
+
+    const RecoveryResult result = UserStore::recover(dir_.path());
+    ASSERT_TRUE(result.ok) << result.error.toStdString();
+    EXPECT_EQ(result.stats.replayedRecords, 3);
+    EXPECT_EQ(result.stats.truncatedBytes, qint64(tail.size()));
+    EXPECT_EQ(result.lastSeq, 3u);
+    EXPECT_EQ(usersOf(result).size(), 2u);
+
+    // 尾部已从文件中截掉，再次恢复得到相同状态且不再截断
+    EXPECT_EQ(QFile(segmentPath(dir_, 1)).size(), qint64(complete_.size()));
+    const RecoveryResult again = UserStore::recover(dir_.path());
+    ASSERT_TRUE(again.ok);
+    EXPECT_EQ(again.stats.truncatedBytes, 0);
+    EXPECT_EQ(usersOf(again), usersOf(result));
+}
+
+TEST_F(UserStoreRecoveryTest, TruncatesTailWithBadChecksum) {
+    // 长度完整但内容损坏（写入乱序落盘）：最后一条记录的 payload 改动一个字节
+    std::string bytes = complete_ + encode(4, LogOp::Delete, "", "bob@example.com", 0);
+    bytes[bytes.size() - 1] ^= 0x5a;
+    writeFile(segmentPath(dir_, 1), bytes);
+
+    const RecoveryResult result = UserStore::recover(dir_.path());
+    ASSERT_TRUE(result.ok) << result.error.toStdString();
+    EXPECT_EQ(result.stats.replayedRecords, 3);
+    EXPECT_EQ(result.stats.truncatedBytes, qint64(bytes.size() - complete_.size()));
+    // 删除 bob 的记录被丢弃
+    EXPECT_EQ(usersOf(result).size(), 2u);
+}
+
+TEST_F(UserStoreRecoveryTest, CorruptMiddleSegmentFails) {
+    // 只有最后一段允许有被中断的尾部；中间段损坏会丢失一段历史，不能自动截断
+    writeFile(segmentPath(dir_, 1), complete_.substr(0, complete_.size() - 3));
+    writeFile(segmentPath(dir_, 4), encode(4, LogOp::Upsert, "Carol", "carol@example.com", 50));
+
+    const RecoveryResult result = UserStore::recover(dir_.path());
+    EXPECT_FALSE(result.ok);
+    EXPECT_FALSE(result.error.isEmpty());
+}
+
+TEST(UserStoreTest, SavedUsersSurviveReopen) {
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    StoreOptions options;
+    options.directory = dir.path();
+    options.durability = Durability::Sync;
+    {
+        UserStore store;
+        store.open(options);
+        ASSERT_TRUE(test::processEventsUntil([&store]() { return store.isOpen(); }));
+        store.save(QStringLiteral("Alice"), QStringLiteral("alice@example.com"), 30);
+        store.save(QStringLiteral("Bob"), QStringLiteral("bob@example.com"), 40);
+        store.remove(QStringLiteral("alice@example.com"));
+        store.close();
+    }
+
+    const RecoveryResult result = UserStore::recover(dir.path());
+    ASSERT_TRUE(result.ok) << result.error.toStdString();
+    EXPECT_EQ(result.stats.truncatedBytes, 0);
+    EXPECT_EQ(usersOf(result), (std::vector<std::string>{"Bob/bob@example.com/40"}));
+}
+
+} // namespace
+} // namespace storage
+} // namespace mvvm
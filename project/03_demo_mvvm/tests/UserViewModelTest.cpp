@@ -0,0 +1,105 @@
+#include "model/UserModel.h"
+#include "viewmodel/UserViewModel.h"
+#include <gtest/gtest.h>
+#include <QString>
+#include <memory>
+
+namespace mvvm {
+namespace {
+
+class UserViewModelTest : public ::testing::Test {
+protected:
+    std::shared_ptr<UserModel> model_ = std::make_shared<UserModel>();
+    UserViewModel viewModel_{model_};
+};
+
+TEST_F(UserViewModelTest, StatusMessageFollowsValidation) {
+    viewModel_.updateName(QStringLiteral("张三"));
+    viewModel_.updateEmail(QStringLiteral("zhang@example.com"));
+    viewModel_.updateAge(QStringLiteral("25"));
+    EXPECT_TRUE(viewModel_.canSave());
+    EXPECT_EQ(viewModel_.displayAge(), QStringLiteral("25"));
+
+    viewModel_.updateAge(QStringLiteral("200"));
+    EXPECT_FALSE(viewModel_.canSave());
+    EXPECT_EQ(viewModel_.displayAge(), QStringLiteral("200"));
+    EXPECT_TRUE(viewModel_.statusMessage().contains(QStringLiteral("年龄无效")));
+
+    viewModel_.resetCommand()->execute();
+    EXPECT_TRUE(viewModel_.displayName().isEmpty());
+    EXPECT_TRUE(viewModel_.statusMessage().contains(QStringLiteral("姓名不能为空")));
+}
+
+TEST_F(UserViewModelTest, SnapshotMatchesPublishedProperties) {
+    int published = 0;
+    QObject::connect(&viewModel_, &UserViewModel::stateChanged, [&published]() { ++published; });
+
+    viewModel_.updateName(QStringLiteral("张三"));
+    viewModel_.updateAge(QStringLiteral("200"));
+    EXPECT_EQ(published, 2);
+    {
+        auto snapshot = viewModel_.snapshot();
+        EXPECT_EQ(snapshot->displayName, viewModel_.displayName());
+        EXPECT_EQ(snapshot->displayAge, viewModel_.displayAge());
+        EXPECT_EQ(snapshot->statusMessage, viewModel_.statusMessage());
+        EXPECT_FALSE(snapshot->canSave);
+    }
+
+    // 读者持有的旧快照不随之后的修改变化
+    quint64 version = 0;
+    {
+        auto before = viewModel_.snapshot();
+        version = before->version;
+        viewModel_.updateAge(QStringLiteral("25"));
+        EXPECT_EQ(before->displayAge, QStringLiteral("200"));
+        EXPECT_EQ(before->version, version);
+    }
+    {
+        auto after = viewModel_.snapshot();
+        EXPECT_EQ(after->displayAge, QStringLiteral("25"));
+        EXPECT_GT(after->version, version);
+        version = after->version;
+    }
+
+    // 值没有变化时不发布新版本
+    viewModel_.updateAge(QStringLiteral("25"));
+    EXPECT_EQ(viewModel_.snapshot()->version, version);
+}
+
+TEST_F(UserViewModelTest, UndoRedoMergesKeystrokes) {
+    const QString name = QStringLiteral("张三");
+    const QString email = QStringLiteral("zhang@example.com");
+
+    // 同一字段的连续输入合并为一步
+    viewModel_.updateName(QStringLiteral("张"));
+    viewModel_.updateName(name);
+    viewModel_.updateEmail(email);
+    viewModel_.setAge(30);
+    viewModel_.setAge(31);
+    EXPECT_EQ(viewModel_.history().undoCount(), 3u);
+
+    viewModel_.undoCommand()->execute();
+    EXPECT_EQ(viewModel_.age(), 0);
+    viewModel_.undoCommand()->execute();
+    EXPECT_TRUE(viewModel_.displayEmail().isEmpty());
+    EXPECT_EQ(viewModel_.displayName(), name);
+    viewModel_.redoCommand()->execute();
+    viewModel_.redoCommand()->execute();
+    EXPECT_EQ(viewModel_.displayEmail(), email);
+    EXPECT_EQ(viewModel_.age(), 31);
+    EXPECT_FALSE(viewModel_.canRedo());
+
+    // 撤销后的新编辑丢弃可重做的步骤
+    viewModel_.undo();
+    viewModel_.updateName(QStringLiteral("李四"));
+    EXPECT_FALSE(viewModel_.canRedo());
+    EXPECT_EQ(viewModel_.age(), 0);
+
+    // 预算不足时丢弃最旧的步骤，当前状态保留
+    viewModel_.setHistoryMemoryBudget(0);
+    EXPECT_FALSE(viewModel_.canUndo());
+    EXPECT_EQ(viewModel_.displayName(), QStringLiteral("李四"));
+}
+
+} // namespace
+} // namespace mvvm
@@ -0,0 +1,121 @@
+#!/usr/bin/env python3
+"""
+回放行为回归检查
+运行 demo_mvvm_replay，从报告中取出与计时无关的字段（操作数、各信号次数、最终状态），
+与签入的基线逐项比较，任何一项不同即以非零状态退出（供 ctest 使用）
+
+    compare_replay.py --replay build/bin/demo_mvvm_replay \\
+                      --baseline project/03_demo_mvvm/tests/baselines/replay_smoke.json \\
+                      --output replay_smoke.json
+
+同一种子生成的操作序列在各平台上相同，这些字段只取决于 MVVM 核心的行为；
+有意改变了信号级联或校验逻辑时用 --update 重写基线并签入
+"""
+
+import argparse
+import json
+import subprocess
+import sys
+from pathlib import Path
+
+# 基线必须包含的部分；缺少任何一部分都视为基线未记录
+SECTIONS = ("config", "opCounts", "notifications", "finalState")
+
+
+def run_replay(executable, output, ops, seed):
+    """运行回放程序，返回完整的 JSON 报告"""
+    command = [
+        str(executable),
+        "--ops", str(ops),
+        "--seed", str(seed),
+        "--warmup", "0",
+        "--output", str(output),
+    ]
+    print(f"执行命令: {' '.join(command)}")
+    subprocess.run(command, check=True)
+    with open(output, encoding="utf-8") as file:
+        return json.load(file)
+
+
+def deterministic_fields(report):
+    """报告中与机器和计时无关的部分"""
+    config = report["config"]
+    return {
+        "config": {key: config[key] for key in ("source", "scriptOps", "distinctTexts", "repeat", "warmupOps")},
+        "opCounts": {kind: stats["count"] for kind, stats in sorted(report["latency"].items())},
+        "notifications": {
+            "total": report["notifications"]["total"],
+            "signals": dict(sorted(report["notifications"]["signals"].items())),
+        },
+        "finalState": report["finalState"],
+    }
+
+
+def flatten(value, prefix=""):
+    """嵌套对象展开为 "a.b.c" → 值，便于逐项报告差异"""
+    if isinstance(value, dict):
+        items = {}
+        for key, child in value.items():
+            items.update(flatten(child, f"{prefix}{key}."))
+        return items
+    return {prefix[:-1]: value}
+
+
+def compare(baseline, current):
+    """返回不一致的项数"""
+    failures = 0
+    for section in SECTIONS:
+        if section not in baseline:
+            print(f"基线缺少 {section}（在完整构建中使用 --update 记录）")
+            failures += 1
+    expected = flatten({section: baseline[section] for section in SECTIONS if section in baseline})
+    actual = flatten({section: current[section] for section in SECTIONS if section in baseline})
+    for name in sorted(set(expected) | set(actual)):
+        if name not in actual:
+            print(f"{name:<60} {expected[name]!r:>12} {'missing':>12}")
+            failures += 1
+        elif name not in expected:
+            print(f"{name:<60} {'(no baseline)':>12} {actual[name]!r:>12}")
+            failures += 1
+        elif expected[name] != actual[name]:
+            print(f"{name:<60} {expected[name]!r:>12} {actual[name]!r:>12}  CHANGED")
+            failures += 1
+    return failures
+
+
+def main():
+    parser = argparse.ArgumentParser(description="比较回放的信号次数和最终状态与签入的基线")
+    parser.add_argument("--replay", required=True, help="demo_mvvm_replay 可执行文件")
+    parser.add_argument("--baseline", required=True, type=Path, help="基线 JSON 文件")
+    parser.add_argument("--output", default="replay_smoke.json", help="本次完整报告的 JSON 文件")
+    parser.add_argument("--ops", type=int, default=20000)
+    parser.add_argument("--seed", type=int, default=1)
+    parser.add_argument("--update", action="store_true", help="用本次结果重写基线")
+    args = parser.parse_args()
+
+    current = deterministic_fields(run_replay(args.replay, args.output, args.ops, args.seed))
+
+    if args.update:
+        args.baseline.parent.mkdir(parents=True, exist_ok=True)
+        with open(args.baseline, "w", encoding="utf-8") as file:
+            json.dump(current, file, indent=2, ensure_ascii=False)
+            file.write("\n")
+        print(f"基线已更新: {args.baseline}")
+        return 0
+
+    if not args.baseline.exists():
+        print(f"基线文件不存在: {args.baseline}（使用 --update 生成）")
+        return 1
+    with open(args.baseline, encoding="utf-8") as file:
+        baseline = json.load(file)
+
+    failures = compare(baseline, current)
+    if failures:
+        print(f"{failures} 项与基线不一致；行为变化是有意的时用 --update 重写基线")
+        return 1
+    print("信号次数和最终状态与基线一致")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,138 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace common {
+
+/**
+ * 单个事件/请求内的临时内存 - 基于 std::pmr::monotonic_buffer_resource
+ *
+ * 处理一个事件时产生的短命数据（解析出的数组、拼接的文本等）用 std::pmr 容器从 resource() 分配，
+ * 事件结束时整体 reset()，没有逐个释放的开销，也不碰全局堆。
+ *
+ *   common::EventArena::Scope scope(arena_);        // 析构时 reset()
+ *   std::pmr::vector<int> numbers(scope.resource());
+ *
+ * 预留的缓冲区不够时向全局堆申请（记入 overflowCount()），下次 reset() 把缓冲区扩大到
+ * 本次实际用量，之后同样规模的事件不再分配。不是线程安全的：每个线程/事件循环使用自己的实例。
+ * 事件处理可能在同一线程上嵌套时（见 EventArenaPool）不能用 thread_local 的实例。
+ */
+class EventArena {
+private:
+    /**
+     * 缓冲区用尽后的上游，转发到 new_delete_resource 并记录字节数
+     */
+    class OverflowResource : public std::pmr::memory_resource {
+    public:
+        std::size_t allocations = 0;
+        std::size_t bytes = 0;
+
+    private:
+        void* do_allocate(std::size_t size, std::size_t alignment) override;
+        void do_deallocate(void* pointer, std::size_t size, std::size_t alignment) override;
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+    };
+
+    std::size_t capacity_;
+    std::unique_ptr<std::byte[]> buffer_;
+    OverflowResource overflow_;
+    std::optional<std::pmr::monotonic_buffer_resource> resource_;
+    std::size_t overflowCount_ = 0;
+
+public:
+    explicit EventArena(std::size_t capacity = 64 * 1024);
+
+    EventArena(const EventArena&) = delete;
+    EventArena& operator=(const EventArena&) = delete;
+
+    std::pmr::memory_resource* resource() { return &*resource_; }
+
+    /**
+     * 释放本次事件的全部分配；之前从 resource() 得到的内存全部失效
+     */
+    void reset();
+
+    std::size_t capacity() const { return capacity_; }
+
+    // 累计向全局堆申请的次数；预热后应保持不变
+    std::size_t overflowCount() const { return overflowCount_ + overflow_.allocations; }
+
+    /**
+     * 事件处理范围：离开作用域时 reset()
+     */
+    class Scope {
+    private:
+        EventArena& arena_;
+
+    public:
+        explicit Scope(EventArena& arena) : arena_(arena) {}
+        ~Scope() { arena_.reset(); }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+        std::pmr::memory_resource* resource() { return arena_.resource(); }
+    };
+};
+
+/**
+ * EventArena 的池：每个事件租用一个独占的实例，归还时 reset() 留待复用
+ *
+ * 调度器中的任务在 TaskGroup / TaskGraph 等待时会帮忙执行其他任务，同一线程上可能嵌套执行
+ * 下一个事件；thread_local 的 EventArena 会被内层事件 reset()，外层仍在使用的内存随之被重用。
+ * 从池中租用则嵌套的事件各用各的实例。租用和归还加锁（线程安全），租到的实例本身仍不是线程安全的。
+ * 池只增不减，实例数等于同时在处理的事件数的峰值。
+ *
+ *   auto lease = pool.acquire();                   // 析构时 reset() 并归还
+ *   std::pmr::string text(lease.resource());
+ */
+class EventArenaPool {
+private:
+    std::size_t capacity_;
+    std::mutex mutex_;
+    std::vector<std::unique_ptr<EventArena>> free_;
+    std::size_t arenaCount_ = 0;
+
+    void release(std::unique_ptr<EventArena> arena);
+
+public:
+    // capacity：新建实例的初始容量
+    explicit EventArenaPool(std::size_t capacity = 64 * 1024) : capacity_(capacity) {}
+
+    EventArenaPool(const EventArenaPool&) = delete;
+    EventArenaPool& operator=(const EventArenaPool&) = delete;
+
+    class Lease {
+    private:
+        EventArenaPool* pool_;
+        std::unique_ptr<EventArena> arena_;
+
+    public:
+        Lease(EventArenaPool& pool, std::unique_ptr<EventArena> arena) : pool_(&pool), arena_(std::move(arena)) {}
+        Lease(Lease&& other) noexcept = default;
+        Lease& operator=(Lease&&) = delete;
+        ~Lease() {
+            if (arena_) {
+                arena_->reset();
+                pool_->release(std::move(arena_));
+            }
+        }
+
+        EventArena& arena() { return *arena_; }
+        std::pmr::memory_resource* resource() { return arena_->resource(); }
+    };
+
+    /**
+     * 取一个空闲实例，没有时新建
+     */
+    Lease acquire();
+
+    // 已创建的实例数（包括租出的）
+    std::size_t arenaCount();
+};
+
+} // namespace common
@@ -0,0 +1,90 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string_view>
+
+namespace common {
+
+/**
+ * 分块行存储 - 只追加的大量文本行
+ *
+ * 行内容按 UTF-8 连续写入固定大小的块，块一旦分配就不再移动或扩容；
+ * 每行只额外占用一个 12 字节的索引项（块号、块内偏移、长度）。
+ * 没有逐行的对象或堆分配，百万行的内存基本等于文本本身，追加的代价只与追加的字节数有关。
+ *
+ * 设置最大行数后，超出时从头部按整块丢弃最旧的行，行数可能暂时多出不到一块。
+ */
+class LineStore {
+private:
+    struct Chunk {
+        std::unique_ptr<char[]> data;
+        std::size_t capacity = 0;
+        std::size_t used = 0;
+        std::size_t lineCount = 0;
+    };
+
+    struct LineRef {
+        std::uint32_t chunk;     // 绝对块号
+        std::uint32_t offset;
+        std::uint32_t length;
+    };
+
+    std::size_t chunkBytes_;
+    std::size_t maximumLines_;
+    std::deque<Chunk> chunks_;
+    std::deque<LineRef> lines_;
+    std::uint32_t firstChunk_;   // chunks_.front() 的绝对块号
+    std::uint64_t firstLine_;    // lines_.front() 的绝对行号
+    std::size_t bytes_;
+
+public:
+    explicit LineStore(std::size_t chunkBytes = 1 << 20);
+
+    LineStore(const LineStore&) = delete;
+    LineStore& operator=(const LineStore&) = delete;
+    LineStore(LineStore&&) = default;
+    LineStore& operator=(LineStore&&) = default;
+
+    /**
+     * 追加一行（不含换行符）
+     */
+    void append(std::string_view line);
+
+    /**
+     * 按 '\n' 拆分后逐行追加，行尾的 '\r' 去掉；末尾的换行不产生额外的空行
+     * 返回追加的行数
+     */
+    std::size_t appendText(std::string_view text);
+
+    void clear();
+
+    /**
+     * 0 表示不限制
+     */
+    void setMaximumLines(std::size_t maximumLines);
+    std::size_t maximumLines() const { return maximumLines_; }
+
+    std::size_t size() const { return lines_.size(); }
+    bool empty() const { return lines_.empty(); }
+
+    /**
+     * 第 index 行（0 为当前保留的最旧一行）
+     * 返回的视图在该行被丢弃或 clear() 之前有效
+     */
+    std::string_view line(std::size_t index) const;
+
+    // 自创建以来被丢弃的行数，即第 0 行的绝对行号
+    std::uint64_t firstLineNumber() const { return firstLine_; }
+
+    // 文本字节数 / 实际占用的内存（块容量加索引）
+    std::size_t byteSize() const { return bytes_; }
+    std::size_t memoryUsage() const;
+
+private:
+    Chunk& chunkFor(std::size_t length);
+    void trim();
+};
+
+} // namespace common
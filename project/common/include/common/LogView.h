@@ -0,0 +1,88 @@
+#pragma once
+#include "common/LineStore.h"
+#include <QAbstractScrollArea>
+#include <QString>
+#include <string_view>
+
+namespace common {
+
+/**
+ * 虚拟化的只读文本 / 日志视图，替代用作结果面板的只读 QTextEdit
+ *
+ * 文本保存在 LineStore 中，不构造 QTextDocument：
+ * - 每次绘制只解码、排版可见的那几行，与总行数无关
+ * - 追加只写入存储并调整滚动条范围，代价与追加的内容成正比；多次追加由一次重绘合并
+ * - 滚动条在底部时追加后自动跟随到末尾
+ * - 支持按行选择（鼠标拖动、Shift+点击、Ctrl+A）和复制
+ *
+ * 水平滚动范围取已绘制过的最长行，不为此测量全部行。
+ */
+class LogView : public QAbstractScrollArea {
+    Q_OBJECT
+
+private:
+    LineStore lines_;
+    int lineHeight_;
+    int ascent_;
+    int widestLine_;
+    // 选择范围（绝对行号，anchor 为起点；无选择时为 -1）
+    qint64 anchorLine_;
+    qint64 cursorLine_;
+
+public:
+    explicit LogView(QWidget* parent = nullptr);
+
+    /**
+     * 替换全部内容
+     */
+    void setPlainText(const QString& text);
+
+    /**
+     * 追加一段文本（按行拆分，总是从新的一行开始）
+     */
+    void appendPlainText(const QString& text);
+
+    /**
+     * 追加 UTF-8 文本，省去到 QString 的转换，适合流式的日志来源
+     */
+    void appendUtf8(std::string_view utf8);
+
+    /**
+     * 最多保留的行数，超出时丢弃最旧的行；0 表示不限制
+     */
+    void setMaximumLineCount(std::size_t count);
+
+    std::size_t lineCount() const { return lines_.size(); }
+    const LineStore& lines() const { return lines_; }
+
+    QString toPlainText() const;
+    QString selectedText() const;
+
+public slots:
+    void clear();
+    void copy();
+    void selectAll();
+    void scrollToBottom();
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+    void resizeEvent(QResizeEvent* event) override;
+    void changeEvent(QEvent* event) override;
+    void keyPressEvent(QKeyEvent* event) override;
+    void mousePressEvent(QMouseEvent* event) override;
+    void mouseMoveEvent(QMouseEvent* event) override;
+    void scrollContentsBy(int dx, int dy) override;
+
+private:
+    void appended(std::size_t sizeBefore, std::uint64_t firstLineBefore, bool wasAtBottom);
+    void updateMetrics();
+    void updateScrollBars();
+    int visibleRows() const;
+    bool isAtBottom() const;
+    qint64 lineAt(int y) const;
+    bool hasSelection() const { return anchorLine_ >= 0; }
+    QString linesText(std::size_t first, std::size_t last) const;
+    static QString decodeLine(std::string_view utf8);
+};
+
+} // namespace common
@@ -0,0 +1,278 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace common {
+
+/**
+ * 进程内指标 - 计数器、仪表和 HDR 延迟直方图
+ *
+ * 指标在首次使用时向 MetricsRegistry 注册一次（加锁），之后的记录只有原子操作：
+ * - Counter / Histogram 按线程分片，每个线程写自己的分片（各占独立的缓存行），
+ *   多线程同时记录不会争用同一个缓存行；读取时把各分片相加
+ * - 记录不分配内存（Histogram 的分片在该分片第一次被使用时分配一次）
+ * 注册返回的引用在进程生命周期内有效，应保存下来重复使用，不要每次按名称查找。
+ *
+ *   static common::Counter& runs = common::MetricsRegistry::global().counter("app_runs_total", "运行次数");
+ *   static common::Histogram& latency = common::MetricsRegistry::global().latencyHistogram("app_run_duration_seconds", "运行耗时");
+ *   runs.add();
+ *   common::LatencyTimer timer(latency);
+ *
+ * 导出见 MetricsExporter（Prometheus 文本或 JSON）。
+ */
+
+namespace detail {
+
+// 分片数：同时记录的线程超过分片数时，多个线程共享一个分片（仍然正确，只是可能争用）
+constexpr std::size_t kMetricShards = 16;
+
+std::size_t nextShard();
+
+// 当前线程的分片号，线程第一次记录时轮流分配
+inline std::size_t threadShard() {
+    thread_local const std::size_t shard = nextShard();
+    return shard;
+}
+
+} // namespace detail
+
+/**
+ * 单调递增的计数器
+ */
+class Counter {
+private:
+    struct alignas(64) Shard {
+        std::atomic<std::uint64_t> value{0};
+    };
+    std::array<Shard, detail::kMetricShards> shards_;
+
+public:
+    void add(std::uint64_t count = 1) {
+        shards_[detail::threadShard()].value.fetch_add(count, std::memory_order_relaxed);
+    }
+
+    std::uint64_t value() const;
+};
+
+/**
+ * 可增可减的瞬时值（队列长度、行数等），最后一次 set 为准
+ */
+class Gauge {
+private:
+    std::atomic<std::int64_t> value_{0};
+
+public:
+    void set(std::int64_t value) { value_.store(value, std::memory_order_relaxed); }
+    void add(std::int64_t delta) { value_.fetch_add(delta, std::memory_order_relaxed); }
+    std::int64_t value() const { return value_.load(std::memory_order_relaxed); }
+};
+
+/**
+ * HDR（高动态范围）直方图的桶布局
+ *
+ * 值域 [0, highest] 按 2 的幂分段，每段再等分为 2^n 个子桶，
+ * 任何值的相对误差都不超过 10^-significantDigits；桶数只随值域的对数增长。
+ * 与 HdrHistogram 的下标计算相同（最小可区分单位为 1）。
+ */
+class HdrLayout {
+private:
+    std::int64_t highest_;
+    int subBucketHalfCountMagnitude_;
+    std::int64_t subBucketHalfCount_;
+    std::int64_t subBucketMask_;
+    std::size_t countsLength_;
+
+public:
+    HdrLayout(std::int64_t highestTrackable, int significantDigits);
+
+    std::int64_t highestTrackable() const { return highest_; }
+    std::size_t countsLength() const { return countsLength_; }
+
+    // 值所在的计数下标；超出值域的值计入最高的桶
+    std::size_t indexOf(std::int64_t value) const {
+        if (value < 0) {
+            value = 0;
+        } else if (value > highest_) {
+            value = highest_;
+        }
+        const int bucket = 64 - countLeadingZeros(static_cast<std::uint64_t>(value | subBucketMask_)) -
+                           (subBucketHalfCountMagnitude_ + 1);
+        const std::int64_t subBucket = value >> bucket;
+        return static_cast<std::size_t>(((static_cast<std::int64_t>(bucket) + 1) << subBucketHalfCountMagnitude_) +
+                                        (subBucket - subBucketHalfCount_));
+    }
+
+    // 下标对应区间的最小值和最大值
+    std::int64_t lowestValueAt(std::size_t index) const;
+    std::int64_t highestValueAt(std::size_t index) const;
+
+private:
+    static int countLeadingZeros(std::uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_clzll(value);
+#else
+        int zeros = 0;
+        for (std::uint64_t bit = std::uint64_t(1) << 63; bit != 0 && !(value & bit); bit >>= 1) {
+            ++zeros;
+        }
+        return zeros;
+#endif
+    }
+};
+
+/**
+ * 某一时刻直方图的合并结果（不再变化），用于导出和计算分位数
+ */
+class HistogramSnapshot {
+private:
+    const HdrLayout* layout_;
+    std::vector<std::uint64_t> counts_;
+    std::uint64_t count_;
+    std::int64_t sum_;
+
+public:
+    HistogramSnapshot(const HdrLayout& layout, std::vector<std::uint64_t> counts, std::uint64_t count, std::int64_t sum)
+        : layout_(&layout), counts_(std::move(counts)), count_(count), sum_(sum) {}
+
+    std::uint64_t count() const { return count_; }
+    std::int64_t sum() const { return sum_; }
+    double mean() const { return count_ == 0 ? 0.0 : static_cast<double>(sum_) / static_cast<double>(count_); }
+
+    // 在直方图精度内的最小值、最大值；没有记录时为 0
+    std::int64_t min() const;
+    std::int64_t max() const;
+
+    /**
+     * percentile 取 0..100：至少 percentile% 的记录不大于返回值（在直方图精度内）
+     */
+    std::int64_t valueAtPercentile(double percentile) const;
+};
+
+/**
+ * HDR 直方图，按线程分片
+ */
+class Histogram {
+private:
+    struct Shard {
+        std::unique_ptr<std::atomic<std::uint64_t>[]> counts;
+        alignas(64) std::atomic<std::uint64_t> count{0};
+        std::atomic<std::int64_t> sum{0};
+    };
+
+    HdrLayout layout_;
+    double exportScale_;
+    std::array<std::atomic<Shard*>, detail::kMetricShards> shards_;
+
+public:
+    /**
+     * highestTrackable 以上的值按 highestTrackable 记录
+     * exportScale 为导出时乘上的系数（例如纳秒 → 秒为 1e-9），记录和分位数仍以原始单位计
+     */
+    Histogram(std::int64_t highestTrackable, int significantDigits, double exportScale = 1.0);
+    ~Histogram();
+
+    Histogram(const Histogram&) = delete;
+    Histogram& operator=(const Histogram&) = delete;
+
+    void record(std::int64_t value) {
+        Shard* shard = shards_[detail::threadShard()].load(std::memory_order_acquire);
+        if (!shard) {
+            shard = createShard(detail::threadShard());
+        }
+        shard->counts[layout_.indexOf(value)].fetch_add(1, std::memory_order_relaxed);
+        shard->count.fetch_add(1, std::memory_order_relaxed);
+        shard->sum.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    HistogramSnapshot snapshot() const;
+
+    const HdrLayout& layout() const { return layout_; }
+    double exportScale() const { return exportScale_; }
+
+private:
+    Shard* createShard(std::size_t index);
+};
+
+/**
+ * 作用域计时：析构时把经过的纳秒数记入直方图
+ */
+class LatencyTimer {
+private:
+    Histogram& histogram_;
+    std::chrono::steady_clock::time_point start_;
+
+public:
+    explicit LatencyTimer(Histogram& histogram) : histogram_(histogram), start_(std::chrono::steady_clock::now()) {}
+    ~LatencyTimer() {
+        histogram_.record(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                              std::chrono::steady_clock::now() - start_).count());
+    }
+
+    LatencyTimer(const LatencyTimer&) = delete;
+    LatencyTimer& operator=(const LatencyTimer&) = delete;
+};
+
+/**
+ * 指标注册表
+ *
+ * 名称遵循 Prometheus 约定（snake_case，计数器以 _total 结尾，延迟以 _seconds 结尾）。
+ * 同名同类型的重复注册返回同一个指标；同名不同类型属于编程错误，抛出 std::logic_error。
+ */
+class MetricsRegistry {
+public:
+    enum class Type { Counter, Gauge, Histogram };
+
+    struct Entry {
+        Type type;
+        std::string help;
+        std::unique_ptr<Counter> counter;
+        std::unique_ptr<Gauge> gauge;
+        std::unique_ptr<Histogram> histogram;
+    };
+
+private:
+    mutable std::mutex mutex_;
+    std::map<std::string, Entry> entries_;   // 按名称排序，导出顺序稳定
+
+public:
+    MetricsRegistry() = default;
+    MetricsRegistry(const MetricsRegistry&) = delete;
+    MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+
+    // 进程内共用的注册表
+    static MetricsRegistry& global();
+
+    Counter& counter(const std::string& name, const std::string& help);
+    Gauge& gauge(const std::string& name, const std::string& help);
+    Histogram& histogram(const std::string& name, const std::string& help, std::int64_t highestTrackable,
+                         int significantDigits = 2, double exportScale = 1.0);
+
+    /**
+     * 以纳秒记录、以秒导出的延迟直方图：值域 1 ns ~ 60 s，两位有效数字
+     */
+    Histogram& latencyHistogram(const std::string& name, const std::string& help);
+
+    /**
+     * 在持有注册表锁的情况下按名称顺序访问所有指标（导出用）
+     */
+    template<typename Visitor>
+    void forEach(Visitor&& visitor) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& item : entries_) {
+            visitor(item.first, item.second);
+        }
+    }
+
+private:
+    Entry& findOrAdd(const std::string& name, Type type, const std::string& help);
+};
+
+} // namespace common
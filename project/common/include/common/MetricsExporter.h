@@ -0,0 +1,76 @@
+#pragma once
+#include "common/Metrics.h"
+#include <atomic>
+#include <string>
+#include <thread>
+
+namespace common {
+
+/**
+ * 指标导出 - Prometheus 文本格式或 JSON
+ *
+ * 两种方式，可同时使用：
+ * - 本地 Unix 域套接字：每个连接返回一次当前指标后关闭。请求为一行文本，
+ *   "json" 返回 JSON，其他（包括空请求）返回 Prometheus 文本；也接受 HTTP GET，
+ *   路径以 .json 结尾时返回 JSON，可以直接
+ *       curl --unix-socket /tmp/app.sock http://localhost/metrics
+ * - 文件：收到 SIGUSR1 时以及导出器析构（程序退出）时写入，扩展名为 .json 时写 JSON
+ *
+ * 通常由环境变量启用，程序中只需
+ *   common::MetricsExporter metricsExporter;
+ *   metricsExporter.startFromEnvironment();   // METRICS_SOCKET、METRICS_FILE
+ *
+ * 服务线程只在有连接或导出请求时醒来，不影响记录指标的线程。
+ * Unix 域套接字和 SIGUSR1 仅在 POSIX 系统上可用，其他平台只在退出时写文件。
+ */
+class MetricsExporter {
+public:
+    enum class Format { Prometheus, Json };
+
+    explicit MetricsExporter(MetricsRegistry& registry = MetricsRegistry::global());
+    ~MetricsExporter();
+
+    MetricsExporter(const MetricsExporter&) = delete;
+    MetricsExporter& operator=(const MetricsExporter&) = delete;
+
+    /**
+     * 按环境变量 METRICS_SOCKET（套接字路径）、METRICS_FILE（导出文件路径）启动，
+     * 都未设置时什么也不做；失败时输出到 stderr，不影响程序运行
+     */
+    void startFromEnvironment();
+
+    /**
+     * 在 socketPath 上监听（已存在的同名文件会被删除）
+     */
+    bool listen(const std::string& socketPath, std::string* error = nullptr);
+
+    /**
+     * 设置按需导出的文件：收到 SIGUSR1 时和析构时写入
+     */
+    void setDumpFile(const std::string& path);
+
+    void stop();
+
+    bool writeFile(const std::string& path, std::string* error = nullptr) const;
+
+    std::string render(Format format) const;
+
+    static std::string render(const MetricsRegistry& registry, Format format);
+    static Format formatForPath(const std::string& path);
+
+private:
+    MetricsRegistry& registry_;
+    std::string socketPath_;
+    std::string dumpFile_;
+    std::atomic<int> listenFd_;
+    int wakeFds_[2];
+    std::thread thread_;
+    std::atomic<bool> stopping_;
+
+    bool ensureThread(std::string* error);
+    void serveLoop();
+    void serveClient(int fd) const;
+    void dumpToFile() const;
+};
+
+} // namespace common
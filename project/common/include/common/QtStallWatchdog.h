@@ -0,0 +1,27 @@
+#pragma once
+#include "common/StallWatchdog.h"
+#include <QObject>
+#include <QTimer>
+
+namespace common {
+namespace qt {
+
+/**
+ * 在 GUI 线程中调用：用 context 线程上的 QTimer 产生心跳并启动监视
+ * 定时器只在事件循环空闲时触发，事件处理阻塞时心跳随之停止。watchdog 需比 context 先停止或同时销毁。
+ *
+ *   common::StallWatchdog watchdog(common::StallWatchdog::Options::fromEnvironment());
+ *   common::qt::startStallWatchdog(watchdog, &app);
+ */
+inline void startStallWatchdog(StallWatchdog& watchdog, QObject* context) {
+    if (!watchdog.options().enabled()) {
+        return;
+    }
+    auto* timer = new QTimer(context);
+    QObject::connect(timer, &QTimer::timeout, context, [&watchdog]() { watchdog.heartbeat(); });
+    timer->start(static_cast<int>(watchdog.options().heartbeatInterval.count()));
+    watchdog.start();
+}
+
+} // namespace qt
+} // namespace common
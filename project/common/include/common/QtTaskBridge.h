@@ -0,0 +1,110 @@
+#pragma once
+#include "common/TaskScheduler.h"
+#include <QCoreApplication>
+#include <QFuture>
+#include <QFutureInterface>
+#include <QMetaObject>
+#include <QObject>
+#include <QPointer>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace common {
+namespace qt {
+
+/**
+ * 在 context 所在线程的事件循环中执行 f；context 已销毁时 f 被丢弃
+ * 调用时 context 必须存活：只在 context 所在线程调用，工作线程使用下面的 QPointer 重载
+ */
+template<typename F>
+void post(QObject* context, F&& f) {
+    QMetaObject::invokeMethod(context, std::forward<F>(f), Qt::QueuedConnection);
+}
+
+/**
+ * 在 GUI 线程的事件循环中执行 f，guard 指向的对象已销毁时 f 被丢弃（任意线程可调用）
+ *
+ * 投递目标是程序对象而不是 guard 本身：工作线程先判断 guard 再取指针时，
+ * 对象可能正好在 GUI 线程上销毁。guard 只在 GUI 线程、执行 f 之前判断。
+ * guard 指向的对象必须属于 GUI 线程。
+ */
+template<typename T, typename F>
+void post(const QPointer<T>& guard, F&& f) {
+    QCoreApplication* app = QCoreApplication::instance();
+    if (!app) {
+        return;   // 程序已在退出
+    }
+    QMetaObject::invokeMethod(app, [guard, f = std::forward<F>(f)]() mutable {
+        if (guard) {
+            f();
+        }
+    }, Qt::QueuedConnection);
+}
+
+/**
+ * 在调度器上执行 work()，完成后在 GUI 线程执行 then(result)；context 属于 GUI 线程，已销毁时不再调用 then
+ *
+ *   common::qt::run(this, [text] { return parse(text); },
+ *                   [this](Result result) { show(result); }, common::TaskPriority::High, token);
+ *
+ * token 被取消后：尚未开始的 work 不再执行，已完成的结果不再交给 then（“最新的请求胜出”）。
+ * work 抛出的异常由调度器输出到 stderr，then 不会被调用。
+ */
+template<typename Work, typename Then>
+void run(QObject* context, Work work, Then then, TaskPriority priority = TaskPriority::Normal,
+         const CancellationToken& token = CancellationToken(), TaskScheduler& scheduler = TaskScheduler::shared()) {
+    Q_ASSERT(context && context->thread() == QCoreApplication::instance()->thread());
+    QPointer<QObject> guard(context);
+    scheduler.submit([guard, work = std::move(work), then = std::move(then), token]() mutable {
+        using Result = std::invoke_result_t<Work&>;
+        if constexpr (std::is_void_v<Result>) {
+            work();
+            if (!token.isCancelled()) {
+                post(guard, [then = std::move(then), token]() mutable {
+                    if (!token.isCancelled()) {
+                        then();
+                    }
+                });
+            }
+        } else {
+            auto result = std::make_shared<Result>(work());
+            if (!token.isCancelled()) {
+                post(guard, [then = std::move(then), result, token]() mutable {
+                    if (!token.isCancelled()) {
+                        then(std::move(*result));
+                    }
+                });
+            }
+        }
+    }, token, priority);
+}
+
+/**
+ * 在调度器上执行 work()，返回 QFuture，可直接替换 QtConcurrent::run 配合 QFutureWatcher 使用
+ * work 抛出的异常被调度器吞掉，future 仍会结束但没有结果；需要报告错误时在结果中携带。
+ */
+template<typename Work>
+auto future(Work work, TaskPriority priority = TaskPriority::Normal, TaskScheduler& scheduler = TaskScheduler::shared())
+    -> QFuture<std::invoke_result_t<Work&>> {
+    using Result = std::invoke_result_t<Work&>;
+    QFutureInterface<Result> promise;
+    promise.reportStarted();
+    QFuture<Result> result = promise.future();
+    scheduler.submit([promise, work = std::move(work)]() mutable {
+        struct Finish {
+            QFutureInterface<Result>& promise;
+            ~Finish() { promise.reportFinished(); }
+        } finish{promise};
+        if constexpr (std::is_void_v<Result>) {
+            work();
+        } else {
+            Result value = work();
+            promise.reportResult(value);
+        }
+    }, priority);
+    return result;
+}
+
+} // namespace qt
+} // namespace common
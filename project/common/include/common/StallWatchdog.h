@@ -0,0 +1,98 @@
+#pragma once
+#include "common/Metrics.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace common {
+
+/**
+ * 事件循环卡顿监视
+ *
+ * 被监视的线程（GUI 线程）定期调用 heartbeat()，只是一次原子写入；监视线程每个心跳间隔醒来一次，
+ * 发现心跳停止超过阈值时判定为卡顿：
+ * - Linux 上向被监视线程发送 SIGUSR2，在信号处理函数中用 backtrace() 记下当前调用栈，
+ *   由监视线程符号化后随报告一起输出（可执行文件需要导出符号才能看到函数名）
+ * - 心跳恢复时再报告一次卡顿总时长
+ * - 指标：gui_stalls_total、gui_stall_duration_seconds
+ *
+ * 一个进程同一时刻只能有一个运行中的监视器（信号处理函数使用进程级的缓冲区）。
+ * Qt 程序通过 common::qt::startStallWatchdog() 用 QTimer 产生心跳。
+ */
+class StallWatchdog {
+public:
+    struct Options {
+        std::chrono::milliseconds threshold{500};          // 心跳停止多久算卡顿
+        std::chrono::milliseconds heartbeatInterval{100};  // 心跳和检查的间隔，决定检测精度
+
+        /**
+         * 读取 GUI_STALL_THRESHOLD_MS（毫秒，0 表示关闭）；未设置时使用默认值
+         */
+        static Options fromEnvironment();
+        bool enabled() const { return threshold.count() > 0; }
+    };
+
+    struct StallEvent {
+        std::chrono::milliseconds duration{0};   // 检测到时为已卡顿的时长，结束时为总时长（精度为心跳间隔）
+        bool ended = false;
+        std::vector<std::string> stack;          // 检测到时被监视线程的调用栈，最内层在前；无法获取时为空
+
+        std::string toString() const;
+    };
+
+    using Reporter = std::function<void(const StallEvent&)>;
+
+    StallWatchdog() : StallWatchdog(Options()) {}
+    explicit StallWatchdog(Options options, MetricsRegistry& registry = MetricsRegistry::global());
+    ~StallWatchdog();
+
+    StallWatchdog(const StallWatchdog&) = delete;
+    StallWatchdog& operator=(const StallWatchdog&) = delete;
+
+    const Options& options() const { return options_; }
+
+    /**
+     * 在监视线程中调用，默认写到 stderr；需在 start() 之前设置
+     */
+    void setReporter(Reporter reporter) { reporter_ = std::move(reporter); }
+
+    /**
+     * 在被监视的线程中调用：记录当前线程并启动监视线程；未启用或已启动时什么也不做
+     */
+    void start();
+    void stop();
+
+    // 被监视的线程调用，只写一个原子时间戳
+    void heartbeat() {
+        lastBeat_.store(nowNanos(), std::memory_order_relaxed);
+    }
+
+private:
+    Options options_;
+    Reporter reporter_;
+    Counter& stalls_;
+    Histogram& stallDuration_;
+    std::atomic<std::int64_t> lastBeat_;
+    std::thread thread_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    bool stopping_ = false;
+    std::thread::native_handle_type target_{};   // 被监视的线程
+
+    static std::int64_t nowNanos() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    void watchLoop();
+    std::vector<std::string> captureStack();
+    void report(const StallEvent& event);
+};
+
+} // namespace common
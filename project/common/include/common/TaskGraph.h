@@ -0,0 +1,93 @@
+#pragma once
+#include "common/TaskScheduler.h"
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace common {
+
+/**
+ * 任务依赖图 - 在 TaskScheduler 上执行，互不依赖的节点并行
+ *
+ * 节点只能依赖先添加的节点，因此图天然无环。节点完成后由它直接提交已就绪的后继，
+ * 只在有依赖的地方汇合，不按“层”整体等待。节点间的数据由调用方通过捕获的共享状态传递：
+ * 依赖关系保证前驱写入的结果对后继可见。
+ *
+ *   common::TaskGraph graph;
+ *   auto load = graph.add("load", [&] { data = load(); });
+ *   auto fit  = graph.add("fit", [&] { model = fit(data); }, {load});
+ *   auto plot = graph.add("plot", [&] { image = plot(data); }, {load});
+ *   graph.run();                                  // 等待期间帮忙执行任务
+ *   spdlog::info(graph.report().toString());      // 各节点耗时和关键路径
+ *
+ * 节点抛出异常时，依赖它的节点（直接或间接）被跳过，其余节点照常执行；
+ * run() 在全部结束后重新抛出第一个异常。
+ */
+class TaskGraph {
+public:
+    using NodeId = std::size_t;
+
+    struct NodeTiming {
+        std::string name;
+        std::int64_t startNanos = 0;    // 相对 run() 开始
+        std::int64_t finishNanos = 0;
+        bool skipped = false;           // 前驱失败而未执行
+
+        std::int64_t durationNanos() const { return finishNanos - startNanos; }
+    };
+
+    struct Report {
+        std::vector<NodeTiming> nodes;       // 与 NodeId 一一对应
+        std::vector<NodeId> criticalPath;    // 按执行耗时计算的最长依赖链，从源到汇
+        std::int64_t criticalPathNanos = 0;
+        std::int64_t elapsedNanos = 0;       // run() 的总耗时
+
+        /**
+         * 多行文本：总耗时、关键路径，然后每个节点一行（开始、结束、耗时）
+         */
+        std::string toString() const;
+    };
+
+private:
+    struct Node {
+        std::string name;
+        TaskScheduler::Task task;
+        TaskPriority priority;
+        std::vector<NodeId> dependencies;
+        std::vector<NodeId> successors;
+    };
+
+    std::vector<Node> nodes_;
+    Report report_;
+
+public:
+    TaskGraph() = default;
+
+    TaskGraph(const TaskGraph&) = delete;
+    TaskGraph& operator=(const TaskGraph&) = delete;
+
+    /**
+     * 添加节点；dependencies 必须是已添加的节点，否则抛出 std::invalid_argument
+     */
+    NodeId add(std::string name, TaskScheduler::Task task, std::initializer_list<NodeId> dependencies = {},
+               TaskPriority priority = TaskPriority::Normal);
+    NodeId add(std::string name, TaskScheduler::Task task, const std::vector<NodeId>& dependencies,
+               TaskPriority priority = TaskPriority::Normal);
+
+    std::size_t size() const { return nodes_.size(); }
+
+    /**
+     * 执行整张图并等待完成，可以重复执行；等待的线程帮忙执行任务，可在工作线程中调用
+     */
+    void run(TaskScheduler& scheduler = TaskScheduler::shared());
+
+    // 最近一次 run() 的计时
+    const Report& report() const { return report_; }
+
+private:
+    void computeCriticalPath();
+};
+
+} // namespace common
@@ -0,0 +1,236 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace common {
+
+/**
+ * 取消令牌 - 可复制，所有副本共享同一个取消标志
+ */
+class CancellationToken {
+private:
+    std::shared_ptr<std::atomic<bool>> cancelled_;
+
+public:
+    CancellationToken() : cancelled_(std::make_shared<std::atomic<bool>>(false)) {}
+
+    bool isCancelled() const { return cancelled_->load(std::memory_order_relaxed); }
+    void cancel() { cancelled_->store(true, std::memory_order_relaxed); }
+};
+
+enum class TaskPriority {
+    High,      // 用户正在等待结果（点击后的计算、保存）
+    Normal,
+    Low        // 后台维护（建索引、快照）
+};
+
+/**
+ * 工作窃取任务调度器 - 各程序共用的唯一线程池
+ *
+ * 每个工作线程对每个优先级各有一个 WorkStealingDeque：
+ * - 工作线程中提交的任务放入自己的队列底部，其他线程（GUI 线程等）提交的放入全局注入队列
+ * - 取任务时按优先级从高到低，依次查看自己的队列、注入队列、从其他工作线程的队列顶部窃取
+ * - 没有任务时睡眠，提交时只在有线程睡眠时才唤醒
+ *
+ * 所有并行代码都应提交到 TaskScheduler::shared()，而不是各自创建线程池，
+ * 否则多个池的线程数相加会超过核数。
+ *
+ * 任务体抛出的异常在 submit() 中被丢弃（输出到 stderr），需要传播异常时使用 TaskGroup。
+ * 在 TaskGroup::wait()、parallelFor 中等待的线程会帮忙执行任务，工作线程中嵌套并行不会死锁。
+ *
+ *   auto& scheduler = common::TaskScheduler::shared();
+ *   scheduler.submit([] { ... }, common::TaskPriority::High);
+ *   scheduler.parallelFor(0, rows, 4096, [&](std::size_t first, std::size_t last) { ... });
+ *   double total = scheduler.parallelReduce(0, n, 1024, 0.0,
+ *       [&](std::size_t first, std::size_t last) { return sum(first, last); },
+ *       [](double a, double b) { return a + b; });
+ */
+class TaskScheduler {
+public:
+    using Task = std::function<void()>;
+
+    static constexpr std::size_t kPriorityCount = 3;
+
+private:
+    struct Node {
+        Task task;
+        std::optional<CancellationToken> token;
+    };
+    struct Worker;
+    class InjectionQueue;
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::unique_ptr<InjectionQueue[]> injected_;             // 每个优先级一个
+    std::atomic<std::int64_t> queued_[kPriorityCount];       // 各优先级尚未取走的任务数
+    std::atomic<std::int64_t> pending_;                      // 全部尚未取走的任务数
+    std::atomic<int> sleepers_;
+    std::atomic<bool> stopping_;
+    std::mutex sleepMutex_;
+    std::condition_variable wake_;
+
+    // 当前线程所属的工作线程（非工作线程为空）
+    static thread_local Worker* currentWorker_;
+
+public:
+    /**
+     * workerCount 为 0 时使用硬件线程数
+     */
+    explicit TaskScheduler(std::size_t workerCount = 0);
+    // 执行完已提交的任务后退出工作线程
+    ~TaskScheduler();
+
+    TaskScheduler(const TaskScheduler&) = delete;
+    TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+    /**
+     * 进程共用的调度器，工作线程数为硬件线程数；首次调用时创建，进程退出前不销毁
+     */
+    static TaskScheduler& shared();
+
+    std::size_t workerCount() const { return workers_.size(); }
+
+    // 当前线程是否为本调度器的工作线程
+    bool isWorkerThread() const;
+
+    void submit(Task task, TaskPriority priority = TaskPriority::Normal);
+
+    /**
+     * token 在任务开始前被取消时跳过该任务（任务体也可以自行检查 token）
+     */
+    void submit(Task task, const CancellationToken& token, TaskPriority priority = TaskPriority::Normal);
+
+    /**
+     * 在当前线程执行一个排队的任务（等待其他任务时帮忙），没有可执行的任务时返回 false
+     */
+    bool runPendingTask();
+
+    /**
+     * 把 [begin, end) 切成若干块并行执行 body(first, last)，返回前所有块都已执行完毕
+     * 块数不超过工作线程数的 4 倍，每块至少 grain 个元素；调用线程执行第一块并在等待时帮忙。
+     * token 被取消后尚未开始的块不再执行。body 抛出的第一个异常在返回时重新抛出。
+     */
+    template<typename Body>
+    void parallelFor(std::size_t begin, std::size_t end, std::size_t grain, Body&& body,
+                     TaskPriority priority = TaskPriority::Normal, const CancellationToken* token = nullptr);
+
+    /**
+     * 并行归约：每块计算 map(first, last)，再按块的顺序用 combine 合并，
+     * 结果与块的执行顺序无关（combine 满足结合律即可，不要求交换律）
+     */
+    template<typename T, typename Map, typename Combine>
+    T parallelReduce(std::size_t begin, std::size_t end, std::size_t grain, T identity, Map&& map, Combine&& combine,
+                     TaskPriority priority = TaskPriority::Normal);
+
+private:
+    void push(Node* node, TaskPriority priority);
+    Node* take(Worker* self);
+    void execute(Node* node);
+    void workerLoop(Worker* self);
+
+    std::size_t chunkCount(std::size_t count, std::size_t grain) const {
+        const std::size_t byGrain = (count + grain - 1) / grain;
+        return std::max<std::size_t>(1, std::min(byGrain, workers_.size() * 4));
+    }
+};
+
+/**
+ * 一组任务：wait() 等待全部完成，并重新抛出第一个异常
+ * 等待期间当前线程帮忙执行调度器中的任务。析构时仍会等待（不抛出异常）。
+ */
+class TaskGroup {
+private:
+    TaskScheduler& scheduler_;
+    std::atomic<std::size_t> pending_;
+    std::mutex mutex_;
+    std::condition_variable done_;
+    std::exception_ptr error_;
+
+public:
+    explicit TaskGroup(TaskScheduler& scheduler = TaskScheduler::shared());
+    ~TaskGroup();
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    void run(TaskScheduler::Task task, TaskPriority priority = TaskPriority::Normal);
+    void wait();
+
+private:
+    void waitAll();
+    void finish(std::exception_ptr error);
+};
+
+template<typename Body>
+void TaskScheduler::parallelFor(std::size_t begin, std::size_t end, std::size_t grain, Body&& body,
+                                TaskPriority priority, const CancellationToken* token) {
+    if (begin >= end) {
+        return;
+    }
+    const std::size_t count = end - begin;
+    const std::size_t chunks = chunkCount(count, std::max<std::size_t>(grain, 1));
+    if (chunks == 1) {
+        if (!token || !token->isCancelled()) {
+            body(begin, end);
+        }
+        return;
+    }
+    const std::size_t chunkSize = (count + chunks - 1) / chunks;
+    TaskGroup group(*this);
+    for (std::size_t first = begin + chunkSize; first < end; first += chunkSize) {
+        const std::size_t last = std::min(end, first + chunkSize);
+        group.run([&body, first, last, token]() {
+            if (!token || !token->isCancelled()) {
+                body(first, last);
+            }
+        }, priority);
+    }
+    std::exception_ptr error;
+    try {
+        if (!token || !token->isCancelled()) {
+            body(begin, std::min(end, begin + chunkSize));
+        }
+    } catch (...) {
+        error = std::current_exception();
+    }
+    group.wait();
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+template<typename T, typename Map, typename Combine>
+T TaskScheduler::parallelReduce(std::size_t begin, std::size_t end, std::size_t grain, T identity, Map&& map,
+                                Combine&& combine, TaskPriority priority) {
+    if (begin >= end) {
+        return identity;
+    }
+    const std::size_t count = end - begin;
+    const std::size_t chunks = chunkCount(count, std::max<std::size_t>(grain, 1));
+    const std::size_t chunkSize = (count + chunks - 1) / chunks;
+    std::vector<T> partial(chunks, identity);
+    parallelFor(0, chunks, 1, [&](std::size_t firstChunk, std::size_t lastChunk) {
+        for (std::size_t chunk = firstChunk; chunk < lastChunk; ++chunk) {
+            const std::size_t first = begin + chunk * chunkSize;
+            if (first < end) {
+                partial[chunk] = map(first, std::min(end, first + chunkSize));
+            }
+        }
+    }, priority);
+    T result = std::move(identity);
+    for (T& value : partial) {
+        result = combine(std::move(result), std::move(value));
+    }
+    return result;
+}
+
+} // namespace common
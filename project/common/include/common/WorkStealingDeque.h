@@ -0,0 +1,117 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace common {
+
+/**
+ * 工作窃取双端队列（Chase-Lev）
+ *
+ * 所属线程在底部 push / pop（后进先出，刚产生的子任务仍在缓存中），
+ * 其他线程在顶部 steal（先进先出，偷走的是最早、通常也是最大的任务）。
+ * 三个操作都不加锁；只有所属线程与窃取者争抢最后一个元素时才需要一次 CAS。
+ *
+ * 元素为指针，空指针表示队列为空或窃取失败。容量不足时所属线程把内容复制到两倍大小的新数组，
+ * 旧数组可能仍在被窃取者读取，保留到队列析构时释放。
+ */
+template<typename T>
+class WorkStealingDeque {
+private:
+    struct Buffer {
+        std::int64_t capacity;
+        std::unique_ptr<std::atomic<T*>[]> slots;
+
+        explicit Buffer(std::int64_t size) : capacity(size), slots(new std::atomic<T*>[static_cast<std::size_t>(size)]) {}
+
+        T* get(std::int64_t index) const { return slots[index & (capacity - 1)].load(std::memory_order_relaxed); }
+        void put(std::int64_t index, T* item) { slots[index & (capacity - 1)].store(item, std::memory_order_relaxed); }
+    };
+
+    std::atomic<std::int64_t> top_;
+    std::atomic<std::int64_t> bottom_;
+    std::atomic<Buffer*> buffer_;
+    std::vector<std::unique_ptr<Buffer>> buffers_;   // 当前数组和所有旧数组，只由所属线程修改
+
+public:
+    explicit WorkStealingDeque(std::int64_t capacity = 256) : top_(0), bottom_(0) {
+        std::int64_t size = 2;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        buffers_.push_back(std::make_unique<Buffer>(size));
+        buffer_.store(buffers_.back().get(), std::memory_order_relaxed);
+    }
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    // 仅所属线程调用
+    void push(T* item) {
+        const std::int64_t bottom = bottom_.load(std::memory_order_relaxed);
+        const std::int64_t top = top_.load(std::memory_order_acquire);
+        Buffer* buffer = buffer_.load(std::memory_order_relaxed);
+        if (bottom - top > buffer->capacity - 1) {
+            buffer = grow(buffer, top, bottom);
+        }
+        buffer->put(bottom, item);
+        bottom_.store(bottom + 1, std::memory_order_release);
+    }
+
+    // 仅所属线程调用
+    T* pop() {
+        const std::int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+        Buffer* buffer = buffer_.load(std::memory_order_relaxed);
+        bottom_.store(bottom, std::memory_order_seq_cst);
+        std::int64_t top = top_.load(std::memory_order_seq_cst);
+        if (top > bottom) {
+            bottom_.store(bottom + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        T* item = buffer->get(bottom);
+        if (top == bottom) {
+            // 最后一个元素：与窃取者竞争
+            if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                item = nullptr;
+            }
+            bottom_.store(bottom + 1, std::memory_order_relaxed);
+        }
+        return item;
+    }
+
+    // 任意线程调用；与其他窃取者或所属线程竞争失败时返回空指针
+    T* steal() {
+        std::int64_t top = top_.load(std::memory_order_seq_cst);
+        const std::int64_t bottom = bottom_.load(std::memory_order_seq_cst);
+        if (top >= bottom) {
+            return nullptr;
+        }
+        Buffer* buffer = buffer_.load(std::memory_order_acquire);
+        T* item = buffer->get(top);
+        if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            return nullptr;
+        }
+        return item;
+    }
+
+    // 近似值，仅供统计和调度提示
+    std::int64_t sizeHint() const {
+        const std::int64_t size = bottom_.load(std::memory_order_relaxed) - top_.load(std::memory_order_relaxed);
+        return size > 0 ? size : 0;
+    }
+
+private:
+    Buffer* grow(Buffer* old, std::int64_t top, std::int64_t bottom) {
+        auto bigger = std::make_unique<Buffer>(old->capacity * 2);
+        for (std::int64_t i = top; i < bottom; ++i) {
+            bigger->put(i, old->get(i));
+        }
+        Buffer* raw = bigger.get();
+        buffers_.push_back(std::move(bigger));
+        buffer_.store(raw, std::memory_order_release);
+        return raw;
+    }
+};
+
+} // namespace common
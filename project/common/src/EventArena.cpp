@@ -0,0 +1,62 @@
+#include "common/EventArena.h"
+
+namespace common {
+
+void* EventArena::OverflowResource::do_allocate(std::size_t size, std::size_t alignment) {
+    ++allocations;
+    bytes += size;
+    return std::pmr::new_delete_resource()->allocate(size, alignment);
+}
+
+void EventArena::OverflowResource::do_deallocate(void* pointer, std::size_t size, std::size_t alignment) {
+    std::pmr::new_delete_resource()->deallocate(pointer, size, alignment);
+}
+
+EventArena::EventArena(std::size_t capacity)
+    : capacity_(capacity > 0 ? capacity : 1), buffer_(new std::byte[capacity_]) {
+    resource_.emplace(buffer_.get(), capacity_, &overflow_);
+}
+
+void EventArena::reset() {
+    if (overflow_.allocations == 0) {
+        // release() 之后重新从预留缓冲区的起点分配
+        resource_->release();
+        return;
+    }
+    // 本次事件超出了预留的缓冲区：归还上游内存，按实际用量扩大缓冲区
+    resource_.reset();
+    overflowCount_ += overflow_.allocations;
+    const std::size_t used = capacity_ + overflow_.bytes;
+    overflow_.allocations = 0;
+    overflow_.bytes = 0;
+    capacity_ = used + used / 2;
+    buffer_.reset(new std::byte[capacity_]);
+    resource_.emplace(buffer_.get(), capacity_, &overflow_);
+}
+
+EventArenaPool::Lease EventArenaPool::acquire() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!free_.empty()) {
+            std::unique_ptr<EventArena> arena = std::move(free_.back());
+            free_.pop_back();
+            return Lease(*this, std::move(arena));
+        }
+        ++arenaCount_;
+        // 归还时 push_back 不再扩容（在析构函数中执行，不能抛出）
+        free_.reserve(arenaCount_);
+    }
+    return Lease(*this, std::make_unique<EventArena>(capacity_));
+}
+
+void EventArenaPool::release(std::unique_ptr<EventArena> arena) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    free_.push_back(std::move(arena));
+}
+
+std::size_t EventArenaPool::arenaCount() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return arenaCount_;
+}
+
+} // namespace common
@@ -0,0 +1,107 @@
+#include "common/LineStore.h"
+#include <algorithm>
+#include <cstring>
+
+namespace common {
+
+LineStore::LineStore(std::size_t chunkBytes)
+    : chunkBytes_(std::max<std::size_t>(chunkBytes, 256)),
+      maximumLines_(0),
+      firstChunk_(0),
+      firstLine_(0),
+      bytes_(0) {
+}
+
+void LineStore::append(std::string_view line) {
+    Chunk& chunk = chunkFor(line.size());
+    const std::uint32_t chunkNumber = firstChunk_ + static_cast<std::uint32_t>(chunks_.size() - 1);
+    if (!line.empty()) {
+        std::memcpy(chunk.data.get() + chunk.used, line.data(), line.size());
+    }
+    lines_.push_back(LineRef{chunkNumber, static_cast<std::uint32_t>(chunk.used),
+                             static_cast<std::uint32_t>(line.size())});
+    chunk.used += line.size();
+    ++chunk.lineCount;
+    bytes_ += line.size();
+    trim();
+}
+
+std::size_t LineStore::appendText(std::string_view text) {
+    std::size_t added = 0;
+    std::size_t start = 0;
+    while (true) {
+        const std::size_t end = text.find('\n', start);
+        std::string_view line = text.substr(start, end == std::string_view::npos ? std::string_view::npos : end - start);
+        if (!line.empty() && line.back() == '\r') {
+            line.remove_suffix(1);
+        }
+        if (end == std::string_view::npos) {
+            // 以换行结尾时最后一段为空，不再追加；空文本仍是一行空行
+            if (start < text.size() || text.empty()) {
+                append(line);
+                ++added;
+            }
+            break;
+        }
+        append(line);
+        ++added;
+        start = end + 1;
+    }
+    return added;
+}
+
+void LineStore::clear() {
+    // 保留绝对编号的连续性，已显示的行号不会回到 0
+    firstLine_ += lines_.size();
+    firstChunk_ += static_cast<std::uint32_t>(chunks_.size());
+    chunks_.clear();
+    lines_.clear();
+    bytes_ = 0;
+}
+
+void LineStore::setMaximumLines(std::size_t maximumLines) {
+    maximumLines_ = maximumLines;
+    trim();
+}
+
+std::string_view LineStore::line(std::size_t index) const {
+    const LineRef& ref = lines_[index];
+    const Chunk& chunk = chunks_[ref.chunk - firstChunk_];
+    return std::string_view(chunk.data.get() + ref.offset, ref.length);
+}
+
+std::size_t LineStore::memoryUsage() const {
+    std::size_t total = lines_.size() * sizeof(LineRef);
+    for (const Chunk& chunk : chunks_) {
+        total += chunk.capacity;
+    }
+    return total;
+}
+
+LineStore::Chunk& LineStore::chunkFor(std::size_t length) {
+    if (chunks_.empty() || chunks_.back().capacity - chunks_.back().used < length) {
+        // 超长的行单独占一块
+        Chunk chunk;
+        chunk.capacity = std::max(chunkBytes_, length);
+        chunk.data.reset(new char[chunk.capacity]);
+        chunks_.push_back(std::move(chunk));
+    }
+    return chunks_.back();
+}
+
+void LineStore::trim() {
+    if (maximumLines_ == 0) {
+        return;
+    }
+    // 只丢弃完整的块；最后一块正在写入，总是保留
+    while (chunks_.size() > 1 && lines_.size() - chunks_.front().lineCount >= maximumLines_) {
+        const Chunk& front = chunks_.front();
+        lines_.erase(lines_.begin(), lines_.begin() + static_cast<std::ptrdiff_t>(front.lineCount));
+        firstLine_ += front.lineCount;
+        bytes_ -= front.used;
+        chunks_.pop_front();
+        ++firstChunk_;
+    }
+}
+
+} // namespace common
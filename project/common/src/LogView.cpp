@@ -0,0 +1,312 @@
+#include "common/LogView.h"
+#include <QApplication>
+#include <QClipboard>
+#include <QKeyEvent>
+#include <QMouseEvent>
+#include <QPaintEvent>
+#include <QPainter>
+#include <QScrollBar>
+#include <QTimer>
+#include <algorithm>
+#include <climits>
+
+namespace common {
+
+namespace {
+
+// 文本与视口左边缘的距离
+constexpr int kMargin = 4;
+
+} // namespace
+
+LogView::LogView(QWidget* parent)
+    : QAbstractScrollArea(parent),
+      lineHeight_(1),
+      ascent_(0),
+      widestLine_(0),
+      anchorLine_(-1),
+      cursorLine_(-1) {
+    setFocusPolicy(Qt::StrongFocus);
+    viewport()->setCursor(Qt::IBeamCursor);
+    updateMetrics();
+    updateScrollBars();
+}
+
+void LogView::setPlainText(const QString& text) {
+    clear();
+    if (!text.isEmpty()) {
+        const QByteArray utf8 = text.toUtf8();
+        lines_.appendText(std::string_view(utf8.constData(), static_cast<std::size_t>(utf8.size())));
+        updateScrollBars();
+        // 与 QTextEdit 一致，替换内容后显示开头
+        verticalScrollBar()->setValue(0);
+    }
+}
+
+void LogView::appendPlainText(const QString& text) {
+    const QByteArray utf8 = text.toUtf8();
+    appendUtf8(std::string_view(utf8.constData(), static_cast<std::size_t>(utf8.size())));
+}
+
+void LogView::appendUtf8(std::string_view utf8) {
+    const std::size_t sizeBefore = lines_.size();
+    const std::uint64_t firstLineBefore = lines_.firstLineNumber();
+    const bool wasAtBottom = isAtBottom();
+    lines_.appendText(utf8);
+    appended(sizeBefore, firstLineBefore, wasAtBottom);
+}
+
+void LogView::setMaximumLineCount(std::size_t count) {
+    const std::size_t sizeBefore = lines_.size();
+    const std::uint64_t firstLineBefore = lines_.firstLineNumber();
+    const bool wasAtBottom = isAtBottom();
+    lines_.setMaximumLines(count);
+    appended(sizeBefore, firstLineBefore, wasAtBottom);
+}
+
+QString LogView::toPlainText() const {
+    return lines_.empty() ? QString() : linesText(0, lines_.size() - 1);
+}
+
+QString LogView::selectedText() const {
+    if (!hasSelection() || lines_.empty()) {
+        return QString();
+    }
+    const qint64 base = static_cast<qint64>(lines_.firstLineNumber());
+    const qint64 last = static_cast<qint64>(lines_.size()) - 1;
+    const qint64 from = std::max<qint64>(std::min(anchorLine_, cursorLine_) - base, 0);
+    const qint64 to = std::min<qint64>(std::max(anchorLine_, cursorLine_) - base, last);
+    if (from > to) {
+        return QString();
+    }
+    return linesText(static_cast<std::size_t>(from), static_cast<std::size_t>(to));
+}
+
+void LogView::clear() {
+    lines_.clear();
+    anchorLine_ = -1;
+    cursorLine_ = -1;
+    widestLine_ = 0;
+    updateScrollBars();
+    viewport()->update();
+}
+
+void LogView::copy() {
+    if (hasSelection()) {
+        QApplication::clipboard()->setText(selectedText());
+    }
+}
+
+void LogView::selectAll() {
+    if (lines_.empty()) {
+        return;
+    }
+    anchorLine_ = static_cast<qint64>(lines_.firstLineNumber());
+    cursorLine_ = anchorLine_ + static_cast<qint64>(lines_.size()) - 1;
+    viewport()->update();
+}
+
+void LogView::scrollToBottom() {
+    verticalScrollBar()->setValue(verticalScrollBar()->maximum());
+}
+
+void LogView::paintEvent(QPaintEvent* event) {
+    QPainter painter(viewport());
+    painter.setFont(font());
+    const QRect rect = event->rect();
+    painter.fillRect(rect, palette().base());
+
+    const std::size_t first = static_cast<std::size_t>(verticalScrollBar()->value());
+    const int x = kMargin - horizontalScrollBar()->value();
+    const int width = viewport()->width();
+    const qint64 base = static_cast<qint64>(lines_.firstLineNumber());
+    const qint64 selectionFrom = std::min(anchorLine_, cursorLine_);
+    const qint64 selectionTo = std::max(anchorLine_, cursorLine_);
+    const QFontMetrics metrics(font());
+    int widest = widestLine_;
+
+    // 只处理与重绘区域相交的行
+    const int firstRow = std::max(rect.top(), 0) / lineHeight_;
+    const int lastRow = rect.bottom() / lineHeight_;
+    for (int row = firstRow; row <= lastRow; ++row) {
+        const std::size_t index = first + static_cast<std::size_t>(row);
+        if (index >= lines_.size()) {
+            break;
+        }
+        const int y = row * lineHeight_;
+        const qint64 lineNumber = base + static_cast<qint64>(index);
+        const bool selected = hasSelection() && lineNumber >= selectionFrom && lineNumber <= selectionTo;
+        if (selected) {
+            painter.fillRect(0, y, width, lineHeight_, palette().highlight());
+            painter.setPen(palette().color(QPalette::HighlightedText));
+        } else {
+            painter.setPen(palette().color(QPalette::Text));
+        }
+        const QString text = decodeLine(lines_.line(index));
+        painter.drawText(x, y + ascent_, text);
+        widest = std::max(widest, metrics.horizontalAdvance(text));
+    }
+
+    if (widest > widestLine_) {
+        // 不在绘制过程中修改滚动条
+        widestLine_ = widest;
+        QTimer::singleShot(0, this, [this]() { updateScrollBars(); });
+    }
+}
+
+void LogView::resizeEvent(QResizeEvent* event) {
+    const bool wasAtBottom = isAtBottom();
+    QAbstractScrollArea::resizeEvent(event);
+    updateScrollBars();
+    if (wasAtBottom) {
+        scrollToBottom();
+    }
+}
+
+void LogView::changeEvent(QEvent* event) {
+    QAbstractScrollArea::changeEvent(event);
+    if (event->type() == QEvent::FontChange) {
+        updateMetrics();
+        widestLine_ = 0;
+        updateScrollBars();
+        viewport()->update();
+    }
+}
+
+void LogView::keyPressEvent(QKeyEvent* event) {
+    if (event->matches(QKeySequence::Copy)) {
+        copy();
+    } else if (event->matches(QKeySequence::SelectAll)) {
+        selectAll();
+    } else if (event->matches(QKeySequence::MoveToStartOfDocument)) {
+        verticalScrollBar()->setValue(0);
+    } else if (event->matches(QKeySequence::MoveToEndOfDocument)) {
+        scrollToBottom();
+    } else {
+        QAbstractScrollArea::keyPressEvent(event);
+    }
+}
+
+void LogView::mousePressEvent(QMouseEvent* event) {
+    if (event->button() != Qt::LeftButton) {
+        QAbstractScrollArea::mousePressEvent(event);
+        return;
+    }
+    const qint64 line = lineAt(event->pos().y());
+    if (line < 0) {
+        return;
+    }
+    if (!(event->modifiers() & Qt::ShiftModifier) || !hasSelection()) {
+        anchorLine_ = line;
+    }
+    cursorLine_ = line;
+    viewport()->update();
+}
+
+void LogView::mouseMoveEvent(QMouseEvent* event) {
+    if (!(event->buttons() & Qt::LeftButton) || !hasSelection()) {
+        return;
+    }
+    // 拖出视口时逐行滚动
+    const int y = event->pos().y();
+    if (y < 0) {
+        verticalScrollBar()->triggerAction(QAbstractSlider::SliderSingleStepSub);
+    } else if (y >= viewport()->height()) {
+        verticalScrollBar()->triggerAction(QAbstractSlider::SliderSingleStepAdd);
+    }
+    const qint64 line = lineAt(y);
+    if (line >= 0 && line != cursorLine_) {
+        cursorLine_ = line;
+        viewport()->update();
+    }
+}
+
+void LogView::scrollContentsBy(int dx, int dy) {
+    // 垂直滚动条以行为单位
+    viewport()->scroll(dx, dy * lineHeight_);
+}
+
+void LogView::appended(std::size_t sizeBefore, std::uint64_t firstLineBefore, bool wasAtBottom) {
+    const std::uint64_t dropped = lines_.firstLineNumber() - firstLineBefore;
+    QScrollBar* bar = verticalScrollBar();
+    const int valueBefore = bar->value();
+    updateScrollBars();
+
+    if (wasAtBottom) {
+        scrollToBottom();
+    } else if (dropped > 0) {
+        // 丢弃了头部的行：保持显示同样的内容
+        bar->setValue(std::max(0, valueBefore - static_cast<int>(std::min<std::uint64_t>(dropped, INT_MAX))));
+    }
+
+    // 新行落在可见区域之外且没有滚动时不需要重绘
+    if (wasAtBottom || dropped > 0 || sizeBefore < static_cast<std::size_t>(valueBefore + visibleRows() + 1)) {
+        viewport()->update();
+    }
+}
+
+void LogView::updateMetrics() {
+    const QFontMetrics metrics(font());
+    lineHeight_ = std::max(1, metrics.lineSpacing());
+    ascent_ = metrics.ascent();
+}
+
+void LogView::updateScrollBars() {
+    const int rows = visibleRows();
+    const int count = static_cast<int>(std::min<std::size_t>(lines_.size(), INT_MAX));
+    QScrollBar* vertical = verticalScrollBar();
+    vertical->setRange(0, std::max(0, count - rows));
+    vertical->setPageStep(std::max(1, rows));
+    vertical->setSingleStep(1);
+
+    const int viewportWidth = viewport()->width();
+    QScrollBar* horizontal = horizontalScrollBar();
+    horizontal->setRange(0, std::max(0, widestLine_ + 2 * kMargin - viewportWidth));
+    horizontal->setPageStep(viewportWidth);
+    horizontal->setSingleStep(std::max(1, QFontMetrics(font()).averageCharWidth() * 4));
+}
+
+int LogView::visibleRows() const {
+    return std::max(1, viewport()->height() / lineHeight_);
+}
+
+bool LogView::isAtBottom() const {
+    return verticalScrollBar()->value() >= verticalScrollBar()->maximum();
+}
+
+qint64 LogView::lineAt(int y) const {
+    if (lines_.empty()) {
+        return -1;
+    }
+    const qint64 row = y < 0 ? 0 : y / lineHeight_;
+    const qint64 index = std::min<qint64>(verticalScrollBar()->value() + row, static_cast<qint64>(lines_.size()) - 1);
+    return static_cast<qint64>(lines_.firstLineNumber()) + index;
+}
+
+QString LogView::linesText(std::size_t first, std::size_t last) const {
+    // 先拼成 UTF-8 再一次解码
+    std::size_t bytes = 0;
+    for (std::size_t i = first; i <= last; ++i) {
+        bytes += lines_.line(i).size() + 1;
+    }
+    QByteArray utf8;
+    utf8.reserve(static_cast<int>(std::min<std::size_t>(bytes, INT_MAX)));
+    for (std::size_t i = first; i <= last; ++i) {
+        const std::string_view line = lines_.line(i);
+        utf8.append(line.data(), static_cast<int>(line.size()));
+        if (i != last) {
+            utf8.append('\n');
+        }
+    }
+    return QString::fromUtf8(utf8);
+}
+
+QString LogView::decodeLine(std::string_view utf8) {
+    QString text = QString::fromUtf8(utf8.data(), static_cast<int>(utf8.size()));
+    if (text.contains(QLatin1Char('\t'))) {
+        text.replace(QLatin1Char('\t'), QLatin1String("    "));
+    }
+    return text;
+}
+
+} // namespace common
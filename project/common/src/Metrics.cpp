@@ -0,0 +1,205 @@
+#include "common/Metrics.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace common {
+
+namespace detail {
+
+std::size_t nextShard() {
+    static std::atomic<std::size_t> next{0};
+    return next.fetch_add(1, std::memory_order_relaxed) % kMetricShards;
+}
+
+} // namespace detail
+
+std::uint64_t Counter::value() const {
+    std::uint64_t total = 0;
+    for (const Shard& shard : shards_) {
+        total += shard.value.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+HdrLayout::HdrLayout(std::int64_t highestTrackable, int significantDigits) {
+    significantDigits = std::clamp(significantDigits, 1, 5);
+    highest_ = std::max<std::int64_t>(highestTrackable, 2);
+
+    // 子桶数取不小于 2 * 10^digits 的 2 的幂，保证每段内的相对误差
+    std::int64_t largestWithSingleUnitResolution = 2;
+    for (int i = 0; i < significantDigits; ++i) {
+        largestWithSingleUnitResolution *= 10;
+    }
+    int subBucketCountMagnitude = 0;
+    while ((std::int64_t(1) << subBucketCountMagnitude) < largestWithSingleUnitResolution) {
+        ++subBucketCountMagnitude;
+    }
+    subBucketHalfCountMagnitude_ = subBucketCountMagnitude - 1;
+    const std::int64_t subBucketCount = std::int64_t(1) << subBucketCountMagnitude;
+    subBucketHalfCount_ = subBucketCount / 2;
+    subBucketMask_ = subBucketCount - 1;
+
+    // 覆盖 highest 所需的分段数
+    std::int64_t smallestUntrackable = subBucketCount;
+    std::int64_t buckets = 1;
+    while (smallestUntrackable <= highest_) {
+        if (smallestUntrackable > INT64_MAX / 2) {
+            ++buckets;
+            break;
+        }
+        smallestUntrackable <<= 1;
+        ++buckets;
+    }
+    countsLength_ = static_cast<std::size_t>((buckets + 1) * subBucketHalfCount_);
+}
+
+std::int64_t HdrLayout::lowestValueAt(std::size_t index) const {
+    std::int64_t bucket = (static_cast<std::int64_t>(index) >> subBucketHalfCountMagnitude_) - 1;
+    std::int64_t subBucket = (static_cast<std::int64_t>(index) & (subBucketHalfCount_ - 1)) + subBucketHalfCount_;
+    if (bucket < 0) {
+        subBucket -= subBucketHalfCount_;
+        bucket = 0;
+    }
+    return subBucket << bucket;
+}
+
+std::int64_t HdrLayout::highestValueAt(std::size_t index) const {
+    const std::int64_t bucket = std::max<std::int64_t>((static_cast<std::int64_t>(index) >> subBucketHalfCountMagnitude_) - 1, 0);
+    return lowestValueAt(index) + (std::int64_t(1) << bucket) - 1;
+}
+
+std::int64_t HistogramSnapshot::min() const {
+    for (std::size_t i = 0; i < counts_.size(); ++i) {
+        if (counts_[i] != 0) {
+            return layout_->lowestValueAt(i);
+        }
+    }
+    return 0;
+}
+
+std::int64_t HistogramSnapshot::max() const {
+    for (std::size_t i = counts_.size(); i-- > 0;) {
+        if (counts_[i] != 0) {
+            return std::min(layout_->highestValueAt(i), layout_->highestTrackable());
+        }
+    }
+    return 0;
+}
+
+std::int64_t HistogramSnapshot::valueAtPercentile(double percentile) const {
+    if (count_ == 0) {
+        return 0;
+    }
+    percentile = std::clamp(percentile, 0.0, 100.0);
+    // 至少要覆盖的记录数（至少 1 条，0 分位即最小值）
+    const auto target = std::max<std::uint64_t>(
+        1, static_cast<std::uint64_t>(std::ceil(percentile / 100.0 * static_cast<double>(count_))));
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < counts_.size(); ++i) {
+        seen += counts_[i];
+        if (seen >= target) {
+            return std::min(layout_->highestValueAt(i), layout_->highestTrackable());
+        }
+    }
+    return max();
+}
+
+Histogram::Histogram(std::int64_t highestTrackable, int significantDigits, double exportScale)
+    : layout_(highestTrackable, significantDigits), exportScale_(exportScale) {
+    for (auto& shard : shards_) {
+        shard.store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+Histogram::~Histogram() {
+    for (auto& shard : shards_) {
+        delete shard.load(std::memory_order_relaxed);
+    }
+}
+
+Histogram::Shard* Histogram::createShard(std::size_t index) {
+    auto created = std::make_unique<Shard>();
+    created->counts.reset(new std::atomic<std::uint64_t>[layout_.countsLength()]());
+    Shard* expected = nullptr;
+    // 共享同一分片的两个线程可能同时创建，只保留先发布的那个
+    if (shards_[index].compare_exchange_strong(expected, created.get(), std::memory_order_acq_rel)) {
+        return created.release();
+    }
+    return expected;
+}
+
+HistogramSnapshot Histogram::snapshot() const {
+    std::vector<std::uint64_t> counts(layout_.countsLength(), 0);
+    std::uint64_t count = 0;
+    std::int64_t sum = 0;
+    for (const auto& slot : shards_) {
+        const Shard* shard = slot.load(std::memory_order_acquire);
+        if (!shard) {
+            continue;
+        }
+        // 与记录并发时各字段不是同一时刻的值，总数以各桶之和为准
+        for (std::size_t i = 0; i < counts.size(); ++i) {
+            const std::uint64_t value = shard->counts[i].load(std::memory_order_relaxed);
+            counts[i] += value;
+            count += value;
+        }
+        sum += shard->sum.load(std::memory_order_relaxed);
+    }
+    return HistogramSnapshot(layout_, std::move(counts), count, sum);
+}
+
+MetricsRegistry& MetricsRegistry::global() {
+    // 有意不析构：静态对象析构之后仍可能有线程在记录
+    static MetricsRegistry* registry = new MetricsRegistry();
+    return *registry;
+}
+
+MetricsRegistry::Entry& MetricsRegistry::findOrAdd(const std::string& name, Type type, const std::string& help) {
+    auto it = entries_.find(name);
+    if (it != entries_.end()) {
+        if (it->second.type != type) {
+            throw std::logic_error("metric '" + name + "' is already registered with a different type");
+        }
+        return it->second;
+    }
+    Entry& entry = entries_[name];
+    entry.type = type;
+    entry.help = help;
+    return entry;
+}
+
+Counter& MetricsRegistry::counter(const std::string& name, const std::string& help) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Entry& entry = findOrAdd(name, Type::Counter, help);
+    if (!entry.counter) {
+        entry.counter = std::make_unique<Counter>();
+    }
+    return *entry.counter;
+}
+
+Gauge& MetricsRegistry::gauge(const std::string& name, const std::string& help) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Entry& entry = findOrAdd(name, Type::Gauge, help);
+    if (!entry.gauge) {
+        entry.gauge = std::make_unique<Gauge>();
+    }
+    return *entry.gauge;
+}
+
+Histogram& MetricsRegistry::histogram(const std::string& name, const std::string& help, std::int64_t highestTrackable,
+                                      int significantDigits, double exportScale) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Entry& entry = findOrAdd(name, Type::Histogram, help);
+    if (!entry.histogram) {
+        entry.histogram = std::make_unique<Histogram>(highestTrackable, significantDigits, exportScale);
+    }
+    return *entry.histogram;
+}
+
+Histogram& MetricsRegistry::latencyHistogram(const std::string& name, const std::string& help) {
+    constexpr std::int64_t kSixtySecondsNs = 60LL * 1000 * 1000 * 1000;
+    return histogram(name, help, kSixtySecondsNs, 2, 1e-9);
+}
+
+} // namespace common
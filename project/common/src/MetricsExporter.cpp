@@ -0,0 +1,504 @@
+#include "common/MetricsExporter.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define COMMON_METRICS_POSIX 1
+#include <cerrno>
+#include <csignal>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace common {
+
+namespace {
+
+// 导出的分位数（Prometheus summary 的 quantile 标签）
+const double kQuantiles[] = {0.5, 0.9, 0.99, 0.999};
+
+void appendNumber(std::string& out, double value) {
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%.9g", value);
+    out += buffer;
+}
+
+void appendNumber(std::string& out, std::uint64_t value) {
+    out += std::to_string(value);
+}
+
+void appendNumber(std::string& out, std::int64_t value) {
+    out += std::to_string(value);
+}
+
+// HELP 行中反斜杠和换行需要转义
+void appendHelp(std::string& out, const std::string& help) {
+    for (char c : help) {
+        if (c == '\\') {
+            out += "\\\\";
+        } else if (c == '\n') {
+            out += "\\n";
+        } else {
+            out += c;
+        }
+    }
+}
+
+void appendJsonString(std::string& out, const std::string& text) {
+    out += '"';
+    for (char c : text) {
+        switch (c) {
+        case '"': out += "\\\""; break;
+        case '\\': out += "\\\\"; break;
+        case '\n': out += "\\n"; break;
+        case '\r': out += "\\r"; break;
+        case '\t': out += "\\t"; break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20) {
+                char escaped[8];
+                std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned char>(c));
+                out += escaped;
+            } else {
+                out += c;
+            }
+        }
+    }
+    out += '"';
+}
+
+const char* typeName(MetricsRegistry::Type type) {
+    switch (type) {
+    case MetricsRegistry::Type::Counter: return "counter";
+    case MetricsRegistry::Type::Gauge: return "gauge";
+    case MetricsRegistry::Type::Histogram: return "summary";
+    }
+    return "untyped";
+}
+
+std::string renderPrometheus(const MetricsRegistry& registry) {
+    std::string out;
+    registry.forEach([&out](const std::string& name, const MetricsRegistry::Entry& entry) {
+        out += "# HELP ";
+        out += name;
+        out += ' ';
+        appendHelp(out, entry.help);
+        out += "\n# TYPE ";
+        out += name;
+        out += ' ';
+        out += typeName(entry.type);
+        out += '\n';
+        switch (entry.type) {
+        case MetricsRegistry::Type::Counter:
+            out += name;
+            out += ' ';
+            appendNumber(out, entry.counter->value());
+            out += '\n';
+            break;
+        case MetricsRegistry::Type::Gauge:
+            out += name;
+            out += ' ';
+            appendNumber(out, entry.gauge->value());
+            out += '\n';
+            break;
+        case MetricsRegistry::Type::Histogram: {
+            const HistogramSnapshot snapshot = entry.histogram->snapshot();
+            const double scale = entry.histogram->exportScale();
+            for (double quantile : kQuantiles) {
+                out += name;
+                out += "{quantile=\"";
+                appendNumber(out, quantile);
+                out += "\"} ";
+                appendNumber(out, static_cast<double>(snapshot.valueAtPercentile(quantile * 100.0)) * scale);
+                out += '\n';
+            }
+            out += name;
+            out += "_sum ";
+            appendNumber(out, static_cast<double>(snapshot.sum()) * scale);
+            out += '\n';
+            out += name;
+            out += "_count ";
+            appendNumber(out, snapshot.count());
+            out += '\n';
+            break;
+        }
+        }
+    });
+    return out;
+}
+
+std::string renderJson(const MetricsRegistry& registry) {
+    std::string out = "{";
+    bool first = true;
+    registry.forEach([&out, &first](const std::string& name, const MetricsRegistry::Entry& entry) {
+        out += first ? "\n  " : ",\n  ";
+        first = false;
+        appendJsonString(out, name);
+        out += ": {\"type\": \"";
+        out += entry.type == MetricsRegistry::Type::Histogram ? "histogram" : typeName(entry.type);
+        out += "\", \"help\": ";
+        appendJsonString(out, entry.help);
+        switch (entry.type) {
+        case MetricsRegistry::Type::Counter:
+            out += ", \"value\": ";
+            appendNumber(out, entry.counter->value());
+            break;
+        case MetricsRegistry::Type::Gauge:
+            out += ", \"value\": ";
+            appendNumber(out, entry.gauge->value());
+            break;
+        case MetricsRegistry::Type::Histogram: {
+            const HistogramSnapshot snapshot = entry.histogram->snapshot();
+            const double scale = entry.histogram->exportScale();
+            out += ", \"count\": ";
+            appendNumber(out, snapshot.count());
+            out += ", \"sum\": ";
+            appendNumber(out, static_cast<double>(snapshot.sum()) * scale);
+            out += ", \"mean\": ";
+            appendNumber(out, snapshot.mean() * scale);
+            out += ", \"min\": ";
+            appendNumber(out, static_cast<double>(snapshot.min()) * scale);
+            out += ", \"max\": ";
+            appendNumber(out, static_cast<double>(snapshot.max()) * scale);
+            out += ", \"p50\": ";
+            appendNumber(out, static_cast<double>(snapshot.valueAtPercentile(50.0)) * scale);
+            out += ", \"p90\": ";
+            appendNumber(out, static_cast<double>(snapshot.valueAtPercentile(90.0)) * scale);
+            out += ", \"p99\": ";
+            appendNumber(out, static_cast<double>(snapshot.valueAtPercentile(99.0)) * scale);
+            out += ", \"p999\": ";
+            appendNumber(out, static_cast<double>(snapshot.valueAtPercentile(99.9)) * scale);
+            break;
+        }
+        }
+        out += '}';
+    });
+    out += first ? "}\n" : "\n}\n";
+    return out;
+}
+
+bool endsWith(const std::string& text, const char* suffix) {
+    const std::size_t length = std::strlen(suffix);
+    return text.size() >= length && text.compare(text.size() - length, length, suffix) == 0;
+}
+
+#ifdef COMMON_METRICS_POSIX
+
+// SIGUSR1 处理函数写入的管道（async-signal-safe：只调用 write）
+std::atomic<int> signalWakeFd{-1};
+
+void onDumpSignal(int) {
+    const int fd = signalWakeFd.load(std::memory_order_relaxed);
+    if (fd >= 0) {
+        const char command = 'd';
+        const int savedErrno = errno;
+        (void)!::write(fd, &command, 1);
+        errno = savedErrno;
+    }
+}
+
+bool sendAll(int fd, const char* data, std::size_t size) {
+#ifdef MSG_NOSIGNAL
+    const int flags = MSG_NOSIGNAL;
+#else
+    const int flags = 0;
+#endif
+    while (size > 0) {
+        const ssize_t written = ::send(fd, data, size, flags);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        data += written;
+        size -= static_cast<std::size_t>(written);
+    }
+    return true;
+}
+
+#endif
+
+} // namespace
+
+MetricsExporter::MetricsExporter(MetricsRegistry& registry)
+    : registry_(registry), listenFd_(-1), wakeFds_{-1, -1}, stopping_(false) {
+}
+
+MetricsExporter::~MetricsExporter() {
+    stop();
+    if (!dumpFile_.empty()) {
+        dumpToFile();
+    }
+}
+
+void MetricsExporter::startFromEnvironment() {
+    std::string error;
+    if (const char* path = std::getenv("METRICS_FILE")) {
+        if (*path) {
+            setDumpFile(path);
+        }
+    }
+    if (const char* path = std::getenv("METRICS_SOCKET")) {
+        if (*path && !listen(path, &error)) {
+            std::fprintf(stderr, "metrics: cannot listen on %s: %s\n", path, error.c_str());
+        }
+    }
+}
+
+MetricsExporter::Format MetricsExporter::formatForPath(const std::string& path) {
+    return endsWith(path, ".json") ? Format::Json : Format::Prometheus;
+}
+
+std::string MetricsExporter::render(const MetricsRegistry& registry, Format format) {
+    return format == Format::Json ? renderJson(registry) : renderPrometheus(registry);
+}
+
+std::string MetricsExporter::render(Format format) const {
+    return render(registry_, format);
+}
+
+bool MetricsExporter::writeFile(const std::string& path, std::string* error) const {
+    // 先写临时文件再改名，读取方不会看到写了一半的内容
+    const std::string temporary = path + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        const std::string text = render(formatForPath(path));
+        file.write(text.data(), static_cast<std::streamsize>(text.size()));
+        if (!file) {
+            if (error) {
+                *error = "cannot write " + temporary;
+            }
+            return false;
+        }
+    }
+#ifdef _WIN32
+    std::remove(path.c_str());
+#endif
+    if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+        if (error) {
+            *error = "cannot rename " + temporary + " to " + path;
+        }
+        return false;
+    }
+    return true;
+}
+
+void MetricsExporter::dumpToFile() const {
+    std::string error;
+    if (!writeFile(dumpFile_, &error)) {
+        std::fprintf(stderr, "metrics: %s\n", error.c_str());
+    }
+}
+
+#ifdef COMMON_METRICS_POSIX
+
+void MetricsExporter::setDumpFile(const std::string& path) {
+    dumpFile_ = path;
+    std::string error;
+    if (!ensureThread(&error)) {
+        std::fprintf(stderr, "metrics: %s\n", error.c_str());
+        return;
+    }
+    signalWakeFd.store(wakeFds_[1]);
+    struct sigaction action;
+    std::memset(&action, 0, sizeof(action));
+    action.sa_handler = &onDumpSignal;
+    sigemptyset(&action.sa_mask);
+    action.sa_flags = SA_RESTART;
+    ::sigaction(SIGUSR1, &action, nullptr);
+}
+
+bool MetricsExporter::listen(const std::string& socketPath, std::string* error) {
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (listenFd_ >= 0 || socketPath.empty() || socketPath.size() >= sizeof(address.sun_path)) {
+        if (error) {
+            *error = listenFd_ >= 0 ? "already listening" : "invalid socket path";
+        }
+        return false;
+    }
+    std::memcpy(address.sun_path, socketPath.data(), socketPath.size());
+
+    const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        if (error) {
+            *error = std::strerror(errno);
+        }
+        return false;
+    }
+    ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+    // 上次异常退出留下的套接字文件
+    ::unlink(socketPath.c_str());
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || ::listen(fd, 8) != 0) {
+        if (error) {
+            *error = std::strerror(errno);
+        }
+        ::close(fd);
+        return false;
+    }
+    listenFd_ = fd;
+    socketPath_ = socketPath;
+    if (!ensureThread(error)) {
+        ::close(listenFd_);
+        listenFd_ = -1;
+        ::unlink(socketPath_.c_str());
+        return false;
+    }
+    // 服务线程可能正阻塞在不含新套接字的 poll 中
+    const char command = 'l';
+    (void)!::write(wakeFds_[1], &command, 1);
+    return true;
+}
+
+bool MetricsExporter::ensureThread(std::string* error) {
+    if (thread_.joinable()) {
+        return true;
+    }
+    if (::pipe(wakeFds_) != 0) {
+        if (error) {
+            *error = std::strerror(errno);
+        }
+        wakeFds_[0] = wakeFds_[1] = -1;
+        return false;
+    }
+    for (int fd : wakeFds_) {
+        ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+        ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+    }
+    stopping_ = false;
+    thread_ = std::thread(&MetricsExporter::serveLoop, this);
+    return true;
+}
+
+void MetricsExporter::stop() {
+    if (!thread_.joinable()) {
+        return;
+    }
+    int expected = wakeFds_[1];
+    signalWakeFd.compare_exchange_strong(expected, -1);
+    stopping_ = true;
+    const char command = 'q';
+    (void)!::write(wakeFds_[1], &command, 1);
+    thread_.join();
+    for (int& fd : wakeFds_) {
+        ::close(fd);
+        fd = -1;
+    }
+    if (listenFd_ >= 0) {
+        ::close(listenFd_);
+        listenFd_ = -1;
+        ::unlink(socketPath_.c_str());
+    }
+}
+
+void MetricsExporter::serveLoop() {
+    while (!stopping_) {
+        const int listenFd = listenFd_.load();
+        pollfd fds[2] = {{wakeFds_[0], POLLIN, 0}, {listenFd, POLLIN, 0}};
+        const nfds_t count = listenFd >= 0 ? 2 : 1;
+        if (::poll(fds, count, -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        if (fds[0].revents & POLLIN) {
+            char commands[64];
+            ssize_t received;
+            bool dump = false;
+            while ((received = ::read(wakeFds_[0], commands, sizeof(commands))) > 0) {
+                dump |= std::memchr(commands, 'd', static_cast<std::size_t>(received)) != nullptr;
+            }
+            if (dump && !dumpFile_.empty()) {
+                dumpToFile();
+            }
+        }
+        if (count > 1 && (fds[1].revents & POLLIN)) {
+            const int client = ::accept(listenFd, nullptr, nullptr);
+            if (client >= 0) {
+                serveClient(client);
+                ::close(client);
+            }
+        }
+    }
+}
+
+void MetricsExporter::serveClient(int fd) const {
+    // 读取请求的第一行；客户端不发送任何内容时短暂等待后按默认格式返回
+    std::string request;
+    char buffer[512];
+    while (request.size() < 4096 && request.find('\n') == std::string::npos) {
+        pollfd client = {fd, POLLIN, 0};
+        if (::poll(&client, 1, 200) <= 0) {
+            break;
+        }
+        const ssize_t received = ::recv(fd, buffer, sizeof(buffer), 0);
+        if (received <= 0) {
+            break;
+        }
+        request.append(buffer, static_cast<std::size_t>(received));
+    }
+    request = request.substr(0, request.find('\n'));
+    if (!request.empty() && request.back() == '\r') {
+        request.pop_back();
+    }
+
+    const bool http = request.compare(0, 4, "GET ") == 0;
+    Format format = Format::Prometheus;
+    if (http) {
+        const std::size_t end = request.find(' ', 4);
+        const std::string path = request.substr(4, end == std::string::npos ? std::string::npos : end - 4);
+        if (endsWith(path.substr(0, path.find('?')), ".json") || path.find("format=json") != std::string::npos) {
+            format = Format::Json;
+        }
+    } else if (request == "json") {
+        format = Format::Json;
+    }
+
+    const std::string body = render(format);
+    if (http) {
+        std::string header = "HTTP/1.0 200 OK\r\nContent-Type: ";
+        header += format == Format::Json ? "application/json" : "text/plain; version=0.0.4";
+        header += "; charset=utf-8\r\nContent-Length: " + std::to_string(body.size()) + "\r\nConnection: close\r\n\r\n";
+        if (!sendAll(fd, header.data(), header.size())) {
+            return;
+        }
+    }
+    sendAll(fd, body.data(), body.size());
+}
+
+#else
+
+void MetricsExporter::setDumpFile(const std::string& path) {
+    dumpFile_ = path;
+}
+
+bool MetricsExporter::listen(const std::string&, std::string* error) {
+    if (error) {
+        *error = "unix domain sockets are not supported on this platform";
+    }
+    return false;
+}
+
+bool MetricsExporter::ensureThread(std::string*) {
+    return false;
+}
+
+void MetricsExporter::stop() {
+}
+
+void MetricsExporter::serveLoop() {
+}
+
+void MetricsExporter::serveClient(int) const {
+}
+
+#endif
+
+} // namespace common
@@ -0,0 +1,206 @@
+#include "common/StallWatchdog.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__linux__)
+#include <cerrno>
+#include <csignal>
+#include <cxxabi.h>
+#include <execinfo.h>
+#include <pthread.h>
+#endif
+
+namespace common {
+
+namespace {
+
+// 进程中正在运行的监视器，只允许一个
+std::atomic<bool> watchdogRunning{false};
+
+#if defined(__linux__)
+
+constexpr int kMaxFrames = 64;
+constexpr int kStackSignal = SIGUSR2;
+
+// 信号处理函数写入的调用栈；frameCount 为 -1 表示等待中（async-signal-safe：只调用 backtrace）
+void* capturedFrames[kMaxFrames];
+std::atomic<int> capturedCount{-1};
+
+void onStackSignal(int) {
+    const int savedErrno = errno;
+    capturedCount.store(::backtrace(capturedFrames, kMaxFrames), std::memory_order_release);
+    errno = savedErrno;
+}
+
+// "binary(_ZN3foo3barEv+0x1c) [0x4011c6]" -> "binary(foo::bar()+0x1c) [0x4011c6]"
+std::string demangleFrame(const char* symbol) {
+    std::string frame(symbol);
+    const std::size_t open = frame.find('(');
+    const std::size_t plus = frame.find('+', open);
+    if (open == std::string::npos || plus == std::string::npos || plus == open + 1) {
+        return frame;
+    }
+    const std::string mangled = frame.substr(open + 1, plus - open - 1);
+    int status = 0;
+    char* demangled = abi::__cxa_demangle(mangled.c_str(), nullptr, nullptr, &status);
+    if (status == 0 && demangled) {
+        frame.replace(open + 1, plus - open - 1, demangled);
+    }
+    std::free(demangled);
+    return frame;
+}
+
+#endif
+
+} // namespace
+
+StallWatchdog::Options StallWatchdog::Options::fromEnvironment() {
+    Options options;
+    if (const char* value = std::getenv("GUI_STALL_THRESHOLD_MS")) {
+        char* end = nullptr;
+        const long milliseconds = std::strtol(value, &end, 10);
+        if (end != value && milliseconds >= 0) {
+            options.threshold = std::chrono::milliseconds(milliseconds);
+            // 阈值很小时提高检查频率，保证能在阈值附近发现卡顿
+            options.heartbeatInterval = std::min(options.heartbeatInterval,
+                                                 std::max(std::chrono::milliseconds(10), options.threshold / 4));
+        }
+    }
+    return options;
+}
+
+std::string StallWatchdog::StallEvent::toString() const {
+    std::string out = ended ? "GUI 线程卡顿结束，共 " : "GUI 线程卡顿，已持续 ";
+    out += std::to_string(duration.count());
+    out += " ms";
+    if (!stack.empty()) {
+        out += "，调用栈:";
+        for (const std::string& frame : stack) {
+            out += "\n    ";
+            out += frame;
+        }
+    }
+    return out;
+}
+
+StallWatchdog::StallWatchdog(Options options, MetricsRegistry& registry)
+    : options_(options),
+      stalls_(registry.counter("gui_stalls_total", "GUI 事件循环卡顿次数")),
+      stallDuration_(registry.latencyHistogram("gui_stall_duration_seconds", "GUI 事件循环每次卡顿的时长")),
+      lastBeat_(0) {
+}
+
+StallWatchdog::~StallWatchdog() {
+    stop();
+}
+
+void StallWatchdog::start() {
+    if (!options_.enabled() || thread_.joinable()) {
+        return;
+    }
+    if (watchdogRunning.exchange(true)) {
+        throw std::logic_error("StallWatchdog: another watchdog is already running");
+    }
+#if defined(__linux__)
+    target_ = ::pthread_self();
+    // 第一次调用 backtrace() 会加载 libgcc（会分配内存），先在这里调用一次，信号处理函数中才安全
+    void* warmup[1];
+    ::backtrace(warmup, 1);
+    struct sigaction action;
+    std::memset(&action, 0, sizeof(action));
+    action.sa_handler = &onStackSignal;
+    sigemptyset(&action.sa_mask);
+    action.sa_flags = SA_RESTART;
+    ::sigaction(kStackSignal, &action, nullptr);
+#endif
+    heartbeat();
+    stopping_ = false;
+    thread_ = std::thread([this]() { watchLoop(); });
+}
+
+void StallWatchdog::stop() {
+    if (!thread_.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_one();
+    thread_.join();
+    watchdogRunning.store(false);
+}
+
+void StallWatchdog::watchLoop() {
+    const std::int64_t threshold = std::chrono::duration_cast<std::chrono::nanoseconds>(options_.threshold).count();
+    bool stalled = false;
+    std::int64_t stalledSince = 0;   // 卡顿前最后一次心跳
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!wake_.wait_for(lock, options_.heartbeatInterval, [this]() { return stopping_; })) {
+        const std::int64_t beat = lastBeat_.load(std::memory_order_relaxed);
+        const std::int64_t now = nowNanos();
+        if (!stalled && now - beat >= threshold) {
+            stalled = true;
+            stalledSince = beat;
+            stalls_.add();
+            StallEvent event;
+            event.duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::nanoseconds(now - beat));
+            lock.unlock();
+            event.stack = captureStack();
+            report(event);
+            lock.lock();
+        } else if (stalled && beat != stalledSince) {
+            stalled = false;
+            stallDuration_.record(beat - stalledSince);
+            StallEvent event;
+            event.ended = true;
+            event.duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::nanoseconds(beat - stalledSince));
+            lock.unlock();
+            report(event);
+            lock.lock();
+        }
+    }
+}
+
+std::vector<std::string> StallWatchdog::captureStack() {
+    std::vector<std::string> stack;
+#if defined(__linux__)
+    capturedCount.store(-1, std::memory_order_relaxed);
+    if (::pthread_kill(target_, kStackSignal) != 0) {
+        return stack;
+    }
+    // 被监视的线程即使阻塞在系统调用中也会立即处理信号；等待上限只防止信号被屏蔽的情况
+    int count = -1;
+    for (int i = 0; i < 200 && (count = capturedCount.load(std::memory_order_acquire)) < 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    if (count <= 0) {
+        return stack;
+    }
+    // 最内层两帧是信号处理函数和内核的信号跳板，跳过
+    const int skip = count > 2 ? 2 : 0;
+    char** symbols = ::backtrace_symbols(capturedFrames + skip, count - skip);
+    if (symbols) {
+        for (int i = 0; i < count - skip; ++i) {
+            stack.push_back(demangleFrame(symbols[i]));
+        }
+        std::free(symbols);
+    }
+#endif
+    return stack;
+}
+
+void StallWatchdog::report(const StallEvent& event) {
+    if (reporter_) {
+        reporter_(event);
+    } else {
+        std::fprintf(stderr, "%s\n", event.toString().c_str());
+    }
+}
+
+} // namespace common
@@ -0,0 +1,178 @@
+#include "common/TaskGraph.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <stdexcept>
+
+namespace common {
+
+namespace {
+
+void appendMillis(std::string& out, std::int64_t nanos) {
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%.3f ms", nanos / 1e6);
+    out += buffer;
+}
+
+} // namespace
+
+TaskGraph::NodeId TaskGraph::add(std::string name, TaskScheduler::Task task, std::initializer_list<NodeId> dependencies,
+                                 TaskPriority priority) {
+    return add(std::move(name), std::move(task), std::vector<NodeId>(dependencies), priority);
+}
+
+TaskGraph::NodeId TaskGraph::add(std::string name, TaskScheduler::Task task, const std::vector<NodeId>& dependencies,
+                                 TaskPriority priority) {
+    const NodeId id = nodes_.size();
+    for (NodeId dependency : dependencies) {
+        if (dependency >= id) {
+            throw std::invalid_argument("TaskGraph: node '" + name + "' depends on a node that was not added before it");
+        }
+    }
+    Node node;
+    node.name = std::move(name);
+    node.task = std::move(task);
+    node.priority = priority;
+    node.dependencies = dependencies;
+    std::sort(node.dependencies.begin(), node.dependencies.end());
+    node.dependencies.erase(std::unique(node.dependencies.begin(), node.dependencies.end()), node.dependencies.end());
+    for (NodeId dependency : node.dependencies) {
+        nodes_[dependency].successors.push_back(id);
+    }
+    nodes_.push_back(std::move(node));
+    return id;
+}
+
+void TaskGraph::run(TaskScheduler& scheduler) {
+    const std::size_t count = nodes_.size();
+    report_ = Report();
+    report_.nodes.resize(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        report_.nodes[i].name = nodes_[i].name;
+    }
+    if (count == 0) {
+        return;
+    }
+
+    // 每个节点尚未完成的前驱数；blocked 表示有前驱失败，节点只传递完成而不执行
+    auto remaining = std::make_unique<std::atomic<std::size_t>[]>(count);
+    auto blocked = std::make_unique<std::atomic<bool>[]>(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        remaining[i].store(nodes_[i].dependencies.size(), std::memory_order_relaxed);
+        blocked[i].store(false, std::memory_order_relaxed);
+    }
+
+    const auto started = std::chrono::steady_clock::now();
+    auto elapsed = [started]() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - started).count();
+    };
+
+    TaskGroup group(scheduler);
+    std::function<void(NodeId)> launch = [&](NodeId id) {
+        group.run([&, id]() {
+            const Node& node = nodes_[id];
+            NodeTiming& timing = report_.nodes[id];
+            bool failed = blocked[id].load(std::memory_order_relaxed);
+            std::exception_ptr error;
+            timing.skipped = failed;
+            timing.startNanos = elapsed();
+            if (!failed) {
+                try {
+                    node.task();
+                } catch (...) {
+                    failed = true;
+                    error = std::current_exception();
+                }
+            }
+            timing.finishNanos = elapsed();
+            // 最后一个完成的前驱负责提交后继；acq_rel 使本节点的结果对后继可见
+            for (NodeId next : node.successors) {
+                if (failed) {
+                    blocked[next].store(true, std::memory_order_relaxed);
+                }
+                if (remaining[next].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    launch(next);
+                }
+            }
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }, nodes_[id].priority);
+    };
+    for (std::size_t i = 0; i < count; ++i) {
+        if (nodes_[i].dependencies.empty()) {
+            launch(i);
+        }
+    }
+
+    std::exception_ptr error;
+    try {
+        group.wait();
+    } catch (...) {
+        error = std::current_exception();
+    }
+    report_.elapsedNanos = elapsed();
+    computeCriticalPath();
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+void TaskGraph::computeCriticalPath() {
+    // 节点按添加顺序已是拓扑序，一遍动态规划即可
+    const std::size_t count = nodes_.size();
+    std::vector<std::int64_t> longest(count, 0);
+    std::vector<NodeId> previous(count, count);
+    NodeId last = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        std::int64_t before = 0;
+        for (NodeId dependency : nodes_[i].dependencies) {
+            if (previous[i] == count || longest[dependency] > before) {
+                before = longest[dependency];
+                previous[i] = dependency;
+            }
+        }
+        longest[i] = before + report_.nodes[i].durationNanos();
+        if (longest[i] > longest[last]) {
+            last = i;
+        }
+    }
+    report_.criticalPathNanos = longest[last];
+    report_.criticalPath.clear();
+    for (NodeId id = last; id != count; id = previous[id]) {
+        report_.criticalPath.push_back(id);
+    }
+    std::reverse(report_.criticalPath.begin(), report_.criticalPath.end());
+}
+
+std::string TaskGraph::Report::toString() const {
+    std::string out = "总耗时 ";
+    appendMillis(out, elapsedNanos);
+    out += "，关键路径 ";
+    appendMillis(out, criticalPathNanos);
+    out += ": ";
+    for (std::size_t i = 0; i < criticalPath.size(); ++i) {
+        if (i > 0) {
+            out += " -> ";
+        }
+        out += nodes[criticalPath[i]].name;
+    }
+    for (const NodeTiming& node : nodes) {
+        out += "\n  ";
+        out += node.name;
+        out += ": ";
+        if (node.skipped) {
+            out += "跳过（前驱失败）";
+            continue;
+        }
+        appendMillis(out, node.startNanos);
+        out += " - ";
+        appendMillis(out, node.finishNanos);
+        out += "（";
+        appendMillis(out, node.durationNanos());
+        out += "）";
+    }
+    return out;
+}
+
+} // namespace common
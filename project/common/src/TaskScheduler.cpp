@@ -0,0 +1,256 @@
+#include "common/TaskScheduler.h"
+#include "common/WorkStealingDeque.h"
+#include <chrono>
+#include <cstdio>
+#include <deque>
+
+namespace common {
+
+namespace {
+
+std::size_t priorityIndex(TaskPriority priority) {
+    return static_cast<std::size_t>(priority);
+}
+
+} // namespace
+
+struct TaskScheduler::Worker {
+    TaskScheduler* scheduler = nullptr;
+    std::size_t index = 0;
+    WorkStealingDeque<Node> deques[kPriorityCount];
+    std::thread thread;
+    std::uint64_t random = 0;   // 选择窃取对象的伪随机状态，仅本线程使用
+};
+
+/**
+ * 非工作线程提交任务的队列；只在对应优先级有排队任务时才加锁
+ */
+class TaskScheduler::InjectionQueue {
+private:
+    std::mutex mutex_;
+    std::deque<Node*> nodes_;
+
+public:
+    void push(Node* node) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        nodes_.push_back(node);
+    }
+
+    Node* pop() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (nodes_.empty()) {
+            return nullptr;
+        }
+        Node* node = nodes_.front();
+        nodes_.pop_front();
+        return node;
+    }
+};
+
+thread_local TaskScheduler::Worker* TaskScheduler::currentWorker_ = nullptr;
+
+TaskScheduler::TaskScheduler(std::size_t workerCount)
+    : injected_(new InjectionQueue[kPriorityCount]), pending_(0), sleepers_(0), stopping_(false) {
+    for (auto& queued : queued_) {
+        queued.store(0, std::memory_order_relaxed);
+    }
+    if (workerCount == 0) {
+        workerCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    workers_.reserve(workerCount);
+    for (std::size_t i = 0; i < workerCount; ++i) {
+        auto worker = std::make_unique<Worker>();
+        worker->scheduler = this;
+        worker->index = i;
+        worker->random = 0x9E3779B97F4A7C15ull * (i + 1);
+        workers_.push_back(std::move(worker));
+    }
+    // 所有 Worker 构造完毕后再启动线程，窃取时遍历的 workers_ 不再变化
+    for (auto& worker : workers_) {
+        Worker* raw = worker.get();
+        raw->thread = std::thread([this, raw]() { workerLoop(raw); });
+    }
+}
+
+TaskScheduler::~TaskScheduler() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    for (auto& worker : workers_) {
+        worker->thread.join();
+    }
+}
+
+TaskScheduler& TaskScheduler::shared() {
+    // 有意不析构：静态对象析构期间其他线程可能仍在提交任务
+    static TaskScheduler* scheduler = new TaskScheduler();
+    return *scheduler;
+}
+
+bool TaskScheduler::isWorkerThread() const {
+    return currentWorker_ && currentWorker_->scheduler == this;
+}
+
+void TaskScheduler::submit(Task task, TaskPriority priority) {
+    push(new Node{std::move(task), std::nullopt}, priority);
+}
+
+void TaskScheduler::submit(Task task, const CancellationToken& token, TaskPriority priority) {
+    push(new Node{std::move(task), token}, priority);
+}
+
+void TaskScheduler::push(Node* node, TaskPriority priority) {
+    const std::size_t level = priorityIndex(priority);
+    queued_[level].fetch_add(1, std::memory_order_seq_cst);
+    if (isWorkerThread()) {
+        currentWorker_->deques[level].push(node);
+    } else {
+        injected_[level].push(node);
+    }
+    pending_.fetch_add(1, std::memory_order_seq_cst);
+    // 睡眠的线程在持有 sleepMutex_ 时检查 pending_：先加锁再通知，唤醒不会丢失
+    if (sleepers_.load(std::memory_order_seq_cst) > 0) {
+        { std::lock_guard<std::mutex> lock(sleepMutex_); }
+        wake_.notify_one();
+    }
+}
+
+TaskScheduler::Node* TaskScheduler::take(Worker* self) {
+    const std::size_t count = workers_.size();
+    for (std::size_t level = 0; level < kPriorityCount; ++level) {
+        if (queued_[level].load(std::memory_order_acquire) <= 0) {
+            continue;
+        }
+        Node* node = self ? self->deques[level].pop() : nullptr;
+        if (!node) {
+            node = injected_[level].pop();
+        }
+        if (!node && count > 0) {
+            // 从随机位置开始依次尝试窃取，避免所有线程同时盯住同一个队列
+            std::size_t start = 0;
+            if (self) {
+                self->random ^= self->random << 13;
+                self->random ^= self->random >> 7;
+                self->random ^= self->random << 17;
+                start = static_cast<std::size_t>(self->random % count);
+            }
+            for (std::size_t i = 0; i < count && !node; ++i) {
+                Worker* victim = workers_[(start + i) % count].get();
+                if (victim != self) {
+                    node = victim->deques[level].steal();
+                }
+            }
+        }
+        if (node) {
+            queued_[level].fetch_sub(1, std::memory_order_relaxed);
+            pending_.fetch_sub(1, std::memory_order_relaxed);
+            return node;
+        }
+    }
+    return nullptr;
+}
+
+void TaskScheduler::execute(Node* node) {
+    std::unique_ptr<Node> owned(node);
+    if (owned->token && owned->token->isCancelled()) {
+        return;
+    }
+    try {
+        owned->task();
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "TaskScheduler: task threw: %s\n", e.what());
+    } catch (...) {
+        std::fprintf(stderr, "TaskScheduler: task threw an unknown exception\n");
+    }
+}
+
+bool TaskScheduler::runPendingTask() {
+    Node* node = take(isWorkerThread() ? currentWorker_ : nullptr);
+    if (!node) {
+        return false;
+    }
+    execute(node);
+    return true;
+}
+
+void TaskScheduler::workerLoop(Worker* self) {
+    currentWorker_ = self;
+    for (;;) {
+        if (Node* node = take(self)) {
+            execute(node);
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(sleepMutex_);
+        if (stopping_ && pending_.load(std::memory_order_seq_cst) <= 0) {
+            break;
+        }
+        sleepers_.fetch_add(1, std::memory_order_seq_cst);
+        // 提交方在 sleepers_ 大于 0 时加锁通知；超时只是兜底
+        wake_.wait_for(lock, std::chrono::milliseconds(50), [this]() {
+            return stopping_ || pending_.load(std::memory_order_seq_cst) > 0;
+        });
+        sleepers_.fetch_sub(1, std::memory_order_seq_cst);
+    }
+    currentWorker_ = nullptr;
+}
+
+TaskGroup::TaskGroup(TaskScheduler& scheduler) : scheduler_(scheduler), pending_(0) {
+}
+
+TaskGroup::~TaskGroup() {
+    waitAll();
+}
+
+void TaskGroup::run(TaskScheduler::Task task, TaskPriority priority) {
+    pending_.fetch_add(1, std::memory_order_relaxed);
+    scheduler_.submit([this, task = std::move(task)]() {
+        std::exception_ptr error;
+        try {
+            task();
+        } catch (...) {
+            error = std::current_exception();
+        }
+        finish(error);
+    }, priority);
+}
+
+void TaskGroup::finish(std::exception_ptr error) {
+    // 在锁内减计数：等待方看到 0 并取得锁之后，这里不会再访问本对象
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (error && !error_) {
+        error_ = error;
+    }
+    if (pending_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        done_.notify_all();
+    }
+}
+
+void TaskGroup::waitAll() {
+    while (pending_.load(std::memory_order_acquire) != 0) {
+        if (scheduler_.runPendingTask()) {
+            continue;
+        }
+        // 剩下的任务正在其他线程执行；短暂等待后再看看有没有可以帮忙的任务
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_.wait_for(lock, std::chrono::milliseconds(1), [this]() {
+            return pending_.load(std::memory_order_acquire) == 0;
+        });
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+}
+
+void TaskGroup::wait() {
+    waitAll();
+    std::exception_ptr error;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::swap(error, error_);
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+} // namespace common
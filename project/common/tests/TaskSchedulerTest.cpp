@@ -0,0 +1,171 @@
+#include "common/TaskScheduler.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace common {
+namespace {
+
+/**
+ * 单个工作线程的调度器：先用一个任务占住工作线程，排好队后再放行，执行顺序完全由调度决定
+ */
+class TaskSchedulerTest : public ::testing::Test {
+protected:
+    TaskScheduler scheduler_{1};
+    std::promise<void> release_;
+    std::mutex mutex_;
+    std::vector<std::string> order_;
+
+    void blockWorker() {
+        std::promise<void> started;
+        std::shared_future<void> release = release_.get_future().share();
+        scheduler_.submit([&started, release]() {
+            started.set_value();
+            release.wait();
+        }, TaskPriority::High);
+        started.get_future().wait();
+    }
+
+    TaskScheduler::Task record(std::string name) {
+        return [this, name]() {
+            std::lock_guard<std::mutex> lock(mutex_);
+            order_.push_back(name);
+        };
+    }
+
+    // 放行工作线程，并等待之后提交的所有任务执行完
+    std::vector<std::string> drain() {
+        release_.set_value();
+        std::promise<void> done;
+        scheduler_.submit([&done]() { done.set_value(); }, TaskPriority::Low);
+        done.get_future().wait();
+        std::lock_guard<std::mutex> lock(mutex_);
+        return order_;
+    }
+};
+
+TEST_F(TaskSchedulerTest, InjectedTasksRunByPriorityThenFifo) {
+    blockWorker();
+    scheduler_.submit(record("low1"), TaskPriority::Low);
+    scheduler_.submit(record("normal1"), TaskPriority::Normal);
+    scheduler_.submit(record("high1"), TaskPriority::High);
+    scheduler_.submit(record("low2"), TaskPriority::Low);
+    scheduler_.submit(record("normal2"), TaskPriority::Normal);
+    scheduler_.submit(record("high2"), TaskPriority::High);
+
+    EXPECT_EQ(drain(), (std::vector<std::string>{"high1", "high2", "normal1", "normal2", "low1", "low2"}));
+}
+
+TEST_F(TaskSchedulerTest, WorkerSubmittedTasksRunByPriority) {
+    blockWorker();
+    // 工作线程中提交的任务进入它自己的队列（同一优先级后进先出）
+    std::promise<void> submitted;
+    scheduler_.submit([this, &submitted]() {
+        scheduler_.submit(record("low"), TaskPriority::Low);
+        scheduler_.submit(record("normal"), TaskPriority::Normal);
+        scheduler_.submit(record("high"), TaskPriority::High);
+        submitted.set_value();
+    }, TaskPriority::Normal);
+
+    const auto order = drain();
+    submitted.get_future().wait();
+    EXPECT_EQ(order, (std::vector<std::string>{"high", "normal", "low"}));
+}
+
+TEST_F(TaskSchedulerTest, CancelledTasksDoNotRun) {
+    blockWorker();
+    CancellationToken stale;
+    CancellationToken latest;
+    scheduler_.submit(record("stale1"), stale, TaskPriority::High);
+    scheduler_.submit(record("stale2"), stale, TaskPriority::Normal);
+    scheduler_.submit(record("latest"), latest, TaskPriority::Normal);
+    stale.cancel();
+
+    EXPECT_EQ(drain(), (std::vector<std::string>{"latest"}));
+    EXPECT_TRUE(stale.isCancelled());
+    EXPECT_FALSE(latest.isCancelled());
+}
+
+TEST_F(TaskSchedulerTest, ExceptionDoesNotStopWorker) {
+    scheduler_.submit([]() { throw std::runtime_error("expected"); });
+    blockWorker();
+    scheduler_.submit(record("after"));
+    EXPECT_EQ(drain(), (std::vector<std::string>{"after"}));
+}
+
+TEST(TaskSchedulerParallelTest, ParallelForCoversRangeOnce) {
+    TaskScheduler scheduler(4);
+    std::vector<std::atomic<int>> visits(10007);
+    for (auto& visit : visits) {
+        visit.store(0, std::memory_order_relaxed);
+    }
+    scheduler.parallelFor(0, visits.size(), 64, [&](std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; ++i) {
+            visits[i].fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+    for (std::size_t i = 0; i < visits.size(); ++i) {
+        ASSERT_EQ(visits[i].load(), 1) << i;
+    }
+
+    // 按块顺序合并：字符串拼接不满足交换律，结果仍与顺序执行相同
+    const std::string digits = scheduler.parallelReduce(0, 100, 7, std::string(),
+        [](std::size_t first, std::size_t last) {
+            std::string text;
+            for (std::size_t i = first; i < last; ++i) {
+                text += static_cast<char>('0' + i % 10);
+            }
+            return text;
+        },
+        [](std::string a, std::string b) { return a + b; });
+    std::string expected;
+    for (int i = 0; i < 100; ++i) {
+        expected += static_cast<char>('0' + i % 10);
+    }
+    EXPECT_EQ(digits, expected);
+}
+
+TEST(TaskSchedulerParallelTest, NestedGroupsDoNotDeadlock) {
+    // 工作线程中等待子任务时帮忙执行，嵌套深度超过线程数也能完成
+    TaskScheduler scheduler(2);
+    std::atomic<int> leaves{0};
+    std::function<void(int)> spawn = [&](int depth) {
+        if (depth == 0) {
+            leaves.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        TaskGroup group(scheduler);
+        group.run([&spawn, depth]() { spawn(depth - 1); });
+        group.run([&spawn, depth]() { spawn(depth - 1); });
+        group.wait();
+    };
+    TaskGroup root(scheduler);
+    root.run([&spawn]() { spawn(8); });
+    root.wait();
+    EXPECT_EQ(leaves.load(), 256);
+}
+
+TEST(TaskSchedulerParallelTest, GroupRethrowsFirstException) {
+    TaskScheduler scheduler(2);
+    TaskGroup group(scheduler);
+    std::atomic<int> completed{0};
+    for (int i = 0; i < 10; ++i) {
+        group.run([&completed, i]() {
+            if (i == 3) {
+                throw std::runtime_error("task 3");
+            }
+            completed.fetch_add(1);
+        });
+    }
+    EXPECT_THROW(group.wait(), std::runtime_error);
+    EXPECT_EQ(completed.load(), 9);
+}
+
+} // namespace
+} // namespace common
@@ -0,0 +1,117 @@
+#include "common/WorkStealingDeque.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace common {
+namespace {
+
+TEST(WorkStealingDequeTest, OwnerPopsNewestThiefStealsOldest) {
+    int items[3] = {0, 1, 2};
+    WorkStealingDeque<int> deque;
+    EXPECT_EQ(deque.pop(), nullptr);
+    EXPECT_EQ(deque.steal(), nullptr);
+
+    for (int& item : items) {
+        deque.push(&item);
+    }
+    EXPECT_EQ(deque.sizeHint(), 3);
+    EXPECT_EQ(deque.pop(), &items[2]);
+    EXPECT_EQ(deque.steal(), &items[0]);
+    EXPECT_EQ(deque.pop(), &items[1]);
+    EXPECT_EQ(deque.pop(), nullptr);
+    EXPECT_EQ(deque.steal(), nullptr);
+    EXPECT_EQ(deque.sizeHint(), 0);
+}
+
+TEST(WorkStealingDequeTest, GrowsAndKeepsOrder) {
+    std::vector<int> items(1000);
+    WorkStealingDeque<int> deque(2);
+    for (int& item : items) {
+        deque.push(&item);
+    }
+    // 扩容后窃取端仍从最早的元素开始
+    for (std::size_t i = 0; i < items.size() / 2; ++i) {
+        ASSERT_EQ(deque.steal(), &items[i]);
+    }
+    for (std::size_t i = items.size(); i-- > items.size() / 2;) {
+        ASSERT_EQ(deque.pop(), &items[i]);
+    }
+    EXPECT_EQ(deque.pop(), nullptr);
+}
+
+/**
+ * 所属线程交替 push / pop，多个窃取者同时 steal；每个元素必须恰好被取走一次
+ * 初始容量很小，扩容也发生在竞争期间
+ */
+TEST(WorkStealingDequeTest, NoTaskLostOrDuplicatedUnderContention) {
+    constexpr int kItems = 200000;
+    constexpr int kThieves = 3;
+    std::vector<int> items(kItems);
+    std::vector<std::atomic<int>> taken(kItems);
+    for (auto& count : taken) {
+        count.store(0, std::memory_order_relaxed);
+    }
+    std::atomic<int> total{0};
+    auto take = [&](int* item) {
+        taken[item - items.data()].fetch_add(1, std::memory_order_relaxed);
+        total.fetch_add(1, std::memory_order_relaxed);
+    };
+
+    WorkStealingDeque<int> deque(2);
+    std::atomic<bool> start{false};
+    std::atomic<bool> ownerDone{false};
+    std::vector<std::thread> thieves;
+    for (int i = 0; i < kThieves; ++i) {
+        thieves.emplace_back([&]() {
+            while (!start.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            for (;;) {
+                if (int* item = deque.steal()) {
+                    take(item);
+                } else if (ownerDone.load(std::memory_order_acquire) && deque.sizeHint() == 0) {
+                    break;   // 不再有新元素且已取空；元素丢失时测试失败而不是挂起
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    start.store(true, std::memory_order_release);
+    for (int i = 0; i < kItems; ++i) {
+        deque.push(&items[i]);
+        // 每推入三个弹出一个：所属线程与窃取者经常争抢最后一个元素
+        if (i % 3 == 2) {
+            if (int* item = deque.pop()) {
+                take(item);
+            }
+        }
+        // 单核机器上也让窃取者在所属线程工作期间运行
+        if (i % 256 == 0) {
+            std::this_thread::yield();
+        }
+    }
+    while (int* item = deque.pop()) {
+        take(item);
+    }
+    ownerDone.store(true, std::memory_order_release);
+    for (auto& thief : thieves) {
+        thief.join();
+    }
+
+    EXPECT_EQ(total.load(), kItems);
+    int lost = 0;
+    int duplicated = 0;
+    for (auto& count : taken) {
+        lost += count.load() == 0;
+        duplicated += count.load() > 1;
+    }
+    EXPECT_EQ(lost, 0);
+    EXPECT_EQ(duplicated, 0);
+}
+
+} // namespace
+} // namespace common